@@ -0,0 +1,118 @@
+#include "bench.h"
+#include <stdlib.h>
+
+#include <iostream>
+#include "vectorial/mat3x4f.h"
+
+#define NUM (16384)
+#define ITER 100
+using namespace vectorial;
+
+namespace {
+    template<typename T>
+    T* alloc(size_t n) {
+        void *ptr = memalign(n*sizeof(T), 16);
+        return static_cast<T*>(ptr);
+    }
+}
+
+
+// The same NUM parent/local transforms of a scene graph as mat4f and mat3x4f
+static mat4f* ma;
+static mat4f* mb;
+static mat4f* mout;
+static mat3x4f* aa;
+static mat3x4f* ab;
+static mat3x4f* aout;
+static vec3f* v;
+static vec3f* vout;
+
+
+void mat4_affine_compose_func() {
+    for(size_t i = 0; i < NUM; ++i)
+    {
+        mout[i] = ma[i] * mb[i];
+    }
+}
+
+void mat3x4_compose_func() {
+    for(size_t i = 0; i < NUM; ++i)
+    {
+        aout[i] = aa[i] * ab[i];
+    }
+}
+
+void mat4_affine_point_func() {
+    for(size_t i = 0; i < NUM; ++i)
+    {
+        vout[i] = transformPoint(ma[i], v[i]);
+    }
+}
+
+void mat3x4_point_func() {
+    for(size_t i = 0; i < NUM; ++i)
+    {
+        vout[i] = transformPoint(aa[i], v[i]);
+    }
+}
+
+void mat4_affine_inverse_func() {
+    for(size_t i = 0; i < NUM; ++i)
+    {
+        mout[i] = inverse(ma[i]);
+    }
+}
+
+void mat3x4_inverse_func() {
+    for(size_t i = 0; i < NUM; ++i)
+    {
+        aout[i] = inverse(aa[i]);
+    }
+}
+
+void mat3x4_ortho_inverse_func() {
+    for(size_t i = 0; i < NUM; ++i)
+    {
+        aout[i] = orthoInverse(aa[i]);
+    }
+}
+
+
+void affine_bench() {
+
+    ma = alloc<mat4f>(NUM);
+    mb = alloc<mat4f>(NUM);
+    mout = alloc<mat4f>(NUM);
+    aa = alloc<mat3x4f>(NUM);
+    ab = alloc<mat3x4f>(NUM);
+    aout = alloc<mat3x4f>(NUM);
+    v = alloc<vec3f>(NUM);
+    vout = alloc<vec3f>(NUM);
+
+    for(size_t i = 0; i < NUM; ++i)
+    {
+        ma[i] = mat4f::translation(vec3f(i, 1, -2)) * mat4f::axisRotation(0.001f * i, vec3f(1, (float)(i % 7), 2));
+        mb[i] = mat4f::translation(vec3f(0, -3, i)) * mat4f::axisRotation(2.0f - 0.0001f * i, vec3f((float)(i % 5), 1, -1));
+        aa[i] = mat3x4f(ma[i]);
+        ab[i] = mat3x4f(mb[i]);
+        v[i] = vec3f(i, NUM-i, 1);
+    }
+
+    profile("mat4f affine compose", mat4_affine_compose_func, ITER, NUM);
+    profile("mat3x4f compose", mat3x4_compose_func, ITER, NUM);
+    profile("mat4f affine transformPoint", mat4_affine_point_func, ITER, NUM);
+    profile("mat3x4f transformPoint", mat3x4_point_func, ITER, NUM);
+    profile("mat4f affine inverse", mat4_affine_inverse_func, ITER, NUM);
+    profile("mat3x4f inverse", mat3x4_inverse_func, ITER, NUM);
+    profile("mat3x4f orthoInverse", mat3x4_ortho_inverse_func, ITER, NUM);
+
+    memfree(ma);
+    memfree(mb);
+    memfree(mout);
+    memfree(aa);
+    memfree(ab);
+    memfree(aout);
+    memfree(v);
+    memfree(vout);
+
+}
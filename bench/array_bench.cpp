@@ -0,0 +1,74 @@
+#include "bench.h"
+#include <stdlib.h>
+
+#include <iostream>
+#include "vectorial/simd4x4f_array.h"
+
+#define NUM (81920)
+#define ITER 100
+
+namespace {
+    simd4f* alloc_simd4f(size_t n) {
+        void *ptr = memalign(n*sizeof(simd4f), 16);
+        return static_cast<simd4f*>(ptr);
+    }
+    simd4x4f* alloc_simd4x4f(size_t n) {
+        void *ptr = memalign(n*sizeof(simd4x4f), 16);
+        return static_cast<simd4x4f*>(ptr);
+    }
+}
+
+
+static simd4x4f* ma;
+static simd4x4f* mb;
+static simd4x4f* mo;
+static simd4f* a;
+static simd4f* b;
+
+
+void array_matrix_mul_func() {
+    simd4x4f_matrix_mul_array(ma, mb, mo, NUM/16);
+}
+
+void array_point3_mul_func() {
+    simd4x4f_matrix_point3_mul_array(&ma[0], a, b, NUM);
+}
+
+void array_bench() {
+
+    a = alloc_simd4f(NUM);
+    b = alloc_simd4f(NUM);
+    ma = alloc_simd4x4f(NUM/16);
+    mb = alloc_simd4x4f(NUM/16);
+    mo = alloc_simd4x4f(NUM/16);
+
+    for(size_t i = 0; i < NUM; ++i)
+    {
+        a[i] = simd4f_create(i, NUM-i, i, 1);
+    }
+    for(size_t i = 0; i < NUM/16; ++i)
+    {
+        simd4x4f_axis_rotation(&ma[i], 0.5f, simd4f_create(1,2,i,0));
+        simd4x4f_axis_rotation(&mb[i], 0.25f, simd4f_create(i,2,3,0));
+        ma[i].w = simd4f_create(1,2,3,1);
+    }
+
+    // One run per set of kernels, the levels below AVX2 use the generic ones
+    const vectorial_isa isas[] = { VECTORIAL_ISA_GENERIC, VECTORIAL_ISA_AVX2, VECTORIAL_ISA_AVX512 };
+    for(size_t k = 0; k < sizeof(isas) / sizeof(isas[0]) && isas[k] <= vectorial_cpu_isa(); ++k)
+    {
+        vectorial_dispatch_force(isas[k]);
+        const std::string isa = std::string(", ") + vectorial_isa_name(isas[k]);
+        std::cout << "Dispatch: " << vectorial_isa_name(vectorial_dispatch_isa()) << std::endl;
+        profile(("simd4x4f_matrix_mul_array" + isa).c_str(), array_matrix_mul_func, ITER, NUM/16);
+        profile(("simd4x4f_matrix_point3_mul_array" + isa).c_str(), array_point3_mul_func, ITER, NUM);
+    }
+    vectorial_dispatch_force(VECTORIAL_ISA_DEFAULT);
+
+    memfree(a);
+    memfree(b);
+    memfree(ma);
+    memfree(mb);
+    memfree(mo);
+
+}
@@ -1,8 +1,40 @@
 #include "bench.h"
-#include <sstream>
+#include <algorithm>
+#include <fstream>
 #include <iostream>
+#include <sstream>
+#include <vector>
+#include <math.h>
+#include <string.h>
 #include "vectorial/config.h"
 
+/*
+  Usage: benchmark [options] [bench...]
+
+  Runs the named benches, all of them by default, see --list. Each
+  profile() warms up, then times every call of its function on its own
+  and reports the median, 5th and 95th percentile, mean and standard
+  deviation of those samples. Per item times and items per second come
+  from the median.
+
+    --list            print the bench names and exit
+    --filter TEXT     only the profiles with TEXT in their name
+    --samples N       samples per profile instead of each bench's own count
+    --warmup SECONDS  least time spent warming up, 0.05 by default
+    --format FORMAT   text, json or csv
+    --output FILE     write the json or csv there instead of stdout
+    --counters        hardware counters per item, Linux only
+
+  The counters cover the timed samples of the calling thread: cycles,
+  instructions, L1d read misses, last level cache misses and branch
+  misses, and instructions per cycle from the first two. Work handed to
+  other threads, as in the parallel bench, isn't counted. When they
+  can't be opened the benches run without them.
+
+  With json or csv going to stdout the text output and whatever the
+  benches print moves to stderr, so stdout stays machine readable.
+*/
+
 
 namespace profiler {
 
@@ -13,7 +45,7 @@ namespace profiler {
     }
     #endif
     
-    #ifdef BENCH_GTOD
+    #ifdef BENCH_CLOCK_GETTIME
     void init() {
     }
     #endif
@@ -28,40 +60,24 @@ namespace profiler {
     #endif
 
 
-    time_t now() {
+    uint64_t now() {
 
         #ifdef BENCH_MACH
-        return mach_absolute_time();
+        return mach_absolute_time() * info.numer / info.denom;
         #endif
 
-        #ifdef BENCH_GTOD
-        time_t v;
-        gettimeofday(&v, NULL);
-        return v;
+        #ifdef BENCH_CLOCK_GETTIME
+        struct timespec v;
+        clock_gettime(CLOCK_MONOTONIC, &v);
+        return uint64_t(v.tv_sec) * 1000000000u + v.tv_nsec;
         #endif
         
         #ifdef BENCH_QPC
         LARGE_INTEGER v;
         QueryPerformanceCounter(&v);
-        return v;
-        #endif
-
-    }
-    
-    
-    double diffTime(time_t start, time_t end) {
-        
-        #ifdef BENCH_GTOD
-        return (end.tv_sec - start.tv_sec) + (end.tv_usec - start.tv_usec) / 1000000.0;
-        #endif
-        
-        #ifdef BENCH_MACH        
-        return ((end-start) * info.numer / info.denom) / 1000000000.0;
+        return uint64_t(v.QuadPart / frequency * 1e9);
         #endif
 
-        #ifdef BENCH_QPC
-        return (end.QuadPart - start.QuadPart) / frequency;
-        #endif
     }
     
 }
@@ -81,37 +97,297 @@ std::string formatTime(double d, double relative ) {
     return ss.str();
 }
 
-void profile(const char* name, void (*func)(), int iterations, int elements) {
-    
+
+namespace {
+
+    struct options {
+        int samples;
+        double warmup;
+        std::string format;
+        std::string output;
+        std::string filter;
+        bool counters;
+
+        options() : samples(0), warmup(0.05), format("text"), counters(false) {}
+    };
+
+    // Seconds per call
+    struct result {
+        std::string bench, name;
+        int elements, samples, bytes_per_element;
+        double median, p5, p95, mean, stddev;
+
+        // Per item, -1 when not counted
+        double counts[counters::event_count];
+
+        bool counted(int e) const { return counts[e] >= 0; }
+        double ipc() const {
+            return counted(counters::cycles) && counted(counters::instructions) && counts[counters::cycles] > 0 ?
+                counts[counters::instructions] / counts[counters::cycles] : -1;
+        }
+    };
+
+    options opts;
+    std::string current_bench;
+    std::vector<result> results;
+
+    double percentile(const std::vector<double>& sorted, double p) {
+        const double at = p * (sorted.size() - 1);
+        const size_t i = size_t(at);
+        if( i + 1 >= sorted.size() ) return sorted.back();
+        return sorted[i] + (sorted[i+1] - sorted[i]) * (at - i);
+    }
+
+    void write_optional(std::ostream& out, double v, const char* none) {
+        if( v < 0 ) out << none;
+        else out << v;
+    }
+
+    std::string quoted(const std::string& s, char escape) {
+        std::string q = "\"";
+        for(size_t i = 0; i < s.size(); ++i) {
+            if( s[i] == '"' || s[i] == '\\' ) q += s[i] == '"' ? escape : '\\';
+            q += s[i];
+        }
+        return q + "\"";
+    }
+
+    void write_json(std::ostream& out) {
+        out.precision(9);
+        out << "{\n";
+        out << "  \"simd\": " << quoted(VECTORIAL_SIMD_TYPE, '\\') << ",\n";
+        out << "  \"simd8f\": " << quoted(VECTORIAL_SIMD8F_TYPE, '\\') << ",\n";
+        #ifdef __VERSION__
+        out << "  \"compiler\": " << quoted(__VERSION__, '\\') << ",\n";
+        #endif
+        out << "  \"results\": [";
+        for(size_t i = 0; i < results.size(); ++i) {
+            const result& r = results[i];
+            out << (i ? ",\n" : "\n");
+            out << "    { \"bench\": " << quoted(r.bench, '\\') << ", \"name\": " << quoted(r.name, '\\')
+                << ", \"elements\": " << r.elements << ", \"samples\": " << r.samples
+                << ", \"median_ns\": " << r.median * 1e9 << ", \"p5_ns\": " << r.p5 * 1e9 << ", \"p95_ns\": " << r.p95 * 1e9
+                << ", \"mean_ns\": " << r.mean * 1e9 << ", \"stddev_ns\": " << r.stddev * 1e9
+                << ", \"ns_per_element\": " << r.median * 1e9 / r.elements
+                << ", \"elements_per_second\": " << r.elements / r.median;
+            out << ", \"bytes_per_element\": " << r.bytes_per_element << ", \"bytes_per_second\": ";
+            write_optional(out, r.bytes_per_element ? r.bytes_per_element * r.elements / r.median : -1, "null");
+            for(int e = 0; e < counters::event_count; ++e) {
+                out << ", \"" << counters::names[e] << "_per_element\": ";
+                write_optional(out, r.counts[e], "null");
+            }
+            out << ", \"ipc\": ";
+            write_optional(out, r.ipc(), "null");
+            out << " }";
+        }
+        out << "\n  ]\n}\n";
+    }
+
+    void write_csv(std::ostream& out) {
+        out.precision(9);
+        out << "bench,name,simd,elements,samples,median_ns,p5_ns,p95_ns,mean_ns,stddev_ns,ns_per_element,elements_per_second,bytes_per_element,bytes_per_second";
+        for(int e = 0; e < counters::event_count; ++e) out << "," << counters::names[e] << "_per_element";
+        out << ",ipc\n";
+        for(size_t i = 0; i < results.size(); ++i) {
+            const result& r = results[i];
+            out << r.bench << "," << quoted(r.name, '"') << "," << VECTORIAL_SIMD_TYPE << "," << r.elements << "," << r.samples << ","
+                << r.median * 1e9 << "," << r.p5 * 1e9 << "," << r.p95 * 1e9 << ","
+                << r.mean * 1e9 << "," << r.stddev * 1e9 << ","
+                << r.median * 1e9 / r.elements << "," << r.elements / r.median << "," << r.bytes_per_element << ",";
+            write_optional(out, r.bytes_per_element ? r.bytes_per_element * r.elements / r.median : -1, "");
+            for(int e = 0; e < counters::event_count; ++e) {
+                out << ",";
+                write_optional(out, r.counts[e], "");
+            }
+            out << ",";
+            write_optional(out, r.ipc(), "");
+            out << "\n";
+        }
+    }
+
+}
+
+
+bool profiled(const char* name) {
+    return opts.filter.empty() || strstr(name, opts.filter.c_str()) != 0;
+}
+
+void profile(const char* name, void (*func)(), int iterations, int elements, int bytes_per_element) {
+
+    if( !profiled(name) ) return;
+
     profiler::init();
-    profiler::time_t start = profiler::now();
-    for(int i = 0; i < iterations; ++i)
+    const uint64_t warmup_end = profiler::now() + uint64_t(opts.warmup * 1e9);
+    do {
+        func();
+    } while( profiler::now() < warmup_end );
+
+    const int count = opts.samples > 0 ? opts.samples : iterations;
+    std::vector<double> samples(count);
+    int64_t counts[counters::event_count];
+    if( opts.counters ) counters::start();
+    for(int i = 0; i < count; ++i)
     {
+        const uint64_t start = profiler::now();
         func();
+        samples[i] = (profiler::now() - start) * 1e-9;
     }
-    profiler::time_t end = profiler::now();
-    
-    std::cout << "Using simd: " << VECTORIAL_SIMD_TYPE << std::endl;
+    if( opts.counters ) counters::stop(counts);
+    else for(int e = 0; e < counters::event_count; ++e) counts[e] = -1;
+    std::sort(samples.begin(), samples.end());
+
+    result r;
+    r.bench = current_bench;
+    r.name = name;
+    r.elements = elements;
+    r.bytes_per_element = bytes_per_element;
+    r.samples = count;
+    r.median = percentile(samples, 0.5);
+    r.p5 = percentile(samples, 0.05);
+    r.p95 = percentile(samples, 0.95);
+    double sum = 0, sum2 = 0;
+    for(int i = 0; i < count; ++i) sum += samples[i];
+    r.mean = sum / count;
+    for(int i = 0; i < count; ++i) sum2 += (samples[i] - r.mean) * (samples[i] - r.mean);
+    r.stddev = count > 1 ? sqrt(sum2 / (count - 1)) : 0.0;
+    for(int e = 0; e < counters::event_count; ++e)
+        r.counts[e] = counts[e] < 0 ? -1 : counts[e] / (double(count) * elements);
+    results.push_back(r);
+
     std::cout << "Testing: " << name << std::endl;
-    std::cout << "Duration " << formatTime(profiler::diffTime(start,end)) << std::endl;
-    std::cout << "Per iter " << formatTime(profiler::diffTime(start,end) / iterations) << std::endl;
-    std::cout << "Per item " << formatTime(profiler::diffTime(start,end) / iterations / elements) << std::endl;
+    std::cout << "Per iter " << formatTime(r.median) << ", p5 " << formatTime(r.p5, r.median) << ", p95 " << formatTime(r.p95, r.median)
+              << ", stddev " << formatTime(r.stddev, r.median) << " over " << count << " samples" << std::endl;
+    std::cout << "Per item " << formatTime(r.median / elements) << ", " << elements / r.median / 1e6 << "M items/s";
+    if( bytes_per_element ) std::cout << ", " << bytes_per_element * (elements / r.median) / 1e9 << "GB/s";
+    std::cout << std::endl;
+    if( opts.counters ) {
+        std::cout << "Counters per item";
+        for(int e = 0; e < counters::event_count; ++e) {
+            std::cout << (e ? ", " : " ") << counters::names[e] << " ";
+            write_optional(std::cout, r.counts[e], "-");
+        }
+        std::cout << ", ipc ";
+        write_optional(std::cout, r.ipc(), "-");
+        std::cout << std::endl;
+    }
 
-    
 }
 
 void add_bench();
 void dot_bench();
 void quad_bench();
 void matrix_bench();
+void madd_bench();
+void array_bench();
+void soa_bench();
+void transform_bench();
+void parallel_bench();
+void math_bench();
+void quat_bench();
+void affine_bench();
+void mat3_bench();
+void cull_bench();
+void ray_bench();
+void bounds_bench();
+void latency_bench();
+void sweep_bench();
 
-int main() {
-    
-//    add_bench();
-//    dot_bench();
-//    quad_bench();
-    matrix_bench();
+struct bench_entry {
+    const char* name;
+    void (*func)();
+};
 
-    return 0;
+static const bench_entry benches[] = {
+    { "add", add_bench },
+    { "dot", dot_bench },
+    { "quad", quad_bench },
+    { "matrix", matrix_bench },
+    { "madd", madd_bench },
+    { "array", array_bench },
+    { "soa", soa_bench },
+    { "transform", transform_bench },
+    { "parallel", parallel_bench },
+    { "math", math_bench },
+    { "quat", quat_bench },
+    { "affine", affine_bench },
+    { "mat3", mat3_bench },
+    { "cull", cull_bench },
+    { "ray", ray_bench },
+    { "bounds", bounds_bench },
+    { "latency", latency_bench },
+    { "sweep", sweep_bench },
+};
+
+static const size_t bench_count = sizeof(benches) / sizeof(benches[0]);
+
+
+static int usage(const char* error) {
+    std::cerr << "benchmark: " << error << std::endl;
+    std::cerr << "usage: benchmark [--list] [--filter TEXT] [--samples N] [--warmup SECONDS] [--counters]" << std::endl;
+    std::cerr << "                 [--format text|json|csv] [--output FILE] [bench...]" << std::endl;
+    return 2;
 }
 
+int main(int argc, char** argv) {
+
+    std::vector<std::string> selected;
+    for(int i = 1; i < argc; ++i)
+    {
+        const std::string arg = argv[i];
+        const bool has_value = i + 1 < argc;
+        if( arg == "--list" ) {
+            for(size_t b = 0; b < bench_count; ++b) std::cout << benches[b].name << std::endl;
+            return 0;
+        }
+        else if( arg == "--help" ) return usage("benchmarks of vectorial");
+        else if( arg == "--filter" && has_value ) opts.filter = argv[++i];
+        else if( arg == "--samples" && has_value ) opts.samples = atoi(argv[++i]);
+        else if( arg == "--warmup" && has_value ) opts.warmup = atof(argv[++i]);
+        else if( arg == "--format" && has_value ) opts.format = argv[++i];
+        else if( arg == "--output" && has_value ) opts.output = argv[++i];
+        else if( arg == "--counters" ) opts.counters = true;
+        else if( arg.compare(0, 2, "--") == 0 ) return usage(("bad option " + arg).c_str());
+        else {
+            bool known = false;
+            for(size_t b = 0; b < bench_count; ++b) known = known || arg == benches[b].name;
+            if( !known ) return usage(("no bench named " + arg + ", see --list").c_str());
+            selected.push_back(arg);
+        }
+    }
+    if( opts.format != "text" && opts.format != "json" && opts.format != "csv" ) return usage("format is text, json or csv");
+    if( opts.samples < 0 || opts.warmup < 0 ) return usage("samples and warmup can't be negative");
+
+    if( opts.counters && !counters::open() ) {
+        std::cerr << "benchmark: no counters, " << counters::why() << std::endl;
+        opts.counters = false;
+    }
+
+    // Keep stdout for the report when it goes there
+    std::streambuf* stdout_buf = std::cout.rdbuf();
+    if( opts.format != "text" && opts.output.empty() ) std::cout.rdbuf(std::cerr.rdbuf());
+
+    std::cout << "Using simd: " << VECTORIAL_SIMD_TYPE << ", simd8f: " << VECTORIAL_SIMD8F_TYPE << std::endl;
+    for(size_t b = 0; b < bench_count; ++b)
+    {
+        if( !selected.empty() && std::find(selected.begin(), selected.end(), benches[b].name) == selected.end() ) continue;
+        current_bench = benches[b].name;
+        benches[b].func();
+    }
+
+    std::cout.rdbuf(stdout_buf);
+    if( opts.format == "text" ) return 0;
+
+    std::ofstream file;
+    if( !opts.output.empty() ) {
+        file.open(opts.output.c_str());
+        if( !file ) {
+            std::cerr << "benchmark: can't write " << opts.output << std::endl;
+            return 1;
+        }
+    }
+    std::ostream& out = opts.output.empty() ? std::cout : file;
+    if( opts.format == "json" ) write_json(out);
+    else write_csv(out);
+
+    return 0;
+}
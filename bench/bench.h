@@ -7,17 +7,18 @@
 #ifdef __APPLE__
     #define BENCH_MACH
     #include <mach/mach_time.h>
-    #include <stdint.h>
 #elif defined(_WIN32)
     #define BENCH_QPC
     #define WIN32_LEAN_AND_MEAN
     #include <windows.h>
     #include <malloc.h>
 #else
-    #define BENCH_GTOD
-    #include <sys/time.h>
+    #define BENCH_CLOCK_GETTIME
+    #include <time.h>
 #endif
 
+#include <stdint.h>
+
 
 static void* memalign(size_t count, size_t align) {
     #ifdef _WIN32
@@ -27,7 +28,7 @@ static void* memalign(size_t count, size_t align) {
     int e = posix_memalign(&ptr, align, count);
     //    if( e == EINVAL ) printf("EINVAL posix_memalign\n");
     //    if( e == ENOMEM ) printf("ENOMEM posix_memalign\n");
-    return ptr;
+    return e == 0 ? ptr : 0;
     #endif
 }
 
@@ -41,25 +42,41 @@ static void memfree(void* ptr) {
 
 namespace profiler {
 
-    #ifdef BENCH_GTOD
-        typedef struct timeval time_t;
-    #endif
-    #ifdef BENCH_MACH
-        typedef const uint64_t time_t;
-    #endif
-    #ifdef BENCH_QPC
-        typedef LARGE_INTEGER time_t;
-    #endif
-
     void init();
-    time_t now();
 
-    double diffTime(time_t start, time_t end);
+    // Monotonic clock in nanoseconds
+    uint64_t now();
+
+}
+
+namespace counters {
+
+    enum event { cycles, instructions, l1d_misses, llc_misses, branch_misses, event_count };
+
+    extern const char* const names[event_count];
+
+    // Opens the hardware counters of the calling thread, false when none of
+    // them are available, see why(). Linux perf_event_open only.
+    bool open();
+    const std::string& why();
+
+    void start();
+
+    // Counts since start(), scaled up when the events were multiplexed,
+    // -1 for the ones that couldn't be counted
+    void stop(int64_t* values);
 
 }
 
 std::string formatTime(double d, double relative=-1);
-void profile(const char* name, void (*func)(), int iterations, int elements);
+
+// Times func, which handles elements items per call. iterations is the
+// default sample count, the command line can override it, see bench.cpp.
+// With the bytes each item reads and writes it also reports bandwidth.
+void profile(const char* name, void (*func)(), int iterations, int elements, int bytes_per_element = 0);
+
+// Whether profile() would run name, for skipping costly setup
+bool profiled(const char* name);
 
 
 #endif
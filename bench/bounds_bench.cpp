@@ -0,0 +1,106 @@
+#include "bench.h"
+#include <stdlib.h>
+#include <float.h>
+
+#include <iostream>
+#include "vectorial/bounds.h"
+#include "vectorial/parallel.h"
+
+// A deformed mesh worth of points, 16MB as vec3f
+#define NUM (1024*1024)
+#define ITER 20
+using namespace vectorial;
+
+namespace {
+    template<typename T>
+    T* alloc(size_t n) {
+        void *ptr = memalign(n*sizeof(T), 16);
+        return static_cast<T*>(ptr);
+    }
+}
+
+
+static vec3f* points;
+static float* packed;
+static vec3f lo, hi, center;
+static vec4f sphere;
+
+
+// One min and max per point, every one waiting on the previous
+void bounds_loop_func() {
+    vec3f l(FLT_MAX), h(-FLT_MAX);
+    for(size_t i = 0; i < NUM; ++i)
+    {
+        l = min(l, points[i]);
+        h = max(h, points[i]);
+    }
+    lo = l;
+    hi = h;
+}
+
+void bounds_array_func() {
+    bounds(points, NUM, lo, hi);
+}
+
+void bounds_packed3_func() {
+    bounds(packed, NUM, lo, hi);
+}
+
+void bounds_parallel_func() {
+    parallel_aabb_array(default_thread_pool(), (const simd4f*)points, NUM, &lo.value, &hi.value);
+}
+
+void centroid_loop_func() {
+    vec3f s(0.0f);
+    for(size_t i = 0; i < NUM; ++i)
+    {
+        s += points[i];
+    }
+    center = s / float(NUM);
+}
+
+void centroid_array_func() {
+    center = centroid(points, NUM);
+}
+
+void centroid_packed3_func() {
+    center = centroid(packed, NUM);
+}
+
+void sphere_array_func() {
+    sphere = boundingSphere(points, NUM);
+}
+
+void sphere_packed3_func() {
+    sphere = boundingSphere(packed, NUM);
+}
+
+
+void bounds_bench() {
+
+    points = alloc<vec3f>(NUM);
+    packed = alloc<float>(3 * NUM);
+
+    srand(1);
+    for(size_t i = 0; i < NUM; ++i)
+    {
+        points[i] = vec3f( rand() % 2000 - 1000.0f, (rand() % 2000) * 0.01f, rand() % 500 - 250.0f );
+        points[i].store(packed + 3*i);
+    }
+
+    profile("aabb, vec3f min max loop", bounds_loop_func, ITER, NUM);
+    profile("aabb, vec3f array", bounds_array_func, ITER, NUM);
+    profile("aabb, packed float3", bounds_packed3_func, ITER, NUM);
+    profile("aabb, vec3f array on default pool", bounds_parallel_func, ITER, NUM);
+    profile("centroid, vec3f add loop", centroid_loop_func, ITER, NUM);
+    profile("centroid, vec3f array", centroid_array_func, ITER, NUM);
+    profile("centroid, packed float3", centroid_packed3_func, ITER, NUM);
+    std::cout << "Centroid " << center.x() << " " << center.y() << " " << center.z() << std::endl;
+    profile("bounding sphere, vec3f array", sphere_array_func, ITER, NUM);
+    profile("bounding sphere, packed float3", sphere_packed3_func, ITER, NUM);
+    std::cout << "Radius " << sphere.w() << std::endl;
+
+    memfree(points);
+    memfree(packed);
+
+}
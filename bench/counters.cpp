@@ -0,0 +1,100 @@
+#include "bench.h"
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <errno.h>
+#include <string.h>
+#include <unistd.h>
+#endif
+
+
+namespace counters {
+
+    const char* const names[event_count] = { "cycles", "instructions", "l1d_misses", "llc_misses", "branch_misses" };
+
+    namespace {
+        std::string reason = "hardware counters need Linux perf_event_open";
+    }
+
+    const std::string& why() {
+        return reason;
+    }
+
+    #ifdef __linux__
+
+    namespace {
+
+        int fds[event_count] = { -1, -1, -1, -1, -1 };
+
+        int open_event(uint32_t type, uint64_t config) {
+            struct perf_event_attr attr;
+            memset(&attr, 0, sizeof(attr));
+            attr.size = sizeof(attr);
+            attr.type = type;
+            attr.config = config;
+            attr.disabled = 1;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+            return (int)syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+        }
+
+    }
+
+    bool open() {
+        const uint64_t l1d_read_miss = PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+
+        fds[cycles] = open_event(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+        if( fds[cycles] < 0 ) {
+            reason = std::string("perf_event_open: ") + strerror(errno);
+            if( errno == EACCES || errno == EPERM ) reason += ", see /proc/sys/kernel/perf_event_paranoid";
+            return false;
+        }
+        fds[instructions] = open_event(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+        fds[l1d_misses] = open_event(PERF_TYPE_HW_CACHE, l1d_read_miss);
+        fds[llc_misses] = open_event(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+        fds[branch_misses] = open_event(PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES);
+        return true;
+    }
+
+    void start() {
+        for(int i = 0; i < event_count; ++i)
+        {
+            if( fds[i] < 0 ) continue;
+            ioctl(fds[i], PERF_EVENT_IOC_RESET, 0);
+            ioctl(fds[i], PERF_EVENT_IOC_ENABLE, 0);
+        }
+    }
+
+    void stop(int64_t* values) {
+        for(int i = 0; i < event_count; ++i)
+            if( fds[i] >= 0 ) ioctl(fds[i], PERF_EVENT_IOC_DISABLE, 0);
+
+        for(int i = 0; i < event_count; ++i)
+        {
+            // value, time enabled, time running
+            uint64_t v[3];
+            values[i] = -1;
+            if( fds[i] < 0 || read(fds[i], v, sizeof(v)) != sizeof(v) || v[2] == 0 ) continue;
+            values[i] = int64_t(v[2] < v[1] ? double(v[0]) * v[1] / v[2] : v[0]);
+        }
+    }
+
+    #else
+
+    bool open() {
+        return false;
+    }
+
+    void start() {
+    }
+
+    void stop(int64_t* values) {
+        for(int i = 0; i < event_count; ++i) values[i] = -1;
+    }
+
+    #endif
+
+}
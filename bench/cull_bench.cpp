@@ -0,0 +1,101 @@
+#include "bench.h"
+#include <stdlib.h>
+#include <math.h>
+
+#include <iostream>
+#include "vectorial/frustumf.h"
+
+#define NUM (1024*1024)
+#define ITER 20
+using namespace vectorial;
+
+namespace {
+    template<typename T>
+    T* alloc(size_t n) {
+        void *ptr = memalign(n*sizeof(T), 16);
+        return static_cast<T*>(ptr);
+    }
+}
+
+
+// A million objects scattered around a camera, roughly a fifth visible
+static frustumf frustum;
+static vec4f* spheres;
+static vec3f* box_min;
+static vec3f* box_max;
+static uint32_t* bits;
+static uint32_t* indices;
+static size_t visible;
+
+
+// One plane at a time with vec4f dot, how culling was done before
+void cull_sphere_dot_func() {
+    vec4f planes[6];
+    for(int p = 0; p < 6; ++p) planes[p] = frustum.plane(p);
+
+    size_t count = 0;
+    for(size_t i = 0; i < NUM; ++i)
+    {
+        const vec4f center( spheres[i].x(), spheres[i].y(), spheres[i].z(), 1.0f );
+        const float radius = spheres[i].w();
+        bool inside = true;
+        for(int p = 0; p < 6; ++p) {
+            if( dot(planes[p], center) < -radius ) { inside = false; break; }
+        }
+        if( inside ) indices[count++] = i;
+    }
+    visible = count;
+}
+
+void cull_sphere_bits_func() {
+    cullSpheres(frustum, spheres, NUM, bits);
+}
+
+void cull_sphere_compact_func() {
+    visible = compactSpheres(frustum, spheres, NUM, indices);
+}
+
+void cull_box_bits_func() {
+    cullBoxes(frustum, box_min, box_max, NUM, bits);
+}
+
+void cull_box_compact_func() {
+    visible = compactBoxes(frustum, box_min, box_max, NUM, indices);
+}
+
+
+void cull_bench() {
+
+    spheres = alloc<vec4f>(NUM);
+    box_min = alloc<vec3f>(NUM);
+    box_max = alloc<vec3f>(NUM);
+    bits = alloc<uint32_t>(NUM / 32);
+    indices = alloc<uint32_t>(NUM);
+
+    frustum = frustumf( mat4f::perspective(1.0f, 1.5f, 1.0f, 500.0f)
+                      * mat4f::lookAt(vec3f(0, 10, 0), vec3f(100, 0, 30), vec3f(0, 1, 0)) );
+
+    srand(1);
+    for(size_t i = 0; i < NUM; ++i)
+    {
+        const vec3f c( rand() % 1000 - 500.0f, rand() % 100 - 50.0f, rand() % 1000 - 500.0f );
+        const float r = 0.5f + (rand() % 100) * 0.05f;
+        spheres[i] = vec4f(c.x(), c.y(), c.z(), r);
+        box_min[i] = c - vec3f(r, r, r);
+        box_max[i] = c + vec3f(r, r, r);
+    }
+
+    profile("frustum spheres, vec4f dot per plane", cull_sphere_dot_func, ITER, NUM);
+    std::cout << "Visible " << visible << " of " << NUM << std::endl;
+    profile("frustum spheres, bitmask", cull_sphere_bits_func, ITER, NUM);
+    profile("frustum spheres, compact", cull_sphere_compact_func, ITER, NUM);
+    profile("frustum boxes, bitmask", cull_box_bits_func, ITER, NUM);
+    profile("frustum boxes, compact", cull_box_compact_func, ITER, NUM);
+
+    memfree(spheres);
+    memfree(box_min);
+    memfree(box_max);
+    memfree(bits);
+    memfree(indices);
+
+}
@@ -0,0 +1,353 @@
+#include "bench.h"
+#include <math.h>
+
+#include <iostream>
+#include "vectorial/simd4f.h"
+#include "vectorial/simd4f_math.h"
+#include "vectorial/simd4f_aos.h"
+#include "vectorial/simd4f_quat.h"
+#include "vectorial/simd4f_bounds.h"
+#include "vectorial/simd4f_frustum.h"
+#include "vectorial/simd4f_ray.h"
+#include "vectorial/simd4x4f.h"
+
+#define CHAIN (65536)
+#define WIDTH 8
+#define ITER 30
+
+// Each op is a step from one value to the next. The latency run feeds
+// every result into the next step, the throughput run interleaves WIDTH
+// independent chains so only the issue rate limits them. Per item times
+// are then the latency and the reciprocal throughput of one op.
+//
+// The ops are listed once in the tables below, one line per function of
+// simd4f*.h and simd4x4f.h that works on single values, the array kernels
+// being timed by their own benches. The steps are picked to stay bounded
+// when repeated: tiny offsets and factors next to 1, inverse pairs like
+// exp of log for functions that would run off to infinity or zero on their
+// own, and a compare and select for masks. Functions giving ints or
+// floats nudge the value by a tiny multiple of the result. Those with no
+// input to chain on (identity, zero, the quaternion identity) are left
+// out.
+//
+// _SIMD4F_BARRIER keeps the compiler from folding the steps together,
+// transposes cancelling out for one. On the scalar backend the barrier
+// goes through memory, so those latencies include a store and a load.
+
+namespace {
+
+    simd4f k_add, k_mul, k_div, k_half, k_tan, k_len3, k_len2;
+    simd4f k_dot4, k_dot3, k_dot2, k_cross, k_min, k_max, k_quat, k_axis, k_sphere, k_far;
+    simd4f_mask k_select;
+    simd4x4f rotation, k_add4, k_mul4, k_div4;
+    simd4f_frustum frustum;
+    simd4f_ray_packet rays;
+    simd4f triangle[3];
+
+    simd4f sink;
+
+    void keep(simd4f& v) {
+        _SIMD4F_BARRIER(v);
+    }
+
+    void keep(simd4x4f& m) {
+        _SIMD4F_BARRIER(m.x);
+        _SIMD4F_BARRIER(m.y);
+        _SIMD4F_BARRIER(m.z);
+        _SIMD4F_BARRIER(m.w);
+    }
+
+    simd4f fold(const simd4f& v) { return v; }
+    simd4f fold(const simd4x4f& m) { return simd4f_add( simd4f_add(m.x, m.y), simd4f_add(m.z, m.w) ); }
+
+    template<class Op>
+    void latency_func() {
+        typename Op::type v = Op::start(0);
+        for(size_t i = 0; i < CHAIN; ++i)
+        {
+            v = Op::step(v);
+            keep(v);
+        }
+        sink = fold(v);
+    }
+
+    // Separate locals rather than an array, which ends up on the stack
+    template<class Op>
+    void throughput_func() {
+        typename Op::type v0 = Op::start(0), v1 = Op::start(1), v2 = Op::start(2), v3 = Op::start(3);
+        typename Op::type v4 = Op::start(4), v5 = Op::start(5), v6 = Op::start(6), v7 = Op::start(7);
+        for(size_t i = 0; i < CHAIN; ++i)
+        {
+            v0 = Op::step(v0); v1 = Op::step(v1); v2 = Op::step(v2); v3 = Op::step(v3);
+            v4 = Op::step(v4); v5 = Op::step(v5); v6 = Op::step(v6); v7 = Op::step(v7);
+            keep(v0); keep(v1); keep(v2); keep(v3);
+            keep(v4); keep(v5); keep(v6); keep(v7);
+        }
+        sink = simd4f_add( simd4f_add( simd4f_add(fold(v0), fold(v1)), simd4f_add(fold(v2), fold(v3)) ),
+                           simd4f_add( simd4f_add(fold(v4), fold(v5)), simd4f_add(fold(v6), fold(v7)) ) );
+    }
+
+    template<class Op>
+    void measure(const char* name) {
+        const std::string latency = std::string("latency ") + name;
+        const std::string throughput = std::string("throughput ") + name;
+        profile(latency.c_str(), latency_func<Op>, ITER, CHAIN);
+        profile(throughput.c_str(), throughput_func<Op>, ITER, CHAIN * WIDTH);
+    }
+
+
+    struct vector_op {
+        typedef simd4f type;
+        static simd4f start(int j) { return simd4f_create(1.0f + 0.125f * j, 2.0f, 3.0f, 4.0f); }
+    };
+
+    // Unit quaternions, slerp needs them
+    struct quat_op {
+        typedef simd4f type;
+        static simd4f start(int j) { return simd4f_quat_axis_rotation(0.1f * (j + 1), simd4f_create(0.0f, 0.6f, 0.8f, 0.0f)); }
+    };
+
+    struct matrix_op {
+        typedef simd4x4f type;
+        static simd4x4f start(int j) {
+            simd4x4f m;
+            simd4x4f_axis_rotation(&m, 0.1f * (j + 1), simd4f_create(0.0f, 0.6f, 0.8f, 0.0f));
+            return m;
+        }
+    };
+
+
+    // The value moved by a tiny multiple of an int or float result
+    simd4f nudge(simd4f v, float by) { return simd4f_madd( simd4f_splat(by), k_add, v ); }
+
+    // Functions writing through pointers, as steps returning the value
+
+    typedef void (*vector_transform)(const simd4x4f*, const simd4f*, simd4f*);
+    typedef void (*matrix_binary)(const simd4x4f*, const simd4x4f*, simd4x4f*);
+
+    template<vector_transform F>
+    simd4f transformed(simd4f v) { simd4f r; F(&rotation, &v, &r); return r; }
+
+    template<matrix_binary F>
+    simd4x4f combined(const simd4x4f& a, const simd4x4f& b) { simd4x4f r; F(&a, &b, &r); return r; }
+
+    simd4f stored4(simd4f v) { float f[4]; simd4f_ustore4(v, f); return simd4f_uload4(f); }
+    simd4f stored3(simd4f v) { float f[4]; simd4f_ustore3(v, f); return simd4f_uload3(f); }
+    simd4f stored2(simd4f v) { float f[4]; simd4f_ustore2(v, f); return simd4f_uload2(f); }
+
+    simd4f frexp_ldexp(simd4f v) { simd4f e; const simd4f m = simd4f_frexp(v, &e); return simd4f_ldexp(m, e); }
+    simd4f sincos(simd4f v) { simd4f s, c; simd4f_sincos(v, &s, &c); return simd4f_add(s, c); }
+
+    simd4f matrix_sum(simd4f v) { const simd4x4f m = simd4x4f_create(v, v, v, v); simd4f r; simd4x4f_sum(&m, &r); return simd4f_mul(r, simd4f_splat(0.25f)); }
+    simd4f translation(simd4f v) { simd4x4f m; simd4x4f_translation(&m, simd4f_get_x(v), simd4f_get_y(v), simd4f_get_z(v)); return m.w; }
+    simd4f axis_rotation(simd4f v) { simd4x4f m; simd4x4f_axis_rotation(&m, simd4f_get_x(v), k_axis); return m.x; }
+    simd4f perspective(simd4f v) { simd4x4f m; simd4x4f_perspective(&m, 1.0f + 1e-7f * simd4f_get_x(v), 1.0f, 1.0f, 100.0f); return m.x; }
+    // w.x is -(x + 1), so x flips between two values
+    simd4f ortho(simd4f v) { const float x = simd4f_get_x(v); simd4x4f m; simd4x4f_ortho(&m, x, x + 2.0f, -1.0f, 1.0f, 1.0f, 100.0f); return m.w; }
+    simd4f lookat(simd4f v) { simd4x4f m; simd4x4f_lookat(&m, v, simd4f_zero(), simd4f_create(0.0f, 1.0f, 0.0f, 0.0f)); return m.w; }
+
+    simd4x4f matrix_div(const simd4x4f& m) { simd4x4f a = k_div4, b = m, r; simd4x4f_div(&a, &b, &r); return r; }
+    simd4x4f transposed(const simd4x4f& m) { simd4x4f r; simd4x4f_transpose(&m, &r); return r; }
+    simd4x4f transposed_inplace(const simd4x4f& m) { simd4x4f r = m; simd4x4f_transpose_inplace(&r); return r; }
+    simd4x4f inverted(const simd4x4f& m) { simd4x4f r; simd4x4f_inverse(&m, &r); return r; }
+    simd4x4f uloaded(const simd4x4f& m) { float f[16]; simd4f_ustore4(m.x, f); simd4f_ustore4(m.y, f + 4); simd4f_ustore4(m.z, f + 8); simd4f_ustore4(m.w, f + 12); simd4x4f r; simd4x4f_uload(&r, f); return r; }
+    simd4x4f aos4(const simd4x4f& m) { float f[16]; simd4x4f r; simd4f_aos_store4(m.x, m.y, m.z, m.w, f, 4); simd4f_aos_load4(f, 4, &r.x, &r.y, &r.z, &r.w); return r; }
+    simd4x4f aos3(const simd4x4f& m) { float f[12]; simd4x4f r = m; simd4f_aos_store3(m.x, m.y, m.z, f, 3); simd4f_aos_load3(f, 3, &r.x, &r.y, &r.z); return r; }
+
+    // The rays start from v, so the whole test is on the chain
+    simd4f ray_triangle(simd4f v) {
+        simd4f_ray_packet r = rays;
+        r.ox = v;
+        simd4f t = k_far;
+        simd4f_ray_triangle(&r, triangle[0], triangle[1], triangle[2], &t);
+        return simd4f_madd(t, k_add, v);
+    }
+
+    simd4f ray_aabb(simd4f v) {
+        simd4f_ray_packet r = rays;
+        r.ox = v;
+        simd4f tnear = k_far;
+        simd4f_ray_aabb(&r, simd4f_create(-10.0f, -10.0f, 4.0f, 0.0f), simd4f_create(10.0f, 10.0f, 6.0f, 0.0f), k_far, &tnear);
+        return simd4f_madd(tnear, k_add, v);
+    }
+
+
+#define LATENCY_VECTOR_OPS(OP) \
+    OP(add, simd4f_add(v, k_add)) \
+    OP(sub, simd4f_sub(v, k_add)) \
+    OP(mul, simd4f_mul(v, k_mul)) \
+    OP(madd, simd4f_madd(v, k_mul, k_add)) \
+    /* Dividing by the chain, -ffast-math turns a constant divisor into a mul */ \
+    OP(div, simd4f_div(k_div, v)) \
+    OP(reciprocal, simd4f_reciprocal(v)) \
+    OP(sqrt, simd4f_sqrt(v)) \
+    OP(rsqrt, simd4f_rsqrt(v)) \
+    OP(min, simd4f_min(v, k_min)) \
+    OP(max, simd4f_max(v, k_max)) \
+    OP(floor, simd4f_floor(v)) \
+    OP(frexp_ldexp, frexp_ldexp(v)) \
+    OP(get_x, simd4f_splat(simd4f_get_x(v))) \
+    OP(splat_x, simd4f_splat_x(v)) \
+    OP(splat_y, simd4f_splat_y(v)) \
+    OP(splat_z, simd4f_splat_z(v)) \
+    OP(splat_w, simd4f_splat_w(v)) \
+    OP(get_y, simd4f_splat(simd4f_get_y(v))) \
+    OP(get_z, simd4f_splat(simd4f_get_z(v))) \
+    OP(get_w, simd4f_splat(simd4f_get_w(v))) \
+    OP(shuffle_wxyz, simd4f_shuffle_wxyz(v)) \
+    OP(shuffle_zwxy, simd4f_shuffle_zwxy(v)) \
+    OP(shuffle_yzwx, simd4f_shuffle_yzwx(v)) \
+    OP(zero_w, simd4f_zero_w(v)) \
+    OP(zero_zw, simd4f_zero_zw(v)) \
+    OP(merge_high, simd4f_merge_high(v, k_dot4)) \
+    OP(flip_sign_0101, simd4f_flip_sign_0101(v)) \
+    OP(flip_sign_1010, simd4f_flip_sign_1010(v)) \
+    OP(ustore4_uload4, stored4(v)) \
+    OP(ustore3_uload3, stored3(v)) \
+    OP(ustore2_uload2, stored2(v)) \
+    OP(cmpeq, simd4f_select(simd4f_cmpeq(v, k_div), k_add, v)) \
+    OP(cmpne, simd4f_select(simd4f_cmpne(v, k_div), v, k_add)) \
+    OP(cmplt, simd4f_select(simd4f_cmplt(v, k_min), v, k_add)) \
+    OP(cmple, simd4f_select(simd4f_cmple(v, k_min), v, k_add)) \
+    OP(cmpgt, simd4f_select(simd4f_cmpgt(v, k_max), v, k_add)) \
+    OP(cmpge, simd4f_select(simd4f_cmpge(v, k_max), v, k_add)) \
+    OP(mask_and, simd4f_select(simd4f_mask_and(simd4f_cmplt(v, k_min), simd4f_cmpgt(v, k_max)), v, k_add)) \
+    OP(mask_or, simd4f_select(simd4f_mask_or(simd4f_cmplt(v, k_min), simd4f_cmpgt(v, k_max)), v, k_add)) \
+    OP(mask_xor, simd4f_select(simd4f_mask_xor(simd4f_cmplt(v, k_min), k_select), v, k_add)) \
+    OP(mask_not, simd4f_select(simd4f_mask_not(simd4f_cmpgt(v, k_min)), v, k_add)) \
+    OP(select, simd4f_select(k_select, v, k_add)) \
+    OP(movemask, nudge(v, (float)simd4f_movemask(simd4f_cmplt(v, k_div)))) \
+    OP(any, nudge(v, (float)simd4f_any(simd4f_cmplt(v, k_div)))) \
+    OP(all, nudge(v, (float)simd4f_all(simd4f_cmplt(v, k_div)))) \
+    OP(sum, simd4f_mul(simd4f_sum(v), k_dot4)) \
+    OP(dot4, simd4f_dot4(v, k_dot4)) \
+    OP(dot3, simd4f_dot3(v, k_dot3)) \
+    OP(dot2, simd4f_dot2(v, k_dot2)) \
+    OP(dot3_scalar, simd4f_splat(simd4f_dot3_scalar(v, k_dot3))) \
+    OP(cross3, simd4f_cross3(v, k_cross)) \
+    OP(length4, simd4f_mul(simd4f_length4(v), k_half)) \
+    OP(length3, simd4f_mul(simd4f_length3(v), k_len3)) \
+    OP(length2, simd4f_mul(simd4f_length2(v), k_len2)) \
+    OP(length4_squared, simd4f_sqrt(simd4f_mul(simd4f_length4_squared(v), k_dot4))) \
+    OP(length3_squared, simd4f_sqrt(simd4f_mul(simd4f_length3_squared(v), k_dot3))) \
+    OP(length2_squared, simd4f_sqrt(simd4f_mul(simd4f_length2_squared(v), k_dot2))) \
+    OP(length3_squared_scalar, simd4f_sqrt(simd4f_splat(simd4f_length3_squared_scalar(v) * (1.0f/3)))) \
+    OP(normalize4, simd4f_normalize4(v)) \
+    OP(normalize3, simd4f_normalize3(v)) \
+    OP(normalize2, simd4f_normalize2(v)) \
+    OP(sin, simd4f_sin(v)) \
+    OP(cos, simd4f_cos(v)) \
+    OP(sincos, sincos(v)) \
+    OP(tan, simd4f_tan(simd4f_mul(v, k_tan))) \
+    OP(exp_log, simd4f_exp(simd4f_log(v))) \
+    OP(exp2_log2, simd4f_exp2(simd4f_log2(v))) \
+    OP(pow, simd4f_pow(v, k_half)) \
+    OP(exp_fast_log_fast, simd4f_exp_fast(simd4f_log_fast(v))) \
+    OP(exp2_fast_log2_fast, simd4f_exp2_fast(simd4f_log2_fast(v))) \
+    OP(pow_fast, simd4f_pow_fast(v, k_half)) \
+    OP(quat_rotate3, simd4f_quat_rotate3(k_quat, v)) \
+    OP(sphere_merge, simd4f_sphere_merge(v, k_sphere)) \
+    OP(frustum_sphere_visible, nudge(v, (float)simd4f_frustum_sphere_visible(&frustum, v))) \
+    OP(frustum_aabb_visible, nudge(v, (float)simd4f_frustum_aabb_visible(&frustum, v, simd4f_add(v, k_div)))) \
+    OP(ray_triangle, ray_triangle(v)) \
+    OP(ray_aabb, ray_aabb(v)) \
+    OP(simd4x4f_matrix_vector_mul, transformed<simd4x4f_matrix_vector_mul>(v)) \
+    OP(simd4x4f_matrix_vector3_mul, transformed<simd4x4f_matrix_vector3_mul>(v)) \
+    OP(simd4x4f_matrix_point3_mul, transformed<simd4x4f_matrix_point3_mul>(v)) \
+    OP(simd4x4f_inv_ortho_matrix_point3_mul, transformed<simd4x4f_inv_ortho_matrix_point3_mul>(v)) \
+    OP(simd4x4f_inv_ortho_matrix_vector3_mul, transformed<simd4x4f_inv_ortho_matrix_vector3_mul>(v)) \
+    OP(simd4x4f_sum, matrix_sum(v)) \
+    OP(simd4x4f_translation, translation(v)) \
+    OP(simd4x4f_axis_rotation, axis_rotation(v)) \
+    OP(simd4x4f_perspective, perspective(v)) \
+    OP(simd4x4f_ortho, ortho(v)) \
+    OP(simd4x4f_lookat, lookat(v))
+
+#define LATENCY_QUAT_OPS(OP) \
+    OP(quat_mul, simd4f_quat_mul(v, k_quat)) \
+    OP(quat_conjugate, simd4f_quat_conjugate(v)) \
+    OP(quat_normalize, simd4f_quat_normalize(v)) \
+    OP(quat_nlerp, simd4f_quat_nlerp(v, k_quat, 0.5f)) \
+    OP(quat_slerp, simd4f_quat_slerp(v, k_quat, 0.5f)) \
+    OP(quat_axis_rotation, simd4f_quat_axis_rotation(simd4f_get_x(v), k_axis))
+
+#define LATENCY_MATRIX_OPS(OP) \
+    OP(simd4x4f_matrix_mul, combined<simd4x4f_matrix_mul>(m, rotation)) \
+    OP(simd4x4f_add, combined<simd4x4f_add>(m, k_add4)) \
+    OP(simd4x4f_sub, combined<simd4x4f_sub>(m, k_add4)) \
+    OP(simd4x4f_mul, combined<simd4x4f_mul>(m, k_mul4)) \
+    OP(simd4x4f_div, matrix_div(m)) \
+    OP(simd4x4f_transpose, transposed(m)) \
+    OP(simd4x4f_transpose_inplace, transposed_inplace(m)) \
+    OP(simd4x4f_inverse, inverted(m)) \
+    OP(simd4x4f_uload, uloaded(m)) \
+    OP(aos_store4_load4, aos4(m)) \
+    OP(aos_store3_load3, aos3(m))
+
+#define LATENCY_VECTOR_STEP(name, expr) \
+    struct name##_op : vector_op { static simd4f step(simd4f v) { return expr; } };
+#define LATENCY_QUAT_STEP(name, expr) \
+    struct name##_op : quat_op { static simd4f step(simd4f v) { return expr; } };
+#define LATENCY_MATRIX_STEP(name, expr) \
+    struct name##_op : matrix_op { static simd4x4f step(const simd4x4f& m) { return expr; } };
+
+    LATENCY_VECTOR_OPS(LATENCY_VECTOR_STEP)
+    LATENCY_QUAT_OPS(LATENCY_QUAT_STEP)
+    LATENCY_MATRIX_OPS(LATENCY_MATRIX_STEP)
+
+#undef LATENCY_VECTOR_STEP
+#undef LATENCY_QUAT_STEP
+#undef LATENCY_MATRIX_STEP
+
+}
+
+
+void latency_bench() {
+
+    k_add = simd4f_splat(1e-7f);
+    k_mul = simd4f_splat(0.9999999f);
+    k_div = simd4f_splat(2.0f);
+    k_half = simd4f_splat(0.5f);
+    k_tan = simd4f_splat(0.1f);
+    k_len3 = simd4f_splat(0.57735027f);
+    k_len2 = simd4f_splat(0.70710678f);
+    k_dot4 = simd4f_splat(0.25f);
+    k_dot3 = simd4f_create(1.0f/3, 1.0f/3, 1.0f/3, 0.0f);
+    k_dot2 = simd4f_create(0.5f, 0.5f, 0.0f, 0.0f);
+    k_cross = simd4f_create(0.0f, 0.0f, 1.0f, 0.0f);
+    k_min = simd4f_splat(100.0f);
+    k_max = simd4f_splat(-100.0f);
+    k_axis = simd4f_create(0.0f, 0.6f, 0.8f, 0.0f);
+    k_quat = simd4f_quat_axis_rotation(0.01f, k_axis);
+    k_sphere = simd4f_create(1.0f, 2.0f, 3.0f, 1.0f);
+    k_far = simd4f_splat(100.0f);
+    k_select = simd4f_cmpgt( simd4f_create(1.0f, 0.0f, 1.0f, 0.0f), simd4f_zero() );
+
+    simd4x4f_axis_rotation(&rotation, 0.01f, k_axis);
+    k_add4 = simd4x4f_create(k_add, k_add, k_add, k_add);
+    k_mul4 = simd4x4f_create(k_mul, k_mul, k_mul, k_mul);
+    k_div4 = simd4x4f_create(k_div, k_div, k_div, k_div);
+
+    simd4x4f projection, view, clip;
+    simd4x4f_perspective(&projection, 1.0f, 1.0f, 0.5f, 1000.0f);
+    simd4x4f_lookat(&view, simd4f_create(0.0f, 0.0f, -10.0f, 0.0f), simd4f_zero(), simd4f_create(0.0f, 1.0f, 0.0f, 0.0f));
+    simd4x4f_matrix_mul(&projection, &view, &clip);
+    simd4f_frustum_from_simd4x4f(&clip, &frustum);
+
+    // Four rays along z through a triangle and box around z 5
+    const float origins[12] = { 0.0f, 0.0f, 0.0f,  1.0f, 0.0f, 0.0f,  0.0f, 1.0f, 0.0f,  1.0f, 1.0f, 0.0f };
+    const float directions[12] = { 0.0f, 0.0f, 1.0f,  0.0f, 0.0f, 1.0f,  0.0f, 0.0f, 1.0f,  0.0f, 0.0f, 1.0f };
+    simd4f_ray_packet_load(origins, directions, 3, &rays);
+    triangle[0] = simd4f_create(-20.0f, -20.0f, 5.0f, 0.0f);
+    triangle[1] = simd4f_create(40.0f, -20.0f, 5.0f, 0.0f);
+    triangle[2] = simd4f_create(-20.0f, 40.0f, 5.0f, 0.0f);
+
+#define LATENCY_MEASURE(name, expr) measure<name##_op>(#name);
+    LATENCY_VECTOR_OPS(LATENCY_MEASURE)
+    LATENCY_QUAT_OPS(LATENCY_MEASURE)
+    LATENCY_MATRIX_OPS(LATENCY_MEASURE)
+#undef LATENCY_MEASURE
+
+    std::cout << "Last " << simd4f_get_x(sink) << std::endl;
+
+}
@@ -0,0 +1,83 @@
+#include "bench.h"
+#include <stdlib.h>
+
+#include <iostream>
+#include "vectorial/simd4x4f.h"
+
+#define NUM (81920)
+#define ITER 100
+//using namespace vectorial;
+
+namespace {
+    simd4f* alloc_simd4f(size_t n) {
+        void *ptr = memalign(n*sizeof(simd4f), 16);
+        return static_cast<simd4f*>(ptr);
+    }    
+}
+
+
+
+static simd4x4f m;
+static simd4f * a;
+static simd4f * b;
+
+
+
+void madd_separate_func() {
+    
+    const simd4x4f mm = m;
+    simd4f* vectorial_restrict aa = a;
+    simd4f* vectorial_restrict bb = b;
+    
+    for(size_t i = 0; i < NUM; ++i)
+    {
+        const simd4f v = aa[i];
+        bb[i] = simd4f_add(simd4f_mul(mm.x, simd4f_splat_x(v)), 
+                  simd4f_add(simd4f_mul(mm.y, simd4f_splat_y(v)), 
+                    simd4f_add(simd4f_mul(mm.z, simd4f_splat_z(v)), 
+                      simd4f_mul(mm.w, simd4f_splat_w(v)) ) ) );
+    }    
+}
+
+void madd_fused_func() {
+    
+    const simd4x4f mm = m;
+    simd4f* vectorial_restrict aa = a;
+    simd4f* vectorial_restrict bb = b;
+    
+    for(size_t i = 0; i < NUM; ++i)
+    {
+        const simd4f v = aa[i];
+        bb[i] = simd4f_madd(mm.x, simd4f_splat_x(v), 
+                  simd4f_madd(mm.y, simd4f_splat_y(v), 
+                    simd4f_madd(mm.z, simd4f_splat_z(v), 
+                      simd4f_mul(mm.w, simd4f_splat_w(v)) ) ) );
+    }    
+}
+
+void madd_bench() {
+
+    a = alloc_simd4f(NUM);
+    b = alloc_simd4f(NUM);
+
+    simd4x4f_axis_rotation(&m, 0.5f, simd4f_create(1,2,3,0));
+    m.w = simd4f_create(1,2,3,1);
+
+    for(size_t i = 0; i < NUM; ++i)
+    {
+        a[i] = simd4f_create(i, NUM-i, i, 1);
+    }
+    
+    #ifdef VECTORIAL_HAVE_FMA
+    std::cout << "Fused multiply-add available" << std::endl;
+    #else
+    std::cout << "No fused multiply-add, simd4f_madd is mul+add" << std::endl;
+    #endif
+    profile("matrix vector mul, separate mul+add", madd_separate_func, ITER, NUM);
+    profile("matrix vector mul, madd chain", madd_fused_func, ITER, NUM);
+
+    memfree(a);
+    memfree(b);
+
+
+}
@@ -0,0 +1,84 @@
+#include "bench.h"
+#include <stdlib.h>
+
+#include <iostream>
+#include "vectorial/mat3f.h"
+
+#define NUM (16384)
+#define ITER 100
+using namespace vectorial;
+
+namespace {
+    template<typename T>
+    T* alloc(size_t n) {
+        void *ptr = memalign(n*sizeof(T), 16);
+        return static_cast<T*>(ptr);
+    }
+}
+
+
+// Model matrices of NUM objects and their normal matrices
+static mat4f* model;
+static mat4f* normal4;
+static mat3f* normal3;
+static mat3f* ma;
+static mat3f* mb;
+
+
+void normal_matrix_4x4_func() {
+    for(size_t i = 0; i < NUM; ++i)
+    {
+        normal4[i] = transpose(inverse(model[i]));
+    }
+}
+
+void normal_matrix_3x3_func() {
+    for(size_t i = 0; i < NUM; ++i)
+    {
+        normal3[i] = normalMatrix(model[i]);
+    }
+}
+
+void mat3_inverse_func() {
+    for(size_t i = 0; i < NUM; ++i)
+    {
+        normal3[i] = inverse(ma[i]);
+    }
+}
+
+void mat3_mul_func() {
+    for(size_t i = 0; i < NUM; ++i)
+    {
+        normal3[i] = ma[i] * mb[i];
+    }
+}
+
+
+void mat3_bench() {
+
+    model = alloc<mat4f>(NUM);
+    normal4 = alloc<mat4f>(NUM);
+    normal3 = alloc<mat3f>(NUM);
+    ma = alloc<mat3f>(NUM);
+    mb = alloc<mat3f>(NUM);
+
+    for(size_t i = 0; i < NUM; ++i)
+    {
+        model[i] = mat4f::translation(vec3f(i, 1, -2)) * mat4f::axisRotation(0.001f * i, vec3f(1, (float)(i % 7), 2))
+                 * mat4f::scale(vec3f(1, 2, 1 + 0.001f * i));
+        ma[i] = mat3f(model[i]);
+        mb[i] = mat3f::axisRotation(2.0f - 0.0001f * i, vec3f((float)(i % 5), 1, -1));
+    }
+
+    profile("mat4f inverse transpose normal matrix", normal_matrix_4x4_func, ITER, NUM);
+    profile("mat3f normalMatrix", normal_matrix_3x3_func, ITER, NUM);
+    profile("mat3f inverse", mat3_inverse_func, ITER, NUM);
+    profile("mat3f multiply", mat3_mul_func, ITER, NUM);
+
+    memfree(model);
+    memfree(normal4);
+    memfree(normal3);
+    memfree(ma);
+    memfree(mb);
+
+}
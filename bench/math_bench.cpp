@@ -0,0 +1,144 @@
+#include "bench.h"
+#include <stdlib.h>
+#include <math.h>
+
+#include <iostream>
+#include "vectorial/simd4f_math.h"
+
+#define NUM (81920)
+#define ITER 100
+
+namespace {
+    simd4f* alloc_simd4f(size_t n) {
+        void *ptr = memalign(n*sizeof(simd4f), 16);
+        return static_cast<simd4f*>(ptr);
+    }
+}
+
+
+static simd4f* a;
+static simd4f* b;
+static simd4f* c;
+static simd4f* e;   // exponents in [-20, 20)
+static simd4f* l;   // colors in (0, 1]
+
+
+void math_sinf_func() {
+    const float* vectorial_restrict aa = (const float*)a;
+    float* vectorial_restrict bb = (float*)b;
+    for(size_t i = 0; i < 4*NUM; ++i)
+    {
+        bb[i] = sinf(aa[i]);
+    }
+}
+
+void math_sin_func() {
+    for(size_t i = 0; i < NUM; ++i)
+    {
+        b[i] = simd4f_sin(a[i]);
+    }
+}
+
+void math_cos_func() {
+    for(size_t i = 0; i < NUM; ++i)
+    {
+        b[i] = simd4f_cos(a[i]);
+    }
+}
+
+void math_sincos_func() {
+    for(size_t i = 0; i < NUM; ++i)
+    {
+        simd4f_sincos(a[i], &b[i], &c[i]);
+    }
+}
+
+void math_tan_func() {
+    for(size_t i = 0; i < NUM; ++i)
+    {
+        b[i] = simd4f_tan(a[i]);
+    }
+}
+
+void math_expf_func() {
+    const float* vectorial_restrict ee = (const float*)e;
+    float* vectorial_restrict bb = (float*)b;
+    for(size_t i = 0; i < 4*NUM; ++i)
+    {
+        bb[i] = expf(ee[i]);
+    }
+}
+
+void math_powf_func() {
+    const float* vectorial_restrict ll = (const float*)l;
+    float* vectorial_restrict bb = (float*)b;
+    for(size_t i = 0; i < 4*NUM; ++i)
+    {
+        bb[i] = powf(ll[i], 2.2f);
+    }
+}
+
+#define MATH_BENCH_FUNC(name, expr, input) \
+    void math_##name##_func() { \
+        for(size_t i = 0; i < NUM; ++i) \
+        { \
+            const simd4f x = input[i]; \
+            b[i] = expr; \
+        } \
+    }
+
+MATH_BENCH_FUNC(exp, simd4f_exp(x), e)
+MATH_BENCH_FUNC(exp_fast, simd4f_exp_fast(x), e)
+MATH_BENCH_FUNC(exp2, simd4f_exp2(x), e)
+MATH_BENCH_FUNC(exp2_fast, simd4f_exp2_fast(x), e)
+MATH_BENCH_FUNC(log, simd4f_log(x), l)
+MATH_BENCH_FUNC(log_fast, simd4f_log_fast(x), l)
+MATH_BENCH_FUNC(log2, simd4f_log2(x), l)
+MATH_BENCH_FUNC(log2_fast, simd4f_log2_fast(x), l)
+MATH_BENCH_FUNC(pow, simd4f_pow(x, simd4f_splat(2.2f)), l)
+MATH_BENCH_FUNC(pow_fast, simd4f_pow_fast(x, simd4f_splat(2.2f)), l)
+
+void math_bench() {
+
+    a = alloc_simd4f(NUM);
+    b = alloc_simd4f(NUM);
+    c = alloc_simd4f(NUM);
+    e = alloc_simd4f(NUM);
+    l = alloc_simd4f(NUM);
+
+    for(size_t i = 0; i < NUM; ++i)
+    {
+        const float f = (float(i) - NUM/2) * 0.01f;
+        a[i] = simd4f_create(f, f + 0.25f, f + 0.5f, f + 0.75f);
+        const float g = (float(i) - NUM/2) * (40.0f / NUM);
+        e[i] = simd4f_create(g, g + 0.001f, g + 0.002f, g + 0.003f);
+        const float h = (i + 1.0f) / NUM;
+        l[i] = simd4f_create(h, h * 0.5f, h * 0.25f, h * 0.125f);
+    }
+
+    profile("sinf, per float", math_sinf_func, ITER, 4*NUM);
+    profile("simd4f_sin, per float", math_sin_func, ITER, 4*NUM);
+    profile("simd4f_cos, per float", math_cos_func, ITER, 4*NUM);
+    profile("simd4f_sincos, per float", math_sincos_func, ITER, 4*NUM);
+    profile("simd4f_tan, per float", math_tan_func, ITER, 4*NUM);
+
+    profile("expf, per float", math_expf_func, ITER, 4*NUM);
+    profile("simd4f_exp, per float", math_exp_func, ITER, 4*NUM);
+    profile("simd4f_exp_fast, per float", math_exp_fast_func, ITER, 4*NUM);
+    profile("simd4f_exp2, per float", math_exp2_func, ITER, 4*NUM);
+    profile("simd4f_exp2_fast, per float", math_exp2_fast_func, ITER, 4*NUM);
+    profile("simd4f_log, per float", math_log_func, ITER, 4*NUM);
+    profile("simd4f_log_fast, per float", math_log_fast_func, ITER, 4*NUM);
+    profile("simd4f_log2, per float", math_log2_func, ITER, 4*NUM);
+    profile("simd4f_log2_fast, per float", math_log2_fast_func, ITER, 4*NUM);
+    profile("powf gamma 2.2, per float", math_powf_func, ITER, 4*NUM);
+    profile("simd4f_pow gamma 2.2, per float", math_pow_func, ITER, 4*NUM);
+    profile("simd4f_pow_fast gamma 2.2, per float", math_pow_fast_func, ITER, 4*NUM);
+
+    memfree(a);
+    memfree(b);
+    memfree(c);
+    memfree(e);
+    memfree(l);
+
+}
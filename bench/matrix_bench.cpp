@@ -4,6 +4,7 @@
 
 #include <iostream>
 #include "vectorial/simd4x4f.h"
+#include "vectorial/simd4x4f_array.h"
 
 #define NUM (819200)
 #define ITER 100
@@ -37,6 +38,47 @@ void matrix_func() {
     }    
 }
 
+void matrix_array_func() {
+    simd4x4f_matrix_mul_array(a, b, c, NUM);
+}
+
+void matrix_array_stream_func() {
+    simd4x4f_matrix_mul_array_stream(a, b, c, NUM);
+}
+
+void matrix_one_by_array_func() {
+    simd4x4f_matrix_mul_one_by_array(a, b, c, NUM);
+}
+
+void matrix_one_by_array_stream_func() {
+    simd4x4f_matrix_mul_one_by_array_stream(a, b, c, NUM);
+}
+
+void matrix_array_by_one_func() {
+    simd4x4f_matrix_mul_array_by_one(a, b, c, NUM);
+}
+
+void matrix_array_by_one_stream_func() {
+    simd4x4f_matrix_mul_array_by_one_stream(a, b, c, NUM);
+}
+
+void matrix_inverse_func() {
+    for(size_t i = 0; i < NUM; ++i)
+    {
+        simd4x4f_inverse(&a[i], &c[i]);
+    }
+}
+
+void matrix_inverse_array_func() {
+    simd4x4f_inverse_array(a, c, NUM);
+}
+
+static float * det;
+
+void matrix_inverse_array_det_func() {
+    simd4x4f_inverse_array_det(a, c, det, NUM);
+}
+
 void matrix_bench() {
 
     a = alloc_vec4x4f(NUM);
@@ -54,6 +96,28 @@ void matrix_bench() {
         
     profile("matrix mul", matrix_func, ITER, NUM);
 
+    std::cout << "Dispatch: " << vectorial_isa_name(vectorial_dispatch_isa()) << std::endl;
+    profile("matrix mul array, pairwise", matrix_array_func, ITER, NUM);
+    profile("matrix mul array, pairwise, stream", matrix_array_stream_func, ITER, NUM);
+    profile("matrix mul array, one by many", matrix_one_by_array_func, ITER, NUM);
+    profile("matrix mul array, one by many, stream", matrix_one_by_array_stream_func, ITER, NUM);
+    profile("matrix mul array, many by one", matrix_array_by_one_func, ITER, NUM);
+    profile("matrix mul array, many by one, stream", matrix_array_by_one_stream_func, ITER, NUM);
+
+    // Invertible ones for the inverses
+    for(size_t i = 0; i < NUM; ++i)
+    {
+        const float f = 1.0f / (1 + i);
+        a[i]=simd4x4f_create( simd4f_create(4, f, 0, 1), simd4f_create(f, 3, 1, 0),
+                              simd4f_create(0, 1, 5, f), simd4f_create(1, 0, f, 2) );
+    }
+    det = static_cast<float*>(memalign(NUM*sizeof(float), 16));
+
+    profile("matrix inverse", matrix_inverse_func, ITER, NUM);
+    profile("matrix inverse array", matrix_inverse_array_func, ITER, NUM);
+    profile("matrix inverse array, determinants", matrix_inverse_array_det_func, ITER, NUM);
+
+    memfree(det);
     memfree(a);
     memfree(b);
     memfree(c);
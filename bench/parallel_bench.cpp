@@ -0,0 +1,70 @@
+#include "bench.h"
+#include <stdlib.h>
+
+#include <iostream>
+#include <sstream>
+#include "vectorial/parallel.h"
+
+// 64MB of points in and out, well past the caches
+#define NUM (4*1024*1024)
+#define ITER 10
+
+using vectorial::thread_pool;
+
+static thread_pool* pool;
+static simd4x4f* ma;
+static simd4x4f* mb;
+static simd4x4f* mo;
+static simd4f* a;
+static simd4f* b;
+
+
+void parallel_point3_mul_func() {
+    vectorial::parallel_matrix_point3_mul_array(*pool, &ma[0], a, b, NUM);
+}
+
+void parallel_matrix_mul_func() {
+    vectorial::parallel_matrix_mul_array(*pool, ma, mb, mo, NUM/16);
+}
+
+void parallel_bench() {
+
+    a = static_cast<simd4f*>(memalign(NUM*sizeof(simd4f), 64));
+    b = static_cast<simd4f*>(memalign(NUM*sizeof(simd4f), 64));
+    ma = static_cast<simd4x4f*>(memalign(NUM/16*sizeof(simd4x4f), 64));
+    mb = static_cast<simd4x4f*>(memalign(NUM/16*sizeof(simd4x4f), 64));
+    mo = static_cast<simd4x4f*>(memalign(NUM/16*sizeof(simd4x4f), 64));
+
+    for(size_t i = 0; i < NUM; ++i)
+    {
+        a[i] = simd4f_create(i, NUM-i, i, 1);
+        b[i] = simd4f_zero();
+    }
+    for(size_t i = 0; i < NUM/16; ++i)
+    {
+        simd4x4f_axis_rotation(&ma[i], 0.5f, simd4f_create(1,2,i,0));
+        simd4x4f_axis_rotation(&mb[i], 0.25f, simd4f_create(i,2,3,0));
+        mo[i] = ma[i];
+    }
+
+    const size_t max_threads = thread_pool().size();
+    // Doubling up to, and ending at, one per hardware thread
+    for(size_t threads = 1; threads <= max_threads; threads = threads < max_threads && threads * 2 > max_threads ? max_threads : threads * 2)
+    {
+        thread_pool p(threads);
+        pool = &p;
+        std::stringstream ss;
+        ss << threads << " thread" << (threads > 1 ? "s" : "");
+        std::cout << "Threads: " << ss.str() << std::endl;
+        profile(("parallel simd4x4f_matrix_point3_mul_array, " + ss.str()).c_str(), parallel_point3_mul_func, ITER, NUM);
+        profile(("parallel simd4x4f_matrix_mul_array, " + ss.str()).c_str(), parallel_matrix_mul_func, ITER, NUM/16);
+    }
+    pool = 0;
+
+    memfree(a);
+    memfree(b);
+    memfree(ma);
+    memfree(mb);
+    memfree(mo);
+
+}
@@ -0,0 +1,137 @@
+#include "bench.h"
+#include <stdlib.h>
+
+#include <iostream>
+#include "vectorial/quatf.h"
+
+#define NUM (16384)
+#define ITER 100
+using namespace vectorial;
+
+namespace {
+    template<typename T>
+    T* alloc(size_t n) {
+        void *ptr = memalign(n*sizeof(T), 16);
+        return static_cast<T*>(ptr);
+    }
+}
+
+
+// Two poses of NUM joints as quaternions and as the equivalent matrices
+static quatf* qa;
+static quatf* qb;
+static quatf* qout;
+static mat4f* ma;
+static mat4f* mb;
+static mat4f* mout;
+static vec3f* v;
+static vec3f* vout;
+
+
+void quat_compose_func() {
+    for(size_t i = 0; i < NUM; ++i)
+    {
+        qout[i] = qa[i] * qb[i];
+    }
+}
+
+void mat4_compose_func() {
+    for(size_t i = 0; i < NUM; ++i)
+    {
+        mout[i] = ma[i] * mb[i];
+    }
+}
+
+void quat_rotate_func() {
+    for(size_t i = 0; i < NUM; ++i)
+    {
+        vout[i] = qa[i] * v[i];
+    }
+}
+
+void mat4_rotate_func() {
+    for(size_t i = 0; i < NUM; ++i)
+    {
+        vout[i] = transformVector(ma[i], v[i]);
+    }
+}
+
+void quat_nlerp_element_func() {
+    for(size_t i = 0; i < NUM; ++i)
+    {
+        qout[i] = nlerp(qa[i], qb[i], 0.3f);
+    }
+}
+
+void quat_nlerp_array_func() {
+    nlerp(qa, qb, 0.3f, qout, NUM);
+}
+
+void quat_slerp_element_func() {
+    for(size_t i = 0; i < NUM; ++i)
+    {
+        qout[i] = slerp(qa[i], qb[i], 0.3f);
+    }
+}
+
+void quat_slerp_array_func() {
+    slerp(qa, qb, 0.3f, qout, NUM);
+}
+
+// What blending two matrix poses costs: lerp the matrices, which
+// doesn't even stay a rotation
+void mat4_lerp_func() {
+    const simd4f t = simd4f_splat(0.3f);
+    for(size_t i = 0; i < NUM; ++i)
+    {
+        const simd4x4f& a = ma[i].value;
+        const simd4x4f& b = mb[i].value;
+        simd4x4f& o = mout[i].value;
+        o.x = simd4f_madd( simd4f_sub(b.x, a.x), t, a.x );
+        o.y = simd4f_madd( simd4f_sub(b.y, a.y), t, a.y );
+        o.z = simd4f_madd( simd4f_sub(b.z, a.z), t, a.z );
+        o.w = simd4f_madd( simd4f_sub(b.w, a.w), t, a.w );
+    }
+}
+
+
+void quat_bench() {
+
+    qa = alloc<quatf>(NUM);
+    qb = alloc<quatf>(NUM);
+    qout = alloc<quatf>(NUM);
+    ma = alloc<mat4f>(NUM);
+    mb = alloc<mat4f>(NUM);
+    mout = alloc<mat4f>(NUM);
+    v = alloc<vec3f>(NUM);
+    vout = alloc<vec3f>(NUM);
+
+    for(size_t i = 0; i < NUM; ++i)
+    {
+        qa[i] = quatf::axisRotation(0.001f * i, vec3f(1, (float)(i % 7), 2));
+        qb[i] = quatf::axisRotation(2.0f - 0.0001f * i, vec3f((float)(i % 5), 1, -1));
+        ma[i] = toMat4f(qa[i]);
+        mb[i] = toMat4f(qb[i]);
+        v[i] = vec3f(i, NUM-i, 1);
+    }
+
+    profile("quatf compose", quat_compose_func, ITER, NUM);
+    profile("mat4f compose", mat4_compose_func, ITER, NUM);
+    profile("quatf rotate vec3f", quat_rotate_func, ITER, NUM);
+    profile("mat4f transformVector vec3f", mat4_rotate_func, ITER, NUM);
+    profile("quatf nlerp per element", quat_nlerp_element_func, ITER, NUM);
+    profile("quatf nlerp array", quat_nlerp_array_func, ITER, NUM);
+    profile("quatf slerp per element", quat_slerp_element_func, ITER, NUM);
+    profile("quatf slerp array", quat_slerp_array_func, ITER, NUM);
+    profile("mat4f lerp per element", mat4_lerp_func, ITER, NUM);
+
+    memfree(qa);
+    memfree(qb);
+    memfree(qout);
+    memfree(ma);
+    memfree(mb);
+    memfree(mout);
+    memfree(v);
+    memfree(vout);
+
+}
@@ -0,0 +1,182 @@
+#include "bench.h"
+#include <stdlib.h>
+#include <float.h>
+
+#include <iostream>
+#include "vectorial/ray_soa.h"
+
+#define RAYS (16384)
+#define TRIS (64)
+#define ITER 10
+using namespace vectorial;
+
+namespace {
+    template<typename T>
+    T* alloc(size_t n) {
+        void *ptr = memalign(n*sizeof(T), 16);
+        return static_cast<T*>(ptr);
+    }
+}
+
+
+// RAYS camera rays against a soup of TRIS triangles and boxes around them,
+// counted per ray-primitive test
+static vec3f* origins;
+static vec3f* directions;
+static vec3f* vertices;
+static vec3f* box_min;
+static vec3f* box_max;
+static float* dist;
+static int32_t* hit_index;
+static size_t hits;
+
+
+// One ray and one triangle at a time with vec3f cross and dot
+void ray_triangle_vec3f_func() {
+    size_t count = 0;
+    for(size_t i = 0; i < RAYS; ++i)
+    {
+        const vec3f o = origins[i];
+        const vec3f d = directions[i];
+        float t = FLT_MAX;
+        int32_t closest = -1;
+        for(int k = 0; k < TRIS; ++k)
+        {
+            const vec3f v0 = vertices[3*k];
+            const vec3f e1 = vertices[3*k+1] - v0;
+            const vec3f e2 = vertices[3*k+2] - v0;
+            const vec3f p = cross(d, e2);
+            const float det = dot(e1, p);
+            if( det == 0.0f ) continue;
+            const float invdet = 1.0f / det;
+            const vec3f s = o - v0;
+            const float u = dot(s, p) * invdet;
+            if( u < 0.0f || u > 1.0f ) continue;
+            const vec3f q = cross(s, e1);
+            const float v = dot(d, q) * invdet;
+            if( v < 0.0f || u + v > 1.0f ) continue;
+            const float tt = dot(e2, q) * invdet;
+            if( tt > 0.0f && tt < t ) { t = tt; closest = k; }
+        }
+        dist[i] = t;
+        hit_index[i] = closest;
+        if( closest >= 0 ) ++count;
+    }
+    hits = count;
+}
+
+void ray_triangle_soa4_func() {
+    for(size_t i = 0; i < RAYS; i += 4)
+    {
+        ray_soa4 r;
+        r.load(origins + i, directions + i);
+        simd4f t = simd4f_splat(FLT_MAX);
+        intersectTriangles(r, vertices, TRIS, t, hit_index + i);
+        simd4f_ustore4(t, dist + i);
+    }
+}
+
+void ray_triangle_soa8_func() {
+    for(size_t i = 0; i < RAYS; i += 8)
+    {
+        ray_soa8 r;
+        r.load(origins + i, directions + i);
+        simd8f t = simd8f_splat(FLT_MAX);
+        intersectTriangles(r, vertices, TRIS, t, hit_index + i);
+        simd8f_ustore8(t, dist + i);
+    }
+}
+
+// Slab test one ray and one box at a time, with the reciprocal precomputed like the packets have it
+void ray_box_vec3f_func() {
+    size_t count = 0;
+    for(size_t i = 0; i < RAYS; ++i)
+    {
+        const vec3f o = origins[i];
+        const vec3f rd = vec3f(1.0f) / directions[i];
+        for(int k = 0; k < TRIS; ++k)
+        {
+            const vec3f t0 = (box_min[k] - o) * rd;
+            const vec3f t1 = (box_max[k] - o) * rd;
+            const vec3f lo = min(t0, t1);
+            const vec3f hi = max(t0, t1);
+            const float enter = fmaxf( fmaxf(lo.x(), lo.y()), fmaxf(lo.z(), 0.0f) );
+            const float leave = fminf( fminf(hi.x(), hi.y()), fminf(hi.z(), FLT_MAX) );
+            if( enter <= leave ) ++count;
+        }
+    }
+    hits = count;
+}
+
+void ray_box_soa4_func() {
+    int count = 0;
+    for(size_t i = 0; i < RAYS; i += 4)
+    {
+        ray_soa4 r;
+        r.load(origins + i, directions + i);
+        simd4f tnear = simd4f_zero();
+        for(int k = 0; k < TRIS; ++k)
+        {
+            count += simd4f_movemask( intersectBox(r, box_min[k], box_max[k], simd4f_splat(FLT_MAX), tnear) );
+        }
+    }
+    hits = count;
+}
+
+void ray_box_soa8_func() {
+    int count = 0;
+    for(size_t i = 0; i < RAYS; i += 8)
+    {
+        ray_soa8 r;
+        r.load(origins + i, directions + i);
+        simd8f tnear = simd8f_zero();
+        for(int k = 0; k < TRIS; ++k)
+        {
+            count += simd8f_movemask( intersectBox(r, box_min[k], box_max[k], simd8f_splat(FLT_MAX), tnear) );
+        }
+    }
+    hits = count;
+}
+
+
+void ray_bench() {
+
+    origins = alloc<vec3f>(RAYS);
+    directions = alloc<vec3f>(RAYS);
+    vertices = alloc<vec3f>(3 * TRIS);
+    box_min = alloc<vec3f>(TRIS);
+    box_max = alloc<vec3f>(TRIS);
+    dist = alloc<float>(RAYS);
+    hit_index = alloc<int32_t>(RAYS);
+
+    srand(1);
+    for(size_t i = 0; i < RAYS; ++i)
+    {
+        origins[i] = vec3f(0, 0, 0);
+        directions[i] = vec3f( (rand() % 1000 - 500) * 0.002f, (rand() % 1000 - 500) * 0.002f, -1.0f );
+    }
+    for(int k = 0; k < TRIS; ++k)
+    {
+        const vec3f c( rand() % 100 - 50.0f, rand() % 100 - 50.0f, -60.0f - rand() % 40 );
+        for(int j = 0; j < 3; ++j) vertices[3*k+j] = c + vec3f( rand() % 20 - 10.0f, rand() % 20 - 10.0f, rand() % 20 - 10.0f );
+        box_min[k] = min( vertices[3*k], min( vertices[3*k+1], vertices[3*k+2] ) );
+        box_max[k] = max( vertices[3*k], max( vertices[3*k+1], vertices[3*k+2] ) );
+    }
+
+    profile("ray triangle, vec3f one at a time", ray_triangle_vec3f_func, ITER, RAYS * TRIS);
+    std::cout << "Hits " << hits << " of " << RAYS << std::endl;
+    profile("ray triangle, 4 ray packets", ray_triangle_soa4_func, ITER, RAYS * TRIS);
+    profile("ray triangle, 8 ray packets", ray_triangle_soa8_func, ITER, RAYS * TRIS);
+    profile("ray box, vec3f one at a time", ray_box_vec3f_func, ITER, RAYS * TRIS);
+    profile("ray box, 4 ray packets", ray_box_soa4_func, ITER, RAYS * TRIS);
+    profile("ray box, 8 ray packets", ray_box_soa8_func, ITER, RAYS * TRIS);
+
+    memfree(origins);
+    memfree(directions);
+    memfree(vertices);
+    memfree(box_min);
+    memfree(box_max);
+    memfree(dist);
+    memfree(hit_index);
+
+}
@@ -0,0 +1,121 @@
+#include "bench.h"
+#include <stdlib.h>
+
+#include <iostream>
+#include "vectorial/vec3f.h"
+#include "vectorial/vec3f_soa4.h"
+#include "vectorial/vec3f_soa8.h"
+
+#define NUM (81920)
+#define ITER 100
+using namespace vectorial;
+
+namespace {
+    vec3f* alloc_vec3f(size_t n) {
+        void *ptr = memalign(n*sizeof(vec3f), 16);
+        return static_cast<vec3f*>(ptr);
+    }
+    float* alloc_float(size_t n) {
+        void *ptr = memalign(n*sizeof(float), 32);
+        return static_cast<float*>(ptr);
+    }
+}
+
+
+
+static vec3f * a;
+static vec3f * b;
+static float * ax, * ay, * az;
+static float * bx, * by, * bz;
+
+
+
+// Normalize every point and take its dot with a light direction, the
+// normalized point written back over the input
+static const vec3f light(0.267261f, 0.534522f, 0.801784f);
+static float * c;
+
+
+void soa_aos_func() {
+
+    vec3f* vectorial_restrict aa = a;
+    float* vectorial_restrict cc = c;
+    const vec3f l = light;
+
+    for(size_t i = 0; i < NUM; ++i)
+    {
+        const vec3f n = normalize(aa[i]);
+        cc[i] = dot(n, l);
+        aa[i] = n;
+    }
+}
+
+void soa_soa4_func() {
+
+    const vec3f_soa4 l(light);
+
+    for(size_t i = 0; i < NUM; i += 4)
+    {
+        vec3f_soa4 p;
+        p.load(ax + i, ay + i, az + i);
+        const vec3f_soa4 n = normalize(p);
+        simd4f_ustore4(dot(n, l), c + i);
+        n.store(ax + i, ay + i, az + i);
+    }
+}
+
+// Same on the vec3f array, transposing to packets and back
+void soa_aos_soa4_func() {
+
+    const vec3f_soa4 l(light);
+
+    for(size_t i = 0; i < NUM; i += 4)
+    {
+        vec3f_soa4 p;
+        p.load(a + i);
+        const vec3f_soa4 n = normalize(p);
+        simd4f_ustore4(dot(n, l), c + i);
+        n.store(a + i);
+    }
+}
+
+void soa_soa8_func() {
+
+    const vec3f_soa8 l(light);
+
+    for(size_t i = 0; i < NUM; i += 8)
+    {
+        vec3f_soa8 p;
+        p.load(bx + i, by + i, bz + i);
+        const vec3f_soa8 n = normalize(p);
+        simd8f_ustore8(dot(n, l), c + i);
+        n.store(bx + i, by + i, bz + i);
+    }
+}
+
+void soa_bench() {
+
+    a = alloc_vec3f(NUM);
+    ax = alloc_float(NUM); ay = alloc_float(NUM); az = alloc_float(NUM);
+    bx = alloc_float(NUM); by = alloc_float(NUM); bz = alloc_float(NUM);
+    c = alloc_float(NUM);
+
+    for(size_t i = 0; i < NUM; ++i)
+    {
+        a[i] = vec3f(i, NUM-i, 1);
+        ax[i] = bx[i] = i;
+        ay[i] = by[i] = NUM-i;
+        az[i] = bz[i] = 1;
+    }
+
+    profile("normalize and dot, vec3f", soa_aos_func, ITER, NUM);
+    profile("normalize and dot, vec3f_soa4", soa_soa4_func, ITER, NUM);
+    profile("normalize and dot, vec3f array through vec3f_soa4", soa_aos_soa4_func, ITER, NUM);
+    profile("normalize and dot, vec3f_soa8", soa_soa8_func, ITER, NUM);
+
+    memfree(a);
+    memfree(ax); memfree(ay); memfree(az);
+    memfree(bx); memfree(by); memfree(bz);
+    memfree(c);
+
+}
@@ -0,0 +1,145 @@
+#include "bench.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+
+#include <iostream>
+#include "vectorial/simd4x4f.h"
+#include "vectorial/simd4x4f_array.h"
+#include "vectorial/simd4f_bounds.h"
+
+// The array kernels over working sets doubling from L1 sized to well past
+// the last level cache. The working set is everything a pass reads and
+// writes, so per item bytes over time gives the bandwidth the kernel gets
+// at that size: flat while compute bound, dropping off at each cache level
+// once bandwidth bound.
+//
+// Small sets repeat the pass to keep every call around PASS_BYTES of
+// traffic, one pass over the set being too short to time.
+
+#define MIN_BYTES (4 << 10)
+#define MAX_BYTES (256 << 20)
+#define PASS_BYTES (64 << 20)
+#define ITER 10
+
+namespace {
+
+    // MAX_BYTES each, enough for any kernel's inputs and outputs alone
+    simd4x4f* a;
+    simd4x4f* b;
+    simd4x4f* c;
+
+    size_t n;
+    int reps;
+
+    simd4f aabb_min, aabb_max;
+
+
+    void matrix_mul_array_func() {
+        for(int r = 0; r < reps; ++r) simd4x4f_matrix_mul_array(a, b, c, n);
+    }
+
+    void matrix_mul_array_stream_func() {
+        for(int r = 0; r < reps; ++r) simd4x4f_matrix_mul_array_stream(a, b, c, n);
+    }
+
+    void matrix_point3_mul_array_func() {
+        for(int r = 0; r < reps; ++r) simd4x4f_matrix_point3_mul_array(a, &b->x, &c->x, n);
+    }
+
+    void inverse_array_func() {
+        for(int r = 0; r < reps; ++r) simd4x4f_inverse_array(a, c, n);
+    }
+
+    void aabb_array_func() {
+        for(int r = 0; r < reps; ++r) simd4f_aabb_array(&a->x, n, &aabb_min, &aabb_max);
+    }
+
+
+    std::string formatBytes(size_t bytes) {
+        char s[32];
+        if( bytes >= (1 << 20) ) sprintf(s, "%uMB", unsigned(bytes >> 20));
+        else sprintf(s, "%uKB", unsigned(bytes >> 10));
+        return s;
+    }
+
+    std::string label(const char* name, size_t bytes) {
+        return std::string("sweep ") + name + " " + formatBytes(bytes);
+    }
+
+    struct kernel {
+        const char* name;
+        void (*func)();
+        int bytes_per_element;
+    };
+
+    const kernel kernels[] = {
+        { "simd4x4f_matrix_mul_array", matrix_mul_array_func, 3 * sizeof(simd4x4f) },
+        { "simd4x4f_matrix_mul_array_stream", matrix_mul_array_stream_func, 3 * sizeof(simd4x4f) },
+        { "simd4x4f_matrix_point3_mul_array", matrix_point3_mul_array_func, 2 * sizeof(simd4f) },
+        { "simd4x4f_inverse_array", inverse_array_func, 2 * sizeof(simd4x4f) },
+        { "simd4f_aabb_array", aabb_array_func, sizeof(simd4f) },
+    };
+
+    const size_t kernel_count = sizeof(kernels) / sizeof(kernels[0]);
+
+    bool any_profiled() {
+        for(size_t k = 0; k < kernel_count; ++k)
+            for(size_t bytes = MIN_BYTES; bytes <= MAX_BYTES; bytes *= 2)
+                if( profiled(label(kernels[k].name, bytes).c_str()) ) return true;
+        return false;
+    }
+
+    void sweep(const kernel& k) {
+        for(size_t bytes = MIN_BYTES; bytes <= MAX_BYTES; bytes *= 2)
+        {
+            n = bytes / k.bytes_per_element;
+            reps = bytes < PASS_BYTES ? int(PASS_BYTES / bytes) : 1;
+            profile(label(k.name, bytes).c_str(), k.func, ITER, int(n * reps), k.bytes_per_element);
+        }
+    }
+
+}
+
+
+void sweep_bench() {
+
+    // Filling the buffers takes longer than a filtered run
+    if( !any_profiled() ) return;
+
+    a = static_cast<simd4x4f*>(memalign(MAX_BYTES, 64));
+    b = static_cast<simd4x4f*>(memalign(MAX_BYTES, 64));
+    c = static_cast<simd4x4f*>(memalign(MAX_BYTES, 64));
+    if( !a || !b || !c ) {
+        std::cerr << "sweep: can't allocate 3 x " << formatBytes(MAX_BYTES) << ", skipped" << std::endl;
+        if( a ) memfree(a);
+        if( b ) memfree(b);
+        if( c ) memfree(c);
+        return;
+    }
+
+    // Well conditioned matrices, nothing drifting towards denormals or
+    // infinities however often the kernels run over them
+    simd4x4f m[16];
+    for(int i = 0; i < 16; ++i)
+    {
+        simd4x4f_axis_rotation(&m[i], 0.3f * i, simd4f_create(0.0f, 0.6f, 0.8f, 0.0f));
+        m[i].w = simd4f_create(0.5f * i, 1.0f, -2.0f, 1.0f);
+    }
+    const size_t count = MAX_BYTES / sizeof(simd4x4f);
+    for(size_t i = 0; i < count; ++i)
+    {
+        a[i] = m[i % 16];
+        b[i] = m[(i + 7) % 16];
+    }
+    memset(c, 0, MAX_BYTES);
+
+    for(size_t k = 0; k < kernel_count; ++k) sweep(kernels[k]);
+
+    std::cout << "Last " << simd4f_get_x(c[0].x) << " " << simd4f_get_x(aabb_max) << std::endl;
+
+    memfree(a);
+    memfree(b);
+    memfree(c);
+
+}
@@ -0,0 +1,91 @@
+#include "bench.h"
+#include <stdlib.h>
+
+#include <iostream>
+#include "vectorial/vec3f.h"
+#include "vectorial/mat4f_array.h"
+
+#define NUM (81920)
+#define ITER 100
+using namespace vectorial;
+
+namespace {
+    vec3f* alloc_vec3f(size_t n) {
+        void *ptr = memalign(n*sizeof(vec3f), 16);
+        return static_cast<vec3f*>(ptr);
+    }
+    float* alloc_float(size_t n) {
+        void *ptr = memalign(n*sizeof(float), 16);
+        return static_cast<float*>(ptr);
+    }
+}
+
+
+
+static mat4f m;
+static vec3f * a;
+static vec3f * b;
+static float * pa;
+static float * pb;
+
+
+
+void transform_element_func() {
+
+    const mat4f mm = m;
+    vec3f* vectorial_restrict aa = a;
+    vec3f* vectorial_restrict bb = b;
+
+    for(size_t i = 0; i < NUM; ++i)
+    {
+        bb[i] = transformPoint(mm, aa[i]);
+    }
+}
+
+void transform_array_func() {
+    transformPoints(m, a, b, NUM);
+}
+
+void transform_packed_element_func() {
+
+    const mat4f mm = m;
+    float* vectorial_restrict aa = pa;
+    float* vectorial_restrict bb = pb;
+
+    for(size_t i = 0; i < NUM; ++i)
+    {
+        transformPoint(mm, vec3f(aa + 3*i)).store(bb + 3*i);
+    }
+}
+
+void transform_packed_array_func() {
+    transformPoints(m, pa, pb, NUM);
+}
+
+void transform_bench() {
+
+    a = alloc_vec3f(NUM);
+    b = alloc_vec3f(NUM);
+    pa = alloc_float(3*NUM);
+    pb = alloc_float(3*NUM);
+
+    simd4x4f_axis_rotation(&m.value, 0.5f, simd4f_create(1,2,3,0));
+    m.value.w = simd4f_create(1,2,3,1);
+
+    for(size_t i = 0; i < NUM; ++i)
+    {
+        a[i] = vec3f(i, NUM-i, 1);
+        a[i].store(pa + 3*i);
+    }
+
+    profile("transformPoint per vec3f", transform_element_func, ITER, NUM);
+    profile("transformPoints on vec3f array", transform_array_func, ITER, NUM);
+    profile("transformPoint per packed float3", transform_packed_element_func, ITER, NUM);
+    profile("transformPoints on packed float3 array", transform_packed_array_func, ITER, NUM);
+
+    memfree(a);
+    memfree(b);
+    memfree(pa);
+    memfree(pb);
+
+}
@@ -0,0 +1,57 @@
+/*
+  Vectorial
+  Copyright (c) 2010 Mikko Lehtonen
+  Licensed under the terms of the two-clause BSD License (see LICENSE)
+*/
+#ifndef VECTORIAL_BOUNDS_H
+#define VECTORIAL_BOUNDS_H
+
+#ifndef VECTORIAL_SIMD4F_BOUNDS_H
+  #include "vectorial/simd4f_bounds.h"
+#endif
+
+#ifndef VECTORIAL_VEC3F_H
+  #include "vectorial/vec3f.h"
+#endif
+
+#ifndef VECTORIAL_VEC4F_H
+  #include "vectorial/vec4f.h"
+#endif
+
+#include <stddef.h>
+
+
+namespace vectorial {
+
+    // Bounds of n points, as vec3f or packed float[3], see simd4f_bounds.h
+
+    vectorial_inline void bounds(const vec3f* points, size_t n, vec3f& aabbMin, vec3f& aabbMax) {
+        simd4f_aabb_array((const simd4f*)points, n, &aabbMin.value, &aabbMax.value);
+    }
+
+    vectorial_inline void bounds(const float* points, size_t n, vec3f& aabbMin, vec3f& aabbMax) {
+        simd4f_aabb_packed3(points, n, &aabbMin.value, &aabbMax.value);
+    }
+
+    vectorial_inline vec3f centroid(const vec3f* points, size_t n) {
+        return vec3f( simd4f_centroid_array((const simd4f*)points, n) );
+    }
+
+    vectorial_inline vec3f centroid(const float* points, size_t n) {
+        return vec3f( simd4f_centroid_packed3(points, n) );
+    }
+
+    // Center in xyz and radius in w, like the spheres of frustumf
+    vectorial_inline vec4f boundingSphere(const vec3f* points, size_t n) {
+        return vec4f( simd4f_bounding_sphere_array((const simd4f*)points, n) );
+    }
+
+    vectorial_inline vec4f boundingSphere(const float* points, size_t n) {
+        return vec4f( simd4f_bounding_sphere_packed3(points, n) );
+    }
+
+}
+
+
+
+#endif
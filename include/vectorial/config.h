@@ -56,6 +56,128 @@
 #endif
 
 
+// The 8-wide simd8f follows the simd4f selection, using AVX when the
+// compiler targets it and a pair of simd4f otherwise. Gnu targets with
+// AVX get 32 byte gnu vectors, without it those would change the calling
+// convention (gcc -Wpsabi) so they get the pair of 16 byte ones too.
+#if !defined(VECTORIAL_SIMD8F_AVX) && !defined(VECTORIAL_SIMD8F_PAIR) && !defined(VECTORIAL_SIMD8F_GNU) && !defined(VECTORIAL_SIMD8F_SCALAR)
+    #if defined(VECTORIAL_SCALAR)
+        #define VECTORIAL_SIMD8F_SCALAR
+    #elif defined(VECTORIAL_SSE) && defined(__AVX__)
+        #define VECTORIAL_SIMD8F_AVX
+    #elif defined(VECTORIAL_SSE)
+        #define VECTORIAL_SIMD8F_PAIR
+    #elif defined(__GNUC__) && !defined(__arm__) && defined(__AVX__)
+        #define VECTORIAL_SIMD8F_GNU
+    #elif defined(__GNUC__) && !defined(__arm__)
+        #define VECTORIAL_SIMD8F_PAIR
+    #else
+        #define VECTORIAL_SIMD8F_SCALAR
+    #endif
+#endif
+
+// The integer simd4i pairs with simd4f, SSE needs SSE2 for the integer
+// operations and falls back to plain ints without it.
+#if !defined(VECTORIAL_SIMD4I_SSE) && !defined(VECTORIAL_SIMD4I_NEON) && !defined(VECTORIAL_SIMD4I_GNU) && !defined(VECTORIAL_SIMD4I_SCALAR)
+    #if defined(VECTORIAL_SSE) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+        #define VECTORIAL_SIMD4I_SSE
+    #elif defined(VECTORIAL_NEON)
+        #define VECTORIAL_SIMD4I_NEON
+    #elif defined(VECTORIAL_GNU)
+        #define VECTORIAL_SIMD4I_GNU
+    #else
+        #define VECTORIAL_SIMD4I_SCALAR
+    #endif
+#endif
+
+// Four doubles in simd4d, as one AVX register or pairs of SSE2 and
+// AArch64 NEON registers. 32bit NEON has no double vectors.
+#if !defined(VECTORIAL_SIMD4D_AVX) && !defined(VECTORIAL_SIMD4D_SSE) && !defined(VECTORIAL_SIMD4D_NEON) && !defined(VECTORIAL_SIMD4D_GNU) && !defined(VECTORIAL_SIMD4D_SCALAR)
+    #if defined(VECTORIAL_SSE) && defined(__AVX__)
+        #define VECTORIAL_SIMD4D_AVX
+    #elif defined(VECTORIAL_SSE) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+        #define VECTORIAL_SIMD4D_SSE
+    #elif defined(VECTORIAL_NEON) && defined(__aarch64__)
+        #define VECTORIAL_SIMD4D_NEON
+    #elif defined(VECTORIAL_GNU)
+        #define VECTORIAL_SIMD4D_GNU
+    #else
+        #define VECTORIAL_SIMD4D_SCALAR
+    #endif
+#endif
+
+// Fused multiply-add, simd4f_madd and friends map to a single rounding
+// instruction when available. MSVC has no __FMA__, but /arch:AVX2 implies it.
+#if !defined(VECTORIAL_HAVE_FMA) && !defined(VECTORIAL_NO_FMA)
+    #if defined(VECTORIAL_SSE) && (defined(__FMA__) || (defined(_MSC_VER) && defined(__AVX2__)))
+        #define VECTORIAL_HAVE_FMA
+    #elif defined(VECTORIAL_NEON) && (defined(__ARM_FEATURE_FMA) || defined(__aarch64__))
+        #define VECTORIAL_HAVE_FMA
+    #endif
+#endif
+
+// Runtime dispatch of the array kernels (simd4x4f_array.h) to AVX2/AVX-512
+// variants, needs intrinsics usable in functions with a target attribute.
+#if defined(VECTORIAL_SSE) && !defined(VECTORIAL_DISPATCH) && !defined(VECTORIAL_NO_DISPATCH)
+    #if defined(__clang__) || (defined(_MSC_VER) && _MSC_VER >= 1910) || \
+        (defined(__GNUC__) && (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9)))
+        #define VECTORIAL_DISPATCH
+    #endif
+#endif
+
+#ifdef VECTORIAL_SIMD8F_SCALAR
+    #define VECTORIAL_SIMD8F_TYPE "scalar"
+#endif
+
+#ifdef VECTORIAL_SIMD8F_AVX
+    #define VECTORIAL_SIMD8F_TYPE "avx"
+#endif
+
+#ifdef VECTORIAL_SIMD8F_PAIR
+    #define VECTORIAL_SIMD8F_TYPE VECTORIAL_SIMD_TYPE " pair"
+#endif
+
+#ifdef VECTORIAL_SIMD8F_GNU
+    #define VECTORIAL_SIMD8F_TYPE "gnu"
+#endif
+
+#ifdef VECTORIAL_SIMD4I_SCALAR
+    #define VECTORIAL_SIMD4I_TYPE "scalar"
+#endif
+
+#ifdef VECTORIAL_SIMD4I_SSE
+    #define VECTORIAL_SIMD4I_TYPE "sse"
+#endif
+
+#ifdef VECTORIAL_SIMD4I_NEON
+    #define VECTORIAL_SIMD4I_TYPE "neon"
+#endif
+
+#ifdef VECTORIAL_SIMD4I_GNU
+    #define VECTORIAL_SIMD4I_TYPE "gnu"
+#endif
+
+#ifdef VECTORIAL_SIMD4D_SCALAR
+    #define VECTORIAL_SIMD4D_TYPE "scalar"
+#endif
+
+#ifdef VECTORIAL_SIMD4D_SSE
+    #define VECTORIAL_SIMD4D_TYPE "sse"
+#endif
+
+#ifdef VECTORIAL_SIMD4D_AVX
+    #define VECTORIAL_SIMD4D_TYPE "avx"
+#endif
+
+#ifdef VECTORIAL_SIMD4D_NEON
+    #define VECTORIAL_SIMD4D_TYPE "neon"
+#endif
+
+#ifdef VECTORIAL_SIMD4D_GNU
+    #define VECTORIAL_SIMD4D_TYPE "gnu"
+#endif
+
+
 #define vectorial_inline    static inline
 
 #if defined(__GNUC__) 
@@ -63,12 +185,15 @@
     #define vectorial_restrict  __restrict
   #endif
   #define simd4f_aligned16  __attribute__ ((aligned (16)))
+  #define simd8f_aligned32  __attribute__ ((aligned (32)))
 #elif defined(_WIN32)
   #define vectorial_restrict  
   #define simd4f_aligned16   __declspec(align(16))
+  #define simd8f_aligned32   __declspec(align(32))
 #else
   #define vectorial_restrict  restrict
   #define simd4f_aligned16   
+  #define simd8f_aligned32   
 #endif
 // #define vectorial_restrict
 
@@ -78,6 +203,20 @@
     #define vectorial_pure
 #endif
 
+// vectorial_shared: one instance of a global shared by every translation
+// unit, keeps the header-only dispatch state in one place.
+// vectorial_target: compile a single function for a wider instruction set.
+#if defined(_MSC_VER)
+    #define vectorial_shared  __declspec(selectany)
+    #define vectorial_target(isa)
+#elif defined(__GNUC__)
+    #define vectorial_shared  __attribute__((weak))
+    #define vectorial_target(isa) __attribute__((target(isa)))
+#else
+    #define vectorial_shared
+    #define vectorial_target(isa)
+#endif
+
 #ifdef _WIN32
   #if defined(min) || defined(max)
 #pragma message ( "set NOMINMAX as preprocessor macro, undefining min/max " )
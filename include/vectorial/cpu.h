@@ -0,0 +1,168 @@
+/*
+  Vectorial
+  Copyright (c) 2010 Mikko Lehtonen
+  Licensed under the terms of the two-clause BSD License (see LICENSE)
+*/
+#ifndef VECTORIAL_CPU_H
+#define VECTORIAL_CPU_H
+
+#ifndef VECTORIAL_CONFIG_H
+  #include "vectorial/config.h"
+#endif
+
+/*
+  Runtime cpu detection for the dispatched array kernels.
+
+  The level is detected once and cached for the whole program, threads
+  racing on the first dispatched call all store the same level. It can be
+  lowered with vectorial_dispatch_force() or by setting the VECTORIAL_ISA
+  environment variable (generic, sse2, sse4.1, avx2, avx512) before the
+  first dispatched call, f.ex. to benchmark the variants against each other.
+
+  VECTORIAL_ISA_GENERIC selects the kernels compiled for the simd type
+  chosen in config.h, as do the levels below AVX2, which have no variants
+  of their own. Without VECTORIAL_DISPATCH everything reports it.
+*/
+
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef VECTORIAL_DISPATCH
+    #if defined(_MSC_VER)
+        #include <intrin.h>
+        #include <immintrin.h>
+    #else
+        #include <cpuid.h>
+        #include <immintrin.h>
+    #endif
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+typedef enum {
+    VECTORIAL_ISA_DEFAULT = 0,  // for vectorial_dispatch_force, the detected level
+    VECTORIAL_ISA_GENERIC,
+    VECTORIAL_ISA_SSE2,
+    VECTORIAL_ISA_SSE4_1,
+    VECTORIAL_ISA_AVX2,     // AVX2 and FMA
+    VECTORIAL_ISA_AVX512    // AVX-512F
+} vectorial_isa;
+
+
+vectorial_inline const char* vectorial_isa_name(vectorial_isa isa) {
+    switch(isa) {
+        case VECTORIAL_ISA_SSE2: return "sse2";
+        case VECTORIAL_ISA_SSE4_1: return "sse4.1";
+        case VECTORIAL_ISA_AVX2: return "avx2";
+        case VECTORIAL_ISA_AVX512: return "avx512";
+        case VECTORIAL_ISA_DEFAULT: return "default";
+        default: return VECTORIAL_SIMD_TYPE;
+    }
+}
+
+
+#ifdef VECTORIAL_DISPATCH
+
+// Read and written atomically, the thread pool's workers dispatch at once
+vectorial_shared long _vectorial_dispatch_isa = -1;
+
+#if defined(_MSC_VER)
+    #define _VECTORIAL_ATOMIC_LOAD(p) _InterlockedOr((volatile long*)(p), 0)
+    #define _VECTORIAL_ATOMIC_STORE(p, v) _InterlockedExchange((volatile long*)(p), (v))
+#else
+    #define _VECTORIAL_ATOMIC_LOAD(p) __atomic_load_n((p), __ATOMIC_ACQUIRE)
+    #define _VECTORIAL_ATOMIC_STORE(p, v) __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+#endif
+
+
+vectorial_inline void _vectorial_cpuid(int leaf, unsigned int regs[4]) {
+#if defined(_MSC_VER)
+    int r[4];
+    __cpuidex(r, leaf, 0);
+    regs[0] = r[0]; regs[1] = r[1]; regs[2] = r[2]; regs[3] = r[3];
+#else
+    regs[0] = regs[1] = regs[2] = regs[3] = 0;
+    if( (unsigned int)leaf <= __get_cpuid_max(0, 0) ) {
+        __cpuid_count(leaf, 0, regs[0], regs[1], regs[2], regs[3]);
+    }
+#endif
+}
+
+// Which register state the OS saves on context switch
+vectorial_inline unsigned int _vectorial_xgetbv() {
+#if defined(_MSC_VER)
+    return (unsigned int)_xgetbv(0);
+#else
+    unsigned int eax, edx;
+    __asm__ ("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    return eax;
+#endif
+}
+
+vectorial_inline vectorial_isa vectorial_cpu_isa() {
+    unsigned int r1[4], r7[4];
+    _vectorial_cpuid(1, r1);
+    _vectorial_cpuid(7, r7);
+
+    const int sse2 = (r1[3] >> 26) & 1;
+    const int sse41 = (r1[2] >> 19) & 1;
+    const int osxsave = (r1[2] >> 27) & 1;
+    const int avx = (r1[2] >> 28) & 1;
+    const int fma = (r1[2] >> 12) & 1;
+    const int avx2 = (r7[1] >> 5) & 1;
+    const int avx512f = (r7[1] >> 16) & 1;
+
+    const unsigned int xcr0 = osxsave ? _vectorial_xgetbv() : 0;
+    const int ymm_state = (xcr0 & 0x06) == 0x06;
+    const int zmm_state = (xcr0 & 0xe6) == 0xe6;
+
+    if( avx512f && zmm_state ) return VECTORIAL_ISA_AVX512;
+    if( avx && avx2 && fma && ymm_state ) return VECTORIAL_ISA_AVX2;
+    if( sse41 ) return VECTORIAL_ISA_SSE4_1;
+    if( sse2 ) return VECTORIAL_ISA_SSE2;
+    return VECTORIAL_ISA_GENERIC;
+}
+
+// Force a lower level, VECTORIAL_ISA_DEFAULT goes back to the detected one.
+// Levels the cpu doesn't have are clamped to what it does.
+vectorial_inline void vectorial_dispatch_force(vectorial_isa isa) {
+    const vectorial_isa cpu = vectorial_cpu_isa();
+    _VECTORIAL_ATOMIC_STORE(&_vectorial_dispatch_isa, (long)((isa == VECTORIAL_ISA_DEFAULT || isa > cpu) ? cpu : isa));
+}
+
+vectorial_inline vectorial_isa vectorial_dispatch_isa() {
+    long current = _VECTORIAL_ATOMIC_LOAD(&_vectorial_dispatch_isa);
+    if( current < 0 ) {
+        vectorial_isa isa = VECTORIAL_ISA_DEFAULT;
+        const char* env = getenv("VECTORIAL_ISA");
+        if( env ) {
+            if( strcmp(env, "generic") == 0 ) isa = VECTORIAL_ISA_GENERIC;
+            else if( strcmp(env, "sse2") == 0 ) isa = VECTORIAL_ISA_SSE2;
+            else if( strcmp(env, "sse4.1") == 0 ) isa = VECTORIAL_ISA_SSE4_1;
+            else if( strcmp(env, "avx2") == 0 ) isa = VECTORIAL_ISA_AVX2;
+            else if( strcmp(env, "avx512") == 0 ) isa = VECTORIAL_ISA_AVX512;
+        }
+        vectorial_dispatch_force(isa);
+        current = _VECTORIAL_ATOMIC_LOAD(&_vectorial_dispatch_isa);
+    }
+    return (vectorial_isa)current;
+}
+
+#else
+
+vectorial_inline vectorial_isa vectorial_cpu_isa() { return VECTORIAL_ISA_GENERIC; }
+vectorial_inline void vectorial_dispatch_force(vectorial_isa isa) { (void)isa; }
+vectorial_inline vectorial_isa vectorial_dispatch_isa() { return VECTORIAL_ISA_GENERIC; }
+
+#endif
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif
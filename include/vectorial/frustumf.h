@@ -0,0 +1,78 @@
+/*
+  Vectorial
+  Copyright (c) 2010 Mikko Lehtonen
+  Licensed under the terms of the two-clause BSD License (see LICENSE)
+*/
+#ifndef VECTORIAL_FRUSTUMF_H
+#define VECTORIAL_FRUSTUMF_H
+
+#ifndef VECTORIAL_SIMD4F_FRUSTUM_H
+  #include "vectorial/simd4f_frustum.h"
+#endif
+
+#ifndef VECTORIAL_VEC3F_H
+  #include "vectorial/vec3f.h"
+#endif
+
+#ifndef VECTORIAL_MAT4F_H
+  #include "vectorial/mat4f.h"
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+
+namespace vectorial {
+
+    // See simd4f_frustum.h for the plane and result layouts
+    class frustumf {
+    public:
+
+        simd4f_frustum value;
+
+        inline frustumf() {}
+        inline frustumf(const simd4f_frustum& v) : value(v) {}
+        explicit inline frustumf(const mat4f& viewProjection) { simd4f_frustum_from_simd4x4f(&viewProjection.value, &value); }
+
+        inline vec4f plane(int i) const { return vec4f( value.plane[i] ); }
+
+    };
+
+
+    // Spheres as vec4f, center in xyz and radius in w
+
+    vectorial_inline bool isVisible(const frustumf& f, const vec4f& sphere) {
+        return simd4f_frustum_sphere_visible(&f.value, sphere.value) != 0;
+    }
+
+    vectorial_inline bool isVisible(const frustumf& f, const vec3f& aabbMin, const vec3f& aabbMax) {
+        return simd4f_frustum_aabb_visible(&f.value, aabbMin.value, aabbMax.value) != 0;
+    }
+
+
+    // Bit i%32 of visible[i/32] for each of n objects
+
+    vectorial_inline void cullSpheres(const frustumf& f, const vec4f* spheres, size_t n, uint32_t* visible) {
+        simd4f_frustum_cull_spheres(&f.value, (const simd4f*)spheres, n, visible);
+    }
+
+    vectorial_inline void cullBoxes(const frustumf& f, const vec3f* aabbMin, const vec3f* aabbMax, size_t n, uint32_t* visible) {
+        simd4f_frustum_cull_aabbs(&f.value, (const simd4f*)aabbMin, (const simd4f*)aabbMax, n, visible);
+    }
+
+    // Indices of the visible ones, indices needs room for n. Returns the count.
+
+    vectorial_inline size_t compactSpheres(const frustumf& f, const vec4f* spheres, size_t n, uint32_t* indices) {
+        return simd4f_frustum_compact_spheres(&f.value, (const simd4f*)spheres, n, indices);
+    }
+
+    vectorial_inline size_t compactBoxes(const frustumf& f, const vec3f* aabbMin, const vec3f* aabbMax, size_t n, uint32_t* indices) {
+        return simd4f_frustum_compact_aabbs(&f.value, (const simd4f*)aabbMin, (const simd4f*)aabbMax, n, indices);
+    }
+
+}
+
+
+
+
+#endif
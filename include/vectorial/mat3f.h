@@ -0,0 +1,138 @@
+/*
+  Vectorial
+  Copyright (c) 2010 Mikko Lehtonen
+  Licensed under the terms of the two-clause BSD License (see LICENSE)
+*/
+#ifndef VECTORIAL_MAT3F_H
+#define VECTORIAL_MAT3F_H
+
+#ifndef VECTORIAL_SIMD3X3F_H
+  #include "vectorial/simd3x3f.h"
+#endif
+
+#ifndef VECTORIAL_VEC3F_H
+  #include "vectorial/vec3f.h"
+#endif
+
+#ifndef VECTORIAL_MAT4F_H
+  #include "vectorial/mat4f.h"
+#endif
+
+
+namespace vectorial {
+
+    class mat3f {
+    public:
+
+        simd3x3f value;
+
+        inline mat3f() {}
+        inline mat3f(const simd3x3f& v) : value(v) {}
+        inline mat3f(const vec3f& v0, const vec3f& v1, const vec3f& v2)
+            : value( simd3x3f_create(simd4f_zero_w(v0.value), simd4f_zero_w(v1.value), simd4f_zero_w(v2.value)) ) {}
+        explicit inline mat3f(const mat4f& m) { simd3x3f_from_simd4x4f(&m.value, &value); }
+        explicit inline mat3f(const float *ary) { simd3x3f_uload(&value, ary); }
+
+        inline void load(const float *ary) { simd3x3f_uload(&value, ary); }
+        inline void store(float *ary) const { simd3x3f_ustore(&value, ary); }
+
+        static mat3f identity() { mat3f m; simd3x3f_identity(&m.value); return m; }
+
+        static mat3f axisRotation(float angle, const vec3f& axis) {
+            simd4x4f m;
+            simd4x4f_axis_rotation(&m, angle, axis.value);
+            return mat3f( mat4f(m) );
+        }
+
+        static mat3f scale(float scale) {
+            return simd3x3f_create( simd4f_create(scale,0,0,0),
+                                    simd4f_create(0,scale,0,0),
+                                    simd4f_create(0,0,scale,0) );
+        }
+
+        static mat3f scale(const vec3f& scale) {
+            return simd3x3f_create( simd4f_create(scale.x(),0,0,0),
+                                    simd4f_create(0,scale.y(),0,0),
+                                    simd4f_create(0,0,scale.z(),0) );
+        }
+
+    };
+
+
+    vectorial_inline mat3f operator*(const mat3f& lhs, const mat3f& rhs) {
+        mat3f ret;
+        simd3x3f_matrix_mul(&lhs.value, &rhs.value, &ret.value);
+        return ret;
+    }
+
+    vectorial_inline mat3f operator*=(mat3f& lhs, const mat3f& rhs) {
+        const simd3x3f tmp = lhs.value;
+        simd3x3f_matrix_mul(&tmp, &rhs.value, &lhs.value);
+        return lhs;
+    }
+
+    vectorial_inline vec3f operator*(const mat3f& lhs, const vec3f& rhs) {
+        vec3f ret;
+        simd3x3f_matrix_vector_mul(&lhs.value, &rhs.value, &ret.value);
+        return ret;
+    }
+
+
+    vectorial_inline mat3f transpose(const mat3f& m) {
+        mat3f ret;
+        simd3x3f_transpose(&m.value, &ret.value);
+        return ret;
+    }
+
+    vectorial_inline float determinant(const mat3f& m) {
+        return simd4f_get_x( simd3x3f_determinant(&m.value) );
+    }
+
+    vectorial_inline mat3f inverse(const mat3f& m) {
+        mat3f ret;
+        simd3x3f_inverse(&m.value, &ret.value);
+        return ret;
+    }
+
+    // Inverse transpose of the upper 3x3, for transforming normals
+    vectorial_inline mat3f normalMatrix(const mat4f& m) {
+        mat3f ret;
+        simd3x3f_normal_matrix(&m.value, &ret.value);
+        return ret;
+    }
+
+    vectorial_inline mat4f toMat4f(const mat3f& m) {
+        mat4f ret;
+        simd3x3f_to_simd4x4f(&m.value, &ret.value);
+        return ret;
+    }
+
+}
+
+
+#ifdef VECTORIAL_OSTREAM
+//#include <ostream>
+
+vectorial_inline std::ostream& operator<<(std::ostream& os, const vectorial::mat3f& v) {
+
+    os << "[ ";
+    os << simd4f_get_x(v.value.x) << ", ";
+    os << simd4f_get_x(v.value.y) << ", ";
+    os << simd4f_get_x(v.value.z) << " ; ";
+
+    os << simd4f_get_y(v.value.x) << ", ";
+    os << simd4f_get_y(v.value.y) << ", ";
+    os << simd4f_get_y(v.value.z) << " ; ";
+
+    os << simd4f_get_z(v.value.x) << ", ";
+    os << simd4f_get_z(v.value.y) << ", ";
+    os << simd4f_get_z(v.value.z) << " ]";
+
+    return os;
+}
+#endif
+
+
+
+
+#endif
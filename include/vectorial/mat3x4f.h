@@ -0,0 +1,130 @@
+/*
+  Vectorial
+  Copyright (c) 2010 Mikko Lehtonen
+  Licensed under the terms of the two-clause BSD License (see LICENSE)
+*/
+#ifndef VECTORIAL_MAT3X4F_H
+#define VECTORIAL_MAT3X4F_H
+
+#ifndef VECTORIAL_SIMD4X3F_H
+  #include "vectorial/simd4x3f.h"
+#endif
+
+#ifndef VECTORIAL_VEC3F_H
+  #include "vectorial/vec3f.h"
+#endif
+
+#ifndef VECTORIAL_MAT4F_H
+  #include "vectorial/mat4f.h"
+#endif
+
+
+namespace vectorial {
+
+    // Affine transform, a mat4f without the 0 0 0 1 row
+    class mat3x4f {
+    public:
+
+        simd4x3f value;
+
+        inline mat3x4f() {}
+        inline mat3x4f(const simd4x3f& v) : value(v) {}
+        explicit inline mat3x4f(const mat4f& m) { simd4x3f_from_simd4x4f(&m.value, &value); }
+        explicit inline mat3x4f(const float *ary) { simd4x3f_uload(&value, ary); }
+
+        inline void load(const float *ary) { simd4x3f_uload(&value, ary); }
+        inline void store(float *ary) const { simd4x3f_ustore(&value, ary); }
+
+        static mat3x4f identity() { mat3x4f m; simd4x3f_identity(&m.value); return m; }
+
+        static mat3x4f translation(const vec3f& pos) {
+            simd4x3f m;
+            simd4x3f_translation(&m, pos.x(), pos.y(), pos.z());
+            return m;
+        }
+
+        static mat3x4f axisRotation(float angle, const vec3f& axis) {
+            simd4x4f m;
+            simd4x4f_axis_rotation(&m, angle, axis.value);
+            return mat3x4f( mat4f(m) );
+        }
+
+    };
+
+
+    vectorial_inline mat3x4f operator*(const mat3x4f& lhs, const mat3x4f& rhs) {
+        mat3x4f ret;
+        simd4x3f_matrix_mul(&lhs.value, &rhs.value, &ret.value);
+        return ret;
+    }
+
+    vectorial_inline mat3x4f operator*=(mat3x4f& lhs, const mat3x4f& rhs) {
+        const simd4x3f tmp = lhs.value;
+        simd4x3f_matrix_mul(&tmp, &rhs.value, &lhs.value);
+        return lhs;
+    }
+
+    vectorial_inline vec3f transformVector(const mat3x4f& lhs, const vec3f& rhs) {
+        vec3f ret;
+        simd4x3f_matrix_vector3_mul(&lhs.value, &rhs.value, &ret.value);
+        return ret;
+    }
+
+    vectorial_inline vec3f transformPoint(const mat3x4f& lhs, const vec3f& rhs) {
+        vec3f ret;
+        simd4x3f_matrix_point3_mul(&lhs.value, &rhs.value, &ret.value);
+        return ret;
+    }
+
+
+    vectorial_inline mat3x4f inverse(const mat3x4f& m) {
+        mat3x4f ret;
+        simd4x3f_inverse(&m.value, &ret.value);
+        return ret;
+    }
+
+    // Only for rotation and translation
+    vectorial_inline mat3x4f orthoInverse(const mat3x4f& m) {
+        mat3x4f ret;
+        simd4x3f_inverse_ortho(&m.value, &ret.value);
+        return ret;
+    }
+
+    vectorial_inline mat4f toMat4f(const mat3x4f& m) {
+        mat4f ret;
+        simd4x3f_to_simd4x4f(&m.value, &ret.value);
+        return ret;
+    }
+
+}
+
+
+#ifdef VECTORIAL_OSTREAM
+//#include <ostream>
+
+vectorial_inline std::ostream& operator<<(std::ostream& os, const vectorial::mat3x4f& v) {
+
+    os << "[ ";
+    os << simd4f_get_x(v.value.x) << ", ";
+    os << simd4f_get_y(v.value.x) << ", ";
+    os << simd4f_get_z(v.value.x) << ", ";
+    os << simd4f_get_w(v.value.x) << " ; ";
+
+    os << simd4f_get_x(v.value.y) << ", ";
+    os << simd4f_get_y(v.value.y) << ", ";
+    os << simd4f_get_z(v.value.y) << ", ";
+    os << simd4f_get_w(v.value.y) << " ; ";
+
+    os << simd4f_get_x(v.value.z) << ", ";
+    os << simd4f_get_y(v.value.z) << ", ";
+    os << simd4f_get_z(v.value.z) << ", ";
+    os << simd4f_get_w(v.value.z) << " ]";
+
+    return os;
+}
+#endif
+
+
+
+
+#endif
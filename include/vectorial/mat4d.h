@@ -0,0 +1,192 @@
+/*
+  Vectorial
+  Copyright (c) 2010 Mikko Lehtonen
+  Licensed under the terms of the two-clause BSD License (see LICENSE)
+*/
+#ifndef VECTORIAL_MAT4D_H
+#define VECTORIAL_MAT4D_H
+
+#ifndef VECTORIAL_SIMD4X4D_H
+  #include "vectorial/simd4x4d.h"
+#endif
+
+#ifndef VECTORIAL_VEC4D_H
+  #include "vectorial/vec4d.h"
+#endif
+
+#ifndef VECTORIAL_MAT4F_H
+  #include "vectorial/mat4f.h"
+#endif
+
+
+namespace vectorial {
+
+
+    class mat4d {
+    public:
+
+        simd4x4d value;
+
+        inline mat4d() {}
+        inline mat4d(const simd4x4d& v) : value(v) {}
+        inline mat4d(const vec4d& v0, const vec4d& v1, const vec4d& v2, const vec4d& v3) : value(simd4x4d_create(v0.value, v1.value, v2.value, v3.value)) {}
+        explicit inline mat4d(const double *ary) { simd4x4d_uload(&value, ary); }
+        explicit inline mat4d(const mat4f& m) : value(simd4x4d_create( simd4f_to_simd4d(m.value.x), simd4f_to_simd4d(m.value.y),
+                                                                        simd4f_to_simd4d(m.value.z), simd4f_to_simd4d(m.value.w) )) {}
+
+        inline void load(const double *ary) { simd4x4d_uload(&value, ary); }
+        inline void store(double *ary) const { simd4x4d_ustore(&value, ary); }
+
+        static mat4d identity() { mat4d m; simd4x4d_identity(&m.value); return m; }
+
+        static mat4d perspective(double fovy, double aspect, double znear, double zfar) {
+            simd4x4d m;
+            simd4x4d_perspective(&m, fovy, aspect, znear, zfar);
+            return m;
+        }
+
+        static mat4d ortho(double left, double right, double bottom, double top, double znear, double zfar) {
+            simd4x4d m;
+            simd4x4d_ortho(&m, left, right, bottom, top, znear, zfar);
+            return m;
+        }
+
+        static mat4d lookAt(const vec3d& eye, const vec3d& center, const vec3d& up) {
+            simd4x4d m;
+            simd4x4d_lookat(&m, eye.value, center.value, up.value);
+            return m;
+        }
+
+        static mat4d translation(const vec3d& pos) {
+            simd4x4d m;
+            simd4x4d_translation(&m, pos.x(), pos.y(), pos.z());
+            return m;
+        }
+
+        static mat4d axisRotation(double angle, const vec3d& axis) {
+            simd4x4d m;
+            simd4x4d_axis_rotation(&m, angle, axis.value);
+            return m;
+        }
+
+        static mat4d scale(double scale) {
+            return simd4x4d_create( simd4d_create(scale,0,0,0),
+                                    simd4d_create(0,scale,0,0),
+                                    simd4d_create(0,0,scale,0),
+                                    simd4d_create(0,0,0,1) );
+        }
+
+        static mat4d scale(const vec3d& scale) {
+            return simd4x4d_create( simd4d_create(scale.x(),0,0,0),
+                                    simd4d_create(0,scale.y(),0,0),
+                                    simd4d_create(0,0,scale.z(),0),
+                                    simd4d_create(0,0,0,1) );
+        }
+
+    };
+
+
+    vectorial_inline mat4d operator*(const mat4d& lhs, const mat4d& rhs) {
+        mat4d ret;
+        simd4x4d_matrix_mul(&lhs.value, &rhs.value, &ret.value);
+        return ret;
+    }
+
+    vectorial_inline mat4d operator*=(mat4d& lhs, const mat4d& rhs) {
+        const simd4x4d tmp = lhs.value;
+        simd4x4d_matrix_mul(&tmp, &rhs.value, &lhs.value);
+        return lhs;
+    }
+
+
+    vectorial_inline vec4d operator*(const mat4d& lhs, const vec4d& rhs) {
+        vec4d ret;
+        simd4x4d_matrix_vector_mul(&lhs.value, &rhs.value, &ret.value);
+        return ret;
+    }
+
+    vectorial_inline vec3d transformVector(const mat4d& lhs, const vec3d& rhs) {
+        vec3d ret;
+        simd4x4d_matrix_vector3_mul(&lhs.value, &rhs.value, &ret.value);
+        return ret;
+    }
+
+    vectorial_inline vec4d transformVector(const mat4d& lhs, const vec4d& rhs) {
+        vec4d ret;
+        simd4x4d_matrix_vector_mul(&lhs.value, &rhs.value, &ret.value);
+        return ret;
+    }
+
+    vectorial_inline vec3d transformPoint(const mat4d& lhs, const vec3d& rhs) {
+        vec3d ret;
+        simd4x4d_matrix_point3_mul(&lhs.value, &rhs.value, &ret.value);
+        return ret;
+    }
+
+
+    vectorial_inline mat4d transpose(const mat4d& m) {
+        mat4d ret;
+        simd4x4d_transpose(&m.value, &ret.value);
+        return ret;
+    }
+
+    vectorial_inline mat4d inverse(const mat4d& m) {
+        mat4d ret;
+        simd4x4d_inverse(&m.value, &ret.value);
+        return ret;
+    }
+
+
+    // Rounded to float as is
+    vectorial_inline mat4f toFloat(const mat4d& m) {
+        mat4f ret;
+        simd4x4d_to_simd4x4f(&m.value, &ret.value);
+        return ret;
+    }
+
+    // The model matrix for drawing with the camera at origin, translation
+    // is made relative in doubles so the float result keeps its precision
+    vectorial_inline mat4f relativeToFloat(const mat4d& m, const vec3d& origin) {
+        mat4f ret;
+        simd4x4d_relative_to_simd4x4f(&m.value, origin.value, &ret.value);
+        return ret;
+    }
+
+}
+
+
+
+#ifdef VECTORIAL_OSTREAM
+//#include <ostream>
+
+vectorial_inline std::ostream& operator<<(std::ostream& os, const vectorial::mat4d& v) {
+
+    os << "[ ";
+    os << simd4d_get_x(v.value.x) << ", ";
+    os << simd4d_get_x(v.value.y) << ", ";
+    os << simd4d_get_x(v.value.z) << ", ";
+    os << simd4d_get_x(v.value.w) << " ; ";
+
+    os << simd4d_get_y(v.value.x) << ", ";
+    os << simd4d_get_y(v.value.y) << ", ";
+    os << simd4d_get_y(v.value.z) << ", ";
+    os << simd4d_get_y(v.value.w) << " ; ";
+
+    os << simd4d_get_z(v.value.x) << ", ";
+    os << simd4d_get_z(v.value.y) << ", ";
+    os << simd4d_get_z(v.value.z) << ", ";
+    os << simd4d_get_z(v.value.w) << " ; ";
+
+    os << simd4d_get_w(v.value.x) << ", ";
+    os << simd4d_get_w(v.value.y) << ", ";
+    os << simd4d_get_w(v.value.z) << ", ";
+    os << simd4d_get_w(v.value.w) << " ]";
+
+    return os;
+}
+#endif
+
+
+
+
+#endif
@@ -0,0 +1,85 @@
+/*
+  Vectorial
+  Copyright (c) 2010 Mikko Lehtonen
+  Licensed under the terms of the two-clause BSD License (see LICENSE)
+*/
+#ifndef VECTORIAL_MAT4F_ARRAY_H
+#define VECTORIAL_MAT4F_ARRAY_H
+
+#ifndef VECTORIAL_MAT4F_H
+  #include "vectorial/mat4f.h"
+#endif
+
+#ifndef VECTORIAL_MAT3X4F_H
+  #include "vectorial/mat3x4f.h"
+#endif
+
+#ifndef VECTORIAL_SIMD4X4F_ARRAY_H
+  #include "vectorial/simd4x4f_array.h"
+#endif
+
+#include <stddef.h>
+
+/*
+  Whole arrays at once for mat4f and mat3x4f, see simd4x4f_array.h. Kept
+  apart from mat4f.h as the kernels pull in cpu.h and simd8f. out may be
+  the same array as in.
+*/
+
+namespace vectorial {
+
+
+    vectorial_inline void transformPoints(const mat4f& m, const vec3f* in, vec3f* out, size_t n) {
+        simd4x4f_matrix_point3_mul_array(&m.value, (const simd4f*)in, (simd4f*)out, n);
+    }
+
+    vectorial_inline void transformVectors(const mat4f& m, const vec3f* in, vec3f* out, size_t n) {
+        simd4x4f_matrix_vector3_mul_array(&m.value, (const simd4f*)in, (simd4f*)out, n);
+    }
+
+    vectorial_inline void transformVectors(const mat4f& m, const vec4f* in, vec4f* out, size_t n) {
+        simd4x4f_matrix_vector_mul_array(&m.value, (const simd4f*)in, (simd4f*)out, n);
+    }
+
+    vectorial_inline void projectPoints(const mat4f& m, const vec3f* in, vec3f* out, size_t n) {
+        simd4x4f_matrix_point3_project_array(&m.value, (const simd4f*)in, (simd4f*)out, n);
+    }
+
+    // Packed float[3] arrays of n points or vectors
+
+    vectorial_inline void transformPoints(const mat4f& m, const float* in, float* out, size_t n) {
+        simd4x4f_matrix_point3_mul_packed3(&m.value, in, out, n);
+    }
+
+    vectorial_inline void transformVectors(const mat4f& m, const float* in, float* out, size_t n) {
+        simd4x4f_matrix_vector3_mul_packed3(&m.value, in, out, n);
+    }
+
+    vectorial_inline void projectPoints(const mat4f& m, const float* in, float* out, size_t n) {
+        simd4x4f_matrix_point3_project_packed3(&m.value, in, out, n);
+    }
+
+    // n matrices at once, see simd4x4f_inverse_array
+    vectorial_inline void inverse(const mat4f* in, mat4f* out, size_t n) {
+        simd4x4f_inverse_array((const simd4x4f*)in, (simd4x4f*)out, n);
+    }
+
+
+    // mat3x4f expands to a simd4x4f once
+
+    vectorial_inline void transformPoints(const mat3x4f& m, const vec3f* in, vec3f* out, size_t n) {
+        simd4x4f t;
+        simd4x3f_to_simd4x4f(&m.value, &t);
+        simd4x4f_matrix_point3_mul_array(&t, (const simd4f*)in, (simd4f*)out, n);
+    }
+
+    vectorial_inline void transformVectors(const mat3x4f& m, const vec3f* in, vec3f* out, size_t n) {
+        simd4x4f t;
+        simd4x3f_to_simd4x4f(&m.value, &t);
+        simd4x4f_matrix_vector3_mul_array(&t, (const simd4f*)in, (simd4f*)out, n);
+    }
+
+}
+
+
+#endif
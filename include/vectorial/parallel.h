@@ -0,0 +1,348 @@
+/*
+  Vectorial
+  Copyright (c) 2010 Mikko Lehtonen
+  Licensed under the terms of the two-clause BSD License (see LICENSE)
+*/
+#ifndef VECTORIAL_PARALLEL_H
+#define VECTORIAL_PARALLEL_H
+
+#ifndef VECTORIAL_SIMD4X4F_ARRAY_H
+  #include "vectorial/simd4x4f_array.h"
+#endif
+
+#ifndef VECTORIAL_SIMD4F_BOUNDS_H
+  #include "vectorial/simd4f_bounds.h"
+#endif
+
+#include <stddef.h>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/*
+  Thread pool for running the array kernels on several cores, needs C++11
+  and linking with -pthread.
+
+  parallel_for splits [0, n) into chunks of grain items. Each worker starts
+  on its own contiguous run of chunks and steals single chunks from the
+  others when it runs out. Given the item size and the output pointer the
+  chunk boundaries land on cache line boundaries of the output, so no two
+  workers write the same line.
+
+  The calling thread works too, a pool of size 1 runs everything inline.
+  Calls from inside a running job also run inline, and calls from several
+  threads at once take turns.
+*/
+
+namespace vectorial {
+
+    class thread_pool {
+    public:
+
+        enum { cache_line = 64 };
+
+        // threads counts the caller, 0 for one per hardware thread
+        explicit thread_pool(size_t threads = 0) : slices(0), generation(0), pending(0), stopping(false) {
+            if( threads == 0 ) threads = std::thread::hardware_concurrency();
+            if( threads == 0 ) threads = 1;
+            slices.resize(threads);
+            for(size_t i = 1; i < threads; ++i) {
+                workers.push_back(std::thread(&thread_pool::worker, this, i));
+            }
+        }
+
+        ~thread_pool() {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                stopping = true;
+            }
+            wake.notify_all();
+            for(size_t i = 0; i < workers.size(); ++i) workers[i].join();
+        }
+
+        size_t size() const { return slices.size(); }
+
+        // f(begin, end) for chunks covering [0, n). grain 0 picks one giving
+        // each thread a few chunks of at least a page of output.
+        template<typename F>
+        void parallel_for(size_t n, const F& f, size_t grain = 0, size_t item_size = 0, const void* out = 0) {
+            if( n == 0 ) return;
+
+            size_t align = 1, head = 0;
+            if( item_size ) {
+                align = cache_line / gcd(cache_line, item_size);
+                const size_t misalign = size_t(out) % cache_line;
+                for(size_t i = 0; i < align && misalign; ++i) {
+                    if( (misalign + i * item_size) % cache_line == 0 ) { head = i; break; }
+                }
+            }
+            if( grain == 0 ) {
+                const size_t min_grain = item_size ? 4096 / item_size : 1024;
+                grain = n / (size() * 8);
+                if( grain < min_grain ) grain = min_grain;
+            }
+            grain = (grain + align - 1) / align * align;
+
+            job j;
+            j.run = &call<F>;
+            j.context = &f;
+            j.n = n;
+            j.grain = grain;
+            j.shift = (grain - head % grain) % grain;
+            j.chunks = (n + j.shift + grain - 1) / grain;
+
+            if( j.chunks == 1 || size() == 1 || inside_job() ) {
+                f(size_t(0), n);
+                return;
+            }
+
+            std::lock_guard<std::mutex> submitting(submit);
+            const size_t threads = size();
+            for(size_t w = 0; w < threads; ++w) {
+                slices[w].next.store(j.chunks * w / threads, std::memory_order_relaxed);
+                slices[w].end = j.chunks * (w + 1) / threads;
+            }
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                current = j;
+                pending = workers.size();
+                ++generation;
+            }
+            wake.notify_all();
+
+            execute(j, 0);
+
+            std::unique_lock<std::mutex> lock(mutex);
+            while( pending != 0 ) done.wait(lock);
+        }
+
+    private:
+
+        struct job {
+            void (*run)(const void* context, size_t begin, size_t end);
+            const void* context;
+            size_t n, grain, shift, chunks;
+        };
+
+        // Padded to two lines so the counters of neighbours never share one,
+        // whatever the alignment of the vector storage
+        struct slice {
+            std::atomic<size_t> next;
+            size_t end;
+            char padding[2 * cache_line - sizeof(std::atomic<size_t>) - sizeof(size_t)];
+
+            slice() : next(0), end(0) {}
+            slice(const slice&) : next(0), end(0) {}
+        };
+
+        template<typename F>
+        static void call(const void* context, size_t begin, size_t end) {
+            (*static_cast<const F*>(context))(begin, end);
+        }
+
+        static size_t gcd(size_t a, size_t b) {
+            while( b ) { const size_t t = a % b; a = b; b = t; }
+            return a;
+        }
+
+        static bool& inside_job() {
+            static thread_local bool inside = false;
+            return inside;
+        }
+
+        void run_chunk(const job& j, size_t c) {
+            const size_t begin = c == 0 ? 0 : c * j.grain - j.shift;
+            size_t end = (c + 1) * j.grain - j.shift;
+            if( end > j.n ) end = j.n;
+            j.run(j.context, begin, end);
+        }
+
+        void execute(const job& j, size_t self) {
+            inside_job() = true;
+            const size_t threads = size();
+            for(size_t k = 0; k < threads; ++k) {
+                slice& s = slices[(self + k) % threads];
+                for(;;) {
+                    const size_t c = s.next.fetch_add(1, std::memory_order_relaxed);
+                    if( c >= s.end ) break;
+                    run_chunk(j, c);
+                }
+            }
+            inside_job() = false;
+        }
+
+        void worker(size_t self) {
+            size_t seen = 0;
+            for(;;) {
+                job j;
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    while( !stopping && generation == seen ) wake.wait(lock);
+                    if( stopping ) return;
+                    seen = generation;
+                    j = current;
+                }
+                execute(j, self);
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    if( --pending != 0 ) continue;
+                }
+                done.notify_one();
+            }
+        }
+
+        thread_pool(const thread_pool&);
+        thread_pool& operator=(const thread_pool&);
+
+        std::vector<slice> slices;
+        std::vector<std::thread> workers;
+        std::mutex submit;
+        std::mutex mutex;
+        std::condition_variable wake;
+        std::condition_variable done;
+        job current;
+        size_t generation;
+        size_t pending;
+        bool stopping;
+    };
+
+
+    // Shared pool with one thread per hardware thread, started on first use
+    inline thread_pool& default_thread_pool() {
+        static thread_pool pool;
+        return pool;
+    }
+
+
+    // The array kernels split over a pool, same arguments and aliasing rules
+    // as the simd4x4f_array.h ones they run per chunk
+
+    inline void parallel_matrix_mul_array(thread_pool& pool, const simd4x4f* a, const simd4x4f* b, simd4x4f* out, size_t n, size_t grain = 0) {
+        pool.parallel_for(n, [=](size_t i, size_t e) { simd4x4f_matrix_mul_array(a + i, b + i, out + i, e - i); }, grain, sizeof(simd4x4f), out);
+    }
+
+    inline void parallel_matrix_mul_one_by_array(thread_pool& pool, const simd4x4f* a, const simd4x4f* b, simd4x4f* out, size_t n, size_t grain = 0) {
+        pool.parallel_for(n, [=](size_t i, size_t e) { simd4x4f_matrix_mul_one_by_array(a, b + i, out + i, e - i); }, grain, sizeof(simd4x4f), out);
+    }
+
+    inline void parallel_matrix_mul_array_by_one(thread_pool& pool, const simd4x4f* a, const simd4x4f* b, simd4x4f* out, size_t n, size_t grain = 0) {
+        pool.parallel_for(n, [=](size_t i, size_t e) { simd4x4f_matrix_mul_array_by_one(a + i, b, out + i, e - i); }, grain, sizeof(simd4x4f), out);
+    }
+
+    inline void parallel_matrix_point3_mul_array(thread_pool& pool, const simd4x4f* m, const simd4f* in, simd4f* out, size_t n, size_t grain = 0) {
+        pool.parallel_for(n, [=](size_t i, size_t e) { simd4x4f_matrix_point3_mul_array(m, in + i, out + i, e - i); }, grain, sizeof(simd4f), out);
+    }
+
+    inline void parallel_matrix_vector3_mul_array(thread_pool& pool, const simd4x4f* m, const simd4f* in, simd4f* out, size_t n, size_t grain = 0) {
+        pool.parallel_for(n, [=](size_t i, size_t e) { simd4x4f_matrix_vector3_mul_array(m, in + i, out + i, e - i); }, grain, sizeof(simd4f), out);
+    }
+
+    inline void parallel_matrix_vector_mul_array(thread_pool& pool, const simd4x4f* m, const simd4f* in, simd4f* out, size_t n, size_t grain = 0) {
+        pool.parallel_for(n, [=](size_t i, size_t e) { simd4x4f_matrix_vector_mul_array(m, in + i, out + i, e - i); }, grain, sizeof(simd4f), out);
+    }
+
+    inline void parallel_matrix_point3_project_array(thread_pool& pool, const simd4x4f* m, const simd4f* in, simd4f* out, size_t n, size_t grain = 0) {
+        pool.parallel_for(n, [=](size_t i, size_t e) { simd4x4f_matrix_point3_project_array(m, in + i, out + i, e - i); }, grain, sizeof(simd4f), out);
+    }
+
+    inline void parallel_matrix_point3_mul_packed3(thread_pool& pool, const simd4x4f* m, const float* in, float* out, size_t n, size_t grain = 0) {
+        pool.parallel_for(n, [=](size_t i, size_t e) { simd4x4f_matrix_point3_mul_packed3(m, in + 3*i, out + 3*i, e - i); }, grain, 3*sizeof(float), out);
+    }
+
+    inline void parallel_matrix_vector3_mul_packed3(thread_pool& pool, const simd4x4f* m, const float* in, float* out, size_t n, size_t grain = 0) {
+        pool.parallel_for(n, [=](size_t i, size_t e) { simd4x4f_matrix_vector3_mul_packed3(m, in + 3*i, out + 3*i, e - i); }, grain, 3*sizeof(float), out);
+    }
+
+
+    // The simd4f_bounds.h reductions, each chunk reduced on its own. Boxes
+    // merge under a lock, min and max not minding the order, centroid sums
+    // and spheres are kept per chunk and merged in order. Spheres merge into the sphere around them,
+    // which can be a little larger than the one a single pass finds.
+
+    inline void parallel_aabb_array(thread_pool& pool, const simd4f* points, size_t n, simd4f* aabb_min, simd4f* aabb_max, size_t grain = 0) {
+        std::mutex merging;
+        simd4f lo = simd4f_splat(FLT_MAX), hi = simd4f_splat(-FLT_MAX);
+        pool.parallel_for(n, [&](size_t i, size_t e) {
+            simd4f l, h;
+            simd4f_aabb_array(points + i, e - i, &l, &h);
+            std::lock_guard<std::mutex> lock(merging);
+            lo = simd4f_min(lo, l);
+            hi = simd4f_max(hi, h);
+        }, grain);
+        *aabb_min = simd4f_zero_w(lo);
+        *aabb_max = simd4f_zero_w(hi);
+    }
+
+    inline void parallel_aabb_packed3(thread_pool& pool, const float* points, size_t n, simd4f* aabb_min, simd4f* aabb_max, size_t grain = 0) {
+        std::mutex merging;
+        simd4f lo = simd4f_splat(FLT_MAX), hi = simd4f_splat(-FLT_MAX);
+        pool.parallel_for(n, [&](size_t i, size_t e) {
+            simd4f l, h;
+            simd4f_aabb_packed3(points + 3*i, e - i, &l, &h);
+            std::lock_guard<std::mutex> lock(merging);
+            lo = simd4f_min(lo, l);
+            hi = simd4f_max(hi, h);
+        }, grain);
+        *aabb_min = simd4f_zero_w(lo);
+        *aabb_max = simd4f_zero_w(hi);
+    }
+
+    // Each grain sized chunk reduced to a simd4f by chunk(begin, end), the
+    // results merged in chunk order once all are in, so the rounding is the
+    // same however the chunks were scheduled. Ranges run inline cover several
+    // chunks and still reduce them one by one.
+    template<typename Chunk, typename Merge>
+    inline simd4f _parallel_reduce(thread_pool& pool, size_t n, size_t grain, const Chunk& chunk, const Merge& merge) {
+        if( grain == 0 ) {
+            grain = n / (pool.size() * 8);
+            if( grain < 1024 ) grain = 1024;
+        }
+        const size_t chunks = (n + grain - 1) / grain;
+        std::vector<float> results(4 * chunks);
+        pool.parallel_for(n, [&](size_t i, size_t e) {
+            for(size_t c = i / grain; c * grain < e; ++c) {
+                const size_t end = (c + 1) * grain < n ? (c + 1) * grain : n;
+                simd4f_ustore4( chunk(c * grain, end), &results[4 * c] );
+            }
+        }, grain);
+        simd4f r = simd4f_uload4(&results[0]);
+        for(size_t c = 1; c < chunks; ++c) r = merge( r, simd4f_uload4(&results[4 * c]) );
+        return r;
+    }
+
+    inline simd4f parallel_centroid_array(thread_pool& pool, const simd4f* points, size_t n, size_t grain = 0) {
+        if( n == 0 ) return simd4f_zero();
+        const simd4f sum = _parallel_reduce(pool, n, grain,
+            [=](size_t i, size_t e) { return _simd4f_sum_array(points + i, e - i); },
+            [](simd4f a, simd4f b) { return simd4f_add(a, b); });
+        return simd4f_mul( sum, simd4f_splat(1.0f / n) );
+    }
+
+    inline simd4f parallel_centroid_packed3(thread_pool& pool, const float* points, size_t n, size_t grain = 0) {
+        if( n == 0 ) return simd4f_zero();
+        const simd4f sum = _parallel_reduce(pool, n, grain,
+            [=](size_t i, size_t e) { return _simd4f_sum_packed3(points + 3*i, e - i); },
+            [](simd4f a, simd4f b) { return simd4f_add(a, b); });
+        return simd4f_mul( sum, simd4f_splat(1.0f / n) );
+    }
+
+    inline simd4f parallel_bounding_sphere_array(thread_pool& pool, const simd4f* points, size_t n, size_t grain = 0) {
+        if( n == 0 ) return simd4f_zero();
+        return _parallel_reduce(pool, n, grain,
+            [=](size_t i, size_t e) { return simd4f_bounding_sphere_array(points + i, e - i); },
+            simd4f_sphere_merge);
+    }
+
+    inline simd4f parallel_bounding_sphere_packed3(thread_pool& pool, const float* points, size_t n, size_t grain = 0) {
+        if( n == 0 ) return simd4f_zero();
+        return _parallel_reduce(pool, n, grain,
+            [=](size_t i, size_t e) { return simd4f_bounding_sphere_packed3(points + 3*i, e - i); },
+            simd4f_sphere_merge);
+    }
+
+}
+
+
+#endif
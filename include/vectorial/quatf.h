@@ -0,0 +1,134 @@
+/*
+  Vectorial
+  Copyright (c) 2010 Mikko Lehtonen
+  Licensed under the terms of the two-clause BSD License (see LICENSE)
+*/
+#ifndef VECTORIAL_QUATF_H
+#define VECTORIAL_QUATF_H
+
+#ifndef VECTORIAL_SIMD4F_QUAT_H
+  #include "vectorial/simd4f_quat.h"
+#endif
+
+#ifndef VECTORIAL_VEC3F_H
+  #include "vectorial/vec3f.h"
+#endif
+
+#ifndef VECTORIAL_MAT4F_H
+  #include "vectorial/mat4f.h"
+#endif
+
+#include <stddef.h>
+
+
+namespace vectorial {
+
+    // Rotation as a unit quaternion, 16 bytes instead of a mat4f's 64
+    class quatf {
+    public:
+
+        simd4f value;
+
+        inline quatf() {}
+        inline quatf(const simd4f& v) : value(v) {}
+        inline quatf(float x, float y, float z, float w) : value( simd4f_create(x,y,z,w) ) {}
+        explicit inline quatf(const float *ary) : value( simd4f_uload4(ary) ) { }
+
+        inline float x() const { return simd4f_get_x(value); }
+        inline float y() const { return simd4f_get_y(value); }
+        inline float z() const { return simd4f_get_z(value); }
+        inline float w() const { return simd4f_get_w(value); }
+
+        inline void load(const float *ary) { value = simd4f_uload4(ary); }
+        inline void store(float *ary) const { simd4f_ustore4(value, ary); }
+
+        static quatf identity() { return quatf( simd4f_quat_identity() ); }
+
+        static quatf axisRotation(float angle, const vec3f& axis) {
+            return quatf( simd4f_quat_axis_rotation(angle, axis.value) );
+        }
+
+        static quatf fromMat4f(const mat4f& m) {
+            return quatf( simd4f_quat_from_simd4x4f(&m.value) );
+        }
+
+    };
+
+
+    // Same order as mat4f, lhs * rhs rotates by rhs first
+    vectorial_inline quatf operator*(const quatf& lhs, const quatf& rhs) {
+        return quatf( simd4f_quat_mul(lhs.value, rhs.value) );
+    }
+
+    vectorial_inline quatf operator*=(quatf& lhs, const quatf& rhs) {
+        return lhs = quatf( simd4f_quat_mul(lhs.value, rhs.value) );
+    }
+
+    vectorial_inline vec3f operator*(const quatf& lhs, const vec3f& rhs) {
+        return vec3f( simd4f_quat_rotate3(lhs.value, rhs.value) );
+    }
+
+    vectorial_inline vec3f rotate(const quatf& q, const vec3f& v) {
+        return vec3f( simd4f_quat_rotate3(q.value, v.value) );
+    }
+
+    vectorial_inline quatf conjugate(const quatf& q) {
+        return quatf( simd4f_quat_conjugate(q.value) );
+    }
+
+    vectorial_inline float dot(const quatf& lhs, const quatf& rhs) {
+        return simd4f_get_x( simd4f_dot4(lhs.value, rhs.value) );
+    }
+
+    vectorial_inline float length(const quatf& q) {
+        return simd4f_get_x( simd4f_length4(q.value) );
+    }
+
+    vectorial_inline quatf normalize(const quatf& q) {
+        return quatf( simd4f_quat_normalize(q.value) );
+    }
+
+    vectorial_inline mat4f toMat4f(const quatf& q) {
+        mat4f ret;
+        simd4f_quat_to_simd4x4f(q.value, &ret.value);
+        return ret;
+    }
+
+
+    vectorial_inline quatf nlerp(const quatf& a, const quatf& b, float t) {
+        return quatf( simd4f_quat_nlerp(a.value, b.value, t) );
+    }
+
+    vectorial_inline quatf slerp(const quatf& a, const quatf& b, float t) {
+        return quatf( simd4f_quat_slerp(a.value, b.value, t) );
+    }
+
+    // Whole poses, see simd4f_quat.h. out may be the same array as a or b.
+
+    vectorial_inline void nlerp(const quatf* a, const quatf* b, float t, quatf* out, size_t n) {
+        simd4f_quat_nlerp_array((const simd4f*)a, (const simd4f*)b, t, (simd4f*)out, n);
+    }
+
+    vectorial_inline void slerp(const quatf* a, const quatf* b, float t, quatf* out, size_t n) {
+        simd4f_quat_slerp_array((const simd4f*)a, (const simd4f*)b, t, (simd4f*)out, n);
+    }
+
+}
+
+
+#ifdef VECTORIAL_OSTREAM
+#include <ostream>
+
+vectorial_inline std::ostream& operator<<(std::ostream& os, const vectorial::quatf& v) {
+    os << "[ " << v.x() << ", "
+               << v.y() << ", "
+               << v.z() << ", "
+               << v.w() << " ]";
+    return os;
+}
+#endif
+
+
+
+
+#endif
@@ -0,0 +1,116 @@
+/*
+  Vectorial
+  Copyright (c) 2010 Mikko Lehtonen
+  Licensed under the terms of the two-clause BSD License (see LICENSE)
+*/
+#ifndef VECTORIAL_RAY_SOA_H
+#define VECTORIAL_RAY_SOA_H
+
+#ifndef VECTORIAL_SIMD4F_RAY_H
+  #include "vectorial/simd4f_ray.h"
+#endif
+
+#ifndef VECTORIAL_VEC3F_SOA4_H
+  #include "vectorial/vec3f_soa4.h"
+#endif
+
+#ifndef VECTORIAL_VEC3F_SOA8_H
+  #include "vectorial/vec3f_soa8.h"
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+
+namespace vectorial {
+
+    // 4 or 8 rays, see simd4f_ray.h for the tests and their results
+
+    class ray_soa4 {
+    public:
+
+        simd4f_ray_packet value;
+
+        inline ray_soa4() {}
+        inline ray_soa4(const simd4f_ray_packet& v) : value(v) {}
+        inline ray_soa4(const vec3f_soa4& origin, const vec3f_soa4& direction) {
+            value.ox = origin.x; value.oy = origin.y; value.oz = origin.z;
+            value.dx = direction.x; value.dy = direction.y; value.dz = direction.z;
+            value.rx = _simd4f_ray_reciprocal(direction.x);
+            value.ry = _simd4f_ray_reciprocal(direction.y);
+            value.rz = _simd4f_ray_reciprocal(direction.z);
+        }
+
+        inline void load(const vec3f *origins, const vec3f *directions) {
+            simd4f_ray_packet_load((const float*)origins, (const float*)directions, 4, &value);
+        }
+
+        inline vec3f_soa4 origin() const { return vec3f_soa4(value.ox, value.oy, value.oz); }
+        inline vec3f_soa4 direction() const { return vec3f_soa4(value.dx, value.dy, value.dz); }
+
+        enum { width = 4 };
+
+    };
+
+    class ray_soa8 {
+    public:
+
+        simd8f_ray_packet value;
+
+        inline ray_soa8() {}
+        inline ray_soa8(const simd8f_ray_packet& v) : value(v) {}
+        inline ray_soa8(const vec3f_soa8& origin, const vec3f_soa8& direction) {
+            value.ox = origin.x; value.oy = origin.y; value.oz = origin.z;
+            value.dx = direction.x; value.dy = direction.y; value.dz = direction.z;
+            value.rx = _simd8f_ray_reciprocal(direction.x);
+            value.ry = _simd8f_ray_reciprocal(direction.y);
+            value.rz = _simd8f_ray_reciprocal(direction.z);
+        }
+
+        inline void load(const vec3f *origins, const vec3f *directions) {
+            simd8f_ray_packet_load((const float*)origins, (const float*)directions, 4, &value);
+        }
+
+        inline vec3f_soa8 origin() const { return vec3f_soa8(value.ox, value.oy, value.oz); }
+        inline vec3f_soa8 direction() const { return vec3f_soa8(value.dx, value.dy, value.dz); }
+
+        enum { width = 8 };
+
+    };
+
+
+    // Updates t in the lanes hitting closer than it
+
+    vectorial_inline simd4f_mask intersectTriangle(const ray_soa4& r, const vec3f& v0, const vec3f& v1, const vec3f& v2, simd4f& t) {
+        return simd4f_ray_triangle(&r.value, v0.value, v1.value, v2.value, &t);
+    }
+
+    vectorial_inline simd8f_mask intersectTriangle(const ray_soa8& r, const vec3f& v0, const vec3f& v1, const vec3f& v2, simd8f& t) {
+        return simd8f_ray_triangle(&r.value, v0.value, v1.value, v2.value, &t);
+    }
+
+    // Sets tnear in the lanes entering the box before tmax
+
+    vectorial_inline simd4f_mask intersectBox(const ray_soa4& r, const vec3f& aabbMin, const vec3f& aabbMax, simd4f tmax, simd4f& tnear) {
+        return simd4f_ray_aabb(&r.value, aabbMin.value, aabbMax.value, tmax, &tnear);
+    }
+
+    vectorial_inline simd8f_mask intersectBox(const ray_soa8& r, const vec3f& aabbMin, const vec3f& aabbMax, simd8f tmax, simd8f& tnear) {
+        return simd8f_ray_aabb(&r.value, aabbMin.value, aabbMax.value, tmax, &tnear);
+    }
+
+    // Closest of n triangles, 3 vertices each, index -1 for misses
+
+    vectorial_inline int intersectTriangles(const ray_soa4& r, const vec3f* vertices, size_t n, simd4f& t, int32_t* index) {
+        return simd4f_ray_triangles(&r.value, (const simd4f*)vertices, n, &t, index);
+    }
+
+    vectorial_inline int intersectTriangles(const ray_soa8& r, const vec3f* vertices, size_t n, simd8f& t, int32_t* index) {
+        return simd8f_ray_triangles(&r.value, (const simd4f*)vertices, n, &t, index);
+    }
+
+}
+
+
+
+#endif
@@ -0,0 +1,158 @@
+/*
+  Vectorial
+  Copyright (c) 2010 Mikko Lehtonen
+  Licensed under the terms of the two-clause BSD License (see LICENSE)
+*/
+#ifndef VECTORIAL_SIMD3X3F_H
+#define VECTORIAL_SIMD3X3F_H
+
+
+#ifndef VECTORIAL_SIMD4X4F_H
+  #include "vectorial/simd4x4f.h"
+#endif
+
+/*
+  Note, x,y,z are columns like with simd4x4f, w of each is kept 0.
+*/
+
+typedef struct {
+    simd4f x,y,z;
+} simd3x3f;
+
+
+vectorial_inline simd3x3f simd3x3f_create(simd4f x, simd4f y, simd4f z) {
+    simd3x3f s = { x, y, z };
+    return s;
+}
+
+vectorial_inline void simd3x3f_identity(simd3x3f* m) {
+    *m = simd3x3f_create( simd4f_create(1.0f, 0.0f, 0.0f, 0.0f),
+                          simd4f_create(0.0f, 1.0f, 0.0f, 0.0f),
+                          simd4f_create(0.0f, 0.0f, 1.0f, 0.0f) );
+}
+
+// 9 floats column by column
+vectorial_inline void simd3x3f_uload(simd3x3f* m, const float *f) {
+    m->x = simd4f_uload3(f + 0);
+    m->y = simd4f_uload3(f + 3);
+    m->z = simd4f_uload3(f + 6);
+}
+
+vectorial_inline void simd3x3f_ustore(const simd3x3f* m, float *f) {
+    simd4f_ustore3(m->x, f + 0);
+    simd4f_ustore3(m->y, f + 3);
+    simd4f_ustore3(m->z, f + 6);
+}
+
+
+// Upper left 3x3 of a
+vectorial_inline void simd3x3f_from_simd4x4f(const simd4x4f* a, simd3x3f* out) {
+    *out = simd3x3f_create( simd4f_zero_w(a->x), simd4f_zero_w(a->y), simd4f_zero_w(a->z) );
+}
+
+vectorial_inline void simd3x3f_to_simd4x4f(const simd3x3f* a, simd4x4f* out) {
+    *out = simd4x4f_create( a->x, a->y, a->z, simd4f_create(0.0f, 0.0f, 0.0f, 1.0f) );
+}
+
+
+vectorial_inline void simd3x3f_transpose(const simd3x3f* a, simd3x3f* out) {
+    simd4x4f t = simd4x4f_create( a->x, a->y, a->z, simd4f_zero() );
+    simd4x4f_transpose_inplace(&t);
+    *out = simd3x3f_create(t.x, t.y, t.z);
+}
+
+
+vectorial_inline void simd3x3f_matrix_vector_mul(const simd3x3f* a, const simd4f * b, simd4f* out) {
+    const simd4f v = *b;
+    *out = simd4f_madd( a->x, simd4f_splat_x(v),
+             simd4f_madd( a->y, simd4f_splat_y(v),
+               simd4f_mul( a->z, simd4f_splat_z(v) ) ) );
+}
+
+vectorial_inline void simd3x3f_matrix_mul(const simd3x3f* a, const simd3x3f* b, simd3x3f* out) {
+    simd4f x, y, z;
+    simd3x3f_matrix_vector_mul(a, &b->x, &x);
+    simd3x3f_matrix_vector_mul(a, &b->y, &y);
+    simd3x3f_matrix_vector_mul(a, &b->z, &z);
+    *out = simd3x3f_create(x, y, z);
+}
+
+vectorial_inline void simd3x3f_add(const simd3x3f* a, const simd3x3f* b, simd3x3f* out) {
+    *out = simd3x3f_create( simd4f_add(a->x, b->x), simd4f_add(a->y, b->y), simd4f_add(a->z, b->z) );
+}
+
+vectorial_inline void simd3x3f_sub(const simd3x3f* a, const simd3x3f* b, simd3x3f* out) {
+    *out = simd3x3f_create( simd4f_sub(a->x, b->x), simd4f_sub(a->y, b->y), simd4f_sub(a->z, b->z) );
+}
+
+vectorial_inline void simd3x3f_mul(const simd3x3f* a, simd4f s, simd3x3f* out) {
+    *out = simd3x3f_create( simd4f_mul(a->x, s), simd4f_mul(a->y, s), simd4f_mul(a->z, s) );
+}
+
+
+// Determinant in all lanes
+vectorial_inline simd4f simd3x3f_determinant(const simd3x3f* a) {
+    return simd4f_dot3( a->x, simd4f_cross3(a->y, a->z) );
+}
+
+// Cross products of the columns are the rows of the inverse times the
+// determinant, so the inverse transpose needs no transpose at all
+
+vectorial_inline simd4f simd3x3f_inverse_transpose(const simd3x3f* a, simd3x3f* out) {
+    const simd4f cx = simd4f_cross3(a->y, a->z);
+    const simd4f cy = simd4f_cross3(a->z, a->x);
+    const simd4f cz = simd4f_cross3(a->x, a->y);
+
+    const simd4f det = simd4f_dot3(a->x, cx);
+    const simd4f invdet = simd4f_div( simd4f_splat(1.0f), det );
+
+    *out = simd3x3f_create( simd4f_mul(cx, invdet), simd4f_mul(cy, invdet), simd4f_mul(cz, invdet) );
+    return det;
+}
+
+// Returns the determinant in all lanes
+vectorial_inline simd4f simd3x3f_inverse(const simd3x3f* a, simd3x3f* out) {
+    simd3x3f t;
+    const simd4f det = simd3x3f_inverse_transpose(a, &t);
+    simd3x3f_transpose(&t, out);
+    return det;
+}
+
+// Transforms normals by the upper 3x3 of a, inverse transpose without
+// going through simd4x4f_inverse
+vectorial_inline void simd3x3f_normal_matrix(const simd4x4f* a, simd3x3f* out) {
+    simd3x3f m;
+    simd3x3f_from_simd4x4f(a, &m);
+    simd3x3f_inverse_transpose(&m, out);
+}
+
+
+
+#ifdef __cplusplus
+
+    #ifdef VECTORIAL_OSTREAM
+        #include <ostream>
+
+        vectorial_inline std::ostream& operator<<(std::ostream& os, const simd3x3f& v) {
+            os << "simd3x3f(simd4f(" << simd4f_get_x(v.x) << ", "
+                       << simd4f_get_y(v.x) << ", "
+                       << simd4f_get_z(v.x) << ", "
+                       << simd4f_get_w(v.x) << "),\n"
+                       << "         simd4f(" << simd4f_get_x(v.y) << ", "
+                       << simd4f_get_y(v.y) << ", "
+                       << simd4f_get_z(v.y) << ", "
+                       << simd4f_get_w(v.y) << "),\n"
+                       << "         simd4f(" << simd4f_get_x(v.z) << ", "
+                       << simd4f_get_y(v.z) << ", "
+                       << simd4f_get_z(v.z) << ", "
+                       << simd4f_get_w(v.z) << "))";
+            return os;
+        }
+    #endif
+
+#endif
+
+
+
+
+#endif
@@ -0,0 +1,66 @@
+/*
+  Vectorial
+  Copyright (c) 2010 Mikko Lehtonen
+  Licensed under the terms of the two-clause BSD License (see LICENSE)
+*/
+
+#ifndef VECTORIAL_SIMD4D_H
+#define VECTORIAL_SIMD4D_H
+
+#ifndef VECTORIAL_CONFIG_H
+  #include "vectorial/config.h"
+#endif
+
+#ifndef VECTORIAL_SIMD4F_H
+  #include "vectorial/simd4f.h"
+#endif
+
+/*
+  simd4d is the double precision simd4f, for coordinates that need more
+  than the 24 bits of a float, like positions in a planet sized world.
+  The functions are those of simd4f with d for f, except that reciprocal
+  and rsqrt are full precision divisions.
+
+  simd4d_to_simd4f and simd4f_to_simd4d convert the four lanes, usually
+  after subtracting a nearby origin so the floats keep their precision.
+*/
+
+#ifdef VECTORIAL_SIMD4D_SCALAR
+    #include "simd4d_scalar.h"
+#elif defined(VECTORIAL_SIMD4D_AVX)
+    #include "simd4d_avx.h"
+#elif defined(VECTORIAL_SIMD4D_SSE)
+    #include "simd4d_sse.h"
+#elif defined(VECTORIAL_SIMD4D_GNU)
+    #include "simd4d_gnu.h"
+#elif defined(VECTORIAL_SIMD4D_NEON)
+    #include "simd4d_neon.h"
+#else
+    #error No implementation defined
+#endif
+
+#include "simd4d_common.h"
+
+
+
+#ifdef __cplusplus
+
+    #ifdef VECTORIAL_OSTREAM
+        #include <ostream>
+
+        vectorial_inline std::ostream& operator<<(std::ostream& os, const simd4d& v) {
+            os << "simd4d(" << simd4d_get_x(v) << ", "
+                       << simd4d_get_y(v) << ", "
+                       << simd4d_get_z(v) << ", "
+                       << simd4d_get_w(v) << ")";
+            return os;
+        }
+    #endif
+
+#endif
+
+
+
+
+#endif
+
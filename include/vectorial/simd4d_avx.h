@@ -0,0 +1,190 @@
+/*
+  Vectorial
+  Copyright (c) 2010 Mikko Lehtonen
+  Licensed under the terms of the two-clause BSD License (see LICENSE)
+*/
+#ifndef VECTORIAL_SIMD4D_AVX_H
+#define VECTORIAL_SIMD4D_AVX_H
+
+#include <immintrin.h>
+#include <string.h>  // memcpy
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+typedef __m256d simd4d;
+
+typedef union {
+    simd4d s ;
+    double d[4];
+} _simd4d_union;
+
+// creating
+
+vectorial_inline simd4d simd4d_create(double x, double y, double z, double w) {
+    simd4d s = _mm256_setr_pd(x, y, z, w);
+    return s;
+}
+
+vectorial_inline simd4d simd4d_zero() { return _mm256_setzero_pd(); }
+
+vectorial_inline simd4d simd4d_uload4(const double *ary) {
+    simd4d s = _mm256_loadu_pd(ary);
+    return s;
+}
+
+vectorial_inline simd4d simd4d_uload3(const double *ary) {
+    simd4d s = _mm256_insertf128_pd( _mm256_castpd128_pd256(_mm_loadu_pd(ary)), _mm_load_sd(ary + 2), 1 );
+    return s;
+}
+
+vectorial_inline simd4d simd4d_uload2(const double *ary) {
+    simd4d s = _mm256_insertf128_pd( _mm256_setzero_pd(), _mm_loadu_pd(ary), 0 );
+    return s;
+}
+
+
+vectorial_inline void simd4d_ustore4(const simd4d val, double *ary) {
+    _mm256_storeu_pd(ary, val);
+}
+
+vectorial_inline void simd4d_ustore3(const simd4d val, double *ary) {
+    _mm_storeu_pd(ary, _mm256_castpd256_pd128(val));
+    _mm_store_sd(ary + 2, _mm256_extractf128_pd(val, 1));
+}
+
+vectorial_inline void simd4d_ustore2(const simd4d val, double *ary) {
+    _mm_storeu_pd(ary, _mm256_castpd256_pd128(val));
+}
+
+
+// utilities
+
+vectorial_inline simd4d simd4d_splat(double v) {
+    simd4d s = _mm256_set1_pd(v);
+    return s;
+}
+
+vectorial_inline simd4d simd4d_splat_x(simd4d v) {
+    return _mm256_permute_pd( _mm256_permute2f128_pd(v, v, 0x00), 0x0 );
+}
+
+vectorial_inline simd4d simd4d_splat_y(simd4d v) {
+    return _mm256_permute_pd( _mm256_permute2f128_pd(v, v, 0x00), 0xf );
+}
+
+vectorial_inline simd4d simd4d_splat_z(simd4d v) {
+    return _mm256_permute_pd( _mm256_permute2f128_pd(v, v, 0x11), 0x0 );
+}
+
+vectorial_inline simd4d simd4d_splat_w(simd4d v) {
+    return _mm256_permute_pd( _mm256_permute2f128_pd(v, v, 0x11), 0xf );
+}
+
+
+// arithmetic
+
+vectorial_inline simd4d simd4d_add(simd4d lhs, simd4d rhs) {
+    simd4d ret = _mm256_add_pd(lhs, rhs);
+    return ret;
+}
+
+vectorial_inline simd4d simd4d_sub(simd4d lhs, simd4d rhs) {
+    simd4d ret = _mm256_sub_pd(lhs, rhs);
+    return ret;
+}
+
+vectorial_inline simd4d simd4d_mul(simd4d lhs, simd4d rhs) {
+    simd4d ret = _mm256_mul_pd(lhs, rhs);
+    return ret;
+}
+
+vectorial_inline simd4d simd4d_div(simd4d lhs, simd4d rhs) {
+    simd4d ret = _mm256_div_pd(lhs, rhs);
+    return ret;
+}
+
+vectorial_inline simd4d simd4d_madd(simd4d m1, simd4d m2, simd4d a) {
+#if defined(VECTORIAL_HAVE_FMA)
+    return _mm256_fmadd_pd(m1, m2, a);
+#else
+    return simd4d_add( simd4d_mul(m1, m2), a );
+#endif
+}
+
+vectorial_inline simd4d simd4d_reciprocal(simd4d v) {
+    return _mm256_div_pd( _mm256_set1_pd(1.0), v );
+}
+
+vectorial_inline simd4d simd4d_sqrt(simd4d v) {
+    simd4d s = _mm256_sqrt_pd(v);
+    return s;
+}
+
+vectorial_inline simd4d simd4d_rsqrt(simd4d v) {
+    return _mm256_div_pd( _mm256_set1_pd(1.0), _mm256_sqrt_pd(v) );
+}
+
+vectorial_inline double simd4d_get_x(simd4d s) { return _mm_cvtsd_f64( _mm256_castpd256_pd128(s) ); }
+vectorial_inline double simd4d_get_y(simd4d s) { const __m128d l = _mm256_castpd256_pd128(s); return _mm_cvtsd_f64( _mm_unpackhi_pd(l, l) ); }
+vectorial_inline double simd4d_get_z(simd4d s) { return _mm_cvtsd_f64( _mm256_extractf128_pd(s, 1) ); }
+vectorial_inline double simd4d_get_w(simd4d s) { const __m128d h = _mm256_extractf128_pd(s, 1); return _mm_cvtsd_f64( _mm_unpackhi_pd(h, h) ); }
+
+vectorial_inline simd4d simd4d_dot3(simd4d lhs, simd4d rhs) {
+    const simd4d m = _mm256_mul_pd(lhs, rhs);
+    const __m128d xy = _mm256_castpd256_pd128(m);
+    const __m128d zw = _mm256_extractf128_pd(m, 1);
+    const __m128d s = _mm_add_pd( _mm_add_pd(xy, _mm_shuffle_pd(xy, xy, 1)), _mm_unpacklo_pd(zw, zw) );
+    return _mm256_insertf128_pd( _mm256_castpd128_pd256(s), s, 1 );
+}
+
+vectorial_inline simd4d simd4d_cross3(simd4d lhs, simd4d rhs) {
+    // zwxy, then yzxw from two in-lane shuffles and zxyw from one
+    const simd4d lt = _mm256_permute2f128_pd(lhs, lhs, 0x01);
+    const simd4d rt = _mm256_permute2f128_pd(rhs, rhs, 0x01);
+
+    const simd4d lyzx = _mm256_blend_pd( _mm256_shuffle_pd(lhs, lt, 0x1), _mm256_shuffle_pd(lt, lhs, 0x8), 0xc );
+    const simd4d ryzx = _mm256_blend_pd( _mm256_shuffle_pd(rhs, rt, 0x1), _mm256_shuffle_pd(rt, rhs, 0x8), 0xc );
+    const simd4d lzxy = _mm256_shuffle_pd(lt, lhs, 0xc);
+    const simd4d rzxy = _mm256_shuffle_pd(rt, rhs, 0xc);
+
+    return _mm256_sub_pd( _mm256_mul_pd(lyzx, rzxy), _mm256_mul_pd(lzxy, ryzx) );
+}
+
+vectorial_inline simd4d simd4d_zero_w(simd4d s) {
+    return _mm256_blend_pd( s, _mm256_setzero_pd(), 0x8 );
+}
+
+vectorial_inline simd4d simd4d_zero_zw(simd4d s) {
+    return _mm256_blend_pd( s, _mm256_setzero_pd(), 0xc );
+}
+
+vectorial_inline simd4d simd4d_min(simd4d a, simd4d b) {
+    return _mm256_min_pd( a, b );
+}
+
+vectorial_inline simd4d simd4d_max(simd4d a, simd4d b) {
+    return _mm256_max_pd( a, b );
+}
+
+
+// conversions
+
+vectorial_inline simd4f simd4d_to_simd4f(simd4d v) {
+    return _mm256_cvtpd_ps( v );
+}
+
+vectorial_inline simd4d simd4f_to_simd4d(simd4f v) {
+    return _mm256_cvtps_pd( v );
+}
+
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif
@@ -0,0 +1,81 @@
+/*
+  Vectorial
+  Copyright (c) 2010 Mikko Lehtonen
+  Licensed under the terms of the two-clause BSD License (see LICENSE)
+*/
+#ifndef VECTORIAL_SIMD4D_COMMON_H
+#define VECTORIAL_SIMD4D_COMMON_H
+
+#include <stddef.h>
+
+
+vectorial_inline simd4d simd4d_sum(simd4d v) {
+    const simd4d s1 = simd4d_add(simd4d_splat_x(v), simd4d_splat_y(v));
+    const simd4d s2 = simd4d_add(s1, simd4d_splat_z(v));
+    const simd4d s3 = simd4d_add(s2, simd4d_splat_w(v));
+    return s3;
+}
+
+vectorial_inline simd4d simd4d_dot4(simd4d lhs, simd4d rhs) {
+    return simd4d_sum( simd4d_mul(lhs, rhs) );
+}
+
+vectorial_inline simd4d simd4d_dot2(simd4d lhs, simd4d rhs) {
+    const simd4d m = simd4d_mul(lhs, rhs);
+    const simd4d s1 = simd4d_add(simd4d_splat_x(m), simd4d_splat_y(m));
+    return s1;
+}
+
+vectorial_inline double simd4d_dot3_scalar(simd4d lhs, simd4d rhs) {
+    return simd4d_get_x( simd4d_dot3(lhs, rhs) );
+}
+
+
+vectorial_inline simd4d simd4d_length4(simd4d v) {
+    return simd4d_sqrt( simd4d_dot4(v,v) );
+}
+
+vectorial_inline simd4d simd4d_length3(simd4d v) {
+    return simd4d_sqrt( simd4d_dot3(v,v) );
+}
+
+vectorial_inline simd4d simd4d_length2(simd4d v) {
+    return simd4d_sqrt( simd4d_dot2(v,v) );
+}
+
+vectorial_inline simd4d simd4d_length4_squared(simd4d v) {
+    return simd4d_dot4(v,v);
+}
+
+vectorial_inline simd4d simd4d_length3_squared(simd4d v) {
+    return simd4d_dot3(v,v);
+}
+
+vectorial_inline simd4d simd4d_length2_squared(simd4d v) {
+    return simd4d_dot2(v,v);
+}
+
+
+vectorial_inline simd4d simd4d_normalize4(simd4d a) {
+    return simd4d_div(a, simd4d_length4(a));
+}
+
+vectorial_inline simd4d simd4d_normalize3(simd4d a) {
+    return simd4d_div(a, simd4d_length3(a));
+}
+
+vectorial_inline simd4d simd4d_normalize2(simd4d a) {
+    return simd4d_div(a, simd4d_length2(a));
+}
+
+
+// Subtracts origin from each point and stores it as floats, the bulk step
+// of camera-relative rendering. in and out may not overlap.
+vectorial_inline void simd4d_relative_to_simd4f_array(const simd4d* in, simd4d origin, simd4f* out, size_t n) {
+    for(size_t i = 0; i < n; ++i) {
+        out[i] = simd4d_to_simd4f( simd4d_sub(in[i], origin) );
+    }
+}
+
+
+#endif
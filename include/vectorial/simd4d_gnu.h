@@ -0,0 +1,204 @@
+/*
+  Vectorial
+  Copyright (c) 2010 Mikko Lehtonen
+  Licensed under the terms of the two-clause BSD License (see LICENSE)
+*/
+#ifndef VECTORIAL_SIMD4D_GNU_H
+#define VECTORIAL_SIMD4D_GNU_H
+
+#include <math.h>
+#include <string.h>  // memcpy
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+#ifdef __AVX__
+typedef double simd4d __attribute__ ((vector_size (32)));
+#else
+// Without AVX a 32 byte vector changes the calling convention (gcc
+// -Wpsabi), so two 16 byte ones, x and y in the first and z and w in the
+// second
+typedef double _simd4d_half __attribute__ ((vector_size (16)));
+typedef struct {
+    _simd4d_half xy;
+    _simd4d_half zw;
+} simd4d;
+#endif
+
+typedef union {
+    simd4d s ;
+    double d[4];
+} _simd4d_union;
+
+
+vectorial_inline double simd4d_get_x(simd4d s) { _simd4d_union u={s}; return u.d[0]; }
+vectorial_inline double simd4d_get_y(simd4d s) { _simd4d_union u={s}; return u.d[1]; }
+vectorial_inline double simd4d_get_z(simd4d s) { _simd4d_union u={s}; return u.d[2]; }
+vectorial_inline double simd4d_get_w(simd4d s) { _simd4d_union u={s}; return u.d[3]; }
+
+
+vectorial_inline simd4d simd4d_create(double x, double y, double z, double w) {
+#ifdef __AVX__
+    simd4d s = { x, y, z, w };
+#else
+    simd4d s = { { x, y }, { z, w } };
+#endif
+    return s;
+}
+
+vectorial_inline simd4d simd4d_zero() { return simd4d_create(0.0, 0.0, 0.0, 0.0); }
+
+vectorial_inline simd4d simd4d_uload4(const double *ary) {
+    simd4d s;
+    memcpy(&s, ary, sizeof(double) * 4);
+    return s;
+}
+
+vectorial_inline simd4d simd4d_uload3(const double *ary) {
+    return simd4d_create( ary[0], ary[1], ary[2], 0 );
+}
+
+vectorial_inline simd4d simd4d_uload2(const double *ary) {
+    return simd4d_create( ary[0], ary[1], 0, 0 );
+}
+
+
+vectorial_inline void simd4d_ustore4(const simd4d val, double *ary) {
+    memcpy(ary, &val, sizeof(double) * 4);
+}
+
+vectorial_inline void simd4d_ustore3(const simd4d val, double *ary) {
+    memcpy(ary, &val, sizeof(double) * 3);
+}
+
+vectorial_inline void simd4d_ustore2(const simd4d val, double *ary) {
+    memcpy(ary, &val, sizeof(double) * 2);
+}
+
+
+vectorial_inline simd4d simd4d_splat(double v) {
+    return simd4d_create( v, v, v, v );
+}
+
+vectorial_inline simd4d simd4d_splat_x(simd4d v) { return simd4d_splat( simd4d_get_x(v) ); }
+vectorial_inline simd4d simd4d_splat_y(simd4d v) { return simd4d_splat( simd4d_get_y(v) ); }
+vectorial_inline simd4d simd4d_splat_z(simd4d v) { return simd4d_splat( simd4d_get_z(v) ); }
+vectorial_inline simd4d simd4d_splat_w(simd4d v) { return simd4d_splat( simd4d_get_w(v) ); }
+
+
+vectorial_inline simd4d simd4d_add(simd4d lhs, simd4d rhs) {
+#ifdef __AVX__
+    simd4d ret = lhs + rhs;
+#else
+    simd4d ret = { lhs.xy + rhs.xy, lhs.zw + rhs.zw };
+#endif
+    return ret;
+}
+
+vectorial_inline simd4d simd4d_sub(simd4d lhs, simd4d rhs) {
+#ifdef __AVX__
+    simd4d ret = lhs - rhs;
+#else
+    simd4d ret = { lhs.xy - rhs.xy, lhs.zw - rhs.zw };
+#endif
+    return ret;
+}
+
+vectorial_inline simd4d simd4d_mul(simd4d lhs, simd4d rhs) {
+#ifdef __AVX__
+    simd4d ret = lhs * rhs;
+#else
+    simd4d ret = { lhs.xy * rhs.xy, lhs.zw * rhs.zw };
+#endif
+    return ret;
+}
+
+vectorial_inline simd4d simd4d_div(simd4d lhs, simd4d rhs) {
+#ifdef __AVX__
+    simd4d ret = lhs / rhs;
+#else
+    simd4d ret = { lhs.xy / rhs.xy, lhs.zw / rhs.zw };
+#endif
+    return ret;
+}
+
+vectorial_inline simd4d simd4d_madd(simd4d m1, simd4d m2, simd4d a) {
+    return simd4d_add( simd4d_mul(m1, m2), a );
+}
+
+vectorial_inline simd4d simd4d_reciprocal(simd4d v) {
+    return simd4d_div( simd4d_splat(1.0), v );
+}
+
+vectorial_inline simd4d simd4d_sqrt(simd4d v) {
+    _simd4d_union u = {v};
+    return simd4d_create( sqrt(u.d[0]), sqrt(u.d[1]), sqrt(u.d[2]), sqrt(u.d[3]) );
+}
+
+vectorial_inline simd4d simd4d_rsqrt(simd4d v) {
+    return simd4d_div( simd4d_splat(1.0), simd4d_sqrt(v) );
+}
+
+vectorial_inline simd4d simd4d_dot3(simd4d lhs, simd4d rhs) {
+    _simd4d_union u = { simd4d_mul(lhs, rhs) };
+    return simd4d_splat( u.d[0] + u.d[1] + u.d[2] );
+}
+
+vectorial_inline simd4d simd4d_cross3(simd4d lhs, simd4d rhs) {
+    _simd4d_union l = {lhs}, r = {rhs};
+    return simd4d_create( l.d[1] * r.d[2] - l.d[2] * r.d[1],
+                          l.d[2] * r.d[0] - l.d[0] * r.d[2],
+                          l.d[0] * r.d[1] - l.d[1] * r.d[0],
+                          0 );
+}
+
+vectorial_inline simd4d simd4d_zero_w(simd4d s) {
+    _simd4d_union u = {s};
+    u.d[3] = 0.0;
+    return u.s;
+}
+
+vectorial_inline simd4d simd4d_zero_zw(simd4d s) {
+    _simd4d_union u = {s};
+    u.d[2] = 0.0;
+    u.d[3] = 0.0;
+    return u.s;
+}
+
+vectorial_inline simd4d simd4d_min(simd4d a, simd4d b) {
+    _simd4d_union ua = {a}, ub = {b};
+    return simd4d_create( ua.d[0] < ub.d[0] ? ua.d[0] : ub.d[0],
+                          ua.d[1] < ub.d[1] ? ua.d[1] : ub.d[1],
+                          ua.d[2] < ub.d[2] ? ua.d[2] : ub.d[2],
+                          ua.d[3] < ub.d[3] ? ua.d[3] : ub.d[3] );
+}
+
+vectorial_inline simd4d simd4d_max(simd4d a, simd4d b) {
+    _simd4d_union ua = {a}, ub = {b};
+    return simd4d_create( ua.d[0] > ub.d[0] ? ua.d[0] : ub.d[0],
+                          ua.d[1] > ub.d[1] ? ua.d[1] : ub.d[1],
+                          ua.d[2] > ub.d[2] ? ua.d[2] : ub.d[2],
+                          ua.d[3] > ub.d[3] ? ua.d[3] : ub.d[3] );
+}
+
+
+vectorial_inline simd4f simd4d_to_simd4f(simd4d v) {
+    _simd4d_union u = {v};
+    return simd4f_create( (float)u.d[0], (float)u.d[1], (float)u.d[2], (float)u.d[3] );
+}
+
+vectorial_inline simd4d simd4f_to_simd4d(simd4f v) {
+    return simd4d_create( simd4f_get_x(v), simd4f_get_y(v), simd4f_get_z(v), simd4f_get_w(v) );
+}
+
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif
@@ -0,0 +1,181 @@
+/*
+  Vectorial
+  Copyright (c) 2010 Mikko Lehtonen
+  Licensed under the terms of the two-clause BSD License (see LICENSE)
+*/
+#ifndef VECTORIAL_SIMD4D_NEON_H
+#define VECTORIAL_SIMD4D_NEON_H
+
+#include <arm_neon.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+// Two AArch64 registers, x and y in the first and z and w in the second
+typedef struct {
+    float64x2_t xy;
+    float64x2_t zw;
+} simd4d;
+
+
+vectorial_inline simd4d _simd4d_pair(float64x2_t xy, float64x2_t zw) {
+    simd4d s = { xy, zw };
+    return s;
+}
+
+
+vectorial_inline simd4d simd4d_create(double x, double y, double z, double w) {
+    const float64_t d[4] = { x,y,z,w };
+    return _simd4d_pair( vld1q_f64(d), vld1q_f64(d + 2) );
+}
+
+vectorial_inline simd4d simd4d_zero() { return _simd4d_pair( vdupq_n_f64(0.0), vdupq_n_f64(0.0) ); }
+
+vectorial_inline simd4d simd4d_uload4(const double *ary) {
+    return _simd4d_pair( vld1q_f64(ary), vld1q_f64(ary + 2) );
+}
+
+vectorial_inline simd4d simd4d_uload3(const double *ary) {
+    return _simd4d_pair( vld1q_f64(ary), vsetq_lane_f64(ary[2], vdupq_n_f64(0.0), 0) );
+}
+
+vectorial_inline simd4d simd4d_uload2(const double *ary) {
+    return _simd4d_pair( vld1q_f64(ary), vdupq_n_f64(0.0) );
+}
+
+
+vectorial_inline void simd4d_ustore4(const simd4d val, double *ary) {
+    vst1q_f64(ary, val.xy);
+    vst1q_f64(ary + 2, val.zw);
+}
+
+vectorial_inline void simd4d_ustore3(const simd4d val, double *ary) {
+    vst1q_f64(ary, val.xy);
+    vst1q_lane_f64(ary + 2, val.zw, 0);
+}
+
+vectorial_inline void simd4d_ustore2(const simd4d val, double *ary) {
+    vst1q_f64(ary, val.xy);
+}
+
+
+vectorial_inline simd4d simd4d_splat(double v) {
+    const float64x2_t s = vdupq_n_f64(v);
+    return _simd4d_pair( s, s );
+}
+
+vectorial_inline simd4d simd4d_splat_x(simd4d v) {
+    const float64x2_t s = vdupq_laneq_f64(v.xy, 0);
+    return _simd4d_pair( s, s );
+}
+
+vectorial_inline simd4d simd4d_splat_y(simd4d v) {
+    const float64x2_t s = vdupq_laneq_f64(v.xy, 1);
+    return _simd4d_pair( s, s );
+}
+
+vectorial_inline simd4d simd4d_splat_z(simd4d v) {
+    const float64x2_t s = vdupq_laneq_f64(v.zw, 0);
+    return _simd4d_pair( s, s );
+}
+
+vectorial_inline simd4d simd4d_splat_w(simd4d v) {
+    const float64x2_t s = vdupq_laneq_f64(v.zw, 1);
+    return _simd4d_pair( s, s );
+}
+
+
+vectorial_inline simd4d simd4d_add(simd4d lhs, simd4d rhs) {
+    return _simd4d_pair( vaddq_f64(lhs.xy, rhs.xy), vaddq_f64(lhs.zw, rhs.zw) );
+}
+
+vectorial_inline simd4d simd4d_sub(simd4d lhs, simd4d rhs) {
+    return _simd4d_pair( vsubq_f64(lhs.xy, rhs.xy), vsubq_f64(lhs.zw, rhs.zw) );
+}
+
+vectorial_inline simd4d simd4d_mul(simd4d lhs, simd4d rhs) {
+    return _simd4d_pair( vmulq_f64(lhs.xy, rhs.xy), vmulq_f64(lhs.zw, rhs.zw) );
+}
+
+vectorial_inline simd4d simd4d_div(simd4d lhs, simd4d rhs) {
+    return _simd4d_pair( vdivq_f64(lhs.xy, rhs.xy), vdivq_f64(lhs.zw, rhs.zw) );
+}
+
+vectorial_inline simd4d simd4d_madd(simd4d m1, simd4d m2, simd4d a) {
+    return _simd4d_pair( vfmaq_f64(a.xy, m1.xy, m2.xy), vfmaq_f64(a.zw, m1.zw, m2.zw) );
+}
+
+vectorial_inline simd4d simd4d_reciprocal(simd4d v) {
+    return simd4d_div( simd4d_splat(1.0), v );
+}
+
+vectorial_inline simd4d simd4d_sqrt(simd4d v) {
+    return _simd4d_pair( vsqrtq_f64(v.xy), vsqrtq_f64(v.zw) );
+}
+
+vectorial_inline simd4d simd4d_rsqrt(simd4d v) {
+    return simd4d_div( simd4d_splat(1.0), simd4d_sqrt(v) );
+}
+
+vectorial_inline double simd4d_get_x(simd4d s) { return vgetq_lane_f64(s.xy, 0); }
+vectorial_inline double simd4d_get_y(simd4d s) { return vgetq_lane_f64(s.xy, 1); }
+vectorial_inline double simd4d_get_z(simd4d s) { return vgetq_lane_f64(s.zw, 0); }
+vectorial_inline double simd4d_get_w(simd4d s) { return vgetq_lane_f64(s.zw, 1); }
+
+vectorial_inline simd4d simd4d_dot3(simd4d lhs, simd4d rhs) {
+    const float64x2_t xy = vmulq_f64(lhs.xy, rhs.xy);
+    const double d = vpaddd_f64(xy) + vgetq_lane_f64(lhs.zw, 0) * vgetq_lane_f64(rhs.zw, 0);
+    return simd4d_splat(d);
+}
+
+vectorial_inline simd4d simd4d_cross3(simd4d lhs, simd4d rhs) {
+    // yzxw and zxyw of both sides
+    const float64x2_t lyz = vextq_f64(lhs.xy, lhs.zw, 1);
+    const float64x2_t lxw = vcopyq_laneq_f64(lhs.zw, 0, lhs.xy, 0);
+    const float64x2_t lzx = vzip1q_f64(lhs.zw, lhs.xy);
+    const float64x2_t lyw = vzip2q_f64(lhs.xy, lhs.zw);
+
+    const float64x2_t ryz = vextq_f64(rhs.xy, rhs.zw, 1);
+    const float64x2_t rxw = vcopyq_laneq_f64(rhs.zw, 0, rhs.xy, 0);
+    const float64x2_t rzx = vzip1q_f64(rhs.zw, rhs.xy);
+    const float64x2_t ryw = vzip2q_f64(rhs.xy, rhs.zw);
+
+    return _simd4d_pair( vsubq_f64( vmulq_f64(lyz, rzx), vmulq_f64(lzx, ryz) ),
+                         vsubq_f64( vmulq_f64(lxw, ryw), vmulq_f64(lyw, rxw) ) );
+}
+
+vectorial_inline simd4d simd4d_zero_w(simd4d s) {
+    return _simd4d_pair( s.xy, vsetq_lane_f64(0.0, s.zw, 1) );
+}
+
+vectorial_inline simd4d simd4d_zero_zw(simd4d s) {
+    return _simd4d_pair( s.xy, vdupq_n_f64(0.0) );
+}
+
+vectorial_inline simd4d simd4d_min(simd4d a, simd4d b) {
+    return _simd4d_pair( vminq_f64(a.xy, b.xy), vminq_f64(a.zw, b.zw) );
+}
+
+vectorial_inline simd4d simd4d_max(simd4d a, simd4d b) {
+    return _simd4d_pair( vmaxq_f64(a.xy, b.xy), vmaxq_f64(a.zw, b.zw) );
+}
+
+
+vectorial_inline simd4f simd4d_to_simd4f(simd4d v) {
+    return vcombine_f32( vcvt_f32_f64(v.xy), vcvt_f32_f64(v.zw) );
+}
+
+vectorial_inline simd4d simd4f_to_simd4d(simd4f v) {
+    return _simd4d_pair( vcvt_f64_f32( vget_low_f32(v) ), vcvt_high_f64_f32(v) );
+}
+
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif
@@ -0,0 +1,173 @@
+/*
+  Vectorial
+  Copyright (c) 2010 Mikko Lehtonen
+  Licensed under the terms of the two-clause BSD License (see LICENSE)
+*/
+#ifndef VECTORIAL_SIMD4D_SCALAR_H
+#define VECTORIAL_SIMD4D_SCALAR_H
+
+#include <math.h>
+#include <string.h>  // memcpy
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+typedef struct {
+    double x;
+    double y;
+    double z;
+    double w;
+} simd4d;
+
+
+
+vectorial_inline simd4d simd4d_create(double x, double y, double z, double w) {
+    simd4d s = { x, y, z, w };
+    return s;
+}
+
+vectorial_inline simd4d simd4d_zero() { return simd4d_create(0.0, 0.0, 0.0, 0.0); }
+
+vectorial_inline simd4d simd4d_uload4(const double *ary) {
+    simd4d s = { ary[0], ary[1], ary[2], ary[3] };
+    return s;
+}
+
+vectorial_inline simd4d simd4d_uload3(const double *ary) {
+    simd4d s = { ary[0], ary[1], ary[2], 0 };
+    return s;
+}
+
+vectorial_inline simd4d simd4d_uload2(const double *ary) {
+    simd4d s = { ary[0], ary[1], 0, 0 };
+    return s;
+}
+
+
+vectorial_inline void simd4d_ustore4(const simd4d val, double *ary) {
+    memcpy(ary, &val, sizeof(double) * 4);
+}
+
+vectorial_inline void simd4d_ustore3(const simd4d val, double *ary) {
+    memcpy(ary, &val, sizeof(double) * 3);
+}
+
+vectorial_inline void simd4d_ustore2(const simd4d val, double *ary) {
+    memcpy(ary, &val, sizeof(double) * 2);
+}
+
+
+vectorial_inline simd4d simd4d_splat(double v) {
+    simd4d s = { v, v, v, v };
+    return s;
+}
+
+vectorial_inline simd4d simd4d_splat_x(simd4d v) { return simd4d_splat(v.x); }
+vectorial_inline simd4d simd4d_splat_y(simd4d v) { return simd4d_splat(v.y); }
+vectorial_inline simd4d simd4d_splat_z(simd4d v) { return simd4d_splat(v.z); }
+vectorial_inline simd4d simd4d_splat_w(simd4d v) { return simd4d_splat(v.w); }
+
+
+vectorial_inline simd4d simd4d_add(simd4d lhs, simd4d rhs) {
+    simd4d ret = { lhs.x + rhs.x, lhs.y + rhs.y, lhs.z + rhs.z, lhs.w + rhs.w };
+    return ret;
+}
+
+vectorial_inline simd4d simd4d_sub(simd4d lhs, simd4d rhs) {
+    simd4d ret = { lhs.x - rhs.x, lhs.y - rhs.y, lhs.z - rhs.z, lhs.w - rhs.w };
+    return ret;
+}
+
+vectorial_inline simd4d simd4d_mul(simd4d lhs, simd4d rhs) {
+    simd4d ret = { lhs.x * rhs.x, lhs.y * rhs.y, lhs.z * rhs.z, lhs.w * rhs.w };
+    return ret;
+}
+
+vectorial_inline simd4d simd4d_div(simd4d lhs, simd4d rhs) {
+    simd4d ret = { lhs.x / rhs.x, lhs.y / rhs.y, lhs.z / rhs.z, lhs.w / rhs.w };
+    return ret;
+}
+
+vectorial_inline simd4d simd4d_madd(simd4d m1, simd4d m2, simd4d a) {
+    return simd4d_add( simd4d_mul(m1, m2), a );
+}
+
+vectorial_inline simd4d simd4d_reciprocal(simd4d v) {
+    simd4d s = { 1.0 / v.x, 1.0 / v.y, 1.0 / v.z, 1.0 / v.w };
+    return s;
+}
+
+vectorial_inline simd4d simd4d_sqrt(simd4d v) {
+    simd4d s = { sqrt(v.x), sqrt(v.y), sqrt(v.z), sqrt(v.w) };
+    return s;
+}
+
+vectorial_inline simd4d simd4d_rsqrt(simd4d v) {
+    simd4d s = { 1.0 / sqrt(v.x), 1.0 / sqrt(v.y), 1.0 / sqrt(v.z), 1.0 / sqrt(v.w) };
+    return s;
+}
+
+vectorial_inline double simd4d_get_x(simd4d s) { return s.x; }
+vectorial_inline double simd4d_get_y(simd4d s) { return s.y; }
+vectorial_inline double simd4d_get_z(simd4d s) { return s.z; }
+vectorial_inline double simd4d_get_w(simd4d s) { return s.w; }
+
+vectorial_inline simd4d simd4d_dot3(simd4d lhs, simd4d rhs) {
+    return simd4d_splat( lhs.x * rhs.x + lhs.y * rhs.y + lhs.z * rhs.z );
+}
+
+vectorial_inline simd4d simd4d_cross3(simd4d lhs, simd4d rhs) {
+    return simd4d_create( lhs.y * rhs.z - lhs.z * rhs.y,
+                          lhs.z * rhs.x - lhs.x * rhs.z,
+                          lhs.x * rhs.y - lhs.y * rhs.x,
+                          0 );
+}
+
+vectorial_inline simd4d simd4d_zero_w(simd4d s) {
+    simd4d r = { s.x, s.y, s.z, 0.0 };
+    return r;
+}
+
+vectorial_inline simd4d simd4d_zero_zw(simd4d s) {
+    simd4d r = { s.x, s.y, 0.0, 0.0 };
+    return r;
+}
+
+vectorial_inline simd4d simd4d_min(simd4d a, simd4d b) {
+    return simd4d_create( a.x < b.x ? a.x : b.x,
+                          a.y < b.y ? a.y : b.y,
+                          a.z < b.z ? a.z : b.z,
+                          a.w < b.w ? a.w : b.w );
+}
+
+vectorial_inline simd4d simd4d_max(simd4d a, simd4d b) {
+    return simd4d_create( a.x > b.x ? a.x : b.x,
+                          a.y > b.y ? a.y : b.y,
+                          a.z > b.z ? a.z : b.z,
+                          a.w > b.w ? a.w : b.w );
+}
+
+
+// Through memory so they pair with any simd4f, this also covers SSE
+// without SSE2 and 32bit NEON
+
+vectorial_inline simd4f simd4d_to_simd4f(simd4d v) {
+    return simd4f_create( (float)v.x, (float)v.y, (float)v.z, (float)v.w );
+}
+
+vectorial_inline simd4d simd4f_to_simd4d(simd4f v) {
+    float f[4];
+    simd4f_ustore4(v, f);
+    return simd4d_create( f[0], f[1], f[2], f[3] );
+}
+
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif
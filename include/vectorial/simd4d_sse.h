@@ -0,0 +1,195 @@
+/*
+  Vectorial
+  Copyright (c) 2010 Mikko Lehtonen
+  Licensed under the terms of the two-clause BSD License (see LICENSE)
+*/
+#ifndef VECTORIAL_SIMD4D_SSE_H
+#define VECTORIAL_SIMD4D_SSE_H
+
+#include <emmintrin.h>
+#if defined(VECTORIAL_HAVE_FMA)
+    #include <immintrin.h>
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+// Two SSE2 registers, x and y in the first and z and w in the second
+typedef struct {
+    __m128d xy;
+    __m128d zw;
+} simd4d;
+
+
+vectorial_inline simd4d _simd4d_pair(__m128d xy, __m128d zw) {
+    simd4d s = { xy, zw };
+    return s;
+}
+
+// creating
+
+vectorial_inline simd4d simd4d_create(double x, double y, double z, double w) {
+    return _simd4d_pair( _mm_setr_pd(x, y), _mm_setr_pd(z, w) );
+}
+
+vectorial_inline simd4d simd4d_zero() { return _simd4d_pair( _mm_setzero_pd(), _mm_setzero_pd() ); }
+
+vectorial_inline simd4d simd4d_uload4(const double *ary) {
+    return _simd4d_pair( _mm_loadu_pd(ary), _mm_loadu_pd(ary + 2) );
+}
+
+vectorial_inline simd4d simd4d_uload3(const double *ary) {
+    return _simd4d_pair( _mm_loadu_pd(ary), _mm_load_sd(ary + 2) );
+}
+
+vectorial_inline simd4d simd4d_uload2(const double *ary) {
+    return _simd4d_pair( _mm_loadu_pd(ary), _mm_setzero_pd() );
+}
+
+
+vectorial_inline void simd4d_ustore4(const simd4d val, double *ary) {
+    _mm_storeu_pd(ary, val.xy);
+    _mm_storeu_pd(ary + 2, val.zw);
+}
+
+vectorial_inline void simd4d_ustore3(const simd4d val, double *ary) {
+    _mm_storeu_pd(ary, val.xy);
+    _mm_store_sd(ary + 2, val.zw);
+}
+
+vectorial_inline void simd4d_ustore2(const simd4d val, double *ary) {
+    _mm_storeu_pd(ary, val.xy);
+}
+
+
+// utilities
+
+vectorial_inline simd4d simd4d_splat(double v) {
+    const __m128d s = _mm_set1_pd(v);
+    return _simd4d_pair( s, s );
+}
+
+vectorial_inline simd4d simd4d_splat_x(simd4d v) {
+    const __m128d s = _mm_unpacklo_pd(v.xy, v.xy);
+    return _simd4d_pair( s, s );
+}
+
+vectorial_inline simd4d simd4d_splat_y(simd4d v) {
+    const __m128d s = _mm_unpackhi_pd(v.xy, v.xy);
+    return _simd4d_pair( s, s );
+}
+
+vectorial_inline simd4d simd4d_splat_z(simd4d v) {
+    const __m128d s = _mm_unpacklo_pd(v.zw, v.zw);
+    return _simd4d_pair( s, s );
+}
+
+vectorial_inline simd4d simd4d_splat_w(simd4d v) {
+    const __m128d s = _mm_unpackhi_pd(v.zw, v.zw);
+    return _simd4d_pair( s, s );
+}
+
+
+// arithmetic
+
+vectorial_inline simd4d simd4d_add(simd4d lhs, simd4d rhs) {
+    return _simd4d_pair( _mm_add_pd(lhs.xy, rhs.xy), _mm_add_pd(lhs.zw, rhs.zw) );
+}
+
+vectorial_inline simd4d simd4d_sub(simd4d lhs, simd4d rhs) {
+    return _simd4d_pair( _mm_sub_pd(lhs.xy, rhs.xy), _mm_sub_pd(lhs.zw, rhs.zw) );
+}
+
+vectorial_inline simd4d simd4d_mul(simd4d lhs, simd4d rhs) {
+    return _simd4d_pair( _mm_mul_pd(lhs.xy, rhs.xy), _mm_mul_pd(lhs.zw, rhs.zw) );
+}
+
+vectorial_inline simd4d simd4d_div(simd4d lhs, simd4d rhs) {
+    return _simd4d_pair( _mm_div_pd(lhs.xy, rhs.xy), _mm_div_pd(lhs.zw, rhs.zw) );
+}
+
+vectorial_inline simd4d simd4d_madd(simd4d m1, simd4d m2, simd4d a) {
+#if defined(VECTORIAL_HAVE_FMA)
+    return _simd4d_pair( _mm_fmadd_pd(m1.xy, m2.xy, a.xy), _mm_fmadd_pd(m1.zw, m2.zw, a.zw) );
+#else
+    return simd4d_add( simd4d_mul(m1, m2), a );
+#endif
+}
+
+vectorial_inline simd4d simd4d_reciprocal(simd4d v) {
+    return simd4d_div( simd4d_splat(1.0), v );
+}
+
+vectorial_inline simd4d simd4d_sqrt(simd4d v) {
+    return _simd4d_pair( _mm_sqrt_pd(v.xy), _mm_sqrt_pd(v.zw) );
+}
+
+vectorial_inline simd4d simd4d_rsqrt(simd4d v) {
+    return simd4d_div( simd4d_splat(1.0), simd4d_sqrt(v) );
+}
+
+vectorial_inline double simd4d_get_x(simd4d s) { return _mm_cvtsd_f64( s.xy ); }
+vectorial_inline double simd4d_get_y(simd4d s) { return _mm_cvtsd_f64( _mm_unpackhi_pd(s.xy, s.xy) ); }
+vectorial_inline double simd4d_get_z(simd4d s) { return _mm_cvtsd_f64( s.zw ); }
+vectorial_inline double simd4d_get_w(simd4d s) { return _mm_cvtsd_f64( _mm_unpackhi_pd(s.zw, s.zw) ); }
+
+vectorial_inline simd4d simd4d_dot3(simd4d lhs, simd4d rhs) {
+    const __m128d xy = _mm_mul_pd(lhs.xy, rhs.xy);
+    const __m128d zw = _mm_mul_pd(lhs.zw, rhs.zw);
+    const __m128d s = _mm_add_pd( _mm_add_pd(xy, _mm_shuffle_pd(xy, xy, 1)), _mm_unpacklo_pd(zw, zw) );
+    return _simd4d_pair( s, s );
+}
+
+vectorial_inline simd4d simd4d_cross3(simd4d lhs, simd4d rhs) {
+    // yzxw and zxyw of both sides
+    const __m128d lyz = _mm_shuffle_pd(lhs.xy, lhs.zw, 1);
+    const __m128d lxw = _mm_shuffle_pd(lhs.xy, lhs.zw, 2);
+    const __m128d lzx = _mm_shuffle_pd(lhs.zw, lhs.xy, 0);
+    const __m128d lyw = _mm_shuffle_pd(lhs.xy, lhs.zw, 3);
+
+    const __m128d ryz = _mm_shuffle_pd(rhs.xy, rhs.zw, 1);
+    const __m128d rxw = _mm_shuffle_pd(rhs.xy, rhs.zw, 2);
+    const __m128d rzx = _mm_shuffle_pd(rhs.zw, rhs.xy, 0);
+    const __m128d ryw = _mm_shuffle_pd(rhs.xy, rhs.zw, 3);
+
+    return _simd4d_pair( _mm_sub_pd( _mm_mul_pd(lyz, rzx), _mm_mul_pd(lzx, ryz) ),
+                         _mm_sub_pd( _mm_mul_pd(lxw, ryw), _mm_mul_pd(lyw, rxw) ) );
+}
+
+vectorial_inline simd4d simd4d_zero_w(simd4d s) {
+    return _simd4d_pair( s.xy, _mm_move_sd(_mm_setzero_pd(), s.zw) );
+}
+
+vectorial_inline simd4d simd4d_zero_zw(simd4d s) {
+    return _simd4d_pair( s.xy, _mm_setzero_pd() );
+}
+
+vectorial_inline simd4d simd4d_min(simd4d a, simd4d b) {
+    return _simd4d_pair( _mm_min_pd(a.xy, b.xy), _mm_min_pd(a.zw, b.zw) );
+}
+
+vectorial_inline simd4d simd4d_max(simd4d a, simd4d b) {
+    return _simd4d_pair( _mm_max_pd(a.xy, b.xy), _mm_max_pd(a.zw, b.zw) );
+}
+
+
+// conversions
+
+vectorial_inline simd4f simd4d_to_simd4f(simd4d v) {
+    return _mm_movelh_ps( _mm_cvtpd_ps(v.xy), _mm_cvtpd_ps(v.zw) );
+}
+
+vectorial_inline simd4d simd4f_to_simd4d(simd4f v) {
+    return _simd4d_pair( _mm_cvtps_pd(v), _mm_cvtps_pd( _mm_movehl_ps(v, v) ) );
+}
+
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif
@@ -0,0 +1,137 @@
+/*
+  Vectorial
+  Copyright (c) 2010 Mikko Lehtonen
+  Licensed under the terms of the two-clause BSD License (see LICENSE)
+*/
+#ifndef VECTORIAL_SIMD4F_AOS_H
+#define VECTORIAL_SIMD4F_AOS_H
+
+#ifndef VECTORIAL_SIMD4X4F_H
+  #include "vectorial/simd4x4f.h"
+#endif
+
+#include <stddef.h>
+
+/*
+  Conversion between arrays of structures and component registers.
+
+  ary holds 4 vectors, each starting stride floats after the previous one,
+  f.ex. stride 3 for packed float[3], 4 for float[4] and padded vec3f.
+  Loads give one simd4f per component with lane i from vector i, stores
+  do the inverse and only write the 3 or 4 floats of each vector.
+
+  With stride 4 or more, load3 reads the float after each of the first
+  3 vectors too, the last vector is loaded with only its 3 floats.
+*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+vectorial_inline void simd4f_aos_load4(const float *ary, size_t stride, simd4f *x, simd4f *y, simd4f *z, simd4f *w) {
+#if defined(VECTORIAL_NEON)
+    if( stride == 4 ) {
+        const float32x4x4_t v = vld4q_f32((const float32_t*)ary);
+        *x = v.val[0]; *y = v.val[1]; *z = v.val[2]; *w = v.val[3];
+        return;
+    }
+#endif
+    simd4x4f m = simd4x4f_create( simd4f_uload4(ary),
+                                  simd4f_uload4(ary + stride),
+                                  simd4f_uload4(ary + 2*stride),
+                                  simd4f_uload4(ary + 3*stride) );
+    simd4x4f_transpose_inplace(&m);
+    *x = m.x; *y = m.y; *z = m.z; *w = m.w;
+}
+
+vectorial_inline void simd4f_aos_load3(const float *ary, size_t stride, simd4f *x, simd4f *y, simd4f *z) {
+#if defined(VECTORIAL_SSE)
+    if( stride == 3 ) {
+        // x0 y0 z0 x1 | y1 z1 x2 y2 | z2 x3 y3 z3
+        const simd4f a = simd4f_uload4(ary);
+        const simd4f b = simd4f_uload4(ary + 4);
+        const simd4f c = simd4f_uload4(ary + 8);
+        const simd4f yz01 = _mm_shuffle_ps(a, b, _MM_SHUFFLE(1,0,2,1));
+        const simd4f xy23 = _mm_shuffle_ps(b, c, _MM_SHUFFLE(2,1,3,2));
+        *x = _mm_shuffle_ps(a, xy23, _MM_SHUFFLE(2,0,3,0));
+        *y = _mm_shuffle_ps(yz01, xy23, _MM_SHUFFLE(3,1,2,0));
+        *z = _mm_shuffle_ps(yz01, c, _MM_SHUFFLE(3,0,3,1));
+        return;
+    }
+#elif defined(VECTORIAL_NEON)
+    if( stride == 3 ) {
+        const float32x4x3_t v = vld3q_f32((const float32_t*)ary);
+        *x = v.val[0]; *y = v.val[1]; *z = v.val[2];
+        return;
+    }
+#endif
+    simd4x4f m;
+    if( stride >= 4 ) {
+        m = simd4x4f_create( simd4f_uload4(ary),
+                             simd4f_uload4(ary + stride),
+                             simd4f_uload4(ary + 2*stride),
+                             simd4f_uload3(ary + 3*stride) );
+    } else {
+        m = simd4x4f_create( simd4f_uload3(ary),
+                             simd4f_uload3(ary + stride),
+                             simd4f_uload3(ary + 2*stride),
+                             simd4f_uload3(ary + 3*stride) );
+    }
+    simd4x4f_transpose_inplace(&m);
+    *x = m.x; *y = m.y; *z = m.z;
+}
+
+
+vectorial_inline void simd4f_aos_store4(simd4f x, simd4f y, simd4f z, SIMD_PARAM(simd4f, w), float *ary, size_t stride) {
+#if defined(VECTORIAL_NEON)
+    if( stride == 4 ) {
+        float32x4x4_t v;
+        v.val[0] = x; v.val[1] = y; v.val[2] = z; v.val[3] = w;
+        vst4q_f32((float32_t*)ary, v);
+        return;
+    }
+#endif
+    simd4x4f m = simd4x4f_create(x, y, z, w);
+    simd4x4f_transpose_inplace(&m);
+    simd4f_ustore4(m.x, ary);
+    simd4f_ustore4(m.y, ary + stride);
+    simd4f_ustore4(m.z, ary + 2*stride);
+    simd4f_ustore4(m.w, ary + 3*stride);
+}
+
+vectorial_inline void simd4f_aos_store3(simd4f x, simd4f y, simd4f z, float *ary, size_t stride) {
+#if defined(VECTORIAL_SSE)
+    if( stride == 3 ) {
+        const simd4f xy01 = _mm_unpacklo_ps(x, y);
+        const simd4f xy23 = _mm_unpackhi_ps(x, y);
+        const simd4f zx01 = _mm_shuffle_ps(z, xy01, _MM_SHUFFLE(3,2,1,0));
+        const simd4f zx23 = _mm_shuffle_ps(z, xy23, _MM_SHUFFLE(3,2,3,2));
+        simd4f_ustore4(_mm_shuffle_ps(xy01, zx01, _MM_SHUFFLE(2,0,1,0)), ary);
+        simd4f_ustore4(_mm_shuffle_ps(zx01, xy23, _MM_SHUFFLE(1,0,1,3)), ary + 4);
+        simd4f_ustore4(_mm_shuffle_ps(zx23, zx23, _MM_SHUFFLE(1,3,2,0)), ary + 8);
+        return;
+    }
+#elif defined(VECTORIAL_NEON)
+    if( stride == 3 ) {
+        float32x4x3_t v;
+        v.val[0] = x; v.val[1] = y; v.val[2] = z;
+        vst3q_f32((float32_t*)ary, v);
+        return;
+    }
+#endif
+    simd4x4f m = simd4x4f_create(x, y, z, simd4f_zero());
+    simd4x4f_transpose_inplace(&m);
+    simd4f_ustore3(m.x, ary);
+    simd4f_ustore3(m.y, ary + stride);
+    simd4f_ustore3(m.z, ary + 2*stride);
+    simd4f_ustore3(m.w, ary + 3*stride);
+}
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif
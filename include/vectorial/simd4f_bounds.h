@@ -0,0 +1,274 @@
+/*
+  Vectorial
+  Copyright (c) 2010 Mikko Lehtonen
+  Licensed under the terms of the two-clause BSD License (see LICENSE)
+*/
+#ifndef VECTORIAL_SIMD4F_BOUNDS_H
+#define VECTORIAL_SIMD4F_BOUNDS_H
+
+#ifndef VECTORIAL_SIMD4F_AOS_H
+  #include "vectorial/simd4f_aos.h"
+#endif
+
+#ifndef VECTORIAL_SIMD4I_H
+  #include "vectorial/simd4i.h"
+#endif
+
+#include <float.h>
+#include <math.h>
+#include <stddef.h>
+
+/*
+  Bounding volumes of point arrays. Points are simd4f with w ignored, or
+  packed float[3]. Results have w 0, except spheres, which are simd4f with
+  the center in xyz and the radius in w like in simd4f_frustum.h.
+
+  The min, max and sum loops keep several independent accumulators, so
+  each add or compare waits on one from a few iterations back and not on
+  the previous one. Packed points are read as three simd4f per four
+  points, x0 y0 z0 x1, y1 z1 x2 y2 and z2 x3 y3 z3. Each accumulator lane
+  then always sees the same component, and the lanes are folded together
+  at the end.
+
+  The bounding sphere is Ritter's: a first guess from the two points
+  farthest apart of three probes, then grown over every point left
+  outside. It is within a few percent of the smallest sphere for most
+  clouds, and up to about 20% larger in the worst case.
+
+  An empty array gives the empty box min FLT_MAX and max -FLT_MAX, and a
+  zero centroid and sphere.
+*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+vectorial_inline void simd4f_aabb_array(const simd4f* points, size_t n, simd4f* aabb_min, simd4f* aabb_max) {
+    simd4f lo0 = simd4f_splat(FLT_MAX), lo1 = lo0, lo2 = lo0, lo3 = lo0;
+    simd4f hi0 = simd4f_splat(-FLT_MAX), hi1 = hi0, hi2 = hi0, hi3 = hi0;
+
+    size_t i = 0;
+    const size_t n4 = n & ~(size_t)3;
+    for(; i < n4; i += 4) {
+        lo0 = simd4f_min(lo0, points[i]);   hi0 = simd4f_max(hi0, points[i]);
+        lo1 = simd4f_min(lo1, points[i+1]); hi1 = simd4f_max(hi1, points[i+1]);
+        lo2 = simd4f_min(lo2, points[i+2]); hi2 = simd4f_max(hi2, points[i+2]);
+        lo3 = simd4f_min(lo3, points[i+3]); hi3 = simd4f_max(hi3, points[i+3]);
+    }
+    for(; i < n; ++i) {
+        lo0 = simd4f_min(lo0, points[i]);
+        hi0 = simd4f_max(hi0, points[i]);
+    }
+
+    *aabb_min = simd4f_zero_w( simd4f_min( simd4f_min(lo0, lo1), simd4f_min(lo2, lo3) ) );
+    *aabb_max = simd4f_zero_w( simd4f_max( simd4f_max(hi0, hi1), simd4f_max(hi2, hi3) ) );
+}
+
+// Folds accumulators of the x0 y0 z0 x1, y1 z1 x2 y2, z2 x3 y3 z3 pattern
+// into one xyz vector with op
+#define _SIMD4F_PACKED3_FOLD(a, b, c, op) \
+    simd4f_create( op( op(simd4f_get_x(a), simd4f_get_w(a)), op(simd4f_get_z(b), simd4f_get_y(c)) ), \
+                   op( op(simd4f_get_y(a), simd4f_get_x(b)), op(simd4f_get_w(b), simd4f_get_z(c)) ), \
+                   op( op(simd4f_get_z(a), simd4f_get_y(b)), op(simd4f_get_x(c), simd4f_get_w(c)) ), 0.0f )
+
+vectorial_inline void simd4f_aabb_packed3(const float* points, size_t n, simd4f* aabb_min, simd4f* aabb_max) {
+    simd4f loa0 = simd4f_splat(FLT_MAX), lob0 = loa0, loc0 = loa0, loa1 = loa0, lob1 = loa0, loc1 = loa0;
+    simd4f hia0 = simd4f_splat(-FLT_MAX), hib0 = hia0, hic0 = hia0, hia1 = hia0, hib1 = hia0, hic1 = hia0;
+
+    size_t i = 0;
+    const size_t n8 = n & ~(size_t)7;
+    for(; i < n8; i += 8) {
+        const float* p = points + 3*i;
+        const simd4f a0 = simd4f_uload4(p),      b0 = simd4f_uload4(p + 4),  c0 = simd4f_uload4(p + 8);
+        const simd4f a1 = simd4f_uload4(p + 12), b1 = simd4f_uload4(p + 16), c1 = simd4f_uload4(p + 20);
+        loa0 = simd4f_min(loa0, a0); lob0 = simd4f_min(lob0, b0); loc0 = simd4f_min(loc0, c0);
+        hia0 = simd4f_max(hia0, a0); hib0 = simd4f_max(hib0, b0); hic0 = simd4f_max(hic0, c0);
+        loa1 = simd4f_min(loa1, a1); lob1 = simd4f_min(lob1, b1); loc1 = simd4f_min(loc1, c1);
+        hia1 = simd4f_max(hia1, a1); hib1 = simd4f_max(hib1, b1); hic1 = simd4f_max(hic1, c1);
+    }
+    if( i + 4 <= n ) {
+        const float* p = points + 3*i;
+        const simd4f a = simd4f_uload4(p), b = simd4f_uload4(p + 4), c = simd4f_uload4(p + 8);
+        loa0 = simd4f_min(loa0, a); lob0 = simd4f_min(lob0, b); loc0 = simd4f_min(loc0, c);
+        hia0 = simd4f_max(hia0, a); hib0 = simd4f_max(hib0, b); hic0 = simd4f_max(hic0, c);
+        i += 4;
+    }
+
+    simd4f lo = _SIMD4F_PACKED3_FOLD( simd4f_min(loa0, loa1), simd4f_min(lob0, lob1), simd4f_min(loc0, loc1), fminf );
+    simd4f hi = _SIMD4F_PACKED3_FOLD( simd4f_max(hia0, hia1), simd4f_max(hib0, hib1), simd4f_max(hic0, hic1), fmaxf );
+    for(; i < n; ++i) {
+        const simd4f p = simd4f_uload3(points + 3*i);
+        lo = simd4f_min(lo, p);
+        hi = simd4f_max(hi, p);
+    }
+
+    *aabb_min = simd4f_zero_w(lo);
+    *aabb_max = simd4f_zero_w(hi);
+}
+
+
+// Sums of the xyz of the points, for the centroid and its parallel version
+
+vectorial_inline simd4f _simd4f_sum_array(const simd4f* points, size_t n) {
+    simd4f s0 = simd4f_zero(), s1 = s0, s2 = s0, s3 = s0;
+    size_t i = 0;
+    const size_t n4 = n & ~(size_t)3;
+    for(; i < n4; i += 4) {
+        s0 = simd4f_add(s0, points[i]);
+        s1 = simd4f_add(s1, points[i+1]);
+        s2 = simd4f_add(s2, points[i+2]);
+        s3 = simd4f_add(s3, points[i+3]);
+    }
+    for(; i < n; ++i) s0 = simd4f_add(s0, points[i]);
+    return simd4f_zero_w( simd4f_add( simd4f_add(s0, s1), simd4f_add(s2, s3) ) );
+}
+
+#define _SIMD4F_ADD2(a, b) ((a) + (b))
+
+vectorial_inline simd4f _simd4f_sum_packed3(const float* points, size_t n) {
+    simd4f sa0 = simd4f_zero(), sb0 = sa0, sc0 = sa0, sa1 = sa0, sb1 = sa0, sc1 = sa0;
+    size_t i = 0;
+    const size_t n8 = n & ~(size_t)7;
+    for(; i < n8; i += 8) {
+        const float* p = points + 3*i;
+        sa0 = simd4f_add(sa0, simd4f_uload4(p));      sb0 = simd4f_add(sb0, simd4f_uload4(p + 4));  sc0 = simd4f_add(sc0, simd4f_uload4(p + 8));
+        sa1 = simd4f_add(sa1, simd4f_uload4(p + 12)); sb1 = simd4f_add(sb1, simd4f_uload4(p + 16)); sc1 = simd4f_add(sc1, simd4f_uload4(p + 20));
+    }
+    if( i + 4 <= n ) {
+        const float* p = points + 3*i;
+        sa0 = simd4f_add(sa0, simd4f_uload4(p)); sb0 = simd4f_add(sb0, simd4f_uload4(p + 4)); sc0 = simd4f_add(sc0, simd4f_uload4(p + 8));
+        i += 4;
+    }
+
+    simd4f s = _SIMD4F_PACKED3_FOLD( simd4f_add(sa0, sa1), simd4f_add(sb0, sb1), simd4f_add(sc0, sc1), _SIMD4F_ADD2 );
+    for(; i < n; ++i) s = simd4f_add(s, simd4f_uload3(points + 3*i));
+    return simd4f_zero_w(s);
+}
+
+#undef _SIMD4F_ADD2
+
+vectorial_inline simd4f simd4f_centroid_array(const simd4f* points, size_t n) {
+    if( n == 0 ) return simd4f_zero();
+    return simd4f_mul( _simd4f_sum_array(points, n), simd4f_splat(1.0f / n) );
+}
+
+vectorial_inline simd4f simd4f_centroid_packed3(const float* points, size_t n) {
+    if( n == 0 ) return simd4f_zero();
+    return simd4f_mul( _simd4f_sum_packed3(points, n), simd4f_splat(1.0f / n) );
+}
+
+
+// Index of the point farthest from p, four points at a time with the
+// per lane best distances and indices kept apart until the end
+vectorial_inline size_t _simd4f_farthest_strided(const float* points, size_t stride, size_t n, simd4f p) {
+    const simd4f px = simd4f_splat_x(p), py = simd4f_splat_y(p), pz = simd4f_splat_z(p);
+    simd4f best = simd4f_splat(-1.0f);
+    simd4i best_index = simd4i_zero();
+    simd4i index = simd4i_create(0, 1, 2, 3);
+    const simd4i four = simd4i_splat(4);
+
+    size_t i = 0;
+    const size_t n4 = n & ~(size_t)3;
+    for(; i < n4; i += 4) {
+        simd4f x, y, z;
+        simd4f_aos_load3(points + stride*i, stride, &x, &y, &z);
+        x = simd4f_sub(x, px); y = simd4f_sub(y, py); z = simd4f_sub(z, pz);
+        const simd4f d2 = simd4f_madd( x, x, simd4f_madd( y, y, simd4f_mul(z, z) ) );
+        const simd4f_mask further = simd4f_cmpgt(d2, best);
+        best = simd4f_select(further, d2, best);
+        best_index = simd4f_as_simd4i( simd4f_select( further, simd4i_as_simd4f(index), simd4i_as_simd4f(best_index) ) );
+        index = simd4i_add(index, four);
+    }
+
+    simd4f_aligned16 float d[4];
+    simd4f_aligned16 int k[4];
+    simd4f_ustore4(best, d);
+    simd4i_ustore4(best_index, k);
+    float best_d2 = d[0];
+    size_t farthest = (size_t)k[0];
+    for(int lane = 1; lane < 4; ++lane) {
+        if( d[lane] > best_d2 ) { best_d2 = d[lane]; farthest = (size_t)k[lane]; }
+    }
+    for(; i < n; ++i) {
+        const simd4f v = simd4f_sub( simd4f_uload3(points + stride*i), p );
+        const float d2 = simd4f_get_x( simd4f_dot3(v, v) );
+        if( d2 > best_d2 ) { best_d2 = d2; farthest = i; }
+    }
+    return farthest;
+}
+
+// Grows the sphere just enough to take in p when p is outside, its
+// center moving towards p and the far side staying put
+vectorial_inline simd4f _simd4f_sphere_grow(simd4f center, float* radius, simd4f p) {
+    const simd4f v = simd4f_sub(p, center);
+    const float d = sqrtf( simd4f_get_x( simd4f_dot3(v, v) ) );
+    if( d <= *radius ) return center;
+    const float r = 0.5f * (*radius + d);
+    center = simd4f_madd( v, simd4f_splat( (r - *radius) / d ), center );
+    *radius = r;
+    return center;
+}
+
+vectorial_inline simd4f _simd4f_bounding_sphere_strided(const float* points, size_t stride, size_t n) {
+    if( n == 0 ) return simd4f_zero();
+
+    const simd4f first = simd4f_uload3(points);
+    const simd4f a = simd4f_uload3( points + stride * _simd4f_farthest_strided(points, stride, n, first) );
+    const simd4f b = simd4f_uload3( points + stride * _simd4f_farthest_strided(points, stride, n, a) );
+
+    simd4f center = simd4f_mul( simd4f_add(a, b), simd4f_splat(0.5f) );
+    const simd4f ab = simd4f_sub(b, a);
+    float radius = 0.5f * sqrtf( simd4f_get_x( simd4f_dot3(ab, ab) ) );
+
+    // Growing is rare after the first guess, so test four at a time and go
+    // through the outside ones in order only when there are some
+    size_t i = 0;
+    const size_t n4 = n & ~(size_t)3;
+    for(; i < n4; i += 4) {
+        simd4f x, y, z;
+        simd4f_aos_load3(points + stride*i, stride, &x, &y, &z);
+        x = simd4f_sub(x, simd4f_splat_x(center));
+        y = simd4f_sub(y, simd4f_splat_y(center));
+        z = simd4f_sub(z, simd4f_splat_z(center));
+        const simd4f d2 = simd4f_madd( x, x, simd4f_madd( y, y, simd4f_mul(z, z) ) );
+        const int outside = simd4f_movemask( simd4f_cmpgt( d2, simd4f_splat(radius * radius) ) );
+        if( outside == 0 ) continue;
+        for(int lane = 0; lane < 4; ++lane) {
+            if( outside & (1 << lane) ) center = _simd4f_sphere_grow( center, &radius, simd4f_uload3(points + stride*(i + lane)) );
+        }
+    }
+    for(; i < n; ++i) center = _simd4f_sphere_grow( center, &radius, simd4f_uload3(points + stride*i) );
+
+    return simd4f_add( simd4f_zero_w(center), simd4f_create(0.0f, 0.0f, 0.0f, radius) );
+}
+
+vectorial_inline simd4f simd4f_bounding_sphere_array(const simd4f* points, size_t n) {
+    return _simd4f_bounding_sphere_strided( (const float*)points, 4, n );
+}
+
+vectorial_inline simd4f simd4f_bounding_sphere_packed3(const float* points, size_t n) {
+    return _simd4f_bounding_sphere_strided( points, 3, n );
+}
+
+// Smallest sphere around two spheres
+vectorial_inline simd4f simd4f_sphere_merge(simd4f a, simd4f b) {
+    const float ra = simd4f_get_w(a), rb = simd4f_get_w(b);
+    const simd4f v = simd4f_zero_w( simd4f_sub(b, a) );
+    const float d = sqrtf( simd4f_get_x( simd4f_dot3(v, v) ) );
+    if( d + rb <= ra ) return a;
+    if( d + ra <= rb ) return b;
+    const float r = 0.5f * (d + ra + rb);
+    const simd4f center = simd4f_madd( v, simd4f_splat( (r - ra) / d ), simd4f_zero_w(a) );
+    return simd4f_add( center, simd4f_create(0.0f, 0.0f, 0.0f, r) );
+}
+
+#undef _SIMD4F_PACKED3_FOLD
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif
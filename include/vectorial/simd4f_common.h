@@ -71,4 +71,9 @@ vectorial_inline simd4f simd4f_normalize2(simd4f a) {
 }
 
 
+// Any or all of the four lanes set
+vectorial_inline int simd4f_any(simd4f_mask mask) { return simd4f_movemask(mask) != 0; }
+vectorial_inline int simd4f_all(simd4f_mask mask) { return simd4f_movemask(mask) == 15; }
+
+
 #endif
@@ -0,0 +1,302 @@
+/*
+  Vectorial
+  Copyright (c) 2010 Mikko Lehtonen
+  Licensed under the terms of the two-clause BSD License (see LICENSE)
+*/
+#ifndef VECTORIAL_SIMD4F_FRUSTUM_H
+#define VECTORIAL_SIMD4F_FRUSTUM_H
+
+#ifndef VECTORIAL_SIMD4X4F_H
+  #include "vectorial/simd4x4f.h"
+#endif
+
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+  View frustum as six planes, xyz the unit normal pointing inside and w
+  the distance, so a point p is inside when dot3(plane, p) + w >= 0.
+  Planes are in the space of the points the matrix they came from
+  transforms, f.ex. world space for a view-projection matrix.
+
+  Spheres are simd4f with the center in xyz and the radius in w, boxes
+  min and max corners. Both are conservative: everything that touches the
+  frustum is visible, some boxes and spheres near its edges too.
+
+  The array kernels test four objects at a time against all planes with
+  the planes splatted, one object per lane. Results are either a bitmask,
+  bit i%32 of visible[i/32], or the compacted indices of the visible
+  objects.
+*/
+
+enum {
+    SIMD4F_FRUSTUM_LEFT = 0,
+    SIMD4F_FRUSTUM_RIGHT,
+    SIMD4F_FRUSTUM_BOTTOM,
+    SIMD4F_FRUSTUM_TOP,
+    SIMD4F_FRUSTUM_NEAR,
+    SIMD4F_FRUSTUM_FAR,
+    SIMD4F_FRUSTUM_PLANES
+};
+
+typedef struct {
+    simd4f plane[SIMD4F_FRUSTUM_PLANES];
+} simd4f_frustum;
+
+
+// Planes of the clip space box -w <= x,y,z <= w, like simd4x4f_perspective
+// and simd4x4f_ortho produce
+vectorial_inline void simd4f_frustum_from_simd4x4f(const simd4x4f* m, simd4f_frustum* out) {
+    simd4x4f rows;
+    simd4x4f_transpose(m, &rows);
+
+    out->plane[SIMD4F_FRUSTUM_LEFT] = simd4f_add(rows.w, rows.x);
+    out->plane[SIMD4F_FRUSTUM_RIGHT] = simd4f_sub(rows.w, rows.x);
+    out->plane[SIMD4F_FRUSTUM_BOTTOM] = simd4f_add(rows.w, rows.y);
+    out->plane[SIMD4F_FRUSTUM_TOP] = simd4f_sub(rows.w, rows.y);
+    out->plane[SIMD4F_FRUSTUM_NEAR] = simd4f_add(rows.w, rows.z);
+    out->plane[SIMD4F_FRUSTUM_FAR] = simd4f_sub(rows.w, rows.z);
+
+    for(int i = 0; i < SIMD4F_FRUSTUM_PLANES; ++i) {
+        const simd4f p = out->plane[i];
+        out->plane[i] = simd4f_div( p, simd4f_length3(p) );
+    }
+}
+
+
+// The single object tests below do the same operations as the array
+// kernels, in every lane, so objects touching a plane get the same answer
+// from both. The barriers keep -ffast-math from reordering the sums
+// differently in the two.
+
+// Signed distance from each plane to the center, compared to -radius
+vectorial_inline int simd4f_frustum_sphere_visible(const simd4f_frustum* f, simd4f sphere) {
+    const simd4f x = simd4f_splat_x(sphere);
+    const simd4f y = simd4f_splat_y(sphere);
+    const simd4f z = simd4f_splat_z(sphere);
+    const simd4f neg_r = simd4f_sub( simd4f_zero(), simd4f_splat_w(sphere) );
+    for(int i = 0; i < SIMD4F_FRUSTUM_PLANES; ++i) {
+        const simd4f p = f->plane[i];
+        const simd4f dist = simd4f_madd(simd4f_splat_x(p), x, simd4f_madd(simd4f_splat_y(p), y, simd4f_madd(simd4f_splat_z(p), z, simd4f_splat_w(p))));
+        if( !(simd4f_movemask( simd4f_cmpge(dist, neg_r) ) & 1) ) return 0;
+    }
+    return 1;
+}
+
+// Center and half extents, the extents projected on the absolute normal
+// give the box's radius towards each plane
+vectorial_inline int simd4f_frustum_aabb_visible(const simd4f_frustum* f, simd4f aabb_min, simd4f aabb_max) {
+    const simd4f half = simd4f_splat(0.5f);
+    const simd4f c = simd4f_mul( simd4f_add(aabb_max, aabb_min), half );
+    const simd4f e = simd4f_mul( simd4f_sub(aabb_max, aabb_min), half );
+    const simd4f cx = simd4f_splat_x(c), cy = simd4f_splat_y(c), cz = simd4f_splat_z(c);
+    const simd4f ex = simd4f_splat_x(e), ey = simd4f_splat_y(e), ez = simd4f_splat_z(e);
+    for(int i = 0; i < SIMD4F_FRUSTUM_PLANES; ++i) {
+        const simd4f p = f->plane[i];
+        simd4f dist = simd4f_madd(simd4f_splat_x(p), cx, simd4f_madd(simd4f_splat_y(p), cy, simd4f_madd(simd4f_splat_z(p), cz, simd4f_splat_w(p))));
+        const simd4f ax = simd4f_splat( fabsf(simd4f_get_x(p)) );
+        const simd4f ay = simd4f_splat( fabsf(simd4f_get_y(p)) );
+        const simd4f az = simd4f_splat( fabsf(simd4f_get_z(p)) );
+        simd4f radius = simd4f_madd(ax, ex, simd4f_madd(ay, ey, simd4f_mul(az, ez)));
+        _SIMD4F_BARRIER(dist);
+        _SIMD4F_BARRIER(radius);
+        if( !(simd4f_movemask( simd4f_cmpge( simd4f_add(dist, radius), simd4f_zero() ) ) & 1) ) return 0;
+    }
+    return 1;
+}
+
+
+// Each plane component in all lanes, with the absolute values of the
+// normal for boxes
+typedef struct {
+    simd4f nx[SIMD4F_FRUSTUM_PLANES];
+    simd4f ny[SIMD4F_FRUSTUM_PLANES];
+    simd4f nz[SIMD4F_FRUSTUM_PLANES];
+    simd4f d[SIMD4F_FRUSTUM_PLANES];
+    simd4f ax[SIMD4F_FRUSTUM_PLANES];
+    simd4f ay[SIMD4F_FRUSTUM_PLANES];
+    simd4f az[SIMD4F_FRUSTUM_PLANES];
+} _simd4f_frustum_splatted;
+
+vectorial_inline void _simd4f_frustum_splat(const simd4f_frustum* f, _simd4f_frustum_splatted* s) {
+    for(int i = 0; i < SIMD4F_FRUSTUM_PLANES; ++i) {
+        const simd4f p = f->plane[i];
+        s->nx[i] = simd4f_splat_x(p);
+        s->ny[i] = simd4f_splat_y(p);
+        s->nz[i] = simd4f_splat_z(p);
+        s->d[i] = simd4f_splat_w(p);
+        s->ax[i] = simd4f_splat( fabsf(simd4f_get_x(p)) );
+        s->ay[i] = simd4f_splat( fabsf(simd4f_get_y(p)) );
+        s->az[i] = simd4f_splat( fabsf(simd4f_get_z(p)) );
+    }
+}
+
+// Visibility of in[0..3] in bits 0..3, like simd4f_frustum_sphere_visible
+vectorial_inline int _simd4f_frustum_spheres4(const _simd4f_frustum_splatted* s, const simd4f* in) {
+    simd4x4f t = simd4x4f_create( in[0], in[1], in[2], in[3] );
+    simd4x4f_transpose_inplace(&t);
+    const simd4f neg_r = simd4f_sub( simd4f_zero(), t.w );
+
+    simd4f_mask visible = simd4f_cmpge( simd4f_madd(s->nx[0], t.x, simd4f_madd(s->ny[0], t.y, simd4f_madd(s->nz[0], t.z, s->d[0]))), neg_r );
+    for(int i = 1; i < SIMD4F_FRUSTUM_PLANES; ++i) {
+        const simd4f dist = simd4f_madd(s->nx[i], t.x, simd4f_madd(s->ny[i], t.y, simd4f_madd(s->nz[i], t.z, s->d[i])));
+        visible = simd4f_mask_and( visible, simd4f_cmpge(dist, neg_r) );
+    }
+    return simd4f_movemask(visible);
+}
+
+// Like simd4f_frustum_aabb_visible, one box per lane
+vectorial_inline int _simd4f_frustum_aabbs4(const _simd4f_frustum_splatted* s, const simd4f* aabb_min, const simd4f* aabb_max) {
+    simd4x4f lo = simd4x4f_create( aabb_min[0], aabb_min[1], aabb_min[2], aabb_min[3] );
+    simd4x4f hi = simd4x4f_create( aabb_max[0], aabb_max[1], aabb_max[2], aabb_max[3] );
+    simd4x4f_transpose_inplace(&lo);
+    simd4x4f_transpose_inplace(&hi);
+
+    const simd4f half = simd4f_splat(0.5f);
+    const simd4f cx = simd4f_mul( simd4f_add(hi.x, lo.x), half );
+    const simd4f cy = simd4f_mul( simd4f_add(hi.y, lo.y), half );
+    const simd4f cz = simd4f_mul( simd4f_add(hi.z, lo.z), half );
+    const simd4f ex = simd4f_mul( simd4f_sub(hi.x, lo.x), half );
+    const simd4f ey = simd4f_mul( simd4f_sub(hi.y, lo.y), half );
+    const simd4f ez = simd4f_mul( simd4f_sub(hi.z, lo.z), half );
+
+    simd4f_mask visible = simd4f_cmpge( simd4f_zero(), simd4f_zero() );
+    for(int i = 0; i < SIMD4F_FRUSTUM_PLANES; ++i) {
+        simd4f dist = simd4f_madd(s->nx[i], cx, simd4f_madd(s->ny[i], cy, simd4f_madd(s->nz[i], cz, s->d[i])));
+        simd4f radius = simd4f_madd(s->ax[i], ex, simd4f_madd(s->ay[i], ey, simd4f_mul(s->az[i], ez)));
+        _SIMD4F_BARRIER(dist);
+        _SIMD4F_BARRIER(radius);
+        visible = simd4f_mask_and( visible, simd4f_cmpge( simd4f_add(dist, radius), simd4f_zero() ) );
+    }
+    return simd4f_movemask(visible);
+}
+
+
+// The last n < 4 padded with copies of the first, so the tail goes through
+// the same test as the rest. Bits past n are 0.
+vectorial_inline int _simd4f_frustum_spheres_tail(const _simd4f_frustum_splatted* s, const simd4f* in, size_t n) {
+    simd4f t[4];
+    for(size_t j = 0; j < 4; ++j) t[j] = in[j < n ? j : 0];
+    return _simd4f_frustum_spheres4(s, t) & ((1 << n) - 1);
+}
+
+vectorial_inline int _simd4f_frustum_aabbs_tail(const _simd4f_frustum_splatted* s, const simd4f* aabb_min, const simd4f* aabb_max, size_t n) {
+    simd4f lo[4], hi[4];
+    for(size_t j = 0; j < 4; ++j) {
+        lo[j] = aabb_min[j < n ? j : 0];
+        hi[j] = aabb_max[j < n ? j : 0];
+    }
+    return _simd4f_frustum_aabbs4(s, lo, hi) & ((1 << n) - 1);
+}
+
+
+// n spheres into the (n+31)/32 words of visible, unused high bits of the
+// last word are 0
+vectorial_inline void simd4f_frustum_cull_spheres(const simd4f_frustum* f, const simd4f* spheres, size_t n, uint32_t* visible) {
+    _simd4f_frustum_splatted s;
+    _simd4f_frustum_splat(f, &s);
+
+    const size_t n32 = n & ~(size_t)31;
+    size_t i = 0;
+    for(; i < n32; i += 32) {
+        uint32_t word = 0;
+        for(size_t j = 0; j < 32; j += 4) {
+            word |= (uint32_t)_simd4f_frustum_spheres4(&s, spheres + i + j) << j;
+        }
+        visible[i / 32] = word;
+    }
+    if( i < n ) {
+        const size_t rest = n - i, rest4 = rest & ~(size_t)3;
+        uint32_t word = 0;
+        size_t j = 0;
+        for(; j < rest4; j += 4) {
+            word |= (uint32_t)_simd4f_frustum_spheres4(&s, spheres + i + j) << j;
+        }
+        if( j < rest ) word |= (uint32_t)_simd4f_frustum_spheres_tail(&s, spheres + i + j, rest - j) << j;
+        visible[i / 32] = word;
+    }
+}
+
+vectorial_inline void simd4f_frustum_cull_aabbs(const simd4f_frustum* f, const simd4f* aabb_min, const simd4f* aabb_max, size_t n, uint32_t* visible) {
+    _simd4f_frustum_splatted s;
+    _simd4f_frustum_splat(f, &s);
+
+    const size_t n32 = n & ~(size_t)31;
+    size_t i = 0;
+    for(; i < n32; i += 32) {
+        uint32_t word = 0;
+        for(size_t j = 0; j < 32; j += 4) {
+            word |= (uint32_t)_simd4f_frustum_aabbs4(&s, aabb_min + i + j, aabb_max + i + j) << j;
+        }
+        visible[i / 32] = word;
+    }
+    if( i < n ) {
+        const size_t rest = n - i, rest4 = rest & ~(size_t)3;
+        uint32_t word = 0;
+        size_t j = 0;
+        for(; j < rest4; j += 4) {
+            word |= (uint32_t)_simd4f_frustum_aabbs4(&s, aabb_min + i + j, aabb_max + i + j) << j;
+        }
+        if( j < rest ) word |= (uint32_t)_simd4f_frustum_aabbs_tail(&s, aabb_min + i + j, aabb_max + i + j, rest - j) << j;
+        visible[i / 32] = word;
+    }
+}
+
+
+// The indices of visible objects into indices, which has room for n.
+// Returns how many there are. Every lane up to n is written, only the
+// visible ones advance.
+
+vectorial_inline size_t _simd4f_frustum_compact4(int bits, uint32_t base, uint32_t* indices, size_t count) {
+    indices[count] = base;     count += bits & 1;
+    indices[count] = base + 1; count += (bits >> 1) & 1;
+    indices[count] = base + 2; count += (bits >> 2) & 1;
+    indices[count] = base + 3; count += (bits >> 3) & 1;
+    return count;
+}
+
+// Only the first n lanes, so the writes stay within the n indices
+vectorial_inline size_t _simd4f_frustum_compact_tail(int bits, uint32_t base, size_t n, uint32_t* indices, size_t count) {
+    for(size_t j = 0; j < n; ++j) {
+        indices[count] = base + (uint32_t)j;
+        count += (bits >> j) & 1;
+    }
+    return count;
+}
+
+vectorial_inline size_t simd4f_frustum_compact_spheres(const simd4f_frustum* f, const simd4f* spheres, size_t n, uint32_t* indices) {
+    _simd4f_frustum_splatted s;
+    _simd4f_frustum_splat(f, &s);
+
+    const size_t n4 = n & ~(size_t)3;
+    size_t count = 0;
+    size_t i = 0;
+    for(; i < n4; i += 4) {
+        count = _simd4f_frustum_compact4( _simd4f_frustum_spheres4(&s, spheres + i), (uint32_t)i, indices, count );
+    }
+    if( i < n ) {
+        count = _simd4f_frustum_compact_tail( _simd4f_frustum_spheres_tail(&s, spheres + i, n - i), (uint32_t)i, n - i, indices, count );
+    }
+    return count;
+}
+
+vectorial_inline size_t simd4f_frustum_compact_aabbs(const simd4f_frustum* f, const simd4f* aabb_min, const simd4f* aabb_max, size_t n, uint32_t* indices) {
+    _simd4f_frustum_splatted s;
+    _simd4f_frustum_splat(f, &s);
+
+    const size_t n4 = n & ~(size_t)3;
+    size_t count = 0;
+    size_t i = 0;
+    for(; i < n4; i += 4) {
+        count = _simd4f_frustum_compact4( _simd4f_frustum_aabbs4(&s, aabb_min + i, aabb_max + i), (uint32_t)i, indices, count );
+    }
+    if( i < n ) {
+        count = _simd4f_frustum_compact_tail( _simd4f_frustum_aabbs_tail(&s, aabb_min + i, aabb_max + i, n - i), (uint32_t)i, n - i, indices, count );
+    }
+    return count;
+}
+
+
+
+#endif
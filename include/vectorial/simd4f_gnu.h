@@ -22,6 +22,14 @@ typedef union {
     float f[4];
 } _simd4f_union;
 
+// Keeps -ffast-math from reordering arithmetic across v, for the places
+// where the order carries the precision
+#if defined(__SSE__)
+    #define _SIMD4F_BARRIER(v) __asm__("" : "+x"(v))
+#else
+    #define _SIMD4F_BARRIER(v) __asm__("" : "+m"(v))
+#endif
+
 vectorial_inline float simd4f_get_x(simd4f s) { _simd4f_union u={s}; return u.f[0]; }
 vectorial_inline float simd4f_get_y(simd4f s) { _simd4f_union u={s}; return u.f[1]; }
 vectorial_inline float simd4f_get_z(simd4f s) { _simd4f_union u={s}; return u.f[2]; }
@@ -214,6 +222,65 @@ vectorial_inline simd4f simd4f_max(simd4f a, simd4f b) {
                           ua.f[3] > ub.f[3] ? ua.f[3] : ub.f[3] );
 }
 
+vectorial_inline simd4f simd4f_floor(simd4f v) {
+    simd4f ret = { floorf(simd4f_get_x(v)), floorf(simd4f_get_y(v)), floorf(simd4f_get_z(v)), floorf(simd4f_get_w(v)) };
+    return ret;
+}
+
+// x * 2^n for integral n, n clamped to [-252, 254]
+vectorial_inline simd4f simd4f_ldexp(simd4f x, simd4f n) {
+    _simd4f_union u = {x};
+    _simd4f_union un = {n};
+    for(int i = 0; i < 4; ++i) {
+        const float c = un.f[i] < -252.0f ? -252.0f : un.f[i] > 254.0f ? 254.0f : un.f[i];
+        u.f[i] = ldexpf( u.f[i], (int)c );
+    }
+    return u.s;
+}
+
+// Mantissa in [0.5, 1) with x = m * 2^e like frexpf, zero, inf and nan
+// give themselves with e 0
+vectorial_inline simd4f simd4f_frexp(simd4f x, simd4f *e) {
+    _simd4f_union u = {x};
+    _simd4f_union ue;
+    for(int i = 0; i < 4; ++i) {
+        int ei = 0;
+        u.f[i] = frexpf( u.f[i], &ei );
+        ue.f[i] = (float)ei;
+    }
+    *e = ue.s;
+    return u.s;
+}
+
+
+
+// comparing, masks have all bits set where true and none where false
+
+typedef int simd4f_mask __attribute__ ((vector_size (16)));
+
+vectorial_inline simd4f_mask simd4f_cmpeq(simd4f lhs, simd4f rhs) { return (simd4f_mask)( lhs == rhs ); }
+vectorial_inline simd4f_mask simd4f_cmpne(simd4f lhs, simd4f rhs) { return (simd4f_mask)( lhs != rhs ); }
+vectorial_inline simd4f_mask simd4f_cmplt(simd4f lhs, simd4f rhs) { return (simd4f_mask)( lhs < rhs ); }
+vectorial_inline simd4f_mask simd4f_cmple(simd4f lhs, simd4f rhs) { return (simd4f_mask)( lhs <= rhs ); }
+vectorial_inline simd4f_mask simd4f_cmpgt(simd4f lhs, simd4f rhs) { return (simd4f_mask)( lhs > rhs ); }
+vectorial_inline simd4f_mask simd4f_cmpge(simd4f lhs, simd4f rhs) { return (simd4f_mask)( lhs >= rhs ); }
+
+vectorial_inline simd4f_mask simd4f_mask_and(simd4f_mask lhs, simd4f_mask rhs) { return lhs & rhs; }
+vectorial_inline simd4f_mask simd4f_mask_or(simd4f_mask lhs, simd4f_mask rhs) { return lhs | rhs; }
+vectorial_inline simd4f_mask simd4f_mask_xor(simd4f_mask lhs, simd4f_mask rhs) { return lhs ^ rhs; }
+vectorial_inline simd4f_mask simd4f_mask_not(simd4f_mask v) { return ~v; }
+
+// a where the mask is set, b elsewhere
+vectorial_inline simd4f simd4f_select(simd4f_mask mask, simd4f a, simd4f b) {
+    return (simd4f)( (mask & (simd4f_mask)a) | (~mask & (simd4f_mask)b) );
+}
+
+// Lane i of the mask in bit i
+vectorial_inline int simd4f_movemask(simd4f_mask mask) {
+    const simd4f_mask bits = { 1, 2, 4, 8 };
+    const simd4f_mask m = mask & bits;
+    return m[0] | m[1] | m[2] | m[3];
+}
 
 
 #ifdef __cplusplus
@@ -0,0 +1,297 @@
+/*
+  Vectorial
+  Copyright (c) 2010 Mikko Lehtonen
+  Licensed under the terms of the two-clause BSD License (see LICENSE)
+*/
+#ifndef VECTORIAL_SIMD4F_MATH_H
+#define VECTORIAL_SIMD4F_MATH_H
+
+#ifndef VECTORIAL_SIMD4F_H
+  #include "vectorial/simd4f.h"
+#endif
+
+#ifndef VECTORIAL_SIMD4I_H
+  #include "vectorial/simd4i.h"
+#endif
+
+/*
+  Elementary functions over the four lanes, polynomial approximations
+  built on the simd4f operations so every backend gets them.
+
+  sin, cos and sincos reduce by pi/2 in three parts (Cody-Waite), pick
+  the quadrant with the integer simd4i bits of the multiple and use
+  the cephes minimax polynomials on [-pi/4, pi/4]. Against a double libm
+  the error is at most 2 ulp for |x| <= 8192, or 2^-24 absolute near the
+  zeros of the functions. tan is sin/cos of the same reduction, at most
+  5 ulp over the same range away from the poles. Past that the reduction
+  loses accuracy, and inf or nan give nan.
+
+  exp, exp2, log and log2 are the cephes ones. exp and exp2 are within
+  2 ulp for normal results and go to zero and infinity past the range,
+  log and log2 within 2 ulp or 2^-24 absolute for positive normal x, and
+  denormals unless the fpu flushes them. Zero gives -inf, negatives nan
+  and +inf itself. Nan in is nan out.
+  pow is exp2(y * log2(x)) for x >= 0, so the log2 error is scaled by y:
+  the relative error is within (2 + |y log2(x)|) * 2^-23. Special values
+  follow C99 for x >= 0: pow of zero is exactly zero for y > 0, so black
+  stays black through a gamma curve, and inf for y < 0. y zero or x one
+  give one, even with a nan for the other, and +inf gives inf for y > 0
+  and zero for y < 0. Negative x gives nan.
+
+  The special values are picked out by the integer bits, -ffast-math lets
+  the compiler assume floats are never inf or nan and fold the float
+  comparisons.
+
+  The _fast variants trade accuracy for about half the work, with a
+  relative error of 2^-12 for exp2 and exp, and an absolute 2^-12 for log2
+  and log. pow_fast relative within 2^-12 * (1 + |y|).
+*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+// a where the mask is all ones and b where it's zero
+vectorial_inline simd4f _simd4f_math_blend(simd4i mask, simd4f a, simd4f b) {
+    return simd4i_as_simd4f( simd4i_or( simd4i_and(mask, simd4f_as_simd4i(a)), simd4i_and(simd4i_not(mask), simd4f_as_simd4i(b)) ) );
+}
+
+// Flips the sign where bit 1 of q is set
+vectorial_inline simd4f _simd4f_math_negate_bit1(simd4f v, simd4i q) {
+    const simd4i sign = simd4i_shift_left( simd4i_and(q, simd4i_splat(2)), 30 );
+    return simd4i_as_simd4f( simd4i_xor(simd4f_as_simd4i(v), sign) );
+}
+
+// x = r + q*pi/2 with r in [-pi/4, pi/4], returns r and q
+vectorial_inline simd4f _simd4f_trig_reduce(simd4f x, simd4i *q) {
+    const simd4i qi = simd4f_to_simd4i_round( simd4f_mul(x, simd4f_splat(0.636619772367581343f)) );
+    const simd4f qf = simd4i_to_simd4f(qi);
+    *q = qi;
+
+    simd4f r = simd4f_madd( qf, simd4f_splat(-1.5703125f), x );
+    _SIMD4F_BARRIER(r);
+    r = simd4f_madd( qf, simd4f_splat(-4.837512969970703125e-4f), r );
+    _SIMD4F_BARRIER(r);
+    r = simd4f_madd( qf, simd4f_splat(-7.54978995489188216e-8f), r );
+    return r;
+}
+
+vectorial_inline simd4f _simd4f_sin_poly(simd4f r, simd4f z) {
+    simd4f p = simd4f_madd( z, simd4f_splat(-1.9515295891e-4f), simd4f_splat(8.3321608736e-3f) );
+    p = simd4f_madd( p, z, simd4f_splat(-1.6666654611e-1f) );
+    return simd4f_madd( simd4f_mul(p, z), r, r );
+}
+
+vectorial_inline simd4f _simd4f_cos_poly(simd4f z) {
+    simd4f p = simd4f_madd( z, simd4f_splat(2.443315711809948e-5f), simd4f_splat(-1.388731625493765e-3f) );
+    p = simd4f_madd( p, z, simd4f_splat(4.166664568298827e-2f) );
+    p = simd4f_madd( p, z, simd4f_splat(-0.5f) );
+    return simd4f_madd( p, z, simd4f_splat(1.0f) );
+}
+
+
+vectorial_inline void simd4f_sincos(simd4f v, simd4f *s, simd4f *c) {
+    simd4i q;
+    const simd4f r = _simd4f_trig_reduce(v, &q);
+    const simd4f z = simd4f_mul(r, r);
+    const simd4f ps = _simd4f_sin_poly(r, z);
+    const simd4f pc = _simd4f_cos_poly(z);
+
+    // Quadrants 0..3 give sin as  s, c, -s, -c  and cos as  c, -s, -c, s
+    const simd4i odd = simd4i_cmpeq( simd4i_and(q, simd4i_splat(1)), simd4i_splat(1) );
+    *s = _simd4f_math_negate_bit1( _simd4f_math_blend(odd, pc, ps), q );
+    *c = _simd4f_math_negate_bit1( _simd4f_math_blend(odd, ps, pc), simd4i_add(q, simd4i_splat(1)) );
+}
+
+vectorial_inline simd4f simd4f_sin(simd4f v) {
+    simd4i q;
+    const simd4f r = _simd4f_trig_reduce(v, &q);
+    const simd4f z = simd4f_mul(r, r);
+    const simd4i odd = simd4i_cmpeq( simd4i_and(q, simd4i_splat(1)), simd4i_splat(1) );
+    return _simd4f_math_negate_bit1( _simd4f_math_blend(odd, _simd4f_cos_poly(z), _simd4f_sin_poly(r, z)), q );
+}
+
+vectorial_inline simd4f simd4f_cos(simd4f v) {
+    simd4f s, c;
+    simd4f_sincos(v, &s, &c);
+    return c;
+}
+
+vectorial_inline simd4f simd4f_tan(simd4f v) {
+    simd4i q;
+    const simd4f r = _simd4f_trig_reduce(v, &q);
+    const simd4f z = simd4f_mul(r, r);
+    const simd4f ps = _simd4f_sin_poly(r, z);
+    const simd4f pc = _simd4f_cos_poly(z);
+
+    // tan(r + pi/2) = -cos(r) / sin(r), and period pi
+    const simd4i odd = simd4i_cmpeq( simd4i_and(q, simd4i_splat(1)), simd4i_splat(1) );
+    const simd4f n = _simd4f_math_negate_bit1( _simd4f_math_blend(odd, pc, ps), simd4i_shift_left(q, 1) );
+    return simd4f_div( n, _simd4f_math_blend(odd, ps, pc) );
+}
+
+
+// x itself where it's nan, else r
+vectorial_inline simd4f _simd4f_exp_special(simd4f x, simd4f r) {
+    const simd4i abs = simd4i_and( simd4f_as_simd4i(x), simd4i_splat(0x7fffffff) );
+    return _simd4f_math_blend( simd4i_cmpgt(abs, simd4i_splat(0x7f800000)), x, r );
+}
+
+vectorial_inline simd4f simd4f_exp(simd4f v) {
+    const simd4f x = simd4f_min( simd4f_max(v, simd4f_splat(-104.0f)), simd4f_splat(89.0f) );
+    const simd4f n = simd4f_floor( simd4f_madd(x, simd4f_splat(1.44269504088896341f), simd4f_splat(0.5f)) );
+
+    // x - n*ln(2) in two parts
+    simd4f r = simd4f_madd( n, simd4f_splat(-0.693359375f), x );
+    _SIMD4F_BARRIER(r);
+    r = simd4f_madd( n, simd4f_splat(2.12194440e-4f), r );
+
+    const simd4f z = simd4f_mul(r, r);
+    simd4f p = simd4f_madd( r, simd4f_splat(1.9875691500e-4f), simd4f_splat(1.3981999507e-3f) );
+    p = simd4f_madd( p, r, simd4f_splat(8.3334519073e-3f) );
+    p = simd4f_madd( p, r, simd4f_splat(4.1665795894e-2f) );
+    p = simd4f_madd( p, r, simd4f_splat(1.6666665459e-1f) );
+    p = simd4f_madd( p, r, simd4f_splat(5.0000001201e-1f) );
+    p = simd4f_madd( p, z, simd4f_add(r, simd4f_splat(1.0f)) );
+    return _simd4f_exp_special( v, simd4f_ldexp(p, n) );
+}
+
+vectorial_inline simd4f simd4f_exp2(simd4f v) {
+    const simd4f x = simd4f_min( simd4f_max(v, simd4f_splat(-151.0f)), simd4f_splat(129.0f) );
+    const simd4f n = simd4f_floor( simd4f_add(x, simd4f_splat(0.5f)) );
+    const simd4f f = simd4f_sub(x, n);
+
+    simd4f p = simd4f_madd( f, simd4f_splat(1.535336188319500e-4f), simd4f_splat(1.339887440266574e-3f) );
+    p = simd4f_madd( p, f, simd4f_splat(9.618437357674640e-3f) );
+    p = simd4f_madd( p, f, simd4f_splat(5.550332471162809e-2f) );
+    p = simd4f_madd( p, f, simd4f_splat(2.402264791363012e-1f) );
+    p = simd4f_madd( p, f, simd4f_splat(6.931472028550421e-1f) );
+    p = simd4f_madd( p, f, simd4f_splat(1.0f) );
+    return _simd4f_exp_special( v, simd4f_ldexp(p, n) );
+}
+
+// x = (1 + f) * 2^e with 1 + f in [sqrt(0.5), sqrt(2))
+vectorial_inline simd4f _simd4f_log_reduce(simd4f x, simd4f *e) {
+    simd4f ex;
+    const simd4f m = simd4f_frexp(x, &ex);
+    const simd4f up = simd4f_floor( simd4f_mul(m, simd4f_splat(1.41421356237309505f)) );
+    simd4f en = simd4f_add( ex, simd4f_sub(up, simd4f_splat(1.0f)) );
+    _SIMD4F_BARRIER(en);
+    *e = en;
+
+    // Doubled or not, exact
+    simd4f mn = simd4f_mul( m, simd4f_sub(simd4f_splat(2.0f), up) );
+    _SIMD4F_BARRIER(mn);
+    return simd4f_sub( mn, simd4f_splat(1.0f) );
+}
+
+// nan where x is negative, -inf where it's zero, x itself where it's +inf
+// or nan, else r
+vectorial_inline simd4f _simd4f_log_special(simd4f x, simd4f r) {
+    const simd4i bits = simd4f_as_simd4i(x);
+    const simd4i zero = simd4i_zero();
+    r = _simd4f_math_blend( simd4i_cmplt(bits, zero), simd4i_as_simd4f(simd4i_splat(0x7fc00000)), r );
+    r = _simd4f_math_blend( simd4i_cmpeq(simd4i_and(bits, simd4i_splat(0x7fffffff)), zero), simd4i_as_simd4f(simd4i_splat((int)0xff800000)), r );
+    return _simd4f_math_blend( simd4i_cmpgt(bits, simd4i_splat(0x7f7fffff)), x, r );
+}
+
+// Zero where x is zero and y positive, one where y is zero or x one, else
+// r. The rest comes out of log2 and exp2.
+vectorial_inline simd4f _simd4f_pow_special(simd4f x, simd4f y, simd4f r) {
+    const simd4i xb = simd4f_as_simd4i(x);
+    const simd4i yb = simd4f_as_simd4i(y);
+    const simd4i zero = simd4i_zero();
+    const simd4i abs = simd4i_splat(0x7fffffff);
+    const simd4i x_zero = simd4i_cmpeq( simd4i_and(xb, abs), zero );
+    const simd4i y_positive = simd4i_and( simd4i_cmpgt(yb, zero), simd4i_cmplt(yb, simd4i_splat(0x7f800001)) );
+    const simd4i one = simd4i_or( simd4i_cmpeq(simd4i_and(yb, abs), zero), simd4i_cmpeq(xb, simd4i_splat(0x3f800000)) );
+    r = _simd4f_math_blend( simd4i_and(x_zero, y_positive), simd4f_zero(), r );
+    return _simd4f_math_blend( one, simd4f_splat(1.0f), r );
+}
+
+// log(1 + f) - f + f^2/2
+vectorial_inline simd4f _simd4f_log_poly(simd4f f, simd4f z) {
+    simd4f p = simd4f_madd( f, simd4f_splat(7.0376836292e-2f), simd4f_splat(-1.1514610310e-1f) );
+    p = simd4f_madd( p, f, simd4f_splat(1.1676998740e-1f) );
+    p = simd4f_madd( p, f, simd4f_splat(-1.2420140846e-1f) );
+    p = simd4f_madd( p, f, simd4f_splat(1.4249322787e-1f) );
+    p = simd4f_madd( p, f, simd4f_splat(-1.6668057665e-1f) );
+    p = simd4f_madd( p, f, simd4f_splat(2.0000714765e-1f) );
+    p = simd4f_madd( p, f, simd4f_splat(-2.4999993993e-1f) );
+    p = simd4f_madd( p, f, simd4f_splat(3.3333331174e-1f) );
+    return simd4f_mul( simd4f_mul(p, f), z );
+}
+
+vectorial_inline simd4f simd4f_log(simd4f v) {
+    simd4f e;
+    const simd4f f = _simd4f_log_reduce(v, &e);
+    const simd4f z = simd4f_mul(f, f);
+    simd4f y = simd4f_madd( e, simd4f_splat(-2.12194440e-4f), _simd4f_log_poly(f, z) );
+    y = simd4f_madd( z, simd4f_splat(-0.5f), y );
+    return _simd4f_log_special( v, simd4f_madd( e, simd4f_splat(0.693359375f), simd4f_add(f, y) ) );
+}
+
+vectorial_inline simd4f simd4f_log2(simd4f v) {
+    simd4f e;
+    const simd4f f = _simd4f_log_reduce(v, &e);
+    const simd4f z = simd4f_mul(f, f);
+    const simd4f y = simd4f_madd( z, simd4f_splat(-0.5f), _simd4f_log_poly(f, z) );
+
+    // log2(e) - 1 applied separately to keep the bits of f + y
+    const simd4f l2ea = simd4f_splat(0.44269504088896340736f);
+    simd4f r = simd4f_mul( y, l2ea );
+    _SIMD4F_BARRIER(r);
+    r = simd4f_madd( f, l2ea, r );
+    _SIMD4F_BARRIER(r);
+    r = simd4f_add( r, y );
+    _SIMD4F_BARRIER(r);
+    r = simd4f_add( r, f );
+    _SIMD4F_BARRIER(r);
+    return _simd4f_log_special( v, simd4f_add( r, e ) );
+}
+
+vectorial_inline simd4f simd4f_pow(simd4f x, simd4f y) {
+    return _simd4f_pow_special( x, y, simd4f_exp2( simd4f_mul(y, simd4f_log2(x)) ) );
+}
+
+
+vectorial_inline simd4f simd4f_exp2_fast(simd4f v) {
+    const simd4f x = simd4f_min( simd4f_max(v, simd4f_splat(-151.0f)), simd4f_splat(129.0f) );
+    const simd4f n = simd4f_floor( simd4f_add(x, simd4f_splat(0.5f)) );
+    const simd4f f = simd4f_sub(x, n);
+
+    simd4f p = simd4f_madd( f, simd4f_splat(5.575464978045944e-2f), simd4f_splat(2.420353301905411e-1f) );
+    p = simd4f_madd( p, f, simd4f_splat(6.931471805599452e-1f) );
+    p = simd4f_madd( p, f, simd4f_splat(1.0f) );
+    return _simd4f_exp_special( v, simd4f_ldexp(p, n) );
+}
+
+vectorial_inline simd4f simd4f_exp_fast(simd4f v) {
+    return simd4f_exp2_fast( simd4f_mul(v, simd4f_splat(1.44269504088896341f)) );
+}
+
+vectorial_inline simd4f simd4f_log2_fast(simd4f v) {
+    simd4f e;
+    const simd4f f = _simd4f_log_reduce(v, &e);
+    simd4f p = simd4f_madd( f, simd4f_splat(-3.22623590786975e-1f), simd4f_splat(5.101832372272224e-1f) );
+    p = simd4f_madd( p, f, simd4f_splat(-7.246998473568264e-1f) );
+    p = simd4f_madd( p, f, simd4f_splat(1.4423070538781522f) );
+    return _simd4f_log_special( v, simd4f_madd( p, f, e ) );
+}
+
+vectorial_inline simd4f simd4f_log_fast(simd4f v) {
+    return simd4f_mul( simd4f_log2_fast(v), simd4f_splat(0.693147180559945309f) );
+}
+
+vectorial_inline simd4f simd4f_pow_fast(simd4f x, simd4f y) {
+    return _simd4f_pow_special( x, y, simd4f_exp2_fast( simd4f_mul(y, simd4f_log2_fast(x)) ) );
+}
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif
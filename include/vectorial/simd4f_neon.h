@@ -22,6 +22,14 @@ typedef union {
     float f[4];
 } _simd4f_union;
 
+// Keeps -ffast-math from reordering arithmetic across v, for the places
+// where the order carries the precision
+#if defined(__GNUC__)
+    #define _SIMD4F_BARRIER(v) __asm__("" : "+w"(v))
+#else
+    #define _SIMD4F_BARRIER(v) (void)(v)
+#endif
+
 
 
 vectorial_inline simd4f simd4f_create(float x, float y, float z, float w) {
@@ -178,7 +186,11 @@ vectorial_inline simd4f simd4f_div(simd4f lhs, simd4f rhs) {
 }
 
 vectorial_inline simd4f simd4f_madd(simd4f m1, simd4f m2, simd4f a) {
+#if defined(VECTORIAL_HAVE_FMA)
+    return vfmaq_f32( a, m1, m2 );
+#else
     return vmlaq_f32( a, m1, m2 );
+#endif
 }
 
 
@@ -271,6 +283,88 @@ vectorial_inline simd4f simd4f_max(simd4f a, simd4f b) {
     return vmaxq_f32( a, b ); 
 }
 
+vectorial_inline simd4f simd4f_floor(simd4f v) {
+#if defined(__aarch64__)
+    return vrndmq_f32( v );
+#else
+    // Truncate and step down where that rounded up, values past 2^23 are
+    // already integral (and would overflow the conversion), as are inf and nan
+    const simd4f t = vcvtq_f32_s32( vcvtq_s32_f32(v) );
+    const uint32x4_t up = vcgtq_f32( t, v );
+    const simd4f r = vsubq_f32( t, vreinterpretq_f32_u32( vandq_u32( up, vreinterpretq_u32_f32(vdupq_n_f32(1.0f)) ) ) );
+    const uint32x4_t small = vcaltq_f32( v, vdupq_n_f32(8388608.0f) );
+    return vbslq_f32( small, r, v );
+#endif
+}
+
+// x * 2^n for integral n, n clamped to [-252, 254]
+vectorial_inline simd4f simd4f_ldexp(simd4f x, simd4f n) {
+    // Two steps so that results past the normal range under or overflow
+    const int32x4_t ni = vminq_s32( vmaxq_s32( vcvtq_s32_f32(n), vdupq_n_s32(-252) ), vdupq_n_s32(254) );
+    const int32x4_t n1 = vshrq_n_s32( ni, 1 );
+    const int32x4_t n2 = vsubq_s32( ni, n1 );
+    const int32x4_t bias = vdupq_n_s32( 127 );
+    const simd4f s1 = vreinterpretq_f32_s32( vshlq_n_s32( vaddq_s32(n1, bias), 23 ) );
+    const simd4f s2 = vreinterpretq_f32_s32( vshlq_n_s32( vaddq_s32(n2, bias), 23 ) );
+    simd4f r = vmulq_f32( x, s1 );
+    _SIMD4F_BARRIER(r);
+    return vmulq_f32( r, s2 );
+}
+
+// Mantissa in [0.5, 1) with x = m * 2^e like frexpf, zero, inf and nan
+// give themselves with e 0
+vectorial_inline simd4f simd4f_frexp(simd4f x, simd4f *e) {
+    const simd4f a = vabsq_f32( x );
+    const uint32x4_t special = vorrq_u32( vceqq_f32(a, vdupq_n_f32(0.0f)), vmvnq_u32( vcleq_f32(a, vdupq_n_f32(3.40282347e+38f)) ) );
+
+    // Denormals scaled up to normals first
+    const uint32x4_t tiny = vcltq_f32( a, vdupq_n_f32(1.17549435e-38f) );
+    const simd4f xs = vbslq_f32( tiny, vmulq_f32(x, vdupq_n_f32(16777216.0f)), x );
+
+    const uint32x4_t bits = vreinterpretq_u32_f32( xs );
+    const uint32x4_t biased = vshrq_n_u32( vshlq_n_u32(bits, 1), 24 );
+    const simd4f offset = vbslq_f32( tiny, vdupq_n_f32(150.0f), vdupq_n_f32(126.0f) );
+    const simd4f ex = vsubq_f32( vcvtq_f32_u32(biased), offset );
+    const simd4f m = vreinterpretq_f32_u32( vorrq_u32( vandq_u32(bits, vdupq_n_u32(0x807fffff)), vdupq_n_u32(0x3f000000) ) );
+
+    *e = vbslq_f32( special, vdupq_n_f32(0.0f), ex );
+    return vbslq_f32( special, x, m );
+}
+
+
+// comparing, masks have all bits set where true and none where false
+
+typedef uint32x4_t simd4f_mask;
+
+vectorial_inline simd4f_mask simd4f_cmpeq(simd4f lhs, simd4f rhs) { return vceqq_f32( lhs, rhs ); }
+vectorial_inline simd4f_mask simd4f_cmpne(simd4f lhs, simd4f rhs) { return vmvnq_u32( vceqq_f32(lhs, rhs) ); }
+vectorial_inline simd4f_mask simd4f_cmplt(simd4f lhs, simd4f rhs) { return vcltq_f32( lhs, rhs ); }
+vectorial_inline simd4f_mask simd4f_cmple(simd4f lhs, simd4f rhs) { return vcleq_f32( lhs, rhs ); }
+vectorial_inline simd4f_mask simd4f_cmpgt(simd4f lhs, simd4f rhs) { return vcgtq_f32( lhs, rhs ); }
+vectorial_inline simd4f_mask simd4f_cmpge(simd4f lhs, simd4f rhs) { return vcgeq_f32( lhs, rhs ); }
+
+vectorial_inline simd4f_mask simd4f_mask_and(simd4f_mask lhs, simd4f_mask rhs) { return vandq_u32( lhs, rhs ); }
+vectorial_inline simd4f_mask simd4f_mask_or(simd4f_mask lhs, simd4f_mask rhs) { return vorrq_u32( lhs, rhs ); }
+vectorial_inline simd4f_mask simd4f_mask_xor(simd4f_mask lhs, simd4f_mask rhs) { return veorq_u32( lhs, rhs ); }
+vectorial_inline simd4f_mask simd4f_mask_not(simd4f_mask v) { return vmvnq_u32( v ); }
+
+// a where the mask is set, b elsewhere
+vectorial_inline simd4f simd4f_select(simd4f_mask mask, simd4f a, simd4f b) {
+    return vbslq_f32( mask, a, b );
+}
+
+// Lane i of the mask in bit i
+vectorial_inline int simd4f_movemask(simd4f_mask mask) {
+    const uint32_t weights[4] = { 1, 2, 4, 8 };
+    const uint32x4_t m = vandq_u32( mask, vld1q_u32(weights) );
+#if defined(__aarch64__)
+    return (int)vaddvq_u32( m );
+#else
+    const uint32x2_t s = vorr_u32( vget_low_u32(m), vget_high_u32(m) );
+    return (int)vget_lane_u32( vpadd_u32(s, s), 0 );
+#endif
+}
+
 
 #ifdef __cplusplus
 }
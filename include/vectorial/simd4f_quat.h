@@ -0,0 +1,250 @@
+/*
+  Vectorial
+  Copyright (c) 2010 Mikko Lehtonen
+  Licensed under the terms of the two-clause BSD License (see LICENSE)
+*/
+#ifndef VECTORIAL_SIMD4F_QUAT_H
+#define VECTORIAL_SIMD4F_QUAT_H
+
+#ifndef VECTORIAL_SIMD4X4F_H
+  #include "vectorial/simd4x4f.h"
+#endif
+
+#ifndef VECTORIAL_SIMD4F_MATH_H
+  #include "vectorial/simd4f_math.h"
+#endif
+
+#include <math.h>
+#include <stddef.h>
+
+/*
+  Rotation quaternions in a simd4f, x y z is the vector part and w the
+  scalar part. Rotations match simd4x4f_axis_rotation and multiplication
+  order matches matrices, rotating by simd4f_quat_mul(a, b) rotates by b
+  first.
+
+  The array versions blend whole poses, four quaternions at a time
+  transposed to one register per component.
+*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+vectorial_inline simd4f simd4f_quat_identity() {
+    return simd4f_create(0.0f, 0.0f, 0.0f, 1.0f);
+}
+
+vectorial_inline simd4f simd4f_quat_axis_rotation(float radians, simd4f axis) {
+    const float h = radians * 0.5f;
+    const simd4f v = simd4f_mul( simd4f_zero_w( simd4f_normalize3(axis) ), simd4f_splat(sinf(h)) );
+    return simd4f_add( v, simd4f_create(0.0f, 0.0f, 0.0f, cosf(h)) );
+}
+
+vectorial_inline simd4f simd4f_quat_conjugate(simd4f q) {
+    return simd4f_mul( q, simd4f_create(-1.0f, -1.0f, -1.0f, 1.0f) );
+}
+
+vectorial_inline simd4f simd4f_quat_mul(simd4f a, simd4f b) {
+    // v = wa vb + wb va + va x vb, w = wa wb - va . vb
+    const simd4f v = simd4f_madd( simd4f_splat_w(a), b,
+                       simd4f_madd( simd4f_splat_w(b), simd4f_zero_w(a),
+                         simd4f_cross3(a, b) ) );
+    return simd4f_sub( v, simd4f_mul( simd4f_dot3(a, b), simd4f_create(0.0f, 0.0f, 0.0f, 1.0f) ) );
+}
+
+vectorial_inline simd4f simd4f_quat_normalize(simd4f q) {
+    return simd4f_normalize4(q);
+}
+
+// Rotates the xyz of v, w passes through. Two cross products instead of
+// the full q v q*, t = 2 u x v, v' = v + w t + u x t
+vectorial_inline simd4f simd4f_quat_rotate3(simd4f q, simd4f v) {
+    const simd4f t = simd4f_cross3( simd4f_add(q, q), v );
+    return simd4f_add( v, simd4f_madd( simd4f_splat_w(q), simd4f_zero_w(t), simd4f_cross3(q, t) ) );
+}
+
+
+vectorial_inline void simd4f_quat_to_simd4x4f(simd4f q, simd4x4f* m) {
+    const float x = simd4f_get_x(q);
+    const float y = simd4f_get_y(q);
+    const float z = simd4f_get_z(q);
+    const float w = simd4f_get_w(q);
+
+    const float x2 = x + x, y2 = y + y, z2 = z + z;
+    const float xx = x * x2, yy = y * y2, zz = z * z2;
+    const float xy = x * y2, xz = x * z2, yz = y * z2;
+    const float wx = w * x2, wy = w * y2, wz = w * z2;
+
+    *m = simd4x4f_create( simd4f_create( 1.0f - (yy + zz), xy + wz,            xz - wy,            0.0f ),
+                          simd4f_create( xy - wz,            1.0f - (xx + zz), yz + wx,            0.0f ),
+                          simd4f_create( xz + wy,            yz - wx,            1.0f - (xx + yy), 0.0f ),
+                          simd4f_create( 0.0f,               0.0f,               0.0f,             1.0f ) );
+}
+
+// The rotation of the upper 3x3, which should be orthonormal
+vectorial_inline simd4f simd4f_quat_from_simd4x4f(const simd4x4f* m) {
+    const float m00 = simd4f_get_x(m->x), m10 = simd4f_get_y(m->x), m20 = simd4f_get_z(m->x);
+    const float m01 = simd4f_get_x(m->y), m11 = simd4f_get_y(m->y), m21 = simd4f_get_z(m->y);
+    const float m02 = simd4f_get_x(m->z), m12 = simd4f_get_y(m->z), m22 = simd4f_get_z(m->z);
+    const float trace = m00 + m11 + m22;
+
+    // Pick the largest of w, x, y, z to divide by
+    if( trace > 0.0f ) {
+        const float s = 0.5f / sqrtf(trace + 1.0f);
+        return simd4f_create( (m21 - m12) * s, (m02 - m20) * s, (m10 - m01) * s, 0.25f / s );
+    } else if( m00 > m11 && m00 > m22 ) {
+        const float s = 2.0f * sqrtf(1.0f + m00 - m11 - m22);
+        return simd4f_create( 0.25f * s, (m01 + m10) / s, (m02 + m20) / s, (m21 - m12) / s );
+    } else if( m11 > m22 ) {
+        const float s = 2.0f * sqrtf(1.0f + m11 - m00 - m22);
+        return simd4f_create( (m01 + m10) / s, 0.25f * s, (m12 + m21) / s, (m02 - m20) / s );
+    } else {
+        const float s = 2.0f * sqrtf(1.0f + m22 - m00 - m11);
+        return simd4f_create( (m02 + m20) / s, (m12 + m21) / s, 0.25f * s, (m10 - m01) / s );
+    }
+}
+
+
+
+// Four quaternions a component per register. b is negated where the dot
+// is negative so the blends take the short way around.
+
+vectorial_inline simd4f _simd4f_quat_soa_align(simd4f d, simd4f *bx, simd4f *by, simd4f *bz, simd4f *bw) {
+    const simd4f_mask neg = simd4f_cmplt(d, simd4f_zero());
+    *bx = simd4f_select(neg, simd4f_sub(simd4f_zero(), *bx), *bx);
+    *by = simd4f_select(neg, simd4f_sub(simd4f_zero(), *by), *by);
+    *bz = simd4f_select(neg, simd4f_sub(simd4f_zero(), *bz), *bz);
+    *bw = simd4f_select(neg, simd4f_sub(simd4f_zero(), *bw), *bw);
+    return simd4f_select(neg, simd4f_sub(simd4f_zero(), d), d);
+}
+
+vectorial_inline void _simd4f_quat_soa_load(const simd4f *q, simd4f *x, simd4f *y, simd4f *z, simd4f *w) {
+    simd4x4f m = simd4x4f_create(q[0], q[1], q[2], q[3]);
+    simd4x4f_transpose_inplace(&m);
+    *x = m.x; *y = m.y; *z = m.z; *w = m.w;
+}
+
+vectorial_inline simd4f _simd4f_quat_soa_dot(simd4f ax, simd4f ay, simd4f az, simd4f aw,
+                                             simd4f bx, simd4f by, simd4f bz, simd4f bw) {
+    return simd4f_madd(ax, bx, simd4f_madd(ay, by, simd4f_madd(az, bz, simd4f_mul(aw, bw))));
+}
+
+// Weighted sum wa a + wb b, normalized, stored back as four quaternions
+vectorial_inline void _simd4f_quat_soa_blend_store(simd4f wa, simd4f wb,
+                                                   simd4f ax, simd4f ay, simd4f az, simd4f aw,
+                                                   simd4f bx, simd4f by, simd4f bz, simd4f bw, simd4f *out) {
+    const simd4f x = simd4f_madd(wa, ax, simd4f_mul(wb, bx));
+    const simd4f y = simd4f_madd(wa, ay, simd4f_mul(wb, by));
+    const simd4f z = simd4f_madd(wa, az, simd4f_mul(wb, bz));
+    const simd4f w = simd4f_madd(wa, aw, simd4f_mul(wb, bw));
+    const simd4f invlen = simd4f_rsqrt( _simd4f_quat_soa_dot(x, y, z, w, x, y, z, w) );
+    simd4x4f m = simd4x4f_create( simd4f_mul(x, invlen), simd4f_mul(y, invlen), simd4f_mul(z, invlen), simd4f_mul(w, invlen) );
+    simd4x4f_transpose_inplace(&m);
+    out[0] = m.x; out[1] = m.y; out[2] = m.z; out[3] = m.w;
+}
+
+vectorial_inline void _simd4f_quat_nlerp4(const simd4f *a, const simd4f *b, simd4f t, simd4f *out) {
+    simd4f ax, ay, az, aw, bx, by, bz, bw;
+    _simd4f_quat_soa_load(a, &ax, &ay, &az, &aw);
+    _simd4f_quat_soa_load(b, &bx, &by, &bz, &bw);
+    _simd4f_quat_soa_align( _simd4f_quat_soa_dot(ax, ay, az, aw, bx, by, bz, bw), &bx, &by, &bz, &bw );
+    _simd4f_quat_soa_blend_store( simd4f_sub(simd4f_splat(1.0f), t), t, ax, ay, az, aw, bx, by, bz, bw, out );
+}
+
+// acos for [0,1] from Abramowitz and Stegun 4.4.46, |error| <= 2e-8
+vectorial_inline simd4f _simd4f_quat_acos01(simd4f x) {
+    simd4f p = simd4f_splat(-0.0012624911f);
+    p = simd4f_madd(p, x, simd4f_splat( 0.0066700901f));
+    p = simd4f_madd(p, x, simd4f_splat(-0.0170881256f));
+    p = simd4f_madd(p, x, simd4f_splat( 0.0308918810f));
+    p = simd4f_madd(p, x, simd4f_splat(-0.0501743046f));
+    p = simd4f_madd(p, x, simd4f_splat( 0.0889789874f));
+    p = simd4f_madd(p, x, simd4f_splat(-0.2145988016f));
+    p = simd4f_madd(p, x, simd4f_splat( 1.5707963050f));
+    return simd4f_mul( p, simd4f_sqrt( simd4f_max( simd4f_sub(simd4f_splat(1.0f), x), simd4f_zero() ) ) );
+}
+
+vectorial_inline void _simd4f_quat_slerp4(const simd4f *a, const simd4f *b, simd4f t, simd4f *out) {
+    simd4f ax, ay, az, aw, bx, by, bz, bw;
+    _simd4f_quat_soa_load(a, &ax, &ay, &az, &aw);
+    _simd4f_quat_soa_load(b, &bx, &by, &bz, &bw);
+    const simd4f d = _simd4f_quat_soa_align( _simd4f_quat_soa_dot(ax, ay, az, aw, bx, by, bz, bw), &bx, &by, &bz, &bw );
+
+    const simd4f one = simd4f_splat(1.0f);
+    const simd4f theta = _simd4f_quat_acos01( simd4f_min(d, one) );
+    const simd4f sa = simd4f_sin( simd4f_mul( simd4f_sub(one, t), theta ) );
+    const simd4f sb = simd4f_sin( simd4f_mul( t, theta ) );
+    const simd4f s = simd4f_sin( theta );
+
+    // Nearly equal quaternions divide by almost zero, lerp those instead.
+    // Both weights get the same scale, the normalize takes care of it.
+    const simd4f_mask near = simd4f_cmpgt(d, simd4f_splat(0.9995f));
+    const simd4f wa = simd4f_select(near, simd4f_sub(one, t), simd4f_div(sa, s));
+    const simd4f wb = simd4f_select(near, t, simd4f_div(sb, s));
+
+    _simd4f_quat_soa_blend_store( wa, wb, ax, ay, az, aw, bx, by, bz, bw, out );
+}
+
+typedef void (*_simd4f_quat_kernel4)(const simd4f *a, const simd4f *b, simd4f t, simd4f *out);
+
+// Whole groups of four in place, the last n % 4 through a padded copy
+vectorial_inline void _simd4f_quat_blend_array(const simd4f* a, const simd4f* b, float t, simd4f* out, size_t n, _simd4f_quat_kernel4 kernel) {
+    const simd4f tv = simd4f_splat(t);
+    size_t i = 0;
+    for(; i + 4 <= n; i += 4) {
+        kernel( a + i, b + i, tv, out + i );
+    }
+    if( i < n ) {
+        simd4f ta[4], tb[4], to[4];
+        size_t j;
+        for(j = 0; j < 4; ++j) {
+            ta[j] = i + j < n ? a[i + j] : simd4f_quat_identity();
+            tb[j] = i + j < n ? b[i + j] : simd4f_quat_identity();
+        }
+        kernel( ta, tb, tv, to );
+        for(j = 0; i + j < n; ++j) out[i + j] = to[j];
+    }
+}
+
+// out[i] = normalized lerp from a[i] to b[i] by t. out may be a or b.
+vectorial_inline void simd4f_quat_nlerp_array(const simd4f* a, const simd4f* b, float t, simd4f* out, size_t n) {
+    _simd4f_quat_blend_array(a, b, t, out, n, _simd4f_quat_nlerp4);
+}
+
+// out[i] = spherical interpolation from a[i] to b[i] by t, constant
+// angular speed unlike nlerp. out may be a or b.
+vectorial_inline void simd4f_quat_slerp_array(const simd4f* a, const simd4f* b, float t, simd4f* out, size_t n) {
+    _simd4f_quat_blend_array(a, b, t, out, n, _simd4f_quat_slerp4);
+}
+
+
+vectorial_inline simd4f simd4f_quat_nlerp(simd4f a, simd4f b, float t) {
+    const float d = simd4f_get_x( simd4f_dot4(a, b) );
+    const simd4f bb = d < 0.0f ? simd4f_sub(simd4f_zero(), b) : b;
+    return simd4f_normalize4( simd4f_madd( simd4f_sub(bb, a), simd4f_splat(t), a ) );
+}
+
+vectorial_inline simd4f simd4f_quat_slerp(simd4f a, simd4f b, float t) {
+    float d = simd4f_get_x( simd4f_dot4(a, b) );
+    if( d < 0.0f ) {
+        b = simd4f_sub(simd4f_zero(), b);
+        d = -d;
+    }
+    if( d > 0.9995f ) return simd4f_quat_nlerp(a, b, t);
+
+    const float theta = acosf(d);
+    const float s = sinf(theta);
+    const simd4f wa = simd4f_splat( sinf((1.0f - t) * theta) / s );
+    const simd4f wb = simd4f_splat( sinf(t * theta) / s );
+    return simd4f_madd( a, wa, simd4f_mul(b, wb) );
+}
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif
@@ -0,0 +1,249 @@
+/*
+  Vectorial
+  Copyright (c) 2010 Mikko Lehtonen
+  Licensed under the terms of the two-clause BSD License (see LICENSE)
+*/
+#ifndef VECTORIAL_SIMD4F_RAY_H
+#define VECTORIAL_SIMD4F_RAY_H
+
+#ifndef VECTORIAL_SIMD4F_AOS_H
+  #include "vectorial/simd4f_aos.h"
+#endif
+
+#ifndef VECTORIAL_SIMD8F_AOS_H
+  #include "vectorial/simd8f_aos.h"
+#endif
+
+#ifndef VECTORIAL_SIMD4I_H
+  #include "vectorial/simd4i.h"
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+  Ray packets, 4 or 8 rays in structure-of-arrays layout with lane i
+  holding ray i, tested against one triangle or box at a time. The
+  primitive is splatted over the lanes, so there are no horizontal
+  operations and every lane gets its own distance and mask bit.
+
+  Triangles are Moller-Trumbore and two-sided, boxes the slab test with
+  the reciprocal directions kept in the packet. Directions need not be
+  unit length, distances are then in multiples of the direction.
+
+  Direction components within 1e-20 of zero are taken as 1e-20 for the
+  reciprocal, keeping it finite. Fast math does not give the infinity a
+  division by zero should, and huge but finite slabs work the same. A ray
+  parallel to a slab hits if its origin is within it, but one lying in a
+  face of a box only hits the min faces, as if leaning slightly towards +.
+*/
+
+typedef struct {
+    simd4f ox, oy, oz;
+    simd4f dx, dy, dz;
+    simd4f rx, ry, rz;
+} simd4f_ray_packet;
+
+typedef struct {
+    simd8f ox, oy, oz;
+    simd8f dx, dy, dz;
+    simd8f rx, ry, rz;
+} simd8f_ray_packet;
+
+
+vectorial_inline simd4f _simd4f_ray_reciprocal(simd4f d) {
+    const simd4f tiny = simd4f_splat(1e-20f);
+    const simd4f magnitude = simd4f_max( d, simd4f_sub(simd4f_zero(), d) );
+    return simd4f_div( simd4f_splat(1.0f), simd4f_select( simd4f_cmplt(magnitude, tiny), tiny, d ) );
+}
+
+vectorial_inline simd8f _simd8f_ray_reciprocal(simd8f d) {
+    const simd8f tiny = simd8f_splat(1e-20f);
+    const simd8f magnitude = simd8f_max( d, simd8f_sub(simd8f_zero(), d) );
+    return simd8f_div( simd8f_splat(1.0f), simd8f_select( simd8f_cmplt(magnitude, tiny), tiny, d ) );
+}
+
+
+// Origins and directions as 4 or 8 vectors stride floats apart, see simd4f_aos.h
+
+vectorial_inline void simd4f_ray_packet_load(const float *origins, const float *directions, size_t stride, simd4f_ray_packet* out) {
+    simd4f_aos_load3(origins, stride, &out->ox, &out->oy, &out->oz);
+    simd4f_aos_load3(directions, stride, &out->dx, &out->dy, &out->dz);
+    out->rx = _simd4f_ray_reciprocal(out->dx);
+    out->ry = _simd4f_ray_reciprocal(out->dy);
+    out->rz = _simd4f_ray_reciprocal(out->dz);
+}
+
+vectorial_inline void simd8f_ray_packet_load(const float *origins, const float *directions, size_t stride, simd8f_ray_packet* out) {
+    simd8f_aos_load3(origins, stride, &out->ox, &out->oy, &out->oz);
+    simd8f_aos_load3(directions, stride, &out->dx, &out->dy, &out->dz);
+    out->rx = _simd8f_ray_reciprocal(out->dx);
+    out->ry = _simd8f_ray_reciprocal(out->dy);
+    out->rz = _simd8f_ray_reciprocal(out->dz);
+}
+
+
+// Lanes hitting the triangle closer than *t, where *t is set to the hit
+// distance. Start with *t at the far limit, f.ex. FLT_MAX or a ray length,
+// and pass it on to keep the closest hit over many triangles.
+vectorial_inline simd4f_mask simd4f_ray_triangle(const simd4f_ray_packet* r, simd4f v0, simd4f v1, simd4f v2, simd4f* t) {
+    const simd4f e1 = simd4f_sub(v1, v0);
+    const simd4f e2 = simd4f_sub(v2, v0);
+    const simd4f e1x = simd4f_splat_x(e1), e1y = simd4f_splat_y(e1), e1z = simd4f_splat_z(e1);
+    const simd4f e2x = simd4f_splat_x(e2), e2y = simd4f_splat_y(e2), e2z = simd4f_splat_z(e2);
+
+    // p = d x e2, det = e1 . p
+    const simd4f px = simd4f_sub( simd4f_mul(r->dy, e2z), simd4f_mul(r->dz, e2y) );
+    const simd4f py = simd4f_sub( simd4f_mul(r->dz, e2x), simd4f_mul(r->dx, e2z) );
+    const simd4f pz = simd4f_sub( simd4f_mul(r->dx, e2y), simd4f_mul(r->dy, e2x) );
+    const simd4f det = simd4f_madd( e1x, px, simd4f_madd( e1y, py, simd4f_mul(e1z, pz) ) );
+    const simd4f invdet = simd4f_div( simd4f_splat(1.0f), det );
+
+    // s = o - v0, q = s x e1
+    const simd4f sx = simd4f_sub( r->ox, simd4f_splat_x(v0) );
+    const simd4f sy = simd4f_sub( r->oy, simd4f_splat_y(v0) );
+    const simd4f sz = simd4f_sub( r->oz, simd4f_splat_z(v0) );
+    const simd4f qx = simd4f_sub( simd4f_mul(sy, e1z), simd4f_mul(sz, e1y) );
+    const simd4f qy = simd4f_sub( simd4f_mul(sz, e1x), simd4f_mul(sx, e1z) );
+    const simd4f qz = simd4f_sub( simd4f_mul(sx, e1y), simd4f_mul(sy, e1x) );
+
+    const simd4f u = simd4f_mul( simd4f_madd( sx, px, simd4f_madd( sy, py, simd4f_mul(sz, pz) ) ), invdet );
+    const simd4f v = simd4f_mul( simd4f_madd( r->dx, qx, simd4f_madd( r->dy, qy, simd4f_mul(r->dz, qz) ) ), invdet );
+    const simd4f d = simd4f_mul( simd4f_madd( e2x, qx, simd4f_madd( e2y, qy, simd4f_mul(e2z, qz) ) ), invdet );
+
+    const simd4f zero = simd4f_zero();
+    simd4f_mask hit = simd4f_cmpne(det, zero);
+    hit = simd4f_mask_and( hit, simd4f_mask_and( simd4f_cmpge(u, zero), simd4f_cmpge(v, zero) ) );
+    hit = simd4f_mask_and( hit, simd4f_cmple( simd4f_add(u, v), simd4f_splat(1.0f) ) );
+    hit = simd4f_mask_and( hit, simd4f_mask_and( simd4f_cmpgt(d, zero), simd4f_cmplt(d, *t) ) );
+
+    *t = simd4f_select(hit, d, *t);
+    return hit;
+}
+
+// Lanes entering the box before tmax, with the entry distance in tnear
+// for those. Rays starting inside enter at 0.
+vectorial_inline simd4f_mask simd4f_ray_aabb(const simd4f_ray_packet* r, simd4f aabb_min, simd4f aabb_max, simd4f tmax, simd4f* tnear) {
+    const simd4f t0x = simd4f_mul( simd4f_sub( simd4f_splat_x(aabb_min), r->ox ), r->rx );
+    const simd4f t1x = simd4f_mul( simd4f_sub( simd4f_splat_x(aabb_max), r->ox ), r->rx );
+    const simd4f t0y = simd4f_mul( simd4f_sub( simd4f_splat_y(aabb_min), r->oy ), r->ry );
+    const simd4f t1y = simd4f_mul( simd4f_sub( simd4f_splat_y(aabb_max), r->oy ), r->ry );
+    const simd4f t0z = simd4f_mul( simd4f_sub( simd4f_splat_z(aabb_min), r->oz ), r->rz );
+    const simd4f t1z = simd4f_mul( simd4f_sub( simd4f_splat_z(aabb_max), r->oz ), r->rz );
+
+    const simd4f enter = simd4f_max( simd4f_max( simd4f_min(t0x, t1x), simd4f_min(t0y, t1y) ),
+                                     simd4f_max( simd4f_min(t0z, t1z), simd4f_zero() ) );
+    const simd4f leave = simd4f_min( simd4f_min( simd4f_max(t0x, t1x), simd4f_max(t0y, t1y) ),
+                                     simd4f_min( simd4f_max(t0z, t1z), tmax ) );
+
+    const simd4f_mask hit = simd4f_cmple(enter, leave);
+    *tnear = simd4f_select(hit, enter, *tnear);
+    return hit;
+}
+
+
+// 8 wide versions of the above
+
+vectorial_inline simd8f_mask simd8f_ray_triangle(const simd8f_ray_packet* r, simd4f v0, simd4f v1, simd4f v2, simd8f* t) {
+    const simd4f e1 = simd4f_sub(v1, v0);
+    const simd4f e2 = simd4f_sub(v2, v0);
+    const simd8f e1x = simd8f_splat( simd4f_get_x(e1) ), e1y = simd8f_splat( simd4f_get_y(e1) ), e1z = simd8f_splat( simd4f_get_z(e1) );
+    const simd8f e2x = simd8f_splat( simd4f_get_x(e2) ), e2y = simd8f_splat( simd4f_get_y(e2) ), e2z = simd8f_splat( simd4f_get_z(e2) );
+
+    const simd8f px = simd8f_sub( simd8f_mul(r->dy, e2z), simd8f_mul(r->dz, e2y) );
+    const simd8f py = simd8f_sub( simd8f_mul(r->dz, e2x), simd8f_mul(r->dx, e2z) );
+    const simd8f pz = simd8f_sub( simd8f_mul(r->dx, e2y), simd8f_mul(r->dy, e2x) );
+    const simd8f det = simd8f_madd( e1x, px, simd8f_madd( e1y, py, simd8f_mul(e1z, pz) ) );
+    const simd8f invdet = simd8f_div( simd8f_splat(1.0f), det );
+
+    const simd8f sx = simd8f_sub( r->ox, simd8f_splat( simd4f_get_x(v0) ) );
+    const simd8f sy = simd8f_sub( r->oy, simd8f_splat( simd4f_get_y(v0) ) );
+    const simd8f sz = simd8f_sub( r->oz, simd8f_splat( simd4f_get_z(v0) ) );
+    const simd8f qx = simd8f_sub( simd8f_mul(sy, e1z), simd8f_mul(sz, e1y) );
+    const simd8f qy = simd8f_sub( simd8f_mul(sz, e1x), simd8f_mul(sx, e1z) );
+    const simd8f qz = simd8f_sub( simd8f_mul(sx, e1y), simd8f_mul(sy, e1x) );
+
+    const simd8f u = simd8f_mul( simd8f_madd( sx, px, simd8f_madd( sy, py, simd8f_mul(sz, pz) ) ), invdet );
+    const simd8f v = simd8f_mul( simd8f_madd( r->dx, qx, simd8f_madd( r->dy, qy, simd8f_mul(r->dz, qz) ) ), invdet );
+    const simd8f d = simd8f_mul( simd8f_madd( e2x, qx, simd8f_madd( e2y, qy, simd8f_mul(e2z, qz) ) ), invdet );
+
+    const simd8f zero = simd8f_zero();
+    simd8f_mask hit = simd8f_cmpne(det, zero);
+    hit = simd8f_mask_and( hit, simd8f_mask_and( simd8f_cmpge(u, zero), simd8f_cmpge(v, zero) ) );
+    hit = simd8f_mask_and( hit, simd8f_cmple( simd8f_add(u, v), simd8f_splat(1.0f) ) );
+    hit = simd8f_mask_and( hit, simd8f_mask_and( simd8f_cmpgt(d, zero), simd8f_cmplt(d, *t) ) );
+
+    *t = simd8f_select(hit, d, *t);
+    return hit;
+}
+
+vectorial_inline simd8f_mask simd8f_ray_aabb(const simd8f_ray_packet* r, simd4f aabb_min, simd4f aabb_max, simd8f tmax, simd8f* tnear) {
+    const simd8f t0x = simd8f_mul( simd8f_sub( simd8f_splat( simd4f_get_x(aabb_min) ), r->ox ), r->rx );
+    const simd8f t1x = simd8f_mul( simd8f_sub( simd8f_splat( simd4f_get_x(aabb_max) ), r->ox ), r->rx );
+    const simd8f t0y = simd8f_mul( simd8f_sub( simd8f_splat( simd4f_get_y(aabb_min) ), r->oy ), r->ry );
+    const simd8f t1y = simd8f_mul( simd8f_sub( simd8f_splat( simd4f_get_y(aabb_max) ), r->oy ), r->ry );
+    const simd8f t0z = simd8f_mul( simd8f_sub( simd8f_splat( simd4f_get_z(aabb_min) ), r->oz ), r->rz );
+    const simd8f t1z = simd8f_mul( simd8f_sub( simd8f_splat( simd4f_get_z(aabb_max) ), r->oz ), r->rz );
+
+    const simd8f enter = simd8f_max( simd8f_max( simd8f_min(t0x, t1x), simd8f_min(t0y, t1y) ),
+                                     simd8f_max( simd8f_min(t0z, t1z), simd8f_zero() ) );
+    const simd8f leave = simd8f_min( simd8f_min( simd8f_max(t0x, t1x), simd8f_max(t0y, t1y) ),
+                                     simd8f_min( simd8f_max(t0z, t1z), tmax ) );
+
+    const simd8f_mask hit = simd8f_cmple(enter, leave);
+    *tnear = simd8f_select(hit, enter, *tnear);
+    return hit;
+}
+
+
+// Closest hit over n triangles, three vertices each. index gets the
+// triangle each lane hit, -1 for misses, and the result has bit i set
+// for the lanes that hit anything. *t is the far limit as above. The
+// indices are kept in simd4i, so any n up to INT32_MAX works.
+
+// a where the mask is set, b elsewhere, moving the int bits as they are
+vectorial_inline simd4i _simd4i_ray_select(simd4f_mask mask, simd4i a, simd4i b) {
+    return simd4f_as_simd4i( simd4f_select( mask, simd4i_as_simd4f(a), simd4i_as_simd4f(b) ) );
+}
+
+vectorial_inline int simd4f_ray_triangles(const simd4f_ray_packet* r, const simd4f* vertices, size_t n, simd4f* t, int32_t* index) {
+    simd4i closest = simd4i_splat(-1);
+    simd4f_mask any = simd4f_cmpne( simd4f_zero(), simd4f_zero() );
+    for(size_t i = 0; i < n; ++i) {
+        const simd4f_mask hit = simd4f_ray_triangle(r, vertices[3*i], vertices[3*i+1], vertices[3*i+2], t);
+        closest = _simd4i_ray_select( hit, simd4i_splat( (int)i ), closest );
+        any = simd4f_mask_or(any, hit);
+    }
+
+    simd4i_ustore4(closest, index);
+    return simd4f_movemask(any);
+}
+
+// The lanes of the 8-wide hit mask in two simd4f masks, one per half
+vectorial_inline void _simd8f_ray_split_mask(simd8f_mask mask, simd4f_mask* lo, simd4f_mask* hi) {
+    const simd8f lanes = simd8f_select( mask, simd8f_splat(1.0f), simd8f_zero() );
+    *lo = simd4f_cmpgt( simd8f_get_low(lanes), simd4f_zero() );
+    *hi = simd4f_cmpgt( simd8f_get_high(lanes), simd4f_zero() );
+}
+
+vectorial_inline int simd8f_ray_triangles(const simd8f_ray_packet* r, const simd4f* vertices, size_t n, simd8f* t, int32_t* index) {
+    simd4i closest_lo = simd4i_splat(-1), closest_hi = closest_lo;
+    simd8f_mask any = simd8f_cmpne( simd8f_zero(), simd8f_zero() );
+    for(size_t i = 0; i < n; ++i) {
+        const simd8f_mask hit = simd8f_ray_triangle(r, vertices[3*i], vertices[3*i+1], vertices[3*i+2], t);
+        if( simd8f_movemask(hit) == 0 ) continue;
+        simd4f_mask lo, hi;
+        _simd8f_ray_split_mask(hit, &lo, &hi);
+        const simd4i k = simd4i_splat( (int)i );
+        closest_lo = _simd4i_ray_select( lo, k, closest_lo );
+        closest_hi = _simd4i_ray_select( hi, k, closest_hi );
+        any = simd8f_mask_or(any, hit);
+    }
+
+    simd4i_ustore4(closest_lo, index);
+    simd4i_ustore4(closest_hi, index + 4);
+    return simd8f_movemask(any);
+}
+
+
+#endif
@@ -21,6 +21,14 @@ typedef struct {
     float w;
 } simd4f;
 
+// Keeps -ffast-math from reordering arithmetic across v, for the places
+// where the order carries the precision
+#if defined(__GNUC__)
+    #define _SIMD4F_BARRIER(v) __asm__("" : "+m"(v))
+#else
+    #define _SIMD4F_BARRIER(v) (void)(v)
+#endif
+
 
 
 vectorial_inline simd4f simd4f_create(float x, float y, float z, float w) {
@@ -189,6 +197,103 @@ vectorial_inline simd4f simd4f_max(simd4f a, simd4f b) {
                           a.w > b.w ? a.w : b.w );
 }
 
+vectorial_inline simd4f simd4f_floor(simd4f v) {
+    simd4f s = { floorf(v.x), floorf(v.y), floorf(v.z), floorf(v.w) };
+    return s;
+}
+
+vectorial_inline float _simd4f_ldexp_lane(float x, float n) {
+    return ldexpf( x, (int)(n < -252.0f ? -252.0f : n > 254.0f ? 254.0f : n) );
+}
+
+// x * 2^n for integral n, n clamped to [-252, 254]
+vectorial_inline simd4f simd4f_ldexp(simd4f x, simd4f n) {
+    simd4f s = { _simd4f_ldexp_lane(x.x, n.x), _simd4f_ldexp_lane(x.y, n.y),
+                 _simd4f_ldexp_lane(x.z, n.z), _simd4f_ldexp_lane(x.w, n.w) };
+    return s;
+}
+
+// Mantissa in [0.5, 1) with x = m * 2^e like frexpf, zero, inf and nan
+// give themselves with e 0
+vectorial_inline simd4f simd4f_frexp(simd4f x, simd4f *e) {
+    int ex, ey, ez, ew;
+    simd4f s = { frexpf(x.x, &ex), frexpf(x.y, &ey), frexpf(x.z, &ez), frexpf(x.w, &ew) };
+    simd4f se = { (float)ex, (float)ey, (float)ez, (float)ew };
+    *e = se;
+    return s;
+}
+
+
+// comparing, masks have all bits set where true and none where false
+
+typedef struct {
+    int x;
+    int y;
+    int z;
+    int w;
+} simd4f_mask;
+
+vectorial_inline simd4f_mask simd4f_cmpeq(simd4f lhs, simd4f rhs) {
+    simd4f_mask m = { -(lhs.x == rhs.x), -(lhs.y == rhs.y), -(lhs.z == rhs.z), -(lhs.w == rhs.w) };
+    return m;
+}
+
+vectorial_inline simd4f_mask simd4f_cmpne(simd4f lhs, simd4f rhs) {
+    simd4f_mask m = { -(lhs.x != rhs.x), -(lhs.y != rhs.y), -(lhs.z != rhs.z), -(lhs.w != rhs.w) };
+    return m;
+}
+
+vectorial_inline simd4f_mask simd4f_cmplt(simd4f lhs, simd4f rhs) {
+    simd4f_mask m = { -(lhs.x < rhs.x), -(lhs.y < rhs.y), -(lhs.z < rhs.z), -(lhs.w < rhs.w) };
+    return m;
+}
+
+vectorial_inline simd4f_mask simd4f_cmple(simd4f lhs, simd4f rhs) {
+    simd4f_mask m = { -(lhs.x <= rhs.x), -(lhs.y <= rhs.y), -(lhs.z <= rhs.z), -(lhs.w <= rhs.w) };
+    return m;
+}
+
+vectorial_inline simd4f_mask simd4f_cmpgt(simd4f lhs, simd4f rhs) {
+    simd4f_mask m = { -(lhs.x > rhs.x), -(lhs.y > rhs.y), -(lhs.z > rhs.z), -(lhs.w > rhs.w) };
+    return m;
+}
+
+vectorial_inline simd4f_mask simd4f_cmpge(simd4f lhs, simd4f rhs) {
+    simd4f_mask m = { -(lhs.x >= rhs.x), -(lhs.y >= rhs.y), -(lhs.z >= rhs.z), -(lhs.w >= rhs.w) };
+    return m;
+}
+
+vectorial_inline simd4f_mask simd4f_mask_and(simd4f_mask lhs, simd4f_mask rhs) {
+    simd4f_mask m = { lhs.x & rhs.x, lhs.y & rhs.y, lhs.z & rhs.z, lhs.w & rhs.w };
+    return m;
+}
+
+vectorial_inline simd4f_mask simd4f_mask_or(simd4f_mask lhs, simd4f_mask rhs) {
+    simd4f_mask m = { lhs.x | rhs.x, lhs.y | rhs.y, lhs.z | rhs.z, lhs.w | rhs.w };
+    return m;
+}
+
+vectorial_inline simd4f_mask simd4f_mask_xor(simd4f_mask lhs, simd4f_mask rhs) {
+    simd4f_mask m = { lhs.x ^ rhs.x, lhs.y ^ rhs.y, lhs.z ^ rhs.z, lhs.w ^ rhs.w };
+    return m;
+}
+
+vectorial_inline simd4f_mask simd4f_mask_not(simd4f_mask v) {
+    simd4f_mask m = { ~v.x, ~v.y, ~v.z, ~v.w };
+    return m;
+}
+
+// a where the mask is set, b elsewhere
+vectorial_inline simd4f simd4f_select(simd4f_mask mask, simd4f a, simd4f b) {
+    simd4f s = { mask.x ? a.x : b.x, mask.y ? a.y : b.y, mask.z ? a.z : b.z, mask.w ? a.w : b.w };
+    return s;
+}
+
+// Lane i of the mask in bit i
+vectorial_inline int simd4f_movemask(simd4f_mask mask) {
+    return (mask.x & 1) | (mask.y & 2) | (mask.z & 4) | (mask.w & 8);
+}
+
 
 #ifdef __cplusplus
 }
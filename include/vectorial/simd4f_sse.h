@@ -17,10 +17,17 @@
 #endif
 
 #include <xmmintrin.h>
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+#endif
 #if defined(VECTORIAL_USE_SSE4_1)
     #include <smmintrin.h>
 #endif
+#if defined(VECTORIAL_HAVE_FMA)
+    #include <immintrin.h>
+#endif
 #include <string.h>  // memcpy
+#include <math.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -35,6 +42,14 @@ typedef union {
     unsigned int ui[4];
 } _simd4f_union;
 
+// Keeps -ffast-math from reordering arithmetic across v, for the places
+// where the order carries the precision
+#if defined(__GNUC__)
+    #define _SIMD4F_BARRIER(v) __asm__("" : "+x"(v))
+#else
+    #define _SIMD4F_BARRIER(v) (void)(v)
+#endif
+
 // creating
 
 vectorial_inline simd4f simd4f_create(float x, float y, float z, float w) {
@@ -124,7 +139,11 @@ vectorial_inline simd4f simd4f_div(simd4f lhs, simd4f rhs) {
 }
 
 vectorial_inline simd4f simd4f_madd(simd4f m1, simd4f m2, simd4f a) {
+#if defined(VECTORIAL_HAVE_FMA)
+    return _mm_fmadd_ps(m1, m2, a);
+#else
     return simd4f_add( simd4f_mul(m1, m2), a );
+#endif
 }
 
 
@@ -226,6 +245,104 @@ vectorial_inline simd4f simd4f_max(simd4f a, simd4f b) {
     return _mm_max_ps( a, b ); 
 }
 
+vectorial_inline simd4f simd4f_floor(simd4f v) {
+#if defined(VECTORIAL_USE_SSE4_1)
+    return _mm_floor_ps( v );
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    // Truncate and step down where that rounded up, values past 2^23 are
+    // already integral (and would overflow the conversion), as are inf and nan
+    const simd4f t = _mm_cvtepi32_ps( _mm_cvttps_epi32(v) );
+    const simd4f r = _mm_sub_ps( t, _mm_and_ps( _mm_cmpgt_ps(t, v), _mm_set1_ps(1.0f) ) );
+    const simd4f a = _mm_andnot_ps( _mm_set1_ps(-0.0f), v );
+    const simd4f small = _mm_cmplt_ps( a, _mm_set1_ps(8388608.0f) );
+    return _mm_or_ps( _mm_and_ps(small, r), _mm_andnot_ps(small, v) );
+#else
+    _simd4f_union u = {v};
+    return simd4f_create( floorf(u.f[0]), floorf(u.f[1]), floorf(u.f[2]), floorf(u.f[3]) );
+#endif
+}
+
+// x * 2^n for integral n, n clamped to [-252, 254]
+vectorial_inline simd4f simd4f_ldexp(simd4f x, simd4f n) {
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    // Two steps so that results past the normal range under or overflow
+    const __m128i ni = _mm_cvttps_epi32( _mm_min_ps( _mm_max_ps(n, _mm_set1_ps(-252.0f)), _mm_set1_ps(254.0f) ) );
+    const __m128i n1 = _mm_srai_epi32( ni, 1 );
+    const __m128i n2 = _mm_sub_epi32( ni, n1 );
+    const __m128i bias = _mm_set1_epi32( 127 );
+    const simd4f s1 = _mm_castsi128_ps( _mm_slli_epi32( _mm_add_epi32(n1, bias), 23 ) );
+    const simd4f s2 = _mm_castsi128_ps( _mm_slli_epi32( _mm_add_epi32(n2, bias), 23 ) );
+    simd4f r = _mm_mul_ps( x, s1 );
+    _SIMD4F_BARRIER(r);
+    return _mm_mul_ps( r, s2 );
+#else
+    _simd4f_union u = {x}, un = {n};
+    for(int i = 0; i < 4; ++i) u.f[i] = ldexpf( u.f[i], (int)(un.f[i] < -252.0f ? -252.0f : un.f[i] > 254.0f ? 254.0f : un.f[i]) );
+    return u.s;
+#endif
+}
+
+// Mantissa in [0.5, 1) with x = m * 2^e like frexpf, zero, inf and nan
+// give themselves with e 0
+vectorial_inline simd4f simd4f_frexp(simd4f x, simd4f *e) {
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    const simd4f a = _mm_andnot_ps( _mm_set1_ps(-0.0f), x );
+    const simd4f special = _mm_or_ps( _mm_cmpeq_ps(a, _mm_setzero_ps()), _mm_cmpnle_ps(a, _mm_set1_ps(3.40282347e+38f)) );
+
+    // Denormals scaled up to normals first
+    const simd4f tiny = _mm_cmplt_ps( a, _mm_set1_ps(1.17549435e-38f) );
+    const simd4f xs = _mm_or_ps( _mm_and_ps(tiny, _mm_mul_ps(x, _mm_set1_ps(16777216.0f))), _mm_andnot_ps(tiny, x) );
+
+    const __m128i bits = _mm_castps_si128( xs );
+    const __m128i biased = _mm_srli_epi32( _mm_slli_epi32(bits, 1), 24 );
+    const simd4f ex = _mm_sub_ps( _mm_cvtepi32_ps(biased), _mm_add_ps( _mm_set1_ps(126.0f), _mm_and_ps(tiny, _mm_set1_ps(24.0f)) ) );
+    const simd4f m = _mm_castsi128_ps( _mm_or_si128( _mm_and_si128(bits, _mm_set1_epi32(0x807fffff)), _mm_set1_epi32(0x3f000000) ) );
+
+    *e = _mm_andnot_ps( special, ex );
+    return _mm_or_ps( _mm_and_ps(special, x), _mm_andnot_ps(special, m) );
+#else
+    _simd4f_union u = {x}, ue;
+    for(int i = 0; i < 4; ++i) {
+        int ei = 0;
+        u.f[i] = frexpf( u.f[i], &ei );
+        ue.f[i] = (float)ei;
+    }
+    *e = ue.s;
+    return u.s;
+#endif
+}
+
+
+
+// comparing, masks have all bits set where true and none where false
+
+typedef __m128 simd4f_mask;
+
+vectorial_inline simd4f_mask simd4f_cmpeq(simd4f lhs, simd4f rhs) { return _mm_cmpeq_ps( lhs, rhs ); }
+vectorial_inline simd4f_mask simd4f_cmpne(simd4f lhs, simd4f rhs) { return _mm_cmpneq_ps( lhs, rhs ); }
+vectorial_inline simd4f_mask simd4f_cmplt(simd4f lhs, simd4f rhs) { return _mm_cmplt_ps( lhs, rhs ); }
+vectorial_inline simd4f_mask simd4f_cmple(simd4f lhs, simd4f rhs) { return _mm_cmple_ps( lhs, rhs ); }
+vectorial_inline simd4f_mask simd4f_cmpgt(simd4f lhs, simd4f rhs) { return _mm_cmpgt_ps( lhs, rhs ); }
+vectorial_inline simd4f_mask simd4f_cmpge(simd4f lhs, simd4f rhs) { return _mm_cmpge_ps( lhs, rhs ); }
+
+vectorial_inline simd4f_mask simd4f_mask_and(simd4f_mask lhs, simd4f_mask rhs) { return _mm_and_ps( lhs, rhs ); }
+vectorial_inline simd4f_mask simd4f_mask_or(simd4f_mask lhs, simd4f_mask rhs) { return _mm_or_ps( lhs, rhs ); }
+vectorial_inline simd4f_mask simd4f_mask_xor(simd4f_mask lhs, simd4f_mask rhs) { return _mm_xor_ps( lhs, rhs ); }
+vectorial_inline simd4f_mask simd4f_mask_not(simd4f_mask v) { return _mm_xor_ps( v, _mm_cmpeq_ps( _mm_setzero_ps(), _mm_setzero_ps() ) ); }
+
+// a where the mask is set, b elsewhere
+vectorial_inline simd4f simd4f_select(simd4f_mask mask, simd4f a, simd4f b) {
+#if defined(VECTORIAL_USE_SSE4_1)
+    return _mm_blendv_ps( b, a, mask );
+#else
+    return _mm_or_ps( _mm_and_ps(mask, a), _mm_andnot_ps(mask, b) );
+#endif
+}
+
+// Lane i of the mask in bit i
+vectorial_inline int simd4f_movemask(simd4f_mask mask) {
+    return _mm_movemask_ps( mask );
+}
 
 
 #ifdef __cplusplus
@@ -0,0 +1,64 @@
+/*
+  Vectorial
+  Copyright (c) 2010 Mikko Lehtonen
+  Licensed under the terms of the two-clause BSD License (see LICENSE)
+*/
+
+#ifndef VECTORIAL_SIMD4I_H
+#define VECTORIAL_SIMD4I_H
+
+#ifndef VECTORIAL_CONFIG_H
+  #include "vectorial/config.h"
+#endif
+
+#ifndef VECTORIAL_SIMD4F_H
+  #include "vectorial/simd4f.h"
+#endif
+
+/*
+  simd4i is four 32bit signed ints in the same register file as simd4f.
+  add, sub, mul and shift_left wrap around, shift_right is arithmetic and
+  shift_right_logical shifts in zeros, for counts 0..31. The compares give
+  masks of all ones where true and zero where false, usable as is with
+  and, or and xor, or on floats through the bit casts.
+
+  simd4f_to_simd4i_trunc rounds towards zero and simd4f_to_simd4i_round
+  to nearest, ties to even. Floats outside the int range give an
+  unspecified value.
+*/
+
+#ifdef VECTORIAL_SIMD4I_SCALAR
+    #include "simd4i_scalar.h"
+#elif defined(VECTORIAL_SIMD4I_SSE)
+    #include "simd4i_sse.h"
+#elif defined(VECTORIAL_SIMD4I_GNU)
+    #include "simd4i_gnu.h"
+#elif defined(VECTORIAL_SIMD4I_NEON)
+    #include "simd4i_neon.h"
+#else
+    #error No implementation defined
+#endif
+
+
+
+#ifdef __cplusplus
+
+    #ifdef VECTORIAL_OSTREAM
+        #include <ostream>
+
+        vectorial_inline std::ostream& operator<<(std::ostream& os, const simd4i& v) {
+            os << "simd4i(" << simd4i_get_x(v) << ", "
+                       << simd4i_get_y(v) << ", "
+                       << simd4i_get_z(v) << ", "
+                       << simd4i_get_w(v) << ")";
+            return os;
+        }
+    #endif
+
+#endif
+
+
+
+
+#endif
+
@@ -0,0 +1,151 @@
+/*
+  Vectorial
+  Copyright (c) 2010 Mikko Lehtonen
+  Licensed under the terms of the two-clause BSD License (see LICENSE)
+*/
+#ifndef VECTORIAL_SIMD4I_GNU_H
+#define VECTORIAL_SIMD4I_GNU_H
+
+#include <math.h>
+#include <string.h>  // memcpy
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+typedef int simd4i __attribute__ ((vector_size (16)));
+typedef unsigned int _simd4i_unsigned __attribute__ ((vector_size (16)));
+
+typedef union {
+    simd4i s ;
+    int i[4];
+} _simd4i_union;
+
+
+vectorial_inline int simd4i_get_x(simd4i s) { _simd4i_union u={s}; return u.i[0]; }
+vectorial_inline int simd4i_get_y(simd4i s) { _simd4i_union u={s}; return u.i[1]; }
+vectorial_inline int simd4i_get_z(simd4i s) { _simd4i_union u={s}; return u.i[2]; }
+vectorial_inline int simd4i_get_w(simd4i s) { _simd4i_union u={s}; return u.i[3]; }
+
+
+vectorial_inline simd4i simd4i_create(int x, int y, int z, int w) {
+    simd4i s = { x, y, z, w };
+    return s;
+}
+
+vectorial_inline simd4i simd4i_zero() { return simd4i_create(0, 0, 0, 0); }
+
+vectorial_inline simd4i simd4i_splat(int v) {
+    simd4i s = { v, v, v, v };
+    return s;
+}
+
+vectorial_inline simd4i simd4i_uload4(const int *ary) {
+    simd4i s;
+    memcpy(&s, ary, sizeof(int) * 4);
+    return s;
+}
+
+vectorial_inline void simd4i_ustore4(const simd4i val, int *ary) {
+    memcpy(ary, &val, sizeof(int) * 4);
+}
+
+
+// Through unsigned so overflow wraps instead of being undefined
+
+vectorial_inline simd4i simd4i_add(simd4i lhs, simd4i rhs) {
+    return (simd4i)( (_simd4i_unsigned)lhs + (_simd4i_unsigned)rhs );
+}
+
+vectorial_inline simd4i simd4i_sub(simd4i lhs, simd4i rhs) {
+    return (simd4i)( (_simd4i_unsigned)lhs - (_simd4i_unsigned)rhs );
+}
+
+vectorial_inline simd4i simd4i_mul(simd4i lhs, simd4i rhs) {
+    return (simd4i)( (_simd4i_unsigned)lhs * (_simd4i_unsigned)rhs );
+}
+
+vectorial_inline simd4i simd4i_shift_left(simd4i v, int count) {
+    return (simd4i)( (_simd4i_unsigned)v << count );
+}
+
+vectorial_inline simd4i simd4i_shift_right(simd4i v, int count) {
+    return v >> count;
+}
+
+vectorial_inline simd4i simd4i_shift_right_logical(simd4i v, int count) {
+    return (simd4i)( (_simd4i_unsigned)v >> count );
+}
+
+
+vectorial_inline simd4i simd4i_and(simd4i lhs, simd4i rhs) {
+    return lhs & rhs;
+}
+
+vectorial_inline simd4i simd4i_or(simd4i lhs, simd4i rhs) {
+    return lhs | rhs;
+}
+
+vectorial_inline simd4i simd4i_xor(simd4i lhs, simd4i rhs) {
+    return lhs ^ rhs;
+}
+
+vectorial_inline simd4i simd4i_not(simd4i v) {
+    return ~v;
+}
+
+
+vectorial_inline simd4i simd4i_cmpeq(simd4i lhs, simd4i rhs) {
+    return (simd4i)( lhs == rhs );
+}
+
+vectorial_inline simd4i simd4i_cmpgt(simd4i lhs, simd4i rhs) {
+    return (simd4i)( lhs > rhs );
+}
+
+vectorial_inline simd4i simd4i_cmplt(simd4i lhs, simd4i rhs) {
+    return (simd4i)( lhs < rhs );
+}
+
+vectorial_inline simd4i simd4i_min(simd4i a, simd4i b) {
+    const simd4i lt = (simd4i)( a < b );
+    return (a & lt) | (b & ~lt);
+}
+
+vectorial_inline simd4i simd4i_max(simd4i a, simd4i b) {
+    const simd4i gt = (simd4i)( a > b );
+    return (a & gt) | (b & ~gt);
+}
+
+
+vectorial_inline simd4i simd4f_to_simd4i_trunc(simd4f v) {
+    return simd4i_create( (int)simd4f_get_x(v), (int)simd4f_get_y(v), (int)simd4f_get_z(v), (int)simd4f_get_w(v) );
+}
+
+vectorial_inline simd4i simd4f_to_simd4i_round(simd4f v) {
+    return simd4i_create( (int)rintf(simd4f_get_x(v)), (int)rintf(simd4f_get_y(v)),
+                          (int)rintf(simd4f_get_z(v)), (int)rintf(simd4f_get_w(v)) );
+}
+
+vectorial_inline simd4f simd4i_to_simd4f(simd4i v) {
+    _simd4i_union u = {v};
+    return simd4f_create( (float)u.i[0], (float)u.i[1], (float)u.i[2], (float)u.i[3] );
+}
+
+vectorial_inline simd4i simd4f_as_simd4i(simd4f v) {
+    return (simd4i)v;
+}
+
+vectorial_inline simd4f simd4i_as_simd4f(simd4i v) {
+    return (simd4f)v;
+}
+
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif
@@ -0,0 +1,156 @@
+/*
+  Vectorial
+  Copyright (c) 2010 Mikko Lehtonen
+  Licensed under the terms of the two-clause BSD License (see LICENSE)
+*/
+#ifndef VECTORIAL_SIMD4I_NEON_H
+#define VECTORIAL_SIMD4I_NEON_H
+
+#include <arm_neon.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+typedef int32x4_t simd4i;
+
+typedef union {
+    simd4i s ;
+    int i[4];
+} _simd4i_union;
+
+
+
+vectorial_inline simd4i simd4i_create(int x, int y, int z, int w) {
+    const int32_t d[4] = { x,y,z,w };
+    simd4i s = vld1q_s32(d);
+    return s;
+}
+
+vectorial_inline simd4i simd4i_zero() { return vdupq_n_s32(0); }
+
+vectorial_inline simd4i simd4i_splat(int v) {
+    return vdupq_n_s32(v);
+}
+
+vectorial_inline simd4i simd4i_uload4(const int *ary) {
+    return vld1q_s32( (const int32_t*)ary );
+}
+
+vectorial_inline void simd4i_ustore4(const simd4i val, int *ary) {
+    vst1q_s32( (int32_t*)ary, val );
+}
+
+
+vectorial_inline int simd4i_get_x(simd4i s) { return vgetq_lane_s32(s, 0); }
+vectorial_inline int simd4i_get_y(simd4i s) { return vgetq_lane_s32(s, 1); }
+vectorial_inline int simd4i_get_z(simd4i s) { return vgetq_lane_s32(s, 2); }
+vectorial_inline int simd4i_get_w(simd4i s) { return vgetq_lane_s32(s, 3); }
+
+
+vectorial_inline simd4i simd4i_add(simd4i lhs, simd4i rhs) {
+    return vaddq_s32( lhs, rhs );
+}
+
+vectorial_inline simd4i simd4i_sub(simd4i lhs, simd4i rhs) {
+    return vsubq_s32( lhs, rhs );
+}
+
+vectorial_inline simd4i simd4i_mul(simd4i lhs, simd4i rhs) {
+    return vmulq_s32( lhs, rhs );
+}
+
+// Variable shifts go left, a negative count shifts right
+vectorial_inline simd4i simd4i_shift_left(simd4i v, int count) {
+    return vshlq_s32( v, vdupq_n_s32(count) );
+}
+
+vectorial_inline simd4i simd4i_shift_right(simd4i v, int count) {
+    return vshlq_s32( v, vdupq_n_s32(-count) );
+}
+
+vectorial_inline simd4i simd4i_shift_right_logical(simd4i v, int count) {
+    return vreinterpretq_s32_u32( vshlq_u32( vreinterpretq_u32_s32(v), vdupq_n_s32(-count) ) );
+}
+
+
+vectorial_inline simd4i simd4i_and(simd4i lhs, simd4i rhs) {
+    return vandq_s32( lhs, rhs );
+}
+
+vectorial_inline simd4i simd4i_or(simd4i lhs, simd4i rhs) {
+    return vorrq_s32( lhs, rhs );
+}
+
+vectorial_inline simd4i simd4i_xor(simd4i lhs, simd4i rhs) {
+    return veorq_s32( lhs, rhs );
+}
+
+vectorial_inline simd4i simd4i_not(simd4i v) {
+    return vmvnq_s32( v );
+}
+
+
+vectorial_inline simd4i simd4i_cmpeq(simd4i lhs, simd4i rhs) {
+    return vreinterpretq_s32_u32( vceqq_s32(lhs, rhs) );
+}
+
+vectorial_inline simd4i simd4i_cmpgt(simd4i lhs, simd4i rhs) {
+    return vreinterpretq_s32_u32( vcgtq_s32(lhs, rhs) );
+}
+
+vectorial_inline simd4i simd4i_cmplt(simd4i lhs, simd4i rhs) {
+    return vreinterpretq_s32_u32( vcltq_s32(lhs, rhs) );
+}
+
+vectorial_inline simd4i simd4i_min(simd4i a, simd4i b) {
+    return vminq_s32( a, b );
+}
+
+vectorial_inline simd4i simd4i_max(simd4i a, simd4i b) {
+    return vmaxq_s32( a, b );
+}
+
+
+vectorial_inline simd4i simd4f_to_simd4i_trunc(simd4f v) {
+    return vcvtq_s32_f32( v );
+}
+
+vectorial_inline simd4i simd4f_to_simd4i_round(simd4f v) {
+#if defined(__aarch64__)
+    return vcvtnq_s32_f32( v );
+#else
+    // No round to nearest conversion on armv7. Adding and subtracting
+    // copysign(2^23, v) leaves no fraction bits, so NEON's round to nearest
+    // even does the rounding. From 2^23 up v is already an integer.
+    const simd4f big = vdupq_n_f32(8388608.0f);
+    const uint32x4_t sign = vandq_u32( vreinterpretq_u32_f32(v), vdupq_n_u32(0x80000000) );
+    const simd4f magic = vreinterpretq_f32_u32( vorrq_u32( vreinterpretq_u32_f32(big), sign ) );
+    simd4f r = vaddq_f32(v, magic);
+    _SIMD4F_BARRIER(r);
+    r = vsubq_f32(r, magic);
+    return vcvtq_s32_f32( vbslq_f32( vcltq_f32(vabsq_f32(v), big), r, v ) );
+#endif
+}
+
+vectorial_inline simd4f simd4i_to_simd4f(simd4i v) {
+    return vcvtq_f32_s32( v );
+}
+
+vectorial_inline simd4i simd4f_as_simd4i(simd4f v) {
+    return vreinterpretq_s32_f32( v );
+}
+
+vectorial_inline simd4f simd4i_as_simd4f(simd4i v) {
+    return vreinterpretq_f32_s32( v );
+}
+
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif
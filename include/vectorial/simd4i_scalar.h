@@ -0,0 +1,181 @@
+/*
+  Vectorial
+  Copyright (c) 2010 Mikko Lehtonen
+  Licensed under the terms of the two-clause BSD License (see LICENSE)
+*/
+#ifndef VECTORIAL_SIMD4I_SCALAR_H
+#define VECTORIAL_SIMD4I_SCALAR_H
+
+#include <math.h>
+#include <string.h>  // memcpy
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+typedef struct {
+    int x;
+    int y;
+    int z;
+    int w;
+} simd4i;
+
+
+
+vectorial_inline simd4i simd4i_create(int x, int y, int z, int w) {
+    simd4i s = { x, y, z, w };
+    return s;
+}
+
+vectorial_inline simd4i simd4i_zero() { return simd4i_create(0, 0, 0, 0); }
+
+vectorial_inline simd4i simd4i_splat(int v) {
+    simd4i s = { v, v, v, v };
+    return s;
+}
+
+vectorial_inline simd4i simd4i_uload4(const int *ary) {
+    simd4i s = { ary[0], ary[1], ary[2], ary[3] };
+    return s;
+}
+
+vectorial_inline void simd4i_ustore4(const simd4i val, int *ary) {
+    memcpy(ary, &val, sizeof(int) * 4);
+}
+
+
+vectorial_inline int simd4i_get_x(simd4i s) { return s.x; }
+vectorial_inline int simd4i_get_y(simd4i s) { return s.y; }
+vectorial_inline int simd4i_get_z(simd4i s) { return s.z; }
+vectorial_inline int simd4i_get_w(simd4i s) { return s.w; }
+
+
+// Through unsigned so overflow wraps instead of being undefined
+
+vectorial_inline simd4i simd4i_add(simd4i lhs, simd4i rhs) {
+    simd4i ret = { (int)((unsigned)lhs.x + (unsigned)rhs.x), (int)((unsigned)lhs.y + (unsigned)rhs.y),
+                   (int)((unsigned)lhs.z + (unsigned)rhs.z), (int)((unsigned)lhs.w + (unsigned)rhs.w) };
+    return ret;
+}
+
+vectorial_inline simd4i simd4i_sub(simd4i lhs, simd4i rhs) {
+    simd4i ret = { (int)((unsigned)lhs.x - (unsigned)rhs.x), (int)((unsigned)lhs.y - (unsigned)rhs.y),
+                   (int)((unsigned)lhs.z - (unsigned)rhs.z), (int)((unsigned)lhs.w - (unsigned)rhs.w) };
+    return ret;
+}
+
+vectorial_inline simd4i simd4i_mul(simd4i lhs, simd4i rhs) {
+    simd4i ret = { (int)((unsigned)lhs.x * (unsigned)rhs.x), (int)((unsigned)lhs.y * (unsigned)rhs.y),
+                   (int)((unsigned)lhs.z * (unsigned)rhs.z), (int)((unsigned)lhs.w * (unsigned)rhs.w) };
+    return ret;
+}
+
+vectorial_inline simd4i simd4i_shift_left(simd4i v, int count) {
+    simd4i ret = { (int)((unsigned)v.x << count), (int)((unsigned)v.y << count),
+                   (int)((unsigned)v.z << count), (int)((unsigned)v.w << count) };
+    return ret;
+}
+
+vectorial_inline simd4i simd4i_shift_right(simd4i v, int count) {
+    simd4i ret = { v.x >> count, v.y >> count, v.z >> count, v.w >> count };
+    return ret;
+}
+
+vectorial_inline simd4i simd4i_shift_right_logical(simd4i v, int count) {
+    simd4i ret = { (int)((unsigned)v.x >> count), (int)((unsigned)v.y >> count),
+                   (int)((unsigned)v.z >> count), (int)((unsigned)v.w >> count) };
+    return ret;
+}
+
+
+vectorial_inline simd4i simd4i_and(simd4i lhs, simd4i rhs) {
+    simd4i ret = { lhs.x & rhs.x, lhs.y & rhs.y, lhs.z & rhs.z, lhs.w & rhs.w };
+    return ret;
+}
+
+vectorial_inline simd4i simd4i_or(simd4i lhs, simd4i rhs) {
+    simd4i ret = { lhs.x | rhs.x, lhs.y | rhs.y, lhs.z | rhs.z, lhs.w | rhs.w };
+    return ret;
+}
+
+vectorial_inline simd4i simd4i_xor(simd4i lhs, simd4i rhs) {
+    simd4i ret = { lhs.x ^ rhs.x, lhs.y ^ rhs.y, lhs.z ^ rhs.z, lhs.w ^ rhs.w };
+    return ret;
+}
+
+vectorial_inline simd4i simd4i_not(simd4i v) {
+    simd4i ret = { ~v.x, ~v.y, ~v.z, ~v.w };
+    return ret;
+}
+
+
+vectorial_inline simd4i simd4i_cmpeq(simd4i lhs, simd4i rhs) {
+    simd4i ret = { -(lhs.x == rhs.x), -(lhs.y == rhs.y), -(lhs.z == rhs.z), -(lhs.w == rhs.w) };
+    return ret;
+}
+
+vectorial_inline simd4i simd4i_cmpgt(simd4i lhs, simd4i rhs) {
+    simd4i ret = { -(lhs.x > rhs.x), -(lhs.y > rhs.y), -(lhs.z > rhs.z), -(lhs.w > rhs.w) };
+    return ret;
+}
+
+vectorial_inline simd4i simd4i_cmplt(simd4i lhs, simd4i rhs) {
+    simd4i ret = { -(lhs.x < rhs.x), -(lhs.y < rhs.y), -(lhs.z < rhs.z), -(lhs.w < rhs.w) };
+    return ret;
+}
+
+vectorial_inline simd4i simd4i_min(simd4i a, simd4i b) {
+    simd4i ret = { a.x < b.x ? a.x : b.x, a.y < b.y ? a.y : b.y,
+                   a.z < b.z ? a.z : b.z, a.w < b.w ? a.w : b.w };
+    return ret;
+}
+
+vectorial_inline simd4i simd4i_max(simd4i a, simd4i b) {
+    simd4i ret = { a.x > b.x ? a.x : b.x, a.y > b.y ? a.y : b.y,
+                   a.z > b.z ? a.z : b.z, a.w > b.w ? a.w : b.w };
+    return ret;
+}
+
+
+// Conversions go through memory so they pair with any simd4f, this is
+// also the integer half of SSE without SSE2
+
+vectorial_inline simd4i simd4f_to_simd4i_trunc(simd4f v) {
+    float f[4];
+    simd4f_ustore4(v, f);
+    return simd4i_create( (int)f[0], (int)f[1], (int)f[2], (int)f[3] );
+}
+
+vectorial_inline simd4i simd4f_to_simd4i_round(simd4f v) {
+    float f[4];
+    simd4f_ustore4(v, f);
+    return simd4i_create( (int)rintf(f[0]), (int)rintf(f[1]), (int)rintf(f[2]), (int)rintf(f[3]) );
+}
+
+vectorial_inline simd4f simd4i_to_simd4f(simd4i v) {
+    return simd4f_create( (float)v.x, (float)v.y, (float)v.z, (float)v.w );
+}
+
+vectorial_inline simd4i simd4f_as_simd4i(simd4f v) {
+    float f[4];
+    simd4i ret;
+    simd4f_ustore4(v, f);
+    memcpy(&ret, f, sizeof(ret));
+    return ret;
+}
+
+vectorial_inline simd4f simd4i_as_simd4f(simd4i v) {
+    float f[4];
+    memcpy(f, &v, sizeof(f));
+    return simd4f_uload4(f);
+}
+
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif
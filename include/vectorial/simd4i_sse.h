@@ -0,0 +1,172 @@
+/*
+  Vectorial
+  Copyright (c) 2010 Mikko Lehtonen
+  Licensed under the terms of the two-clause BSD License (see LICENSE)
+*/
+#ifndef VECTORIAL_SIMD4I_SSE_H
+#define VECTORIAL_SIMD4I_SSE_H
+
+#include <emmintrin.h>
+#if defined(VECTORIAL_USE_SSE4_1)
+    #include <smmintrin.h>
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+typedef __m128i simd4i;
+
+typedef union {
+    simd4i s ;
+    int i[4];
+} _simd4i_union;
+
+
+// creating
+
+vectorial_inline simd4i simd4i_create(int x, int y, int z, int w) {
+    return _mm_setr_epi32( x, y, z, w );
+}
+
+vectorial_inline simd4i simd4i_zero() { return _mm_setzero_si128(); }
+
+vectorial_inline simd4i simd4i_splat(int v) {
+    return _mm_set1_epi32( v );
+}
+
+vectorial_inline simd4i simd4i_uload4(const int *ary) {
+    return _mm_loadu_si128( (const __m128i*)ary );
+}
+
+vectorial_inline void simd4i_ustore4(const simd4i val, int *ary) {
+    _mm_storeu_si128( (__m128i*)ary, val );
+}
+
+
+// get
+
+vectorial_inline int simd4i_get_x(simd4i s) { return _mm_cvtsi128_si32( s ); }
+vectorial_inline int simd4i_get_y(simd4i s) { return _mm_cvtsi128_si32( _mm_shuffle_epi32(s, _MM_SHUFFLE(1,1,1,1)) ); }
+vectorial_inline int simd4i_get_z(simd4i s) { return _mm_cvtsi128_si32( _mm_shuffle_epi32(s, _MM_SHUFFLE(2,2,2,2)) ); }
+vectorial_inline int simd4i_get_w(simd4i s) { return _mm_cvtsi128_si32( _mm_shuffle_epi32(s, _MM_SHUFFLE(3,3,3,3)) ); }
+
+
+// arithmetic
+
+vectorial_inline simd4i simd4i_add(simd4i lhs, simd4i rhs) {
+    return _mm_add_epi32( lhs, rhs );
+}
+
+vectorial_inline simd4i simd4i_sub(simd4i lhs, simd4i rhs) {
+    return _mm_sub_epi32( lhs, rhs );
+}
+
+vectorial_inline simd4i simd4i_mul(simd4i lhs, simd4i rhs) {
+#if defined(VECTORIAL_USE_SSE4_1)
+    return _mm_mullo_epi32( lhs, rhs );
+#else
+    // Even and odd lanes as 64bit products, low halves back together
+    const __m128i even = _mm_mul_epu32( lhs, rhs );
+    const __m128i odd = _mm_mul_epu32( _mm_srli_epi64(lhs, 32), _mm_srli_epi64(rhs, 32) );
+    return _mm_unpacklo_epi32( _mm_shuffle_epi32(even, _MM_SHUFFLE(0,0,2,0)), _mm_shuffle_epi32(odd, _MM_SHUFFLE(0,0,2,0)) );
+#endif
+}
+
+vectorial_inline simd4i simd4i_shift_left(simd4i v, int count) {
+    return _mm_sll_epi32( v, _mm_cvtsi32_si128(count) );
+}
+
+vectorial_inline simd4i simd4i_shift_right(simd4i v, int count) {
+    return _mm_sra_epi32( v, _mm_cvtsi32_si128(count) );
+}
+
+vectorial_inline simd4i simd4i_shift_right_logical(simd4i v, int count) {
+    return _mm_srl_epi32( v, _mm_cvtsi32_si128(count) );
+}
+
+
+// bitwise
+
+vectorial_inline simd4i simd4i_and(simd4i lhs, simd4i rhs) {
+    return _mm_and_si128( lhs, rhs );
+}
+
+vectorial_inline simd4i simd4i_or(simd4i lhs, simd4i rhs) {
+    return _mm_or_si128( lhs, rhs );
+}
+
+vectorial_inline simd4i simd4i_xor(simd4i lhs, simd4i rhs) {
+    return _mm_xor_si128( lhs, rhs );
+}
+
+vectorial_inline simd4i simd4i_not(simd4i v) {
+    return _mm_xor_si128( v, _mm_set1_epi32(-1) );
+}
+
+
+// compare
+
+vectorial_inline simd4i simd4i_cmpeq(simd4i lhs, simd4i rhs) {
+    return _mm_cmpeq_epi32( lhs, rhs );
+}
+
+vectorial_inline simd4i simd4i_cmpgt(simd4i lhs, simd4i rhs) {
+    return _mm_cmpgt_epi32( lhs, rhs );
+}
+
+vectorial_inline simd4i simd4i_cmplt(simd4i lhs, simd4i rhs) {
+    return _mm_cmplt_epi32( lhs, rhs );
+}
+
+vectorial_inline simd4i simd4i_min(simd4i a, simd4i b) {
+#if defined(VECTORIAL_USE_SSE4_1)
+    return _mm_min_epi32( a, b );
+#else
+    const __m128i gt = _mm_cmpgt_epi32( a, b );
+    return _mm_or_si128( _mm_and_si128(gt, b), _mm_andnot_si128(gt, a) );
+#endif
+}
+
+vectorial_inline simd4i simd4i_max(simd4i a, simd4i b) {
+#if defined(VECTORIAL_USE_SSE4_1)
+    return _mm_max_epi32( a, b );
+#else
+    const __m128i gt = _mm_cmpgt_epi32( a, b );
+    return _mm_or_si128( _mm_and_si128(gt, a), _mm_andnot_si128(gt, b) );
+#endif
+}
+
+
+// conversions
+
+vectorial_inline simd4i simd4f_to_simd4i_trunc(simd4f v) {
+    return _mm_cvttps_epi32( v );
+}
+
+// In the current rounding mode, which is to nearest unless changed
+vectorial_inline simd4i simd4f_to_simd4i_round(simd4f v) {
+    return _mm_cvtps_epi32( v );
+}
+
+vectorial_inline simd4f simd4i_to_simd4f(simd4i v) {
+    return _mm_cvtepi32_ps( v );
+}
+
+vectorial_inline simd4i simd4f_as_simd4i(simd4f v) {
+    return _mm_castps_si128( v );
+}
+
+vectorial_inline simd4f simd4i_as_simd4f(simd4i v) {
+    return _mm_castsi128_ps( v );
+}
+
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif
@@ -0,0 +1,179 @@
+/*
+  Vectorial
+  Copyright (c) 2010 Mikko Lehtonen
+  Licensed under the terms of the two-clause BSD License (see LICENSE)
+*/
+#ifndef VECTORIAL_SIMD4X3F_H
+#define VECTORIAL_SIMD4X3F_H
+
+
+#ifndef VECTORIAL_SIMD4X4F_H
+  #include "vectorial/simd4x4f.h"
+#endif
+
+/*
+  Affine transform in 48 bytes, the top three rows of a simd4x4f whose
+  last row is always 0 0 0 1.
+
+  Note, unlike simd4x4f x,y,z are rows, x is the row that gives the x of
+  a transformed point: xyz of the linear part and w of the translation.
+*/
+
+typedef struct {
+    simd4f x,y,z;
+} simd4x3f;
+
+
+vectorial_inline simd4x3f simd4x3f_create(simd4f x, simd4f y, simd4f z) {
+    simd4x3f s = { x, y, z };
+    return s;
+}
+
+vectorial_inline void simd4x3f_identity(simd4x3f* m) {
+    *m = simd4x3f_create( simd4f_create(1.0f, 0.0f, 0.0f, 0.0f),
+                          simd4f_create(0.0f, 1.0f, 0.0f, 0.0f),
+                          simd4f_create(0.0f, 0.0f, 1.0f, 0.0f) );
+}
+
+// 12 floats row by row
+vectorial_inline void simd4x3f_uload(simd4x3f* m, const float *f) {
+    m->x = simd4f_uload4(f + 0);
+    m->y = simd4f_uload4(f + 4);
+    m->z = simd4f_uload4(f + 8);
+}
+
+vectorial_inline void simd4x3f_ustore(const simd4x3f* m, float *f) {
+    simd4f_ustore4(m->x, f + 0);
+    simd4f_ustore4(m->y, f + 4);
+    simd4f_ustore4(m->z, f + 8);
+}
+
+
+vectorial_inline void simd4x3f_translation(simd4x3f* m, float x, float y, float z) {
+    *m = simd4x3f_create( simd4f_create(1.0f, 0.0f, 0.0f, x),
+                          simd4f_create(0.0f, 1.0f, 0.0f, y),
+                          simd4f_create(0.0f, 0.0f, 1.0f, z) );
+}
+
+
+// The bottom row of a is dropped, it should be 0 0 0 1
+vectorial_inline void simd4x3f_from_simd4x4f(const simd4x4f* a, simd4x3f* out) {
+    simd4x4f t;
+    simd4x4f_transpose(a, &t);
+    *out = simd4x3f_create(t.x, t.y, t.z);
+}
+
+vectorial_inline void simd4x3f_to_simd4x4f(const simd4x3f* a, simd4x4f* out) {
+    const simd4x4f t = simd4x4f_create(a->x, a->y, a->z, simd4f_create(0.0f, 0.0f, 0.0f, 1.0f));
+    simd4x4f_transpose(&t, out);
+}
+
+
+vectorial_inline void simd4x3f_matrix_mul(const simd4x3f* a, const simd4x3f* b, simd4x3f* out) {
+
+    // Row of a times b, the implicit 0 0 0 1 row of b adds the translation
+    // of a into w
+    const simd4f w_mask = simd4f_create(0.0f, 0.0f, 0.0f, 1.0f);
+
+    const simd4f x = a->x;
+    const simd4f y = a->y;
+    const simd4f z = a->z;
+
+    out->x = simd4f_madd( simd4f_splat_x(x), b->x,
+               simd4f_madd( simd4f_splat_y(x), b->y,
+                 simd4f_madd( simd4f_splat_z(x), b->z, simd4f_mul(x, w_mask) ) ) );
+    out->y = simd4f_madd( simd4f_splat_x(y), b->x,
+               simd4f_madd( simd4f_splat_y(y), b->y,
+                 simd4f_madd( simd4f_splat_z(y), b->z, simd4f_mul(y, w_mask) ) ) );
+    out->z = simd4f_madd( simd4f_splat_x(z), b->x,
+               simd4f_madd( simd4f_splat_y(z), b->y,
+                 simd4f_madd( simd4f_splat_z(z), b->z, simd4f_mul(z, w_mask) ) ) );
+
+}
+
+
+// One point or vector dots with each row, the three products are summed
+// across with a transpose. Point results have w 1, vectors w 0.
+
+vectorial_inline void simd4x3f_matrix_point3_mul(const simd4x3f* a, const simd4f * b, simd4f* out) {
+    const simd4f w_one = simd4f_create(0.0f, 0.0f, 0.0f, 1.0f);
+    const simd4f p = simd4f_add( simd4f_zero_w(*b), w_one );
+
+    simd4x4f t = simd4x4f_create( simd4f_mul(a->x, p), simd4f_mul(a->y, p), simd4f_mul(a->z, p), w_one );
+    simd4x4f_transpose_inplace(&t);
+    simd4x4f_sum(&t, out);
+}
+
+vectorial_inline void simd4x3f_matrix_vector3_mul(const simd4x3f* a, const simd4f * b, simd4f* out) {
+    const simd4f v = simd4f_zero_w(*b);
+
+    simd4x4f t = simd4x4f_create( simd4f_mul(a->x, v), simd4f_mul(a->y, v), simd4f_mul(a->z, v), simd4f_zero() );
+    simd4x4f_transpose_inplace(&t);
+    simd4x4f_sum(&t, out);
+}
+
+
+// Columns c0 c1 c2 of the inverse 3x3 scaled by invdet and the linear part
+// applied to the translation t, transposed back to rows
+vectorial_inline void _simd4x3f_inverse_rows(const simd4x3f* a, simd4f c0, simd4f c1, simd4f c2, simd4f invdet, simd4x3f* out) {
+    c0 = simd4f_mul(c0, invdet);
+    c1 = simd4f_mul(c1, invdet);
+    c2 = simd4f_mul(c2, invdet);
+
+    const simd4f t = simd4f_madd( c0, simd4f_splat_w(a->x),
+                       simd4f_madd( c1, simd4f_splat_w(a->y),
+                         simd4f_mul( c2, simd4f_splat_w(a->z) ) ) );
+
+    simd4x4f m = simd4x4f_create( c0, c1, c2, simd4f_sub(simd4f_zero(), t) );
+    simd4x4f_transpose_inplace(&m);
+    *out = simd4x3f_create(m.x, m.y, m.z);
+}
+
+// General affine inverse, the 3x3 from cross products of the rows.
+// Returns the determinant in all lanes.
+vectorial_inline simd4f simd4x3f_inverse(const simd4x3f* a, simd4x3f* out) {
+    const simd4f c0 = simd4f_cross3(a->y, a->z);
+    const simd4f c1 = simd4f_cross3(a->z, a->x);
+    const simd4f c2 = simd4f_cross3(a->x, a->y);
+
+    const simd4f det = simd4f_dot3(a->x, c0);
+
+    _simd4x3f_inverse_rows(a, c0, c1, c2, simd4f_div(simd4f_splat(1.0f), det), out);
+    return det;
+}
+
+// Inverse of a rotation and translation, the 3x3 is only transposed
+vectorial_inline void simd4x3f_inverse_ortho(const simd4x3f* a, simd4x3f* out) {
+    _simd4x3f_inverse_rows(a, simd4f_zero_w(a->x), simd4f_zero_w(a->y), simd4f_zero_w(a->z), simd4f_splat(1.0f), out);
+}
+
+
+
+#ifdef __cplusplus
+
+    #ifdef VECTORIAL_OSTREAM
+        #include <ostream>
+
+        vectorial_inline std::ostream& operator<<(std::ostream& os, const simd4x3f& v) {
+            os << "simd4x3f(simd4f(" << simd4f_get_x(v.x) << ", "
+                       << simd4f_get_y(v.x) << ", "
+                       << simd4f_get_z(v.x) << ", "
+                       << simd4f_get_w(v.x) << "),\n"
+                       << "         simd4f(" << simd4f_get_x(v.y) << ", "
+                       << simd4f_get_y(v.y) << ", "
+                       << simd4f_get_z(v.y) << ", "
+                       << simd4f_get_w(v.y) << "),\n"
+                       << "         simd4f(" << simd4f_get_x(v.z) << ", "
+                       << simd4f_get_y(v.z) << ", "
+                       << simd4f_get_z(v.z) << ", "
+                       << simd4f_get_w(v.z) << "))";
+            return os;
+        }
+    #endif
+
+#endif
+
+
+
+
+#endif
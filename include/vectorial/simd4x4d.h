@@ -0,0 +1,336 @@
+/*
+  Vectorial
+  Copyright (c) 2010 Mikko Lehtonen
+  Licensed under the terms of the two-clause BSD License (see LICENSE)
+*/
+#ifndef VECTORIAL_SIMD4X4D_H
+#define VECTORIAL_SIMD4X4D_H
+
+
+#include "simd4d.h"
+#include "simd4x4f.h"
+
+#include <math.h>
+
+/*
+  Double precision simd4x4f, the columns are simd4d. There are no per
+  backend versions, everything is written on top of simd4d.
+*/
+
+typedef struct {
+    simd4d x,y,z,w;
+} simd4x4d;
+
+
+
+vectorial_inline simd4x4d simd4x4d_create(simd4d x, simd4d y, simd4d z, simd4d w) {
+    simd4x4d s = { x, y, z, w };
+    return s;
+}
+
+
+vectorial_inline void simd4x4d_identity(simd4x4d* m) {
+    *m = simd4x4d_create( simd4d_create(1.0, 0.0, 0.0, 0.0),
+                          simd4d_create(0.0, 1.0, 0.0, 0.0),
+                          simd4d_create(0.0, 0.0, 1.0, 0.0),
+                          simd4d_create(0.0, 0.0, 0.0, 1.0));
+}
+
+
+vectorial_inline void simd4x4d_uload(simd4x4d* m, const double *d) {
+
+    m->x = simd4d_uload4(d + 0);
+    m->y = simd4d_uload4(d + 4);
+    m->z = simd4d_uload4(d + 8);
+    m->w = simd4d_uload4(d + 12);
+
+}
+
+vectorial_inline void simd4x4d_ustore(const simd4x4d* m, double *d) {
+
+    simd4d_ustore4(m->x, d + 0);
+    simd4d_ustore4(m->y, d + 4);
+    simd4d_ustore4(m->z, d + 8);
+    simd4d_ustore4(m->w, d + 12);
+
+}
+
+
+vectorial_inline void simd4x4d_transpose(const simd4x4d *s, simd4x4d *out) {
+    double d[16];
+    simd4x4d_ustore(s, d);
+    *out = simd4x4d_create( simd4d_create(d[0], d[4], d[8],  d[12]),
+                            simd4d_create(d[1], d[5], d[9],  d[13]),
+                            simd4d_create(d[2], d[6], d[10], d[14]),
+                            simd4d_create(d[3], d[7], d[11], d[15]) );
+}
+
+vectorial_inline void simd4x4d_transpose_inplace(simd4x4d *s) {
+    const simd4x4d d = *s;
+    simd4x4d_transpose(&d, s);
+}
+
+
+vectorial_inline void simd4x4d_sum(const simd4x4d* a, simd4d* out) {
+    simd4d t;
+    t = simd4d_add(a->x, a->y);
+    t = simd4d_add(t, a->z);
+    t = simd4d_add(t, a->w);
+    *out = t;
+}
+
+vectorial_inline void simd4x4d_matrix_vector_mul(const simd4x4d* a, const simd4d * b, simd4d* out) {
+
+    const simd4d v = *b;
+
+    *out = simd4d_madd(a->x, simd4d_splat_x(v),
+             simd4d_madd(a->y, simd4d_splat_y(v),
+               simd4d_madd(a->z, simd4d_splat_z(v),
+                 simd4d_mul(a->w, simd4d_splat_w(v)) ) ) );
+
+}
+
+vectorial_inline void simd4x4d_matrix_vector3_mul(const simd4x4d* a, const simd4d * b, simd4d* out) {
+
+    *out = simd4d_madd( a->x, simd4d_splat_x(*b),
+             simd4d_madd( a->y, simd4d_splat_y(*b),
+               simd4d_mul(a->z, simd4d_splat_z(*b)) ) );
+
+}
+
+vectorial_inline void simd4x4d_matrix_point3_mul(const simd4x4d* a, const simd4d * b, simd4d* out) {
+
+    *out = simd4d_madd( a->x, simd4d_splat_x(*b),
+             simd4d_madd( a->y, simd4d_splat_y(*b),
+               simd4d_madd( a->z, simd4d_splat_z(*b),
+                 a->w ) ) );
+
+}
+
+vectorial_inline void simd4x4d_matrix_mul(const simd4x4d* a, const simd4x4d* b, simd4x4d* out) {
+
+    simd4x4d_matrix_vector_mul(a, &b->x, &out->x);
+    simd4x4d_matrix_vector_mul(a, &b->y, &out->y);
+    simd4x4d_matrix_vector_mul(a, &b->z, &out->z);
+    simd4x4d_matrix_vector_mul(a, &b->w, &out->w);
+
+}
+
+
+
+vectorial_inline void simd4x4d_perspective(simd4x4d *m, double fovy_radians, double aspect, double znear, double zfar) {
+
+    double deltaz = zfar - znear;
+    double cotangent = tan( VECTORIAL_HALFPI - fovy_radians * 0.5 );
+
+    double a = cotangent / aspect;
+    double b = cotangent;
+    double c = -(zfar + znear) / deltaz;
+    double d = -2 * znear * zfar / deltaz;
+
+    m->x = simd4d_create( a, 0, 0,  0);
+    m->y = simd4d_create( 0, b, 0,  0);
+    m->z = simd4d_create( 0, 0, c, -1);
+    m->w = simd4d_create( 0, 0, d,  0);
+
+}
+
+vectorial_inline void simd4x4d_ortho(simd4x4d *m, double left, double right, double bottom, double top, double znear, double zfar) {
+
+    double deltax = right - left;
+    double deltay = top - bottom;
+    double deltaz = zfar - znear;
+
+    double a = 2.0 / deltax;
+    double b = -(right + left) / deltax;
+    double c = 2.0 / deltay;
+    double d = -(top + bottom) / deltay;
+    double e =  -2.0 / deltaz;
+    double f = -(zfar + znear) / deltaz;
+
+    m->x = simd4d_create( a, 0, 0, 0);
+    m->y = simd4d_create( 0, c, 0, 0);
+    m->z = simd4d_create( 0, 0, e, 0);
+    m->w = simd4d_create( b, d, f, 1);
+
+}
+
+
+vectorial_inline void simd4x4d_lookat(simd4x4d *m, simd4d eye, simd4d center, simd4d up) {
+
+    simd4d zaxis = simd4d_normalize3( simd4d_sub(center, eye) );
+    simd4d xaxis = simd4d_normalize3( simd4d_cross3( zaxis, up ) );
+    simd4d yaxis = simd4d_cross3(xaxis, zaxis);
+
+    zaxis = simd4d_sub( simd4d_zero(), zaxis);
+
+    double x = -simd4d_dot3_scalar(xaxis, eye);
+    double y = -simd4d_dot3_scalar(yaxis, eye);
+    double z = -simd4d_dot3_scalar(zaxis, eye);
+
+    m->x = xaxis;
+    m->y = yaxis;
+    m->z = zaxis;
+
+    m->w = simd4d_create( 0,0,0, 1);
+    simd4x4d_transpose_inplace(m);
+    m->w = simd4d_create( x,y,z,1);
+
+}
+
+
+vectorial_inline void simd4x4d_translation(simd4x4d* m, double x, double y, double z) {
+    *m = simd4x4d_create( simd4d_create(1.0, 0.0, 0.0, 0.0),
+                          simd4d_create(0.0, 1.0, 0.0, 0.0),
+                          simd4d_create(0.0, 0.0, 1.0, 0.0),
+                          simd4d_create(   x,   y,   z, 1.0));
+}
+
+
+vectorial_inline void simd4x4d_axis_rotation(simd4x4d* m, double radians, simd4d axis) {
+
+    radians = -radians;
+
+    axis = simd4d_normalize3(axis);
+
+    const double sine = sin(radians);
+    const double cosine = cos(radians);
+
+    const double x = simd4d_get_x(axis);
+    const double y = simd4d_get_y(axis);
+    const double z = simd4d_get_z(axis);
+
+    const double ab = x * y * (1 - cosine);
+    const double bc = y * z * (1 - cosine);
+    const double ca = z * x * (1 - cosine);
+
+    const double tx = x * x;
+    const double ty = y * y;
+    const double tz = z * z;
+
+    const simd4d i = simd4d_create( tx + cosine * (1 - tx), ab - z * sine,          ca + y * sine,          0);
+    const simd4d j = simd4d_create( ab + z * sine,          ty + cosine * (1 - ty), bc - x * sine,          0);
+    const simd4d k = simd4d_create( ca - y * sine,          bc + x * sine,          tz + cosine * (1 - tz), 0);
+
+    *m = simd4x4d_create( i,j,k, simd4d_create(0, 0, 0, 1) );
+
+}
+
+
+
+vectorial_inline void simd4x4d_add(const simd4x4d* a, const simd4x4d* b, simd4x4d* out) {
+
+    out->x = simd4d_add(a->x, b->x);
+    out->y = simd4d_add(a->y, b->y);
+    out->z = simd4d_add(a->z, b->z);
+    out->w = simd4d_add(a->w, b->w);
+
+}
+
+vectorial_inline void simd4x4d_sub(const simd4x4d* a, const simd4x4d* b, simd4x4d* out) {
+
+    out->x = simd4d_sub(a->x, b->x);
+    out->y = simd4d_sub(a->y, b->y);
+    out->z = simd4d_sub(a->z, b->z);
+    out->w = simd4d_sub(a->w, b->w);
+
+}
+
+vectorial_inline void simd4x4d_mul(const simd4x4d* a, const simd4x4d* b, simd4x4d* out) {
+
+    out->x = simd4d_mul(a->x, b->x);
+    out->y = simd4d_mul(a->y, b->y);
+    out->z = simd4d_mul(a->z, b->z);
+    out->w = simd4d_mul(a->w, b->w);
+
+}
+
+vectorial_inline void simd4x4d_div(const simd4x4d* a, const simd4x4d* b, simd4x4d* out) {
+
+    out->x = simd4d_div(a->x, b->x);
+    out->y = simd4d_div(a->y, b->y);
+    out->z = simd4d_div(a->z, b->z);
+    out->w = simd4d_div(a->w, b->w);
+
+}
+
+
+// Cofactor expansion in scalar doubles, inverting is rare enough for the
+// large-world matrices that the shuffles of simd4x4f_inverse don't pay off.
+// Returns the determinant in all lanes.
+vectorial_inline simd4d simd4x4d_inverse(const simd4x4d* a, simd4x4d* out) {
+
+    double m[16], inv[16];
+    double det, invdet;
+    int i;
+
+    simd4x4d_ustore(a, m);
+
+    inv[0]  =  m[5]*m[10]*m[15] - m[5]*m[11]*m[14] - m[9]*m[6]*m[15] + m[9]*m[7]*m[14] + m[13]*m[6]*m[11] - m[13]*m[7]*m[10];
+    inv[4]  = -m[4]*m[10]*m[15] + m[4]*m[11]*m[14] + m[8]*m[6]*m[15] - m[8]*m[7]*m[14] - m[12]*m[6]*m[11] + m[12]*m[7]*m[10];
+    inv[8]  =  m[4]*m[9]*m[15]  - m[4]*m[11]*m[13] - m[8]*m[5]*m[15] + m[8]*m[7]*m[13] + m[12]*m[5]*m[11] - m[12]*m[7]*m[9];
+    inv[12] = -m[4]*m[9]*m[14]  + m[4]*m[10]*m[13] + m[8]*m[5]*m[14] - m[8]*m[6]*m[13] - m[12]*m[5]*m[10] + m[12]*m[6]*m[9];
+    inv[1]  = -m[1]*m[10]*m[15] + m[1]*m[11]*m[14] + m[9]*m[2]*m[15] - m[9]*m[3]*m[14] - m[13]*m[2]*m[11] + m[13]*m[3]*m[10];
+    inv[5]  =  m[0]*m[10]*m[15] - m[0]*m[11]*m[14] - m[8]*m[2]*m[15] + m[8]*m[3]*m[14] + m[12]*m[2]*m[11] - m[12]*m[3]*m[10];
+    inv[9]  = -m[0]*m[9]*m[15]  + m[0]*m[11]*m[13] + m[8]*m[1]*m[15] - m[8]*m[3]*m[13] - m[12]*m[1]*m[11] + m[12]*m[3]*m[9];
+    inv[13] =  m[0]*m[9]*m[14]  - m[0]*m[10]*m[13] - m[8]*m[1]*m[14] + m[8]*m[2]*m[13] + m[12]*m[1]*m[10] - m[12]*m[2]*m[9];
+    inv[2]  =  m[1]*m[6]*m[15]  - m[1]*m[7]*m[14]  - m[5]*m[2]*m[15] + m[5]*m[3]*m[14] + m[13]*m[2]*m[7]  - m[13]*m[3]*m[6];
+    inv[6]  = -m[0]*m[6]*m[15]  + m[0]*m[7]*m[14]  + m[4]*m[2]*m[15] - m[4]*m[3]*m[14] - m[12]*m[2]*m[7]  + m[12]*m[3]*m[6];
+    inv[10] =  m[0]*m[5]*m[15]  - m[0]*m[7]*m[13]  - m[4]*m[1]*m[15] + m[4]*m[3]*m[13] + m[12]*m[1]*m[7]  - m[12]*m[3]*m[5];
+    inv[14] = -m[0]*m[5]*m[14]  + m[0]*m[6]*m[13]  + m[4]*m[1]*m[14] - m[4]*m[2]*m[13] - m[12]*m[1]*m[6]  + m[12]*m[2]*m[5];
+    inv[3]  = -m[1]*m[6]*m[11]  + m[1]*m[7]*m[10]  + m[5]*m[2]*m[11] - m[5]*m[3]*m[10] - m[9]*m[2]*m[7]   + m[9]*m[3]*m[6];
+    inv[7]  =  m[0]*m[6]*m[11]  - m[0]*m[7]*m[10]  - m[4]*m[2]*m[11] + m[4]*m[3]*m[10] + m[8]*m[2]*m[7]   - m[8]*m[3]*m[6];
+    inv[11] = -m[0]*m[5]*m[11]  + m[0]*m[7]*m[9]   + m[4]*m[1]*m[11] - m[4]*m[3]*m[9]  - m[8]*m[1]*m[7]   + m[8]*m[3]*m[5];
+    inv[15] =  m[0]*m[5]*m[10]  - m[0]*m[6]*m[9]   - m[4]*m[1]*m[10] + m[4]*m[2]*m[9]  + m[8]*m[1]*m[6]   - m[8]*m[2]*m[5];
+
+    det = m[0]*inv[0] + m[1]*inv[4] + m[2]*inv[8] + m[3]*inv[12];
+    invdet = 1.0 / det;
+
+    for(i = 0; i < 16; ++i) inv[i] *= invdet;
+
+    simd4x4d_uload(out, inv);
+
+    return simd4d_splat(det);
+}
+
+
+// Rounds to a float matrix, the w column of a large-world matrix should be
+// brought near the origin first, see simd4x4d_relative_to_simd4x4f
+vectorial_inline void simd4x4d_to_simd4x4f(const simd4x4d* a, simd4x4f* out) {
+    out->x = simd4d_to_simd4f(a->x);
+    out->y = simd4d_to_simd4f(a->y);
+    out->z = simd4d_to_simd4f(a->z);
+    out->w = simd4d_to_simd4f(a->w);
+}
+
+// Float matrix for drawing relative to origin, the translation is moved by
+// -origin in doubles before anything is rounded
+vectorial_inline void simd4x4d_relative_to_simd4x4f(const simd4x4d* a, simd4d origin, simd4x4f* out) {
+    simd4x4d r = *a;
+    r.w = simd4d_sub(r.w, simd4d_zero_w(origin));
+    simd4x4d_to_simd4x4f(&r, out);
+}
+
+
+
+#ifdef __cplusplus
+
+    #ifdef VECTORIAL_OSTREAM
+        #include <ostream>
+
+        vectorial_inline std::ostream& operator<<(std::ostream& os, const simd4x4d& v) {
+            os << "simd4x4d(" << v.x << ",\n"
+               << "         " << v.y << ",\n"
+               << "         " << v.z << ",\n"
+               << "         " << v.w << ")";
+            return os;
+        }
+    #endif
+
+#endif
+
+
+
+
+
+#endif
@@ -82,9 +82,9 @@ vectorial_inline void simd4x4f_matrix_vector_mul(const simd4x4f* a, const simd4f
     const simd4f vz = simd4f_splat_z(v);
     const simd4f vw = simd4f_splat_w(v);
 
-    #if 0
-    // In a hasty benchmark, this actually performed worse on neon
-    // TODO: revisit and conditionalize accordingly
+    #ifdef VECTORIAL_HAVE_FMA
+    // The madd chain is only used with fused multiply-add, the non-fused
+    // vmlaq chain performed worse on neon. See bench/madd_bench.cpp
 
     *out = simd4f_madd(x, vx, 
              simd4f_madd(y, vy, 
@@ -103,7 +103,7 @@ vectorial_inline void simd4x4f_matrix_vector_mul(const simd4x4f* a, const simd4f
 
 vectorial_inline void simd4x4f_matrix_vector3_mul(const simd4x4f* a, const simd4f * b, simd4f* out) {
 
-    #if 0
+    #ifdef VECTORIAL_HAVE_FMA
     *out = simd4f_madd( a->x, simd4f_splat_x(*b), 
              simd4f_madd( a->y, simd4f_splat_y(*b), 
                simd4f_mul(a->z, simd4f_splat_z(*b)) ) );
@@ -117,7 +117,7 @@ vectorial_inline void simd4x4f_matrix_vector3_mul(const simd4x4f* a, const simd4
 
 vectorial_inline void simd4x4f_matrix_point3_mul(const simd4x4f* a, const simd4f * b, simd4f* out) {
 
-    #if 0
+    #ifdef VECTORIAL_HAVE_FMA
     *out = simd4f_madd( a->x, simd4f_splat_x(*b),
              simd4f_madd( a->y, simd4f_splat_y(*b),
                simd4f_madd( a->z, simd4f_splat_z(*b),
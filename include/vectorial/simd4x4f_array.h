@@ -0,0 +1,552 @@
+/*
+  Vectorial
+  Copyright (c) 2010 Mikko Lehtonen
+  Licensed under the terms of the two-clause BSD License (see LICENSE)
+*/
+#ifndef VECTORIAL_SIMD4X4F_ARRAY_H
+#define VECTORIAL_SIMD4X4F_ARRAY_H
+
+#ifndef VECTORIAL_SIMD4X4F_H
+  #include "vectorial/simd4x4f.h"
+#endif
+
+#ifndef VECTORIAL_SIMD4F_AOS_H
+  #include "vectorial/simd4f_aos.h"
+#endif
+
+#ifndef VECTORIAL_SIMD8F_H
+  #include "vectorial/simd8f.h"
+#endif
+
+#ifndef VECTORIAL_CPU_H
+  #include "vectorial/cpu.h"
+#endif
+
+#include <stddef.h>
+
+/*
+  Kernels working on whole arrays, keeping the matrix in registers. With
+  VECTORIAL_DISPATCH the simd4f array ones pick an AVX2 or AVX-512 variant
+  at runtime (see cpu.h), otherwise they loop over the simd4x4f functions
+  compiled for the configured simd type.
+
+  Every element is loaded before its result is stored, so out may be the
+  same array as one of the inputs.
+*/
+
+#ifdef VECTORIAL_DISPATCH
+    #include "simd4x4f_array_avx.h"
+#endif
+
+
+// a and b advance by a_step and b_step matrices, 0 repeats one matrix
+vectorial_inline void _simd4x4f_matrix_mul_array_default(const simd4x4f* a, size_t a_step, const simd4x4f* b, size_t b_step, simd4x4f* out, size_t n, int stream) {
+    for(size_t i = 0; i < n; ++i) {
+        const simd4x4f ma = a[i*a_step];
+        const simd4x4f mb = b[i*b_step];
+        simd4x4f m;
+        simd4x4f_matrix_mul(&ma, &mb, &m);
+#ifdef VECTORIAL_SSE
+        if( stream ) {
+            float* fo = (float*)&out[i];
+            _mm_stream_ps(fo + 0, m.x);
+            _mm_stream_ps(fo + 4, m.y);
+            _mm_stream_ps(fo + 8, m.z);
+            _mm_stream_ps(fo + 12, m.w);
+            continue;
+        }
+#endif
+        out[i] = m;
+    }
+#ifdef VECTORIAL_SSE
+    if( stream ) _mm_sfence();
+#endif
+}
+
+vectorial_inline void _simd4x4f_matrix_point3_mul_array_default(const simd4x4f* m, const simd4f* in, simd4f* out, size_t n) {
+    const simd4x4f mm = *m;
+    size_t i = 0;
+    const size_t n4 = n & ~(size_t)3;
+    for(; i < n4; i += 4) {
+        const simd4f p0 = in[i], p1 = in[i+1], p2 = in[i+2], p3 = in[i+3];
+        simd4x4f_matrix_point3_mul(&mm, &p0, &out[i]);
+        simd4x4f_matrix_point3_mul(&mm, &p1, &out[i+1]);
+        simd4x4f_matrix_point3_mul(&mm, &p2, &out[i+2]);
+        simd4x4f_matrix_point3_mul(&mm, &p3, &out[i+3]);
+    }
+    for(; i < n; ++i) {
+        simd4x4f_matrix_point3_mul(&mm, &in[i], &out[i]);
+    }
+}
+
+// The divide by w while the result is still in a register
+vectorial_inline simd4f _simd4x4f_matrix_point3_project(const simd4x4f* m, const simd4f* p) {
+    simd4f o;
+    simd4x4f_matrix_point3_mul(m, p, &o);
+    return simd4f_div(o, simd4f_splat_w(o));
+}
+
+vectorial_inline void _simd4x4f_matrix_point3_project_array_default(const simd4x4f* m, const simd4f* in, simd4f* out, size_t n) {
+    const simd4x4f mm = *m;
+    size_t i = 0;
+    const size_t n4 = n & ~(size_t)3;
+    for(; i < n4; i += 4) {
+        const simd4f p0 = in[i], p1 = in[i+1], p2 = in[i+2], p3 = in[i+3];
+        out[i] = _simd4x4f_matrix_point3_project(&mm, &p0);
+        out[i+1] = _simd4x4f_matrix_point3_project(&mm, &p1);
+        out[i+2] = _simd4x4f_matrix_point3_project(&mm, &p2);
+        out[i+3] = _simd4x4f_matrix_point3_project(&mm, &p3);
+    }
+    for(; i < n; ++i) {
+        out[i] = _simd4x4f_matrix_point3_project(&mm, &in[i]);
+    }
+}
+
+vectorial_inline void _simd4x4f_matrix_vector3_mul_array_default(const simd4x4f* m, const simd4f* in, simd4f* out, size_t n) {
+    const simd4x4f mm = *m;
+    size_t i = 0;
+    const size_t n4 = n & ~(size_t)3;
+    for(; i < n4; i += 4) {
+        const simd4f p0 = in[i], p1 = in[i+1], p2 = in[i+2], p3 = in[i+3];
+        simd4x4f_matrix_vector3_mul(&mm, &p0, &out[i]);
+        simd4x4f_matrix_vector3_mul(&mm, &p1, &out[i+1]);
+        simd4x4f_matrix_vector3_mul(&mm, &p2, &out[i+2]);
+        simd4x4f_matrix_vector3_mul(&mm, &p3, &out[i+3]);
+    }
+    for(; i < n; ++i) {
+        simd4x4f_matrix_vector3_mul(&mm, &in[i], &out[i]);
+    }
+}
+
+vectorial_inline void _simd4x4f_matrix_vector_mul_array_default(const simd4x4f* m, const simd4f* in, simd4f* out, size_t n) {
+    const simd4x4f mm = *m;
+    size_t i = 0;
+    const size_t n4 = n & ~(size_t)3;
+    for(; i < n4; i += 4) {
+        const simd4f p0 = in[i], p1 = in[i+1], p2 = in[i+2], p3 = in[i+3];
+        simd4x4f_matrix_vector_mul(&mm, &p0, &out[i]);
+        simd4x4f_matrix_vector_mul(&mm, &p1, &out[i+1]);
+        simd4x4f_matrix_vector_mul(&mm, &p2, &out[i+2]);
+        simd4x4f_matrix_vector_mul(&mm, &p3, &out[i+3]);
+    }
+    for(; i < n; ++i) {
+        simd4x4f_matrix_vector_mul(&mm, &in[i], &out[i]);
+    }
+}
+
+
+vectorial_inline void _simd4x4f_matrix_mul_array_dispatch(const simd4x4f* a, size_t a_step, const simd4x4f* b, size_t b_step, simd4x4f* out, size_t n, int stream) {
+#ifdef VECTORIAL_DISPATCH
+    switch( vectorial_dispatch_isa() ) {
+        case VECTORIAL_ISA_AVX512: _simd4x4f_matrix_mul_array_avx512(a, a_step, b, b_step, out, n, stream); return;
+        case VECTORIAL_ISA_AVX2: _simd4x4f_matrix_mul_array_avx2(a, a_step, b, b_step, out, n, stream); return;
+        default: break;
+    }
+#endif
+    _simd4x4f_matrix_mul_array_default(a, a_step, b, b_step, out, n, stream);
+}
+
+// out[i] = a[i] * b[i]
+vectorial_inline void simd4x4f_matrix_mul_array(const simd4x4f* a, const simd4x4f* b, simd4x4f* out, size_t n) {
+    _simd4x4f_matrix_mul_array_dispatch(a, 1, b, 1, out, n, 0);
+}
+
+// out[i] = *a * b[i], f.ex. parent * local. out may be b but not a.
+vectorial_inline void simd4x4f_matrix_mul_one_by_array(const simd4x4f* a, const simd4x4f* b, simd4x4f* out, size_t n) {
+    _simd4x4f_matrix_mul_array_dispatch(a, 0, b, 1, out, n, 0);
+}
+
+// out[i] = a[i] * *b. out may be a but not b.
+vectorial_inline void simd4x4f_matrix_mul_array_by_one(const simd4x4f* a, const simd4x4f* b, simd4x4f* out, size_t n) {
+    _simd4x4f_matrix_mul_array_dispatch(a, 1, b, 0, out, n, 0);
+}
+
+/*
+  The same with non-temporal stores, for outputs much larger than the
+  cache that are not read again soon. They skip the cache, which for
+  small or soon reused outputs is slower than the plain versions.
+  Only on x86, elsewhere these are the plain versions.
+*/
+
+vectorial_inline void simd4x4f_matrix_mul_array_stream(const simd4x4f* a, const simd4x4f* b, simd4x4f* out, size_t n) {
+    _simd4x4f_matrix_mul_array_dispatch(a, 1, b, 1, out, n, 1);
+}
+
+vectorial_inline void simd4x4f_matrix_mul_one_by_array_stream(const simd4x4f* a, const simd4x4f* b, simd4x4f* out, size_t n) {
+    _simd4x4f_matrix_mul_array_dispatch(a, 0, b, 1, out, n, 1);
+}
+
+vectorial_inline void simd4x4f_matrix_mul_array_by_one_stream(const simd4x4f* a, const simd4x4f* b, simd4x4f* out, size_t n) {
+    _simd4x4f_matrix_mul_array_dispatch(a, 1, b, 0, out, n, 1);
+}
+
+// out[i] = m * in[i], as simd4x4f_matrix_point3_mul
+vectorial_inline void simd4x4f_matrix_point3_mul_array(const simd4x4f* m, const simd4f* in, simd4f* out, size_t n) {
+#ifdef VECTORIAL_DISPATCH
+    switch( vectorial_dispatch_isa() ) {
+        case VECTORIAL_ISA_AVX512: _simd4x4f_transform_array_avx512(m, in, out, n, _SIMD4X4F_ARRAY_POINT3); return;
+        case VECTORIAL_ISA_AVX2: _simd4x4f_transform_array_avx2(m, in, out, n, _SIMD4X4F_ARRAY_POINT3); return;
+        default: break;
+    }
+#endif
+    _simd4x4f_matrix_point3_mul_array_default(m, in, out, n);
+}
+
+// out[i] = m * in[i], as simd4x4f_matrix_vector3_mul
+vectorial_inline void simd4x4f_matrix_vector3_mul_array(const simd4x4f* m, const simd4f* in, simd4f* out, size_t n) {
+#ifdef VECTORIAL_DISPATCH
+    switch( vectorial_dispatch_isa() ) {
+        case VECTORIAL_ISA_AVX512: _simd4x4f_transform_array_avx512(m, in, out, n, _SIMD4X4F_ARRAY_VECTOR3); return;
+        case VECTORIAL_ISA_AVX2: _simd4x4f_transform_array_avx2(m, in, out, n, _SIMD4X4F_ARRAY_VECTOR3); return;
+        default: break;
+    }
+#endif
+    _simd4x4f_matrix_vector3_mul_array_default(m, in, out, n);
+}
+
+// out[i] = m * in[i], as simd4x4f_matrix_vector_mul
+vectorial_inline void simd4x4f_matrix_vector_mul_array(const simd4x4f* m, const simd4f* in, simd4f* out, size_t n) {
+#ifdef VECTORIAL_DISPATCH
+    switch( vectorial_dispatch_isa() ) {
+        case VECTORIAL_ISA_AVX512: _simd4x4f_transform_array_avx512(m, in, out, n, _SIMD4X4F_ARRAY_VECTOR4); return;
+        case VECTORIAL_ISA_AVX2: _simd4x4f_transform_array_avx2(m, in, out, n, _SIMD4X4F_ARRAY_VECTOR4); return;
+        default: break;
+    }
+#endif
+    _simd4x4f_matrix_vector_mul_array_default(m, in, out, n);
+}
+
+// out[i] = m * in[i] divided by its w, for projecting points with a
+// perspective matrix. w of the result is 1.
+vectorial_inline void simd4x4f_matrix_point3_project_array(const simd4x4f* m, const simd4f* in, simd4f* out, size_t n) {
+#ifdef VECTORIAL_DISPATCH
+    switch( vectorial_dispatch_isa() ) {
+        case VECTORIAL_ISA_AVX512: _simd4x4f_transform_array_avx512(m, in, out, n, _SIMD4X4F_ARRAY_PROJECT3); return;
+        case VECTORIAL_ISA_AVX2: _simd4x4f_transform_array_avx2(m, in, out, n, _SIMD4X4F_ARRAY_PROJECT3); return;
+        default: break;
+    }
+#endif
+    _simd4x4f_matrix_point3_project_array_default(m, in, out, n);
+}
+
+
+/*
+  Packed float[3] arrays. Four points at a time are transposed with
+  simd4f_aos.h and transformed with one splatted matrix element per
+  register, the rest go one by one.
+*/
+
+// The matrix transposed and splatted, r[i][j] = m->j[i]
+typedef struct {
+    simd4f r[4][4];
+} _simd4x4f_splatted;
+
+vectorial_inline void _simd4x4f_splat_elements(const simd4x4f* m, _simd4x4f_splatted* out) {
+    simd4x4f t;
+    simd4x4f_transpose(m, &t);
+    const simd4f rows[4] = { t.x, t.y, t.z, t.w };
+    for(int i = 0; i < 4; ++i) {
+        out->r[i][0] = simd4f_splat_x(rows[i]);
+        out->r[i][1] = simd4f_splat_y(rows[i]);
+        out->r[i][2] = simd4f_splat_z(rows[i]);
+        out->r[i][3] = simd4f_splat_w(rows[i]);
+    }
+}
+
+// Row i of the matrix times (x,y,z,1), or (x,y,z,0) without translation
+vectorial_inline simd4f _simd4x4f_soa_row(const _simd4x4f_splatted* s, int i, simd4f x, simd4f y, simd4f z, int translate) {
+    const simd4f t = translate ? s->r[i][3] : simd4f_zero();
+    return simd4f_madd(s->r[i][0], x, simd4f_madd(s->r[i][1], y, simd4f_madd(s->r[i][2], z, t)));
+}
+
+// Points with translate, vectors without. project divides by w.
+vectorial_inline void _simd4x4f_transform_packed3(const simd4x4f* m, const float* in, float* out, size_t n, int translate, int project) {
+    _simd4x4f_splatted s;
+    _simd4x4f_splat_elements(m, &s);
+
+    size_t i = 0;
+    const size_t n4 = n & ~(size_t)3;
+    for(; i < n4; i += 4) {
+        simd4f x, y, z;
+        simd4f_aos_load3(in + 3*i, 3, &x, &y, &z);
+        simd4f ox = _simd4x4f_soa_row(&s, 0, x, y, z, translate);
+        simd4f oy = _simd4x4f_soa_row(&s, 1, x, y, z, translate);
+        simd4f oz = _simd4x4f_soa_row(&s, 2, x, y, z, translate);
+        if( project ) {
+            const simd4f ow = _simd4x4f_soa_row(&s, 3, x, y, z, translate);
+            ox = simd4f_div(ox, ow);
+            oy = simd4f_div(oy, ow);
+            oz = simd4f_div(oz, ow);
+        }
+        simd4f_aos_store3(ox, oy, oz, out + 3*i, 3);
+    }
+    for(; i < n; ++i) {
+        const simd4f p = simd4f_uload3(in + 3*i);
+        simd4f o;
+        if( translate ) simd4x4f_matrix_point3_mul(m, &p, &o);
+        else simd4x4f_matrix_vector3_mul(m, &p, &o);
+        if( project ) o = simd4f_div(o, simd4f_splat_w(o));
+        simd4f_ustore3(o, out + 3*i);
+    }
+}
+
+// out[i] = m * in[i] for n packed points, as simd4x4f_matrix_point3_mul
+vectorial_inline void simd4x4f_matrix_point3_mul_packed3(const simd4x4f* m, const float* in, float* out, size_t n) {
+    _simd4x4f_transform_packed3(m, in, out, n, 1, 0);
+}
+
+// out[i] = m * in[i] for n packed vectors, as simd4x4f_matrix_vector3_mul
+vectorial_inline void simd4x4f_matrix_vector3_mul_packed3(const simd4x4f* m, const float* in, float* out, size_t n) {
+    _simd4x4f_transform_packed3(m, in, out, n, 0, 0);
+}
+
+// As simd4x4f_matrix_point3_project_array for n packed points
+vectorial_inline void simd4x4f_matrix_point3_project_packed3(const simd4x4f* m, const float* in, float* out, size_t n) {
+    _simd4x4f_transform_packed3(m, in, out, n, 1, 1);
+}
+
+
+/*
+  Inverses of four or eight matrices at once. The matrices are transposed
+  so each register holds the same element of all of them, a[row][col],
+  and the cofactors come from 2x2 determinants without any shuffles.
+*/
+
+// p*q - r*s, and p*q - r*s + u*v
+vectorial_inline simd4f _simd4f_soa_det2(simd4f p, simd4f q, simd4f r, SIMD_PARAM(simd4f, s)) {
+    return simd4f_sub( simd4f_mul(p, q), simd4f_mul(r, s) );
+}
+
+vectorial_inline simd4f _simd4f_soa_cofactor(simd4f p, simd4f q, simd4f r, SIMD_PARAM(simd4f, s), SIMD_PARAM(simd4f, u), SIMD_PARAM(simd4f, v)) {
+    return simd4f_madd( u, v, _simd4f_soa_det2(p, q, r, s) );
+}
+
+vectorial_inline simd8f _simd8f_soa_det2(simd8f p, simd8f q, simd8f r, SIMD_PARAM(simd8f, s)) {
+    return simd8f_sub( simd8f_mul(p, q), simd8f_mul(r, s) );
+}
+
+vectorial_inline simd8f _simd8f_soa_cofactor(simd8f p, simd8f q, simd8f r, SIMD_PARAM(simd8f, s), SIMD_PARAM(simd8f, u), SIMD_PARAM(simd8f, v)) {
+    return simd8f_madd( u, v, _simd8f_soa_det2(p, q, r, s) );
+}
+
+// Element (row, col) of in[0..3] into lane 0..3 of a[row][col]
+vectorial_inline void _simd4x4f_soa4_load(const simd4x4f* in, simd4f a[4][4]) {
+    for(int c = 0; c < 4; ++c) {
+        simd4x4f t = simd4x4f_create( (&in[0].x)[c], (&in[1].x)[c], (&in[2].x)[c], (&in[3].x)[c] );
+        simd4x4f_transpose_inplace(&t);
+        a[0][c] = t.x;
+        a[1][c] = t.y;
+        a[2][c] = t.z;
+        a[3][c] = t.w;
+    }
+}
+
+vectorial_inline void _simd4x4f_soa4_store(simd4f b[4][4], simd4x4f* out) {
+    simd4x4f t[4];
+    for(int c = 0; c < 4; ++c) {
+        t[c] = simd4x4f_create( b[0][c], b[1][c], b[2][c], b[3][c] );
+        simd4x4f_transpose_inplace(&t[c]);
+    }
+    out[0] = simd4x4f_create( t[0].x, t[1].x, t[2].x, t[3].x );
+    out[1] = simd4x4f_create( t[0].y, t[1].y, t[2].y, t[3].y );
+    out[2] = simd4x4f_create( t[0].z, t[1].z, t[2].z, t[3].z );
+    out[3] = simd4x4f_create( t[0].w, t[1].w, t[2].w, t[3].w );
+}
+
+// Returns the determinants, in and out may be the same matrices
+vectorial_inline simd4f simd4x4f_inverse4(const simd4x4f* in, simd4x4f* out) {
+    simd4f a[4][4];
+    _simd4x4f_soa4_load(in, a);
+
+    const simd4f s0 = _simd4f_soa_det2(a[0][0], a[1][1], a[1][0], a[0][1]);
+    const simd4f s1 = _simd4f_soa_det2(a[0][0], a[1][2], a[1][0], a[0][2]);
+    const simd4f s2 = _simd4f_soa_det2(a[0][0], a[1][3], a[1][0], a[0][3]);
+    const simd4f s3 = _simd4f_soa_det2(a[0][1], a[1][2], a[1][1], a[0][2]);
+    const simd4f s4 = _simd4f_soa_det2(a[0][1], a[1][3], a[1][1], a[0][3]);
+    const simd4f s5 = _simd4f_soa_det2(a[0][2], a[1][3], a[1][2], a[0][3]);
+
+    const simd4f c0 = _simd4f_soa_det2(a[2][0], a[3][1], a[3][0], a[2][1]);
+    const simd4f c1 = _simd4f_soa_det2(a[2][0], a[3][2], a[3][0], a[2][2]);
+    const simd4f c2 = _simd4f_soa_det2(a[2][0], a[3][3], a[3][0], a[2][3]);
+    const simd4f c3 = _simd4f_soa_det2(a[2][1], a[3][2], a[3][1], a[2][2]);
+    const simd4f c4 = _simd4f_soa_det2(a[2][1], a[3][3], a[3][1], a[2][3]);
+    const simd4f c5 = _simd4f_soa_det2(a[2][2], a[3][3], a[3][2], a[2][3]);
+
+    const simd4f det = simd4f_add( _simd4f_soa_cofactor(s0, c5, s1, c4, s2, c3),
+                                   _simd4f_soa_cofactor(s3, c2, s4, c1, s5, c0) );
+    const simd4f r = simd4f_div( simd4f_splat(1.0f), det );
+    const simd4f nr = simd4f_sub( simd4f_zero(), r );
+
+    simd4f b[4][4];
+    b[0][0] = simd4f_mul(  r, _simd4f_soa_cofactor(a[1][1], c5, a[1][2], c4, a[1][3], c3) );
+    b[0][1] = simd4f_mul( nr, _simd4f_soa_cofactor(a[0][1], c5, a[0][2], c4, a[0][3], c3) );
+    b[0][2] = simd4f_mul(  r, _simd4f_soa_cofactor(a[3][1], s5, a[3][2], s4, a[3][3], s3) );
+    b[0][3] = simd4f_mul( nr, _simd4f_soa_cofactor(a[2][1], s5, a[2][2], s4, a[2][3], s3) );
+
+    b[1][0] = simd4f_mul( nr, _simd4f_soa_cofactor(a[1][0], c5, a[1][2], c2, a[1][3], c1) );
+    b[1][1] = simd4f_mul(  r, _simd4f_soa_cofactor(a[0][0], c5, a[0][2], c2, a[0][3], c1) );
+    b[1][2] = simd4f_mul( nr, _simd4f_soa_cofactor(a[3][0], s5, a[3][2], s2, a[3][3], s1) );
+    b[1][3] = simd4f_mul(  r, _simd4f_soa_cofactor(a[2][0], s5, a[2][2], s2, a[2][3], s1) );
+
+    b[2][0] = simd4f_mul(  r, _simd4f_soa_cofactor(a[1][0], c4, a[1][1], c2, a[1][3], c0) );
+    b[2][1] = simd4f_mul( nr, _simd4f_soa_cofactor(a[0][0], c4, a[0][1], c2, a[0][3], c0) );
+    b[2][2] = simd4f_mul(  r, _simd4f_soa_cofactor(a[3][0], s4, a[3][1], s2, a[3][3], s0) );
+    b[2][3] = simd4f_mul( nr, _simd4f_soa_cofactor(a[2][0], s4, a[2][1], s2, a[2][3], s0) );
+
+    b[3][0] = simd4f_mul( nr, _simd4f_soa_cofactor(a[1][0], c3, a[1][1], c1, a[1][2], c0) );
+    b[3][1] = simd4f_mul(  r, _simd4f_soa_cofactor(a[0][0], c3, a[0][1], c1, a[0][2], c0) );
+    b[3][2] = simd4f_mul( nr, _simd4f_soa_cofactor(a[3][0], s3, a[3][1], s1, a[3][2], s0) );
+    b[3][3] = simd4f_mul(  r, _simd4f_soa_cofactor(a[2][0], s3, a[2][1], s1, a[2][2], s0) );
+
+    _simd4x4f_soa4_store(b, out);
+    return det;
+}
+
+// Eight at a time, in[0..3] in the low and in[4..7] in the high four lanes.
+// With AVX both halves are transposed together within their 128bit lanes.
+
+#ifdef VECTORIAL_SIMD8F_AVX
+vectorial_inline void _simd8f_transpose_lanes(simd8f r[4]) {
+    const __m256 t0 = _mm256_unpacklo_ps(r[0], r[1]);
+    const __m256 t1 = _mm256_unpackhi_ps(r[0], r[1]);
+    const __m256 t2 = _mm256_unpacklo_ps(r[2], r[3]);
+    const __m256 t3 = _mm256_unpackhi_ps(r[2], r[3]);
+    r[0] = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1,0,1,0));
+    r[1] = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3,2,3,2));
+    r[2] = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1,0,1,0));
+    r[3] = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3,2,3,2));
+}
+#endif
+
+vectorial_inline void _simd4x4f_soa8_load(const simd4x4f* in, simd8f a[4][4]) {
+#ifdef VECTORIAL_SIMD8F_AVX
+    for(int c = 0; c < 4; ++c) {
+        simd8f r[4];
+        for(int k = 0; k < 4; ++k) r[k] = simd8f_combine( (&in[k].x)[c], (&in[k + 4].x)[c] );
+        _simd8f_transpose_lanes(r);
+        for(int i = 0; i < 4; ++i) a[i][c] = r[i];
+    }
+#else
+    simd4f lo[4][4], hi[4][4];
+    _simd4x4f_soa4_load(in, lo);
+    _simd4x4f_soa4_load(in + 4, hi);
+    for(int i = 0; i < 4; ++i) {
+        for(int j = 0; j < 4; ++j) a[i][j] = simd8f_combine(lo[i][j], hi[i][j]);
+    }
+#endif
+}
+
+vectorial_inline void _simd4x4f_soa8_store(simd8f b[4][4], simd4x4f* out) {
+#ifdef VECTORIAL_SIMD8F_AVX
+    simd8f r[4][4];
+    for(int c = 0; c < 4; ++c) {
+        for(int i = 0; i < 4; ++i) r[c][i] = b[i][c];
+        _simd8f_transpose_lanes(r[c]);
+    }
+    for(int k = 0; k < 4; ++k) {
+        out[k] = simd4x4f_create( simd8f_get_low(r[0][k]), simd8f_get_low(r[1][k]),
+                                  simd8f_get_low(r[2][k]), simd8f_get_low(r[3][k]) );
+        out[k + 4] = simd4x4f_create( simd8f_get_high(r[0][k]), simd8f_get_high(r[1][k]),
+                                      simd8f_get_high(r[2][k]), simd8f_get_high(r[3][k]) );
+    }
+#else
+    simd4f lo[4][4], hi[4][4];
+    for(int i = 0; i < 4; ++i) {
+        for(int j = 0; j < 4; ++j) {
+            lo[i][j] = simd8f_get_low(b[i][j]);
+            hi[i][j] = simd8f_get_high(b[i][j]);
+        }
+    }
+    _simd4x4f_soa4_store(lo, out);
+    _simd4x4f_soa4_store(hi, out + 4);
+#endif
+}
+
+vectorial_inline simd8f simd4x4f_inverse8(const simd4x4f* in, simd4x4f* out) {
+    simd8f a[4][4];
+    _simd4x4f_soa8_load(in, a);
+
+    const simd8f s0 = _simd8f_soa_det2(a[0][0], a[1][1], a[1][0], a[0][1]);
+    const simd8f s1 = _simd8f_soa_det2(a[0][0], a[1][2], a[1][0], a[0][2]);
+    const simd8f s2 = _simd8f_soa_det2(a[0][0], a[1][3], a[1][0], a[0][3]);
+    const simd8f s3 = _simd8f_soa_det2(a[0][1], a[1][2], a[1][1], a[0][2]);
+    const simd8f s4 = _simd8f_soa_det2(a[0][1], a[1][3], a[1][1], a[0][3]);
+    const simd8f s5 = _simd8f_soa_det2(a[0][2], a[1][3], a[1][2], a[0][3]);
+
+    const simd8f c0 = _simd8f_soa_det2(a[2][0], a[3][1], a[3][0], a[2][1]);
+    const simd8f c1 = _simd8f_soa_det2(a[2][0], a[3][2], a[3][0], a[2][2]);
+    const simd8f c2 = _simd8f_soa_det2(a[2][0], a[3][3], a[3][0], a[2][3]);
+    const simd8f c3 = _simd8f_soa_det2(a[2][1], a[3][2], a[3][1], a[2][2]);
+    const simd8f c4 = _simd8f_soa_det2(a[2][1], a[3][3], a[3][1], a[2][3]);
+    const simd8f c5 = _simd8f_soa_det2(a[2][2], a[3][3], a[3][2], a[2][3]);
+
+    const simd8f det = simd8f_add( _simd8f_soa_cofactor(s0, c5, s1, c4, s2, c3),
+                                   _simd8f_soa_cofactor(s3, c2, s4, c1, s5, c0) );
+    const simd8f r = simd8f_div( simd8f_splat(1.0f), det );
+    const simd8f nr = simd8f_sub( simd8f_zero(), r );
+
+    simd8f b[4][4];
+    b[0][0] = simd8f_mul(  r, _simd8f_soa_cofactor(a[1][1], c5, a[1][2], c4, a[1][3], c3) );
+    b[0][1] = simd8f_mul( nr, _simd8f_soa_cofactor(a[0][1], c5, a[0][2], c4, a[0][3], c3) );
+    b[0][2] = simd8f_mul(  r, _simd8f_soa_cofactor(a[3][1], s5, a[3][2], s4, a[3][3], s3) );
+    b[0][3] = simd8f_mul( nr, _simd8f_soa_cofactor(a[2][1], s5, a[2][2], s4, a[2][3], s3) );
+
+    b[1][0] = simd8f_mul( nr, _simd8f_soa_cofactor(a[1][0], c5, a[1][2], c2, a[1][3], c1) );
+    b[1][1] = simd8f_mul(  r, _simd8f_soa_cofactor(a[0][0], c5, a[0][2], c2, a[0][3], c1) );
+    b[1][2] = simd8f_mul( nr, _simd8f_soa_cofactor(a[3][0], s5, a[3][2], s2, a[3][3], s1) );
+    b[1][3] = simd8f_mul(  r, _simd8f_soa_cofactor(a[2][0], s5, a[2][2], s2, a[2][3], s1) );
+
+    b[2][0] = simd8f_mul(  r, _simd8f_soa_cofactor(a[1][0], c4, a[1][1], c2, a[1][3], c0) );
+    b[2][1] = simd8f_mul( nr, _simd8f_soa_cofactor(a[0][0], c4, a[0][1], c2, a[0][3], c0) );
+    b[2][2] = simd8f_mul(  r, _simd8f_soa_cofactor(a[3][0], s4, a[3][1], s2, a[3][3], s0) );
+    b[2][3] = simd8f_mul( nr, _simd8f_soa_cofactor(a[2][0], s4, a[2][1], s2, a[2][3], s0) );
+
+    b[3][0] = simd8f_mul( nr, _simd8f_soa_cofactor(a[1][0], c3, a[1][1], c1, a[1][2], c0) );
+    b[3][1] = simd8f_mul(  r, _simd8f_soa_cofactor(a[0][0], c3, a[0][1], c1, a[0][2], c0) );
+    b[3][2] = simd8f_mul( nr, _simd8f_soa_cofactor(a[3][0], s3, a[3][1], s1, a[3][2], s0) );
+    b[3][3] = simd8f_mul(  r, _simd8f_soa_cofactor(a[2][0], s3, a[2][1], s1, a[2][2], s0) );
+
+    _simd4x4f_soa8_store(b, out);
+    return det;
+}
+
+
+// Eight at a time where simd8f is a native AVX register, four elsewhere.
+// det, if not NULL, gets the n determinants for
+// singularity checks. out may be the same array as in.
+vectorial_inline void simd4x4f_inverse_array_det(const simd4x4f* in, simd4x4f* out, float* det, size_t n) {
+    size_t i = 0;
+#ifdef VECTORIAL_SIMD8F_AVX
+    for(; i + 8 <= n; i += 8) {
+        const simd8f d = simd4x4f_inverse8(in + i, out + i);
+        if( det ) simd8f_ustore8(d, det + i);
+    }
+#endif
+    for(; i + 4 <= n; i += 4) {
+        const simd4f d = simd4x4f_inverse4(in + i, out + i);
+        if( det ) simd4f_ustore4(d, det + i);
+    }
+    if( i < n ) {
+        // The last few padded with identities
+        simd4x4f m[4];
+        float d[4];
+        for(size_t j = 0; j < 4; ++j) {
+            if( i + j < n ) m[j] = in[i + j];
+            else simd4x4f_identity(&m[j]);
+        }
+        simd4f_ustore4( simd4x4f_inverse4(m, m), d );
+        for(size_t j = 0; i + j < n; ++j) {
+            out[i + j] = m[j];
+            if( det ) det[i + j] = d[j];
+        }
+    }
+}
+
+// out[i] = inverse of in[i]
+vectorial_inline void simd4x4f_inverse_array(const simd4x4f* in, simd4x4f* out, size_t n) {
+    simd4x4f_inverse_array_det(in, out, NULL, n);
+}
+
+
+
+#endif
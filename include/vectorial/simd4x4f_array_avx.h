@@ -0,0 +1,271 @@
+/*
+  Vectorial
+  Copyright (c) 2010 Mikko Lehtonen
+  Licensed under the terms of the two-clause BSD License (see LICENSE)
+*/
+#ifndef VECTORIAL_SIMD4X4F_ARRAY_AVX_H
+#define VECTORIAL_SIMD4X4F_ARRAY_AVX_H
+
+/*
+  Runtime dispatched variants of the simd4x4f_array.h kernels. These are
+  compiled for AVX2 / AVX-512 with target attributes regardless of the
+  compiler flags, and only called after cpu.h has seen the cpu support them.
+
+  AVX2 keeps two simd4f per register and AVX-512 four, the in-lane permutes
+  splat x,y,z,w within each 128bit part like simd4f_splat_x etc. do.
+*/
+
+#include <immintrin.h>
+
+
+// AVX2
+
+// a and b advance by a_step and b_step matrices, 0 repeats one matrix for
+// all of them. stream writes out with non-temporal stores.
+
+vectorial_target("avx2,fma")
+vectorial_inline void _simd4x4f_mul_avx2(const float* fa, __m256 bxy, __m256 bzw, __m256* oxy, __m256* ozw) {
+    const __m256 ax = _mm256_broadcast_ps((const __m128*)(fa + 0));
+    const __m256 ay = _mm256_broadcast_ps((const __m128*)(fa + 4));
+    const __m256 az = _mm256_broadcast_ps((const __m128*)(fa + 8));
+    const __m256 aw = _mm256_broadcast_ps((const __m128*)(fa + 12));
+
+    __m256 xy = _mm256_mul_ps(aw, _mm256_permute_ps(bxy, 0xff));
+    __m256 zw = _mm256_mul_ps(aw, _mm256_permute_ps(bzw, 0xff));
+    xy = _mm256_fmadd_ps(az, _mm256_permute_ps(bxy, 0xaa), xy);
+    zw = _mm256_fmadd_ps(az, _mm256_permute_ps(bzw, 0xaa), zw);
+    xy = _mm256_fmadd_ps(ay, _mm256_permute_ps(bxy, 0x55), xy);
+    zw = _mm256_fmadd_ps(ay, _mm256_permute_ps(bzw, 0x55), zw);
+    *oxy = _mm256_fmadd_ps(ax, _mm256_permute_ps(bxy, 0x00), xy);
+    *ozw = _mm256_fmadd_ps(ax, _mm256_permute_ps(bzw, 0x00), zw);
+}
+
+vectorial_target("avx2,fma")
+vectorial_inline void _simd4x4f_store_avx2(float* fo, __m256 xy, __m256 zw, int stream) {
+    if( !stream ) {
+        _mm256_storeu_ps(fo + 0, xy);
+        _mm256_storeu_ps(fo + 8, zw);
+    } else if( ((size_t)fo & 31) == 0 ) {
+        _mm256_stream_ps(fo + 0, xy);
+        _mm256_stream_ps(fo + 8, zw);
+    } else {
+        _mm_stream_ps(fo + 0, _mm256_castps256_ps128(xy));
+        _mm_stream_ps(fo + 4, _mm256_extractf128_ps(xy, 1));
+        _mm_stream_ps(fo + 8, _mm256_castps256_ps128(zw));
+        _mm_stream_ps(fo + 12, _mm256_extractf128_ps(zw, 1));
+    }
+}
+
+vectorial_target("avx2,fma")
+vectorial_inline void _simd4x4f_matrix_mul_array_avx2(const simd4x4f* a, size_t a_step, const simd4x4f* b, size_t b_step, simd4x4f* out, size_t n, int stream) {
+    const float* fa = (const float*)a;
+    const float* fb = (const float*)b;
+    float* fo = (float*)out;
+    const size_t fa_step = 16 * a_step;
+    const size_t fb_step = 16 * b_step;
+
+    if( n == 0 ) return;
+
+    // Two matrices per iteration, the single b of many-by-one stays loaded
+    const __m256 bsxy = _mm256_loadu_ps(fb + 0);
+    const __m256 bszw = _mm256_loadu_ps(fb + 8);
+
+    size_t i = 0;
+    for(; i + 2 <= n; i += 2) {
+        const float* fb0 = fb + i*fb_step;
+        const float* fb1 = fb0 + fb_step;
+        const __m256 b0xy = fb_step ? _mm256_loadu_ps(fb0 + 0) : bsxy;
+        const __m256 b0zw = fb_step ? _mm256_loadu_ps(fb0 + 8) : bszw;
+        const __m256 b1xy = fb_step ? _mm256_loadu_ps(fb1 + 0) : bsxy;
+        const __m256 b1zw = fb_step ? _mm256_loadu_ps(fb1 + 8) : bszw;
+
+        __m256 o0xy, o0zw, o1xy, o1zw;
+        _simd4x4f_mul_avx2(fa + i*fa_step, b0xy, b0zw, &o0xy, &o0zw);
+        _simd4x4f_mul_avx2(fa + (i+1)*fa_step, b1xy, b1zw, &o1xy, &o1zw);
+
+        _simd4x4f_store_avx2(fo + 16*i, o0xy, o0zw, stream);
+        _simd4x4f_store_avx2(fo + 16*i + 16, o1xy, o1zw, stream);
+    }
+    if( i < n ) {
+        const float* fb0 = fb + i*fb_step;
+        __m256 oxy, ozw;
+        _simd4x4f_mul_avx2(fa + i*fa_step, _mm256_loadu_ps(fb0 + 0), _mm256_loadu_ps(fb0 + 8), &oxy, &ozw);
+        _simd4x4f_store_avx2(fo + 16*i, oxy, ozw, stream);
+    }
+    if( stream ) _mm_sfence();
+}
+
+// The last term of m * in, by mode: nothing for vector3, the translation
+// m.w for point3 and project3 and m.w * in.w for vector4. project3 then
+// divides the result by its w before the store.
+#define _SIMD4X4F_ARRAY_VECTOR3 0
+#define _SIMD4X4F_ARRAY_POINT3 1
+#define _SIMD4X4F_ARRAY_VECTOR4 2
+#define _SIMD4X4F_ARRAY_PROJECT3 3
+
+vectorial_target("avx2,fma")
+vectorial_inline __m256 _simd4x4f_array_last_term_avx2(__m256 mw, __m256 p, int mode) {
+    if( mode == _SIMD4X4F_ARRAY_VECTOR4 ) return _mm256_mul_ps(mw, _mm256_permute_ps(p, 0xff));
+    if( mode == _SIMD4X4F_ARRAY_POINT3 || mode == _SIMD4X4F_ARRAY_PROJECT3 ) return mw;
+    return _mm256_setzero_ps();
+}
+
+vectorial_target("avx2,fma")
+vectorial_inline __m256 _simd4x4f_array_finish_avx2(__m256 o, int mode) {
+    if( mode == _SIMD4X4F_ARRAY_PROJECT3 ) return _mm256_div_ps(o, _mm256_permute_ps(o, 0xff));
+    return o;
+}
+
+vectorial_target("avx2,fma")
+vectorial_inline void _simd4x4f_transform_array_avx2(const simd4x4f* m, const simd4f* in, simd4f* out, size_t n, int mode) {
+    const float* fm = (const float*)m;
+    const float* fi = (const float*)in;
+    float* fo = (float*)out;
+
+    const __m256 mx = _mm256_broadcast_ps((const __m128*)(fm + 0));
+    const __m256 my = _mm256_broadcast_ps((const __m128*)(fm + 4));
+    const __m256 mz = _mm256_broadcast_ps((const __m128*)(fm + 8));
+    const __m256 mw = _mm256_broadcast_ps((const __m128*)(fm + 12));
+
+    size_t i = 0;
+    for(; i + 4 <= n; i += 4) {
+        const __m256 p0 = _mm256_loadu_ps(fi + 4*i);
+        const __m256 p1 = _mm256_loadu_ps(fi + 4*i + 8);
+
+        __m256 o0 = _mm256_fmadd_ps(mz, _mm256_permute_ps(p0, 0xaa), _simd4x4f_array_last_term_avx2(mw, p0, mode));
+        __m256 o1 = _mm256_fmadd_ps(mz, _mm256_permute_ps(p1, 0xaa), _simd4x4f_array_last_term_avx2(mw, p1, mode));
+        o0 = _mm256_fmadd_ps(my, _mm256_permute_ps(p0, 0x55), o0);
+        o1 = _mm256_fmadd_ps(my, _mm256_permute_ps(p1, 0x55), o1);
+        o0 = _mm256_fmadd_ps(mx, _mm256_permute_ps(p0, 0x00), o0);
+        o1 = _mm256_fmadd_ps(mx, _mm256_permute_ps(p1, 0x00), o1);
+
+        _mm256_storeu_ps(fo + 4*i, _simd4x4f_array_finish_avx2(o0, mode));
+        _mm256_storeu_ps(fo + 4*i + 8, _simd4x4f_array_finish_avx2(o1, mode));
+    }
+    if( i + 2 <= n ) {
+        const __m256 p = _mm256_loadu_ps(fi + 4*i);
+        __m256 o = _mm256_fmadd_ps(mz, _mm256_permute_ps(p, 0xaa), _simd4x4f_array_last_term_avx2(mw, p, mode));
+        o = _mm256_fmadd_ps(my, _mm256_permute_ps(p, 0x55), o);
+        o = _mm256_fmadd_ps(mx, _mm256_permute_ps(p, 0x00), o);
+        _mm256_storeu_ps(fo + 4*i, _simd4x4f_array_finish_avx2(o, mode));
+        i += 2;
+    }
+    if( i < n ) {
+        // Upper half of the registers is ignored
+        const __m256 p = _mm256_castps128_ps256(_mm_loadu_ps(fi + 4*i));
+        __m256 o = _mm256_fmadd_ps(mz, _mm256_permute_ps(p, 0xaa), _simd4x4f_array_last_term_avx2(mw, p, mode));
+        o = _mm256_fmadd_ps(my, _mm256_permute_ps(p, 0x55), o);
+        o = _mm256_fmadd_ps(mx, _mm256_permute_ps(p, 0x00), o);
+        _mm_storeu_ps(fo + 4*i, _mm256_castps256_ps128(_simd4x4f_array_finish_avx2(o, mode)));
+    }
+}
+
+
+// AVX-512
+
+// The zero masked forms with every lane set compile to the same plain
+// instructions. The unmasked ones start from _mm512_undefined_ps, which
+// GCC reports as uninitialized wherever they get inlined.
+#define _SIMD4X4F_AVX512_BROADCAST4(v) _mm512_maskz_broadcast_f32x4(0xffff, (v))
+#define _SIMD4X4F_AVX512_PERMUTE(v, c) _mm512_maskz_permute_ps(0xffff, (v), (c))
+#define _SIMD4X4F_AVX512_EXTRACT4(v, i) _mm512_maskz_extractf32x4_ps(0xf, (v), (i))
+
+vectorial_target("avx512f")
+vectorial_inline __m512 _simd4x4f_mul_avx512(const float* fa, __m512 bm) {
+    const __m512 ax = _SIMD4X4F_AVX512_BROADCAST4(_mm_loadu_ps(fa + 0));
+    const __m512 ay = _SIMD4X4F_AVX512_BROADCAST4(_mm_loadu_ps(fa + 4));
+    const __m512 az = _SIMD4X4F_AVX512_BROADCAST4(_mm_loadu_ps(fa + 8));
+    const __m512 aw = _SIMD4X4F_AVX512_BROADCAST4(_mm_loadu_ps(fa + 12));
+
+    __m512 o = _mm512_mul_ps(aw, _SIMD4X4F_AVX512_PERMUTE(bm, 0xff));
+    o = _mm512_fmadd_ps(az, _SIMD4X4F_AVX512_PERMUTE(bm, 0xaa), o);
+    o = _mm512_fmadd_ps(ay, _SIMD4X4F_AVX512_PERMUTE(bm, 0x55), o);
+    return _mm512_fmadd_ps(ax, _SIMD4X4F_AVX512_PERMUTE(bm, 0x00), o);
+}
+
+vectorial_target("avx512f")
+vectorial_inline void _simd4x4f_store_avx512(float* fo, __m512 m, int stream) {
+    if( !stream ) {
+        _mm512_storeu_ps(fo, m);
+    } else if( ((size_t)fo & 63) == 0 ) {
+        _mm512_stream_ps(fo, m);
+    } else {
+        _mm_stream_ps(fo + 0, _SIMD4X4F_AVX512_EXTRACT4(m, 0));
+        _mm_stream_ps(fo + 4, _SIMD4X4F_AVX512_EXTRACT4(m, 1));
+        _mm_stream_ps(fo + 8, _SIMD4X4F_AVX512_EXTRACT4(m, 2));
+        _mm_stream_ps(fo + 12, _SIMD4X4F_AVX512_EXTRACT4(m, 3));
+    }
+}
+
+vectorial_target("avx512f")
+vectorial_inline void _simd4x4f_matrix_mul_array_avx512(const simd4x4f* a, size_t a_step, const simd4x4f* b, size_t b_step, simd4x4f* out, size_t n, int stream) {
+    const float* fa = (const float*)a;
+    const float* fb = (const float*)b;
+    float* fo = (float*)out;
+    const size_t fa_step = 16 * a_step;
+    const size_t fb_step = 16 * b_step;
+
+    if( n == 0 ) return;
+
+    const __m512 bs = _mm512_loadu_ps(fb);
+
+    size_t i = 0;
+    for(; i + 2 <= n; i += 2) {
+        const __m512 b0 = fb_step ? _mm512_loadu_ps(fb + i*fb_step) : bs;
+        const __m512 b1 = fb_step ? _mm512_loadu_ps(fb + (i+1)*fb_step) : bs;
+        const __m512 o0 = _simd4x4f_mul_avx512(fa + i*fa_step, b0);
+        const __m512 o1 = _simd4x4f_mul_avx512(fa + (i+1)*fa_step, b1);
+        _simd4x4f_store_avx512(fo + 16*i, o0, stream);
+        _simd4x4f_store_avx512(fo + 16*i + 16, o1, stream);
+    }
+    if( i < n ) {
+        _simd4x4f_store_avx512(fo + 16*i, _simd4x4f_mul_avx512(fa + i*fa_step, _mm512_loadu_ps(fb + i*fb_step)), stream);
+    }
+    if( stream ) _mm_sfence();
+}
+
+vectorial_target("avx512f")
+vectorial_inline __m512 _simd4x4f_array_last_term_avx512(__m512 mw, __m512 p, int mode) {
+    if( mode == _SIMD4X4F_ARRAY_VECTOR4 ) return _mm512_mul_ps(mw, _SIMD4X4F_AVX512_PERMUTE(p, 0xff));
+    if( mode == _SIMD4X4F_ARRAY_POINT3 || mode == _SIMD4X4F_ARRAY_PROJECT3 ) return mw;
+    return _mm512_setzero_ps();
+}
+
+vectorial_target("avx512f")
+vectorial_inline __m512 _simd4x4f_array_finish_avx512(__m512 o, int mode) {
+    if( mode == _SIMD4X4F_ARRAY_PROJECT3 ) return _mm512_div_ps(o, _SIMD4X4F_AVX512_PERMUTE(o, 0xff));
+    return o;
+}
+
+vectorial_target("avx512f")
+vectorial_inline void _simd4x4f_transform_array_avx512(const simd4x4f* m, const simd4f* in, simd4f* out, size_t n, int mode) {
+    const float* fm = (const float*)m;
+    const float* fi = (const float*)in;
+    float* fo = (float*)out;
+
+    const __m512 mx = _SIMD4X4F_AVX512_BROADCAST4(_mm_loadu_ps(fm + 0));
+    const __m512 my = _SIMD4X4F_AVX512_BROADCAST4(_mm_loadu_ps(fm + 4));
+    const __m512 mz = _SIMD4X4F_AVX512_BROADCAST4(_mm_loadu_ps(fm + 8));
+    const __m512 mw = _SIMD4X4F_AVX512_BROADCAST4(_mm_loadu_ps(fm + 12));
+
+    size_t i = 0;
+    for(; i + 4 <= n; i += 4) {
+        const __m512 p = _mm512_loadu_ps(fi + 4*i);
+        __m512 o = _mm512_fmadd_ps(mz, _SIMD4X4F_AVX512_PERMUTE(p, 0xaa), _simd4x4f_array_last_term_avx512(mw, p, mode));
+        o = _mm512_fmadd_ps(my, _SIMD4X4F_AVX512_PERMUTE(p, 0x55), o);
+        o = _mm512_fmadd_ps(mx, _SIMD4X4F_AVX512_PERMUTE(p, 0x00), o);
+        _mm512_storeu_ps(fo + 4*i, _simd4x4f_array_finish_avx512(o, mode));
+    }
+    if( i < n ) {
+        const __mmask16 k = (__mmask16)((1u << (4 * (n - i))) - 1);
+        const __m512 p = _mm512_maskz_loadu_ps(k, fi + 4*i);
+        __m512 o = _mm512_fmadd_ps(mz, _SIMD4X4F_AVX512_PERMUTE(p, 0xaa), _simd4x4f_array_last_term_avx512(mw, p, mode));
+        o = _mm512_fmadd_ps(my, _SIMD4X4F_AVX512_PERMUTE(p, 0x55), o);
+        o = _mm512_fmadd_ps(mx, _SIMD4X4F_AVX512_PERMUTE(p, 0x00), o);
+        _mm512_mask_storeu_ps(fo + 4*i, k, _simd4x4f_array_finish_avx512(o, mode));
+    }
+}
+
+
+
+#endif
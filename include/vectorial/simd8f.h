@@ -0,0 +1,66 @@
+/*
+  Vectorial
+  Copyright (c) 2010 Mikko Lehtonen
+  Licensed under the terms of the two-clause BSD License (see LICENSE)
+*/
+
+#ifndef VECTORIAL_SIMD8F_H
+#define VECTORIAL_SIMD8F_H
+
+#ifndef VECTORIAL_CONFIG_H
+  #include "vectorial/config.h"
+#endif
+
+#ifndef VECTORIAL_SIMD4F_H
+  #include "vectorial/simd4f.h"
+#endif
+
+/*
+  simd8f is two simd4f side by side. Functions that work on vectors
+  (splat_x, dot4, dot3 etc.) treat the low and high four lanes as two
+  independent vectors, so one simd8f can carry two vec4f at a time.
+*/
+
+#ifdef VECTORIAL_SIMD8F_SCALAR
+    #include "simd8f_scalar.h"
+#elif defined(VECTORIAL_SIMD8F_AVX)
+    #include "simd8f_avx.h"
+#elif defined(VECTORIAL_SIMD8F_PAIR)
+    #include "simd8f_pair.h"
+#elif defined(VECTORIAL_SIMD8F_GNU)
+    #include "simd8f_gnu.h"
+#else
+    #error No implementation defined
+#endif
+
+#include "simd8f_common.h"
+
+
+
+#ifdef __cplusplus
+
+    #ifdef VECTORIAL_OSTREAM
+        #include <ostream>
+
+        vectorial_inline std::ostream& operator<<(std::ostream& os, const simd8f& v) {
+            const simd4f lo = simd8f_get_low(v);
+            const simd4f hi = simd8f_get_high(v);
+            os << "simd8f(" << simd4f_get_x(lo) << ", "
+                       << simd4f_get_y(lo) << ", "
+                       << simd4f_get_z(lo) << ", "
+                       << simd4f_get_w(lo) << ", "
+                       << simd4f_get_x(hi) << ", "
+                       << simd4f_get_y(hi) << ", "
+                       << simd4f_get_z(hi) << ", "
+                       << simd4f_get_w(hi) << ")";
+            return os;
+        }
+    #endif
+
+#endif
+
+
+
+
+#endif
+
@@ -0,0 +1,62 @@
+/*
+  Vectorial
+  Copyright (c) 2010 Mikko Lehtonen
+  Licensed under the terms of the two-clause BSD License (see LICENSE)
+*/
+#ifndef VECTORIAL_SIMD8F_AOS_H
+#define VECTORIAL_SIMD8F_AOS_H
+
+#ifndef VECTORIAL_SIMD8F_H
+  #include "vectorial/simd8f.h"
+#endif
+
+#ifndef VECTORIAL_SIMD4F_AOS_H
+  #include "vectorial/simd4f_aos.h"
+#endif
+
+/*
+  simd4f_aos.h for 8 vectors, as two groups of 4 joined per component.
+*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+vectorial_inline void simd8f_aos_load4(const float *ary, size_t stride, simd8f *x, simd8f *y, simd8f *z, simd8f *w) {
+    simd4f xl, yl, zl, wl, xh, yh, zh, wh;
+    simd4f_aos_load4(ary, stride, &xl, &yl, &zl, &wl);
+    simd4f_aos_load4(ary + 4*stride, stride, &xh, &yh, &zh, &wh);
+    *x = simd8f_combine(xl, xh);
+    *y = simd8f_combine(yl, yh);
+    *z = simd8f_combine(zl, zh);
+    *w = simd8f_combine(wl, wh);
+}
+
+vectorial_inline void simd8f_aos_load3(const float *ary, size_t stride, simd8f *x, simd8f *y, simd8f *z) {
+    simd4f xl, yl, zl, xh, yh, zh;
+    simd4f_aos_load3(ary, stride, &xl, &yl, &zl);
+    simd4f_aos_load3(ary + 4*stride, stride, &xh, &yh, &zh);
+    *x = simd8f_combine(xl, xh);
+    *y = simd8f_combine(yl, yh);
+    *z = simd8f_combine(zl, zh);
+}
+
+
+vectorial_inline void simd8f_aos_store4(simd8f x, simd8f y, simd8f z, SIMD_PARAM(simd8f, w), float *ary, size_t stride) {
+    simd4f_aos_store4(simd8f_get_low(x), simd8f_get_low(y), simd8f_get_low(z), simd8f_get_low(w), ary, stride);
+    simd4f_aos_store4(simd8f_get_high(x), simd8f_get_high(y), simd8f_get_high(z), simd8f_get_high(w), ary + 4*stride, stride);
+}
+
+vectorial_inline void simd8f_aos_store3(simd8f x, simd8f y, simd8f z, float *ary, size_t stride) {
+    simd4f_aos_store3(simd8f_get_low(x), simd8f_get_low(y), simd8f_get_low(z), ary, stride);
+    simd4f_aos_store3(simd8f_get_high(x), simd8f_get_high(y), simd8f_get_high(z), ary + 4*stride, stride);
+}
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif
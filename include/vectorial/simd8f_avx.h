@@ -0,0 +1,184 @@
+/*
+  Vectorial
+  Copyright (c) 2010 Mikko Lehtonen
+  Licensed under the terms of the two-clause BSD License (see LICENSE)
+*/
+#ifndef VECTORIAL_SIMD8F_AVX_H
+#define VECTORIAL_SIMD8F_AVX_H
+
+#include <immintrin.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+typedef __m256 simd8f;
+
+typedef union {
+    simd8f s ;
+    float f[8];
+} _simd8f_union;
+
+// creating
+
+vectorial_inline simd8f simd8f_create(float a, float b, float c, float d, float e, float f, float g, float h) {
+    simd8f s = _mm256_setr_ps(a, b, c, d, e, f, g, h);
+    return s;
+}
+
+vectorial_inline simd8f simd8f_zero() { return _mm256_setzero_ps(); }
+
+vectorial_inline simd8f simd8f_uload8(const float *ary) {
+    simd8f s = _mm256_loadu_ps(ary);
+    return s;
+}
+
+vectorial_inline void simd8f_ustore8(const simd8f val, float *ary) {
+    _mm256_storeu_ps(ary, val);
+}
+
+vectorial_inline simd8f simd8f_combine(simd4f lo, simd4f hi) {
+    simd8f s = _mm256_insertf128_ps(_mm256_castps128_ps256(lo), hi, 1);
+    return s;
+}
+
+vectorial_inline simd4f simd8f_get_low(simd8f s) { return _mm256_castps256_ps128(s); }
+vectorial_inline simd4f simd8f_get_high(simd8f s) { return _mm256_extractf128_ps(s, 1); }
+
+
+// utilities
+
+vectorial_inline simd8f simd8f_splat(float v) {
+    simd8f s = _mm256_set1_ps(v);
+    return s;
+}
+
+vectorial_inline simd8f simd8f_splat_x(simd8f v) {
+    simd8f s = _mm256_permute_ps(v, _MM_SHUFFLE(0,0,0,0));
+    return s;
+}
+
+vectorial_inline simd8f simd8f_splat_y(simd8f v) {
+    simd8f s = _mm256_permute_ps(v, _MM_SHUFFLE(1,1,1,1));
+    return s;
+}
+
+vectorial_inline simd8f simd8f_splat_z(simd8f v) {
+    simd8f s = _mm256_permute_ps(v, _MM_SHUFFLE(2,2,2,2));
+    return s;
+}
+
+vectorial_inline simd8f simd8f_splat_w(simd8f v) {
+    simd8f s = _mm256_permute_ps(v, _MM_SHUFFLE(3,3,3,3));
+    return s;
+}
+
+
+// arithmetic
+
+vectorial_inline simd8f simd8f_add(simd8f lhs, simd8f rhs) {
+    simd8f ret = _mm256_add_ps(lhs, rhs);
+    return ret;
+}
+
+vectorial_inline simd8f simd8f_sub(simd8f lhs, simd8f rhs) {
+    simd8f ret = _mm256_sub_ps(lhs, rhs);
+    return ret;
+}
+
+vectorial_inline simd8f simd8f_mul(simd8f lhs, simd8f rhs) {
+    simd8f ret = _mm256_mul_ps(lhs, rhs);
+    return ret;
+}
+
+vectorial_inline simd8f simd8f_div(simd8f lhs, simd8f rhs) {
+    simd8f ret = _mm256_div_ps(lhs, rhs);
+    return ret;
+}
+
+vectorial_inline simd8f simd8f_madd(simd8f m1, simd8f m2, simd8f a) {
+#if defined(VECTORIAL_HAVE_FMA)
+    return _mm256_fmadd_ps(m1, m2, a);
+#else
+    return simd8f_add( simd8f_mul(m1, m2), a );
+#endif
+}
+
+
+
+vectorial_inline simd8f simd8f_reciprocal(simd8f v) {
+    simd8f s = _mm256_rcp_ps(v);
+    const simd8f two = simd8f_splat(2.0f);
+    s = simd8f_mul(s, simd8f_sub(two, simd8f_mul(v, s)));
+    return s;
+}
+
+vectorial_inline simd8f simd8f_sqrt(simd8f v) {
+    simd8f s = _mm256_sqrt_ps(v);
+    return s;
+}
+
+vectorial_inline simd8f simd8f_rsqrt(simd8f v) {
+    simd8f s = _mm256_rsqrt_ps(v);
+    const simd8f half = simd8f_splat(0.5f);
+    const simd8f three = simd8f_splat(3.0f);
+    s = simd8f_mul(simd8f_mul(s, half), simd8f_sub(three, simd8f_mul(s, simd8f_mul(v,s))));
+    return s;
+}
+
+
+// vector math, each 128bit half is its own vector
+
+vectorial_inline simd8f simd8f_dot4(simd8f lhs, simd8f rhs) {
+    return _mm256_dp_ps(lhs, rhs, 0xff);
+}
+
+vectorial_inline simd8f simd8f_dot3(simd8f lhs, simd8f rhs) {
+    return _mm256_dp_ps(lhs, rhs, 0x7f);
+}
+
+
+vectorial_inline simd8f simd8f_min(simd8f a, simd8f b) {
+    return _mm256_min_ps( a, b );
+}
+
+vectorial_inline simd8f simd8f_max(simd8f a, simd8f b) {
+    return _mm256_max_ps( a, b );
+}
+
+
+
+// comparing, masks have all bits set where true and none where false
+
+typedef __m256 simd8f_mask;
+
+vectorial_inline simd8f_mask simd8f_cmpeq(simd8f lhs, simd8f rhs) { return _mm256_cmp_ps( lhs, rhs, _CMP_EQ_OQ ); }
+vectorial_inline simd8f_mask simd8f_cmpne(simd8f lhs, simd8f rhs) { return _mm256_cmp_ps( lhs, rhs, _CMP_NEQ_UQ ); }
+vectorial_inline simd8f_mask simd8f_cmplt(simd8f lhs, simd8f rhs) { return _mm256_cmp_ps( lhs, rhs, _CMP_LT_OS ); }
+vectorial_inline simd8f_mask simd8f_cmple(simd8f lhs, simd8f rhs) { return _mm256_cmp_ps( lhs, rhs, _CMP_LE_OS ); }
+vectorial_inline simd8f_mask simd8f_cmpgt(simd8f lhs, simd8f rhs) { return _mm256_cmp_ps( lhs, rhs, _CMP_GT_OS ); }
+vectorial_inline simd8f_mask simd8f_cmpge(simd8f lhs, simd8f rhs) { return _mm256_cmp_ps( lhs, rhs, _CMP_GE_OS ); }
+
+vectorial_inline simd8f_mask simd8f_mask_and(simd8f_mask lhs, simd8f_mask rhs) { return _mm256_and_ps( lhs, rhs ); }
+vectorial_inline simd8f_mask simd8f_mask_or(simd8f_mask lhs, simd8f_mask rhs) { return _mm256_or_ps( lhs, rhs ); }
+vectorial_inline simd8f_mask simd8f_mask_xor(simd8f_mask lhs, simd8f_mask rhs) { return _mm256_xor_ps( lhs, rhs ); }
+vectorial_inline simd8f_mask simd8f_mask_not(simd8f_mask v) { return _mm256_xor_ps( v, _mm256_castsi256_ps( _mm256_set1_epi32(-1) ) ); }
+
+// a where the mask is set, b elsewhere
+vectorial_inline simd8f simd8f_select(simd8f_mask mask, simd8f a, simd8f b) {
+    return _mm256_blendv_ps( b, a, mask );
+}
+
+// Lane i of the mask in bit i
+vectorial_inline int simd8f_movemask(simd8f_mask mask) {
+    return _mm256_movemask_ps( mask );
+}
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif
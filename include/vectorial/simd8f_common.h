@@ -0,0 +1,51 @@
+/*
+  Vectorial
+  Copyright (c) 2010 Mikko Lehtonen
+  Licensed under the terms of the two-clause BSD License (see LICENSE)
+*/
+#ifndef VECTORIAL_SIMD8F_COMMON_H
+#define VECTORIAL_SIMD8F_COMMON_H
+
+
+vectorial_inline simd8f simd8f_sum(simd8f v) {
+    const simd8f s1 = simd8f_add(simd8f_splat_x(v), simd8f_splat_y(v));
+    const simd8f s2 = simd8f_add(s1, simd8f_splat_z(v));
+    const simd8f s3 = simd8f_add(s2, simd8f_splat_w(v));
+    return s3;
+}
+
+
+vectorial_inline simd8f simd8f_length4(simd8f v) {
+    return simd8f_sqrt( simd8f_dot4(v,v) );
+}
+
+vectorial_inline simd8f simd8f_length3(simd8f v) {
+    return simd8f_sqrt( simd8f_dot3(v,v) );
+}
+
+vectorial_inline simd8f simd8f_length4_squared(simd8f v) {
+    return simd8f_dot4(v,v);
+}
+
+vectorial_inline simd8f simd8f_length3_squared(simd8f v) {
+    return simd8f_dot3(v,v);
+}
+
+
+vectorial_inline simd8f simd8f_normalize4(simd8f a) {
+    simd8f invlen = simd8f_rsqrt( simd8f_dot4(a,a) );
+    return simd8f_mul(a, invlen);
+}
+
+vectorial_inline simd8f simd8f_normalize3(simd8f a) {
+    simd8f invlen = simd8f_rsqrt( simd8f_dot3(a,a) );
+    return simd8f_mul(a, invlen);
+}
+
+
+// Any or all of the eight lanes set
+vectorial_inline int simd8f_any(simd8f_mask mask) { return simd8f_movemask(mask) != 0; }
+vectorial_inline int simd8f_all(simd8f_mask mask) { return simd8f_movemask(mask) == 255; }
+
+
+#endif
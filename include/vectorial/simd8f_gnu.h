@@ -0,0 +1,180 @@
+/*
+  Vectorial
+  Copyright (c) 2010 Mikko Lehtonen
+  Licensed under the terms of the two-clause BSD License (see LICENSE)
+*/
+#ifndef VECTORIAL_SIMD8F_GNU_H
+#define VECTORIAL_SIMD8F_GNU_H
+
+#include <math.h>
+#include <string.h>  // memcpy
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+typedef float simd8f __attribute__ ((vector_size (32)));
+
+typedef union {
+    simd8f s ;
+    float f[8];
+} _simd8f_union;
+
+
+vectorial_inline simd8f simd8f_create(float a, float b, float c, float d, float e, float f, float g, float h) {
+    simd8f s = { a, b, c, d, e, f, g, h };
+    return s;
+}
+
+vectorial_inline simd8f simd8f_zero() { return simd8f_create(0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f); }
+
+vectorial_inline simd8f simd8f_uload8(const float *ary) {
+    simd8f s;
+    memcpy(&s, ary, sizeof(float) * 8);
+    return s;
+}
+
+vectorial_inline void simd8f_ustore8(const simd8f val, float *ary) {
+    memcpy(ary, &val, sizeof(float) * 8);
+}
+
+vectorial_inline simd8f simd8f_combine(simd4f lo, simd4f hi) {
+    _simd8f_union u;
+    simd4f_ustore4(lo, u.f);
+    simd4f_ustore4(hi, u.f + 4);
+    return u.s;
+}
+
+vectorial_inline simd4f simd8f_get_low(simd8f s) { _simd8f_union u={s}; return simd4f_uload4(u.f); }
+vectorial_inline simd4f simd8f_get_high(simd8f s) { _simd8f_union u={s}; return simd4f_uload4(u.f + 4); }
+
+
+vectorial_inline simd8f simd8f_splat(float v) {
+    simd8f s = { v, v, v, v, v, v, v, v };
+    return s;
+}
+
+vectorial_inline simd8f simd8f_splat_x(simd8f v) {
+    _simd8f_union u = {v};
+    return simd8f_create(u.f[0], u.f[0], u.f[0], u.f[0], u.f[4], u.f[4], u.f[4], u.f[4]);
+}
+
+vectorial_inline simd8f simd8f_splat_y(simd8f v) {
+    _simd8f_union u = {v};
+    return simd8f_create(u.f[1], u.f[1], u.f[1], u.f[1], u.f[5], u.f[5], u.f[5], u.f[5]);
+}
+
+vectorial_inline simd8f simd8f_splat_z(simd8f v) {
+    _simd8f_union u = {v};
+    return simd8f_create(u.f[2], u.f[2], u.f[2], u.f[2], u.f[6], u.f[6], u.f[6], u.f[6]);
+}
+
+vectorial_inline simd8f simd8f_splat_w(simd8f v) {
+    _simd8f_union u = {v};
+    return simd8f_create(u.f[3], u.f[3], u.f[3], u.f[3], u.f[7], u.f[7], u.f[7], u.f[7]);
+}
+
+vectorial_inline simd8f simd8f_reciprocal(simd8f v) {
+    return simd8f_splat(1.0f) / v;
+}
+
+vectorial_inline simd8f simd8f_sqrt(simd8f v) {
+    _simd8f_union u = {v};
+    return simd8f_create(sqrtf(u.f[0]), sqrtf(u.f[1]), sqrtf(u.f[2]), sqrtf(u.f[3]),
+                         sqrtf(u.f[4]), sqrtf(u.f[5]), sqrtf(u.f[6]), sqrtf(u.f[7]));
+}
+
+vectorial_inline simd8f simd8f_rsqrt(simd8f v) {
+    return simd8f_splat(1.0f) / simd8f_sqrt(v);
+}
+
+
+
+vectorial_inline simd8f simd8f_add(simd8f lhs, simd8f rhs) {
+    simd8f ret = lhs + rhs;
+    return ret;
+}
+
+vectorial_inline simd8f simd8f_sub(simd8f lhs, simd8f rhs) {
+    simd8f ret = lhs - rhs;
+    return ret;
+}
+
+vectorial_inline simd8f simd8f_mul(simd8f lhs, simd8f rhs) {
+    simd8f ret = lhs * rhs;
+    return ret;
+}
+
+vectorial_inline simd8f simd8f_div(simd8f lhs, simd8f rhs) {
+    simd8f ret = lhs / rhs;
+    return ret;
+}
+
+vectorial_inline simd8f simd8f_madd(simd8f m1, simd8f m2, simd8f a) {
+    return simd8f_add( simd8f_mul(m1, m2), a );
+}
+
+
+vectorial_inline simd8f simd8f_dot4(simd8f lhs, simd8f rhs) {
+    _simd8f_union m = { lhs * rhs };
+    const float lo = m.f[0] + m.f[1] + m.f[2] + m.f[3];
+    const float hi = m.f[4] + m.f[5] + m.f[6] + m.f[7];
+    return simd8f_create(lo, lo, lo, lo, hi, hi, hi, hi);
+}
+
+vectorial_inline simd8f simd8f_dot3(simd8f lhs, simd8f rhs) {
+    _simd8f_union m = { lhs * rhs };
+    const float lo = m.f[0] + m.f[1] + m.f[2];
+    const float hi = m.f[4] + m.f[5] + m.f[6];
+    return simd8f_create(lo, lo, lo, lo, hi, hi, hi, hi);
+}
+
+
+// comparing, masks have all bits set where true and none where false
+
+typedef int simd8f_mask __attribute__ ((vector_size (32)));
+
+vectorial_inline simd8f_mask simd8f_cmpeq(simd8f lhs, simd8f rhs) { return (simd8f_mask)( lhs == rhs ); }
+vectorial_inline simd8f_mask simd8f_cmpne(simd8f lhs, simd8f rhs) { return (simd8f_mask)( lhs != rhs ); }
+vectorial_inline simd8f_mask simd8f_cmplt(simd8f lhs, simd8f rhs) { return (simd8f_mask)( lhs < rhs ); }
+vectorial_inline simd8f_mask simd8f_cmple(simd8f lhs, simd8f rhs) { return (simd8f_mask)( lhs <= rhs ); }
+vectorial_inline simd8f_mask simd8f_cmpgt(simd8f lhs, simd8f rhs) { return (simd8f_mask)( lhs > rhs ); }
+vectorial_inline simd8f_mask simd8f_cmpge(simd8f lhs, simd8f rhs) { return (simd8f_mask)( lhs >= rhs ); }
+
+vectorial_inline simd8f_mask simd8f_mask_and(simd8f_mask lhs, simd8f_mask rhs) { return lhs & rhs; }
+vectorial_inline simd8f_mask simd8f_mask_or(simd8f_mask lhs, simd8f_mask rhs) { return lhs | rhs; }
+vectorial_inline simd8f_mask simd8f_mask_xor(simd8f_mask lhs, simd8f_mask rhs) { return lhs ^ rhs; }
+vectorial_inline simd8f_mask simd8f_mask_not(simd8f_mask v) { return ~v; }
+
+// a where the mask is set, b elsewhere
+vectorial_inline simd8f simd8f_select(simd8f_mask mask, simd8f a, simd8f b) {
+    return (simd8f)( (mask & (simd8f_mask)a) | (~mask & (simd8f_mask)b) );
+}
+
+// Lane i of the mask in bit i
+vectorial_inline int simd8f_movemask(simd8f_mask mask) {
+    const simd8f_mask bits = { 1, 2, 4, 8, 16, 32, 64, 128 };
+    const simd8f_mask m = mask & bits;
+    return m[0] | m[1] | m[2] | m[3] | m[4] | m[5] | m[6] | m[7];
+}
+
+// min and max after the masks, as a compare and a select
+
+vectorial_inline simd8f simd8f_min(simd8f a, simd8f b) {
+    return simd8f_select( simd8f_cmplt(a, b), a, b );
+}
+
+vectorial_inline simd8f simd8f_max(simd8f a, simd8f b) {
+    return simd8f_select( simd8f_cmpgt(a, b), a, b );
+}
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif
+
@@ -0,0 +1,166 @@
+/*
+  Vectorial
+  Copyright (c) 2010 Mikko Lehtonen
+  Licensed under the terms of the two-clause BSD License (see LICENSE)
+*/
+#ifndef VECTORIAL_SIMD8F_PAIR_H
+#define VECTORIAL_SIMD8F_PAIR_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+// Two simd4f, lanes 0-3 in lo and 4-7 in hi, every operation going
+// through the simd4f one on each half
+typedef struct {
+    simd4f lo;
+    simd4f hi;
+} simd8f;
+
+typedef union {
+    simd8f s ;
+    float f[8];
+} _simd8f_union;
+
+
+vectorial_inline simd8f _simd8f_pair(simd4f lo, simd4f hi) {
+    simd8f s = { lo, hi };
+    return s;
+}
+
+// creating
+
+vectorial_inline simd8f simd8f_create(float a, float b, float c, float d, float e, float f, float g, float h) {
+    return _simd8f_pair( simd4f_create(a, b, c, d), simd4f_create(e, f, g, h) );
+}
+
+vectorial_inline simd8f simd8f_zero() { return _simd8f_pair( simd4f_zero(), simd4f_zero() ); }
+
+vectorial_inline simd8f simd8f_uload8(const float *ary) {
+    return _simd8f_pair( simd4f_uload4(ary), simd4f_uload4(ary + 4) );
+}
+
+vectorial_inline void simd8f_ustore8(const simd8f val, float *ary) {
+    simd4f_ustore4(val.lo, ary);
+    simd4f_ustore4(val.hi, ary + 4);
+}
+
+vectorial_inline simd8f simd8f_combine(simd4f lo, simd4f hi) { return _simd8f_pair( lo, hi ); }
+
+vectorial_inline simd4f simd8f_get_low(simd8f s) { return s.lo; }
+vectorial_inline simd4f simd8f_get_high(simd8f s) { return s.hi; }
+
+
+// utilities
+
+vectorial_inline simd8f simd8f_splat(float v) {
+    const simd4f s = simd4f_splat(v);
+    return _simd8f_pair( s, s );
+}
+
+vectorial_inline simd8f simd8f_splat_x(simd8f v) { return _simd8f_pair( simd4f_splat_x(v.lo), simd4f_splat_x(v.hi) ); }
+vectorial_inline simd8f simd8f_splat_y(simd8f v) { return _simd8f_pair( simd4f_splat_y(v.lo), simd4f_splat_y(v.hi) ); }
+vectorial_inline simd8f simd8f_splat_z(simd8f v) { return _simd8f_pair( simd4f_splat_z(v.lo), simd4f_splat_z(v.hi) ); }
+vectorial_inline simd8f simd8f_splat_w(simd8f v) { return _simd8f_pair( simd4f_splat_w(v.lo), simd4f_splat_w(v.hi) ); }
+
+
+// arithmetic
+
+vectorial_inline simd8f simd8f_add(simd8f lhs, simd8f rhs) {
+    return _simd8f_pair( simd4f_add(lhs.lo, rhs.lo), simd4f_add(lhs.hi, rhs.hi) );
+}
+
+vectorial_inline simd8f simd8f_sub(simd8f lhs, simd8f rhs) {
+    return _simd8f_pair( simd4f_sub(lhs.lo, rhs.lo), simd4f_sub(lhs.hi, rhs.hi) );
+}
+
+vectorial_inline simd8f simd8f_mul(simd8f lhs, simd8f rhs) {
+    return _simd8f_pair( simd4f_mul(lhs.lo, rhs.lo), simd4f_mul(lhs.hi, rhs.hi) );
+}
+
+vectorial_inline simd8f simd8f_div(simd8f lhs, simd8f rhs) {
+    return _simd8f_pair( simd4f_div(lhs.lo, rhs.lo), simd4f_div(lhs.hi, rhs.hi) );
+}
+
+vectorial_inline simd8f simd8f_madd(simd8f m1, simd8f m2, simd8f a) {
+    return _simd8f_pair( simd4f_madd(m1.lo, m2.lo, a.lo), simd4f_madd(m1.hi, m2.hi, a.hi) );
+}
+
+
+
+vectorial_inline simd8f simd8f_reciprocal(simd8f v) {
+    return _simd8f_pair( simd4f_reciprocal(v.lo), simd4f_reciprocal(v.hi) );
+}
+
+vectorial_inline simd8f simd8f_sqrt(simd8f v) {
+    return _simd8f_pair( simd4f_sqrt(v.lo), simd4f_sqrt(v.hi) );
+}
+
+vectorial_inline simd8f simd8f_rsqrt(simd8f v) {
+    return _simd8f_pair( simd4f_rsqrt(v.lo), simd4f_rsqrt(v.hi) );
+}
+
+
+// vector math, each 128bit half is its own vector
+
+vectorial_inline simd8f simd8f_dot4(simd8f lhs, simd8f rhs) {
+    return _simd8f_pair( simd4f_dot4(lhs.lo, rhs.lo), simd4f_dot4(lhs.hi, rhs.hi) );
+}
+
+vectorial_inline simd8f simd8f_dot3(simd8f lhs, simd8f rhs) {
+    return _simd8f_pair( simd4f_dot3(lhs.lo, rhs.lo), simd4f_dot3(lhs.hi, rhs.hi) );
+}
+
+
+vectorial_inline simd8f simd8f_min(simd8f a, simd8f b) {
+    return _simd8f_pair( simd4f_min(a.lo, b.lo), simd4f_min(a.hi, b.hi) );
+}
+
+vectorial_inline simd8f simd8f_max(simd8f a, simd8f b) {
+    return _simd8f_pair( simd4f_max(a.lo, b.lo), simd4f_max(a.hi, b.hi) );
+}
+
+
+
+// comparing, masks have all bits set where true and none where false
+
+typedef struct {
+    simd4f_mask lo;
+    simd4f_mask hi;
+} simd8f_mask;
+
+vectorial_inline simd8f_mask _simd8f_mask_pair(simd4f_mask lo, simd4f_mask hi) {
+    simd8f_mask m = { lo, hi };
+    return m;
+}
+
+vectorial_inline simd8f_mask simd8f_cmpeq(simd8f lhs, simd8f rhs) { return _simd8f_mask_pair( simd4f_cmpeq(lhs.lo, rhs.lo), simd4f_cmpeq(lhs.hi, rhs.hi) ); }
+vectorial_inline simd8f_mask simd8f_cmpne(simd8f lhs, simd8f rhs) { return _simd8f_mask_pair( simd4f_cmpne(lhs.lo, rhs.lo), simd4f_cmpne(lhs.hi, rhs.hi) ); }
+vectorial_inline simd8f_mask simd8f_cmplt(simd8f lhs, simd8f rhs) { return _simd8f_mask_pair( simd4f_cmplt(lhs.lo, rhs.lo), simd4f_cmplt(lhs.hi, rhs.hi) ); }
+vectorial_inline simd8f_mask simd8f_cmple(simd8f lhs, simd8f rhs) { return _simd8f_mask_pair( simd4f_cmple(lhs.lo, rhs.lo), simd4f_cmple(lhs.hi, rhs.hi) ); }
+vectorial_inline simd8f_mask simd8f_cmpgt(simd8f lhs, simd8f rhs) { return _simd8f_mask_pair( simd4f_cmpgt(lhs.lo, rhs.lo), simd4f_cmpgt(lhs.hi, rhs.hi) ); }
+vectorial_inline simd8f_mask simd8f_cmpge(simd8f lhs, simd8f rhs) { return _simd8f_mask_pair( simd4f_cmpge(lhs.lo, rhs.lo), simd4f_cmpge(lhs.hi, rhs.hi) ); }
+
+vectorial_inline simd8f_mask simd8f_mask_and(simd8f_mask lhs, simd8f_mask rhs) { return _simd8f_mask_pair( simd4f_mask_and(lhs.lo, rhs.lo), simd4f_mask_and(lhs.hi, rhs.hi) ); }
+vectorial_inline simd8f_mask simd8f_mask_or(simd8f_mask lhs, simd8f_mask rhs) { return _simd8f_mask_pair( simd4f_mask_or(lhs.lo, rhs.lo), simd4f_mask_or(lhs.hi, rhs.hi) ); }
+vectorial_inline simd8f_mask simd8f_mask_xor(simd8f_mask lhs, simd8f_mask rhs) { return _simd8f_mask_pair( simd4f_mask_xor(lhs.lo, rhs.lo), simd4f_mask_xor(lhs.hi, rhs.hi) ); }
+vectorial_inline simd8f_mask simd8f_mask_not(simd8f_mask v) { return _simd8f_mask_pair( simd4f_mask_not(v.lo), simd4f_mask_not(v.hi) ); }
+
+// a where the mask is set, b elsewhere
+vectorial_inline simd8f simd8f_select(simd8f_mask mask, simd8f a, simd8f b) {
+    return _simd8f_pair( simd4f_select(mask.lo, a.lo, b.lo), simd4f_select(mask.hi, a.hi, b.hi) );
+}
+
+// Lane i of the mask in bit i
+vectorial_inline int simd8f_movemask(simd8f_mask mask) {
+    return simd4f_movemask(mask.lo) | (simd4f_movemask(mask.hi) << 4);
+}
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif
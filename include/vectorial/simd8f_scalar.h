@@ -0,0 +1,234 @@
+/*
+  Vectorial
+  Copyright (c) 2010 Mikko Lehtonen
+  Licensed under the terms of the two-clause BSD License (see LICENSE)
+*/
+#ifndef VECTORIAL_SIMD8F_SCALAR_H
+#define VECTORIAL_SIMD8F_SCALAR_H
+
+#include <math.h>
+#include <string.h>  // memcpy
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+typedef struct {
+    float f[8];
+} simd8f;
+
+
+
+vectorial_inline simd8f simd8f_create(float a, float b, float c, float d, float e, float f, float g, float h) {
+    simd8f s = { { a, b, c, d, e, f, g, h } };
+    return s;
+}
+
+vectorial_inline simd8f simd8f_zero() { return simd8f_create(0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f); }
+
+vectorial_inline simd8f simd8f_uload8(const float *ary) {
+    simd8f s;
+    memcpy(s.f, ary, sizeof(float) * 8);
+    return s;
+}
+
+vectorial_inline void simd8f_ustore8(const simd8f val, float *ary) {
+    memcpy(ary, val.f, sizeof(float) * 8);
+}
+
+vectorial_inline simd8f simd8f_combine(simd4f lo, simd4f hi) {
+    simd8f s;
+    simd4f_ustore4(lo, s.f);
+    simd4f_ustore4(hi, s.f + 4);
+    return s;
+}
+
+vectorial_inline simd4f simd8f_get_low(simd8f s) { return simd4f_uload4(s.f); }
+vectorial_inline simd4f simd8f_get_high(simd8f s) { return simd4f_uload4(s.f + 4); }
+
+
+
+// utilities
+vectorial_inline simd8f simd8f_splat(float v) {
+    return simd8f_create(v, v, v, v, v, v, v, v);
+}
+
+vectorial_inline simd8f simd8f_splat_x(simd8f v) {
+    return simd8f_create(v.f[0], v.f[0], v.f[0], v.f[0], v.f[4], v.f[4], v.f[4], v.f[4]);
+}
+
+vectorial_inline simd8f simd8f_splat_y(simd8f v) {
+    return simd8f_create(v.f[1], v.f[1], v.f[1], v.f[1], v.f[5], v.f[5], v.f[5], v.f[5]);
+}
+
+vectorial_inline simd8f simd8f_splat_z(simd8f v) {
+    return simd8f_create(v.f[2], v.f[2], v.f[2], v.f[2], v.f[6], v.f[6], v.f[6], v.f[6]);
+}
+
+vectorial_inline simd8f simd8f_splat_w(simd8f v) {
+    return simd8f_create(v.f[3], v.f[3], v.f[3], v.f[3], v.f[7], v.f[7], v.f[7], v.f[7]);
+}
+
+vectorial_inline simd8f simd8f_reciprocal(simd8f v) {
+    simd8f s;
+    for(int i = 0; i < 8; ++i) s.f[i] = 1.0f / v.f[i];
+    return s;
+}
+
+vectorial_inline simd8f simd8f_sqrt(simd8f v) {
+    return simd8f_create(sqrtf(v.f[0]), sqrtf(v.f[1]), sqrtf(v.f[2]), sqrtf(v.f[3]),
+                         sqrtf(v.f[4]), sqrtf(v.f[5]), sqrtf(v.f[6]), sqrtf(v.f[7]));
+}
+
+vectorial_inline simd8f simd8f_rsqrt(simd8f v) {
+    return simd8f_create(1.0f/sqrtf(v.f[0]), 1.0f/sqrtf(v.f[1]), 1.0f/sqrtf(v.f[2]), 1.0f/sqrtf(v.f[3]),
+                         1.0f/sqrtf(v.f[4]), 1.0f/sqrtf(v.f[5]), 1.0f/sqrtf(v.f[6]), 1.0f/sqrtf(v.f[7]));
+}
+
+
+// arithmetic
+
+vectorial_inline simd8f simd8f_add(simd8f lhs, simd8f rhs) {
+    simd8f ret;
+    for(int i = 0; i < 8; ++i) ret.f[i] = lhs.f[i] + rhs.f[i];
+    return ret;
+}
+
+vectorial_inline simd8f simd8f_sub(simd8f lhs, simd8f rhs) {
+    simd8f ret;
+    for(int i = 0; i < 8; ++i) ret.f[i] = lhs.f[i] - rhs.f[i];
+    return ret;
+}
+
+vectorial_inline simd8f simd8f_mul(simd8f lhs, simd8f rhs) {
+    simd8f ret;
+    for(int i = 0; i < 8; ++i) ret.f[i] = lhs.f[i] * rhs.f[i];
+    return ret;
+}
+
+vectorial_inline simd8f simd8f_div(simd8f lhs, simd8f rhs) {
+    simd8f ret;
+    for(int i = 0; i < 8; ++i) ret.f[i] = lhs.f[i] / rhs.f[i];
+    return ret;
+}
+
+vectorial_inline simd8f simd8f_madd(simd8f m1, simd8f m2, simd8f a) {
+    return simd8f_add( simd8f_mul(m1, m2), a );
+}
+
+
+vectorial_inline simd8f simd8f_dot4(simd8f lhs, simd8f rhs) {
+    const float lo = lhs.f[0] * rhs.f[0] + lhs.f[1] * rhs.f[1] + lhs.f[2] * rhs.f[2] + lhs.f[3] * rhs.f[3];
+    const float hi = lhs.f[4] * rhs.f[4] + lhs.f[5] * rhs.f[5] + lhs.f[6] * rhs.f[6] + lhs.f[7] * rhs.f[7];
+    return simd8f_create(lo, lo, lo, lo, hi, hi, hi, hi);
+}
+
+vectorial_inline simd8f simd8f_dot3(simd8f lhs, simd8f rhs) {
+    const float lo = lhs.f[0] * rhs.f[0] + lhs.f[1] * rhs.f[1] + lhs.f[2] * rhs.f[2];
+    const float hi = lhs.f[4] * rhs.f[4] + lhs.f[5] * rhs.f[5] + lhs.f[6] * rhs.f[6];
+    return simd8f_create(lo, lo, lo, lo, hi, hi, hi, hi);
+}
+
+
+vectorial_inline simd8f simd8f_min(simd8f a, simd8f b) {
+    simd8f ret;
+    for(int i = 0; i < 8; ++i) ret.f[i] = a.f[i] < b.f[i] ? a.f[i] : b.f[i];
+    return ret;
+}
+
+vectorial_inline simd8f simd8f_max(simd8f a, simd8f b) {
+    simd8f ret;
+    for(int i = 0; i < 8; ++i) ret.f[i] = a.f[i] > b.f[i] ? a.f[i] : b.f[i];
+    return ret;
+}
+
+
+// comparing, masks have all bits set where true and none where false
+
+typedef struct {
+    int m[8];
+} simd8f_mask;
+
+vectorial_inline simd8f_mask simd8f_cmpeq(simd8f lhs, simd8f rhs) {
+    simd8f_mask r;
+    for(int i = 0; i < 8; ++i) r.m[i] = -(lhs.f[i] == rhs.f[i]);
+    return r;
+}
+
+vectorial_inline simd8f_mask simd8f_cmpne(simd8f lhs, simd8f rhs) {
+    simd8f_mask r;
+    for(int i = 0; i < 8; ++i) r.m[i] = -(lhs.f[i] != rhs.f[i]);
+    return r;
+}
+
+vectorial_inline simd8f_mask simd8f_cmplt(simd8f lhs, simd8f rhs) {
+    simd8f_mask r;
+    for(int i = 0; i < 8; ++i) r.m[i] = -(lhs.f[i] < rhs.f[i]);
+    return r;
+}
+
+vectorial_inline simd8f_mask simd8f_cmple(simd8f lhs, simd8f rhs) {
+    simd8f_mask r;
+    for(int i = 0; i < 8; ++i) r.m[i] = -(lhs.f[i] <= rhs.f[i]);
+    return r;
+}
+
+vectorial_inline simd8f_mask simd8f_cmpgt(simd8f lhs, simd8f rhs) {
+    simd8f_mask r;
+    for(int i = 0; i < 8; ++i) r.m[i] = -(lhs.f[i] > rhs.f[i]);
+    return r;
+}
+
+vectorial_inline simd8f_mask simd8f_cmpge(simd8f lhs, simd8f rhs) {
+    simd8f_mask r;
+    for(int i = 0; i < 8; ++i) r.m[i] = -(lhs.f[i] >= rhs.f[i]);
+    return r;
+}
+
+vectorial_inline simd8f_mask simd8f_mask_and(simd8f_mask lhs, simd8f_mask rhs) {
+    simd8f_mask r;
+    for(int i = 0; i < 8; ++i) r.m[i] = lhs.m[i] & rhs.m[i];
+    return r;
+}
+
+vectorial_inline simd8f_mask simd8f_mask_or(simd8f_mask lhs, simd8f_mask rhs) {
+    simd8f_mask r;
+    for(int i = 0; i < 8; ++i) r.m[i] = lhs.m[i] | rhs.m[i];
+    return r;
+}
+
+vectorial_inline simd8f_mask simd8f_mask_xor(simd8f_mask lhs, simd8f_mask rhs) {
+    simd8f_mask r;
+    for(int i = 0; i < 8; ++i) r.m[i] = lhs.m[i] ^ rhs.m[i];
+    return r;
+}
+
+vectorial_inline simd8f_mask simd8f_mask_not(simd8f_mask v) {
+    simd8f_mask r;
+    for(int i = 0; i < 8; ++i) r.m[i] = ~v.m[i];
+    return r;
+}
+
+// a where the mask is set, b elsewhere
+vectorial_inline simd8f simd8f_select(simd8f_mask mask, simd8f a, simd8f b) {
+    simd8f s;
+    for(int i = 0; i < 8; ++i) s.f[i] = mask.m[i] ? a.f[i] : b.f[i];
+    return s;
+}
+
+// Lane i of the mask in bit i
+vectorial_inline int simd8f_movemask(simd8f_mask mask) {
+    int bits = 0;
+    for(int i = 0; i < 8; ++i) bits |= mask.m[i] & (1 << i);
+    return bits;
+}
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif
+
@@ -4,6 +4,7 @@
   Licensed under the terms of the two-clause BSD License (see LICENSE)
 */
 #ifndef VECTORIAL_VEC2F_H
+#define VECTORIAL_VEC2F_H
 
 #ifndef VECTORIAL_SIMD4F_H
   #include "vectorial/simd4f.h"
@@ -16,6 +17,36 @@ namespace vectorial {
     class vec4f;
     class vec3f;
 
+    // Lane masks from comparing vec2f, for select and the any/all tests
+    class vec2b {
+    public:
+
+        simd4f_mask value;
+
+        inline vec2b() {}
+        explicit inline vec2b(const simd4f_mask& v) : value(v) {}
+
+        enum { elements = 2 };
+
+    };
+
+    vectorial_inline vec2b operator&(const vec2b& lhs, const vec2b& rhs) {
+        return vec2b( simd4f_mask_and(lhs.value, rhs.value) );
+    }
+
+    vectorial_inline vec2b operator|(const vec2b& lhs, const vec2b& rhs) {
+        return vec2b( simd4f_mask_or(lhs.value, rhs.value) );
+    }
+
+    vectorial_inline vec2b operator^(const vec2b& lhs, const vec2b& rhs) {
+        return vec2b( simd4f_mask_xor(lhs.value, rhs.value) );
+    }
+
+    vectorial_inline vec2b operator~(const vec2b& v) {
+        return vec2b( simd4f_mask_not(v.value) );
+    }
+
+
     class vec2f {
     public:
 
@@ -166,6 +197,44 @@ namespace vectorial {
     }
 
 
+    vectorial_inline vec2b operator==(const vec2f& lhs, const vec2f& rhs) {
+        return vec2b( simd4f_cmpeq(lhs.value, rhs.value) );
+    }
+
+    vectorial_inline vec2b operator!=(const vec2f& lhs, const vec2f& rhs) {
+        return vec2b( simd4f_cmpne(lhs.value, rhs.value) );
+    }
+
+    vectorial_inline vec2b operator<(const vec2f& lhs, const vec2f& rhs) {
+        return vec2b( simd4f_cmplt(lhs.value, rhs.value) );
+    }
+
+    vectorial_inline vec2b operator<=(const vec2f& lhs, const vec2f& rhs) {
+        return vec2b( simd4f_cmple(lhs.value, rhs.value) );
+    }
+
+    vectorial_inline vec2b operator>(const vec2f& lhs, const vec2f& rhs) {
+        return vec2b( simd4f_cmpgt(lhs.value, rhs.value) );
+    }
+
+    vectorial_inline vec2b operator>=(const vec2f& lhs, const vec2f& rhs) {
+        return vec2b( simd4f_cmpge(lhs.value, rhs.value) );
+    }
+
+    // a where the mask is set, b elsewhere
+    vectorial_inline vec2f select(const vec2b& mask, const vec2f& a, const vec2f& b) {
+        return vec2f( simd4f_select(mask.value, a.value, b.value) );
+    }
+
+    vectorial_inline bool any(const vec2b& mask) {
+        return (simd4f_movemask(mask.value) & 3) != 0;
+    }
+
+    vectorial_inline bool all(const vec2b& mask) {
+        return (simd4f_movemask(mask.value) & 3) == 3;
+    }
+
+
 }
 
 
@@ -0,0 +1,210 @@
+/*
+  Vectorial
+  Copyright (c) 2010 Mikko Lehtonen
+  Licensed under the terms of the two-clause BSD License (see LICENSE)
+*/
+#ifndef VECTORIAL_VEC3D_H
+#define VECTORIAL_VEC3D_H
+
+#ifndef VECTORIAL_SIMD4D_H
+  #include "vectorial/simd4d.h"
+#endif
+
+#ifndef VECTORIAL_VEC3F_H
+  #include "vectorial/vec3f.h"
+#endif
+
+#include <stddef.h>
+
+
+namespace vectorial {
+
+    // vec3f in double precision, for world positions that outgrow floats
+    class vec3d {
+    public:
+
+        simd4d value;
+
+        inline vec3d() {}
+        inline vec3d(const simd4d& v) : value(v) {}
+        explicit inline vec3d(double xyz) : value( simd4d_splat(xyz) ) {}
+        inline vec3d(double x, double y, double z) : value( simd4d_create(x,y,z,0) ) {}
+        explicit inline vec3d(const double *ary) : value( simd4d_uload3(ary) ) { }
+        explicit inline vec3d(const vec3f& v) : value( simd4d_zero_w( simd4f_to_simd4d(v.value) ) ) {}
+
+        inline double x() const { return simd4d_get_x(value); }
+        inline double y() const { return simd4d_get_y(value); }
+        inline double z() const { return simd4d_get_z(value); }
+
+        inline void load(const double *ary) { value = simd4d_uload3(ary); }
+        inline void store(double *ary) const { simd4d_ustore3(value, ary); }
+
+        enum { elements = 3 };
+
+        static vec3d zero() { return vec3d(simd4d_zero()); }
+        static vec3d one() { return vec3d(1.0); }
+        static vec3d xAxis() { return vec3d(1.0, 0.0, 0.0); }
+        static vec3d yAxis() { return vec3d(0.0, 1.0, 0.0); }
+        static vec3d zAxis() { return vec3d(0.0, 0.0, 1.0); }
+
+    };
+
+    vectorial_inline vec3d operator-(const vec3d& lhs) {
+        return vec3d( simd4d_sub(simd4d_zero(), lhs.value) );
+    }
+
+
+    vectorial_inline vec3d operator+(const vec3d& lhs, const vec3d& rhs) {
+        return vec3d( simd4d_add(lhs.value, rhs.value) );
+    }
+
+    vectorial_inline vec3d operator-(const vec3d& lhs, const vec3d& rhs) {
+        return vec3d( simd4d_sub(lhs.value, rhs.value) );
+    }
+
+    vectorial_inline vec3d operator*(const vec3d& lhs, const vec3d& rhs) {
+        return vec3d( simd4d_mul(lhs.value, rhs.value) );
+    }
+
+    vectorial_inline vec3d operator/(const vec3d& lhs, const vec3d& rhs) {
+        return vec3d( simd4d_div(lhs.value, rhs.value) );
+    }
+
+
+    vectorial_inline vec3d operator+=(vec3d& lhs, const vec3d& rhs) {
+        return lhs = vec3d( simd4d_add(lhs.value, rhs.value) );
+    }
+
+    vectorial_inline vec3d operator-=(vec3d& lhs, const vec3d& rhs) {
+        return lhs = vec3d( simd4d_sub(lhs.value, rhs.value) );
+    }
+
+    vectorial_inline vec3d operator*=(vec3d& lhs, const vec3d& rhs) {
+        return lhs = vec3d( simd4d_mul(lhs.value, rhs.value) );
+    }
+
+    vectorial_inline vec3d operator/=(vec3d& lhs, const vec3d& rhs) {
+        return lhs = vec3d( simd4d_div(lhs.value, rhs.value) );
+    }
+
+
+
+    vectorial_inline vec3d operator+(const vec3d& lhs, double rhs) {
+        return vec3d( simd4d_add(lhs.value, simd4d_splat(rhs)) );
+    }
+
+    vectorial_inline vec3d operator-(const vec3d& lhs, double rhs) {
+        return vec3d( simd4d_sub(lhs.value, simd4d_splat(rhs)) );
+    }
+
+    vectorial_inline vec3d operator*(const vec3d& lhs, double rhs) {
+        return vec3d( simd4d_mul(lhs.value, simd4d_splat(rhs)) );
+    }
+
+    vectorial_inline vec3d operator/(const vec3d& lhs, double rhs) {
+        return vec3d( simd4d_div(lhs.value, simd4d_splat(rhs)) );
+    }
+
+    vectorial_inline vec3d operator+(double lhs, const vec3d& rhs) {
+        return vec3d( simd4d_add(simd4d_splat(lhs), rhs.value) );
+    }
+
+    vectorial_inline vec3d operator-(double lhs, const vec3d& rhs) {
+        return vec3d( simd4d_sub(simd4d_splat(lhs), rhs.value) );
+    }
+
+    vectorial_inline vec3d operator*(double lhs, const vec3d& rhs) {
+        return vec3d( simd4d_mul(simd4d_splat(lhs), rhs.value) );
+    }
+
+    vectorial_inline vec3d operator/(double lhs, const vec3d& rhs) {
+        return vec3d( simd4d_div(simd4d_splat(lhs), rhs.value) );
+    }
+
+
+    vectorial_inline vec3d operator+=(vec3d& lhs, double rhs) {
+        return lhs = vec3d( simd4d_add(lhs.value, simd4d_splat(rhs)) );
+    }
+
+    vectorial_inline vec3d operator-=(vec3d& lhs, double rhs) {
+        return lhs = vec3d( simd4d_sub(lhs.value, simd4d_splat(rhs)) );
+    }
+
+    vectorial_inline vec3d operator*=(vec3d& lhs, double rhs) {
+        return lhs = vec3d( simd4d_mul(lhs.value, simd4d_splat(rhs)) );
+    }
+
+    vectorial_inline vec3d operator/=(vec3d& lhs, double rhs) {
+        return lhs = vec3d( simd4d_div(lhs.value, simd4d_splat(rhs)) );
+    }
+
+
+    vectorial_inline double dot(const vec3d& lhs, const vec3d& rhs) {
+        return simd4d_dot3_scalar(lhs.value, rhs.value);
+    }
+
+    vectorial_inline vec3d cross(const vec3d& lhs, const vec3d& rhs) {
+        return simd4d_cross3(lhs.value, rhs.value);
+    }
+
+
+    vectorial_inline double length(const vec3d& v) {
+        return simd4d_get_x( simd4d_length3(v.value) );
+    }
+
+    vectorial_inline double length_squared(const vec3d& v) {
+        return simd4d_get_x( simd4d_length3_squared(v.value) );
+    }
+
+    vectorial_inline vec3d normalize(const vec3d& v) {
+        return vec3d( simd4d_normalize3(v.value) );
+    }
+
+    vectorial_inline vec3d min(const vec3d& a, const vec3d& b) {
+        return vec3d( simd4d_min(a.value, b.value) );
+    }
+
+    vectorial_inline vec3d max(const vec3d& a, const vec3d& b) {
+        return vec3d( simd4d_max(a.value, b.value) );
+    }
+
+
+    // Rounded to float as is, fine for directions and small offsets
+    vectorial_inline vec3f toFloat(const vec3d& v) {
+        return vec3f( simd4d_to_simd4f(v.value) );
+    }
+
+    // v - origin in float, what the renderer wants for a camera at origin
+    vectorial_inline vec3f relativeToFloat(const vec3d& v, const vec3d& origin) {
+        return vec3f( simd4d_to_simd4f( simd4d_sub(v.value, origin.value) ) );
+    }
+
+    // The same for n points at once. in and out may not overlap.
+    vectorial_inline void relativeToFloat(const vec3d* in, const vec3d& origin, vec3f* out, size_t n) {
+        simd4d_relative_to_simd4f_array((const simd4d*)in, origin.value, (simd4f*)out, n);
+    }
+
+}
+
+
+namespace std {
+    inline ::vectorial::vec3d min(const ::vectorial::vec3d& a, const ::vectorial::vec3d& b) { return ::vectorial::min(a,b); }
+    inline ::vectorial::vec3d max(const ::vectorial::vec3d& a, const ::vectorial::vec3d& b) { return ::vectorial::max(a,b); }
+}
+
+
+#ifdef VECTORIAL_OSTREAM
+#include <ostream>
+
+vectorial_inline std::ostream& operator<<(std::ostream& os, const vectorial::vec3d& v) {
+    os << "[ " << v.x() << ", "
+               << v.y() << ", "
+               << v.z() << " ]";
+    return os;
+}
+#endif
+
+
+
+
+#endif
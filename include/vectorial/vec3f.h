@@ -5,6 +5,7 @@
   Licensed under the terms of the two-clause BSD License (see LICENSE)
 */
 #ifndef VECTORIAL_VEC3F_H
+#define VECTORIAL_VEC3F_H
 
 #ifndef VECTORIAL_SIMD4F_H
   #include "vectorial/simd4f.h"
@@ -17,6 +18,36 @@ namespace vectorial {
     class vec4f;
     class vec2f;
 
+    // Lane masks from comparing vec3f, for select and the any/all tests
+    class vec3b {
+    public:
+
+        simd4f_mask value;
+
+        inline vec3b() {}
+        explicit inline vec3b(const simd4f_mask& v) : value(v) {}
+
+        enum { elements = 3 };
+
+    };
+
+    vectorial_inline vec3b operator&(const vec3b& lhs, const vec3b& rhs) {
+        return vec3b( simd4f_mask_and(lhs.value, rhs.value) );
+    }
+
+    vectorial_inline vec3b operator|(const vec3b& lhs, const vec3b& rhs) {
+        return vec3b( simd4f_mask_or(lhs.value, rhs.value) );
+    }
+
+    vectorial_inline vec3b operator^(const vec3b& lhs, const vec3b& rhs) {
+        return vec3b( simd4f_mask_xor(lhs.value, rhs.value) );
+    }
+
+    vectorial_inline vec3b operator~(const vec3b& v) {
+        return vec3b( simd4f_mask_not(v.value) );
+    }
+
+
     class vec3f {
     public:
 
@@ -171,6 +202,44 @@ namespace vectorial {
         return vec3f( simd4f_max(a.value, b.value) );
     }
 
+
+    vectorial_inline vec3b operator==(const vec3f& lhs, const vec3f& rhs) {
+        return vec3b( simd4f_cmpeq(lhs.value, rhs.value) );
+    }
+
+    vectorial_inline vec3b operator!=(const vec3f& lhs, const vec3f& rhs) {
+        return vec3b( simd4f_cmpne(lhs.value, rhs.value) );
+    }
+
+    vectorial_inline vec3b operator<(const vec3f& lhs, const vec3f& rhs) {
+        return vec3b( simd4f_cmplt(lhs.value, rhs.value) );
+    }
+
+    vectorial_inline vec3b operator<=(const vec3f& lhs, const vec3f& rhs) {
+        return vec3b( simd4f_cmple(lhs.value, rhs.value) );
+    }
+
+    vectorial_inline vec3b operator>(const vec3f& lhs, const vec3f& rhs) {
+        return vec3b( simd4f_cmpgt(lhs.value, rhs.value) );
+    }
+
+    vectorial_inline vec3b operator>=(const vec3f& lhs, const vec3f& rhs) {
+        return vec3b( simd4f_cmpge(lhs.value, rhs.value) );
+    }
+
+    // a where the mask is set, b elsewhere
+    vectorial_inline vec3f select(const vec3b& mask, const vec3f& a, const vec3f& b) {
+        return vec3f( simd4f_select(mask.value, a.value, b.value) );
+    }
+
+    vectorial_inline bool any(const vec3b& mask) {
+        return (simd4f_movemask(mask.value) & 7) != 0;
+    }
+
+    vectorial_inline bool all(const vec3b& mask) {
+        return (simd4f_movemask(mask.value) & 7) == 7;
+    }
+
 }
 
 
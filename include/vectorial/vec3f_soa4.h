@@ -0,0 +1,224 @@
+/*
+  Vectorial
+  Copyright (c) 2010 Mikko Lehtonen
+  Licensed under the terms of the two-clause BSD License (see LICENSE)
+*/
+#ifndef VECTORIAL_VEC3F_SOA4_H
+#define VECTORIAL_VEC3F_SOA4_H
+
+#ifndef VECTORIAL_SIMD4F_H
+  #include "vectorial/simd4f.h"
+#endif
+
+#ifndef VECTORIAL_SIMD4F_AOS_H
+  #include "vectorial/simd4f_aos.h"
+#endif
+
+#ifndef VECTORIAL_VEC3F_H
+  #include "vectorial/vec3f.h"
+#endif
+
+/*
+  4 vec3f in structure-of-arrays layout, one simd4f per component
+  with lane i holding vector i. Everything is computed lane-wise, so dot,
+  length etc. need no horizontal operations and give one result per lane.
+*/
+
+namespace vectorial {
+
+    class vec3f_soa4 {
+    public:
+
+        simd4f x, y, z;
+
+        inline vec3f_soa4() {}
+        inline vec3f_soa4(simd4f x_, simd4f y_, simd4f z_) : x(x_), y(y_), z(z_) {}
+        explicit inline vec3f_soa4(float xyz)
+          : x( simd4f_splat(xyz) ), y( simd4f_splat(xyz) ), z( simd4f_splat(xyz) ) {}
+        inline vec3f_soa4(float x_, float y_, float z_)
+          : x( simd4f_splat(x_) ), y( simd4f_splat(y_) ), z( simd4f_splat(z_) ) {}
+
+        // Every lane set to v
+        explicit inline vec3f_soa4(const vec3f& v)
+          : x( simd4f_splat_x(v.value) ),
+            y( simd4f_splat_y(v.value) ),
+            z( simd4f_splat_z(v.value) ) {}
+
+        // Component streams, 4 floats each
+        inline void load(const float *x_, const float *y_, const float *z_) { x = simd4f_uload4(x_); y = simd4f_uload4(y_); z = simd4f_uload4(z_); }
+        inline void store(float *x_, float *y_, float *z_) const { simd4f_ustore4(x, x_); simd4f_ustore4(y, y_); simd4f_ustore4(z, z_); }
+
+        // Packed or strided vectors, see simd4f_aos.h
+        inline void load_aos(const float *ary, size_t stride) { simd4f_aos_load3(ary, stride, &x, &y, &z); }
+        inline void store_aos(float *ary, size_t stride) const { simd4f_aos_store3(x, y, z, ary, stride); }
+
+        // 4 vec3f, padded to 4 floats
+        inline void load(const vec3f *v) { load_aos((const float*)v, 4); }
+        inline void store(vec3f *v) const { simd4f_aos_store4(x, y, z, simd4f_zero(), (float*)v, 4); }
+
+        enum { elements = 3, width = 4 };
+
+        static vec3f_soa4 zero() { return vec3f_soa4(simd4f_zero(), simd4f_zero(), simd4f_zero()); }
+        static vec3f_soa4 one() { return vec3f_soa4(1.0f); }
+
+    };
+
+    vectorial_inline vec3f_soa4 operator-(const vec3f_soa4& lhs) {
+        return vec3f_soa4( simd4f_sub(simd4f_zero(), lhs.x), simd4f_sub(simd4f_zero(), lhs.y), simd4f_sub(simd4f_zero(), lhs.z) );
+    }
+
+
+    vectorial_inline vec3f_soa4 operator+(const vec3f_soa4& lhs, const vec3f_soa4& rhs) {
+        return vec3f_soa4( simd4f_add(lhs.x, rhs.x), simd4f_add(lhs.y, rhs.y), simd4f_add(lhs.z, rhs.z) );
+    }
+
+    vectorial_inline vec3f_soa4 operator-(const vec3f_soa4& lhs, const vec3f_soa4& rhs) {
+        return vec3f_soa4( simd4f_sub(lhs.x, rhs.x), simd4f_sub(lhs.y, rhs.y), simd4f_sub(lhs.z, rhs.z) );
+    }
+
+    vectorial_inline vec3f_soa4 operator*(const vec3f_soa4& lhs, const vec3f_soa4& rhs) {
+        return vec3f_soa4( simd4f_mul(lhs.x, rhs.x), simd4f_mul(lhs.y, rhs.y), simd4f_mul(lhs.z, rhs.z) );
+    }
+
+    vectorial_inline vec3f_soa4 operator/(const vec3f_soa4& lhs, const vec3f_soa4& rhs) {
+        return vec3f_soa4( simd4f_div(lhs.x, rhs.x), simd4f_div(lhs.y, rhs.y), simd4f_div(lhs.z, rhs.z) );
+    }
+
+
+    vectorial_inline vec3f_soa4 operator+=(vec3f_soa4& lhs, const vec3f_soa4& rhs) {
+        return lhs = lhs + rhs;
+    }
+
+    vectorial_inline vec3f_soa4 operator-=(vec3f_soa4& lhs, const vec3f_soa4& rhs) {
+        return lhs = lhs - rhs;
+    }
+
+    vectorial_inline vec3f_soa4 operator*=(vec3f_soa4& lhs, const vec3f_soa4& rhs) {
+        return lhs = lhs * rhs;
+    }
+
+    vectorial_inline vec3f_soa4 operator/=(vec3f_soa4& lhs, const vec3f_soa4& rhs) {
+        return lhs = lhs / rhs;
+    }
+
+
+    // Scales vector i by lane i of rhs, f.ex. the result of dot or length
+    vectorial_inline vec3f_soa4 operator*(const vec3f_soa4& lhs, const simd4f& rhs) {
+        return vec3f_soa4( simd4f_mul(lhs.x, rhs), simd4f_mul(lhs.y, rhs), simd4f_mul(lhs.z, rhs) );
+    }
+
+    vectorial_inline vec3f_soa4 operator/(const vec3f_soa4& lhs, const simd4f& rhs) {
+        return vec3f_soa4( simd4f_div(lhs.x, rhs), simd4f_div(lhs.y, rhs), simd4f_div(lhs.z, rhs) );
+    }
+
+    vectorial_inline vec3f_soa4 operator*(const simd4f& lhs, const vec3f_soa4& rhs) {
+        return rhs * lhs;
+    }
+
+
+
+    vectorial_inline vec3f_soa4 operator+(const vec3f_soa4& lhs, float rhs) {
+        return lhs + vec3f_soa4(rhs);
+    }
+
+    vectorial_inline vec3f_soa4 operator-(const vec3f_soa4& lhs, float rhs) {
+        return lhs - vec3f_soa4(rhs);
+    }
+
+    vectorial_inline vec3f_soa4 operator*(const vec3f_soa4& lhs, float rhs) {
+        return lhs * vec3f_soa4(rhs);
+    }
+
+    vectorial_inline vec3f_soa4 operator/(const vec3f_soa4& lhs, float rhs) {
+        return lhs / vec3f_soa4(rhs);
+    }
+
+
+    vectorial_inline vec3f_soa4 operator+(float lhs, const vec3f_soa4& rhs) {
+        return vec3f_soa4(lhs) + rhs;
+    }
+
+    vectorial_inline vec3f_soa4 operator-(float lhs, const vec3f_soa4& rhs) {
+        return vec3f_soa4(lhs) - rhs;
+    }
+
+    vectorial_inline vec3f_soa4 operator*(float lhs, const vec3f_soa4& rhs) {
+        return vec3f_soa4(lhs) * rhs;
+    }
+
+    vectorial_inline vec3f_soa4 operator/(float lhs, const vec3f_soa4& rhs) {
+        return vec3f_soa4(lhs) / rhs;
+    }
+
+
+    vectorial_inline vec3f_soa4 operator+=(vec3f_soa4& lhs, float rhs) {
+        return lhs = lhs + vec3f_soa4(rhs);
+    }
+
+    vectorial_inline vec3f_soa4 operator-=(vec3f_soa4& lhs, float rhs) {
+        return lhs = lhs - vec3f_soa4(rhs);
+    }
+
+    vectorial_inline vec3f_soa4 operator*=(vec3f_soa4& lhs, float rhs) {
+        return lhs = lhs * vec3f_soa4(rhs);
+    }
+
+    vectorial_inline vec3f_soa4 operator/=(vec3f_soa4& lhs, float rhs) {
+        return lhs = lhs / vec3f_soa4(rhs);
+    }
+
+
+    vectorial_inline simd4f dot(const vec3f_soa4& lhs, const vec3f_soa4& rhs) {
+        return simd4f_madd(lhs.x, rhs.x, simd4f_madd(lhs.y, rhs.y, simd4f_mul(lhs.z, rhs.z)));
+    }
+
+    vectorial_inline vec3f_soa4 cross(const vec3f_soa4& lhs, const vec3f_soa4& rhs) {
+        return vec3f_soa4( simd4f_sub(simd4f_mul(lhs.y, rhs.z), simd4f_mul(lhs.z, rhs.y)),
+                           simd4f_sub(simd4f_mul(lhs.z, rhs.x), simd4f_mul(lhs.x, rhs.z)),
+                           simd4f_sub(simd4f_mul(lhs.x, rhs.y), simd4f_mul(lhs.y, rhs.x)) );
+    }
+
+
+    vectorial_inline simd4f length(const vec3f_soa4& v) {
+        return simd4f_sqrt( dot(v, v) );
+    }
+
+    vectorial_inline simd4f length_squared(const vec3f_soa4& v) {
+        return dot(v, v);
+    }
+
+    vectorial_inline vec3f_soa4 normalize(const vec3f_soa4& v) {
+        return v * simd4f_rsqrt( dot(v, v) );
+    }
+
+    vectorial_inline vec3f_soa4 min(const vec3f_soa4& a, const vec3f_soa4& b) {
+        return vec3f_soa4( simd4f_min(a.x, b.x), simd4f_min(a.y, b.y), simd4f_min(a.z, b.z) );
+    }
+
+    vectorial_inline vec3f_soa4 max(const vec3f_soa4& a, const vec3f_soa4& b) {
+        return vec3f_soa4( simd4f_max(a.x, b.x), simd4f_max(a.y, b.y), simd4f_max(a.z, b.z) );
+    }
+
+}
+
+
+namespace std {
+    inline ::vectorial::vec3f_soa4 min(const ::vectorial::vec3f_soa4& a, const ::vectorial::vec3f_soa4& b) { return ::vectorial::min(a,b); }
+    inline ::vectorial::vec3f_soa4 max(const ::vectorial::vec3f_soa4& a, const ::vectorial::vec3f_soa4& b) { return ::vectorial::max(a,b); }
+}
+
+
+#ifdef VECTORIAL_OSTREAM
+#include <ostream>
+
+vectorial_inline std::ostream& operator<<(std::ostream& os, const vectorial::vec3f_soa4& v) {
+    os << "[ " << v.x << ", "
+               << v.y << ", "
+               << v.z << " ]";
+    return os;
+}
+#endif
+
+
+
+#endif
@@ -0,0 +1,200 @@
+/*
+  Vectorial
+  Copyright (c) 2010 Mikko Lehtonen
+  Licensed under the terms of the two-clause BSD License (see LICENSE)
+*/
+#ifndef VECTORIAL_VEC4D_H
+#define VECTORIAL_VEC4D_H
+
+#ifndef VECTORIAL_VEC3D_H
+  #include "vectorial/vec3d.h"
+#endif
+
+#ifndef VECTORIAL_VEC4F_H
+  #include "vectorial/vec4f.h"
+#endif
+
+
+namespace vectorial {
+
+    class vec4d {
+    public:
+
+        simd4d value;
+
+        inline vec4d() {}
+        inline vec4d(const simd4d& v) : value(v) {}
+        explicit inline vec4d(double xyzw) : value( simd4d_splat(xyzw) ) {}
+        inline vec4d(double x, double y, double z, double w) : value( simd4d_create(x,y,z,w) ) {}
+        inline vec4d(const vec3d& v, double w) : value( simd4d_add( simd4d_zero_w(v.value), simd4d_create(0,0,0,w) ) ) {}
+        explicit inline vec4d(const double *ary) : value( simd4d_uload4(ary) ) { }
+        explicit inline vec4d(const vec4f& v) : value( simd4f_to_simd4d(v.value) ) {}
+
+        inline double x() const { return simd4d_get_x(value); }
+        inline double y() const { return simd4d_get_y(value); }
+        inline double z() const { return simd4d_get_z(value); }
+        inline double w() const { return simd4d_get_w(value); }
+
+        inline void load(const double *ary) { value = simd4d_uload4(ary); }
+        inline void store(double *ary) const { simd4d_ustore4(value, ary); }
+
+        enum { elements = 4 };
+
+
+        static vec4d zero() { return vec4d(simd4d_zero()); }
+        static vec4d one() { return vec4d(1.0); }
+        static vec4d xAxis() { return vec4d(1.0, 0.0, 0.0, 0.0); }
+        static vec4d yAxis() { return vec4d(0.0, 1.0, 0.0, 0.0); }
+        static vec4d zAxis() { return vec4d(0.0, 0.0, 1.0, 0.0); }
+        static vec4d wAxis() { return vec4d(0.0, 0.0, 0.0, 1.0); }
+
+        inline vec3d xyz() const { return vec3d( simd4d_zero_w(value) ); }
+
+    };
+
+    vectorial_inline vec4d operator-(const vec4d& lhs) {
+        return vec4d( simd4d_sub(simd4d_zero(), lhs.value) );
+    }
+
+
+    vectorial_inline vec4d operator+(const vec4d& lhs, const vec4d& rhs) {
+        return vec4d( simd4d_add(lhs.value, rhs.value) );
+    }
+
+    vectorial_inline vec4d operator-(const vec4d& lhs, const vec4d& rhs) {
+        return vec4d( simd4d_sub(lhs.value, rhs.value) );
+    }
+
+    vectorial_inline vec4d operator*(const vec4d& lhs, const vec4d& rhs) {
+        return vec4d( simd4d_mul(lhs.value, rhs.value) );
+    }
+
+    vectorial_inline vec4d operator/(const vec4d& lhs, const vec4d& rhs) {
+        return vec4d( simd4d_div(lhs.value, rhs.value) );
+    }
+
+
+    vectorial_inline vec4d operator+=(vec4d& lhs, const vec4d& rhs) {
+        return lhs = vec4d( simd4d_add(lhs.value, rhs.value) );
+    }
+
+    vectorial_inline vec4d operator-=(vec4d& lhs, const vec4d& rhs) {
+        return lhs = vec4d( simd4d_sub(lhs.value, rhs.value) );
+    }
+
+    vectorial_inline vec4d operator*=(vec4d& lhs, const vec4d& rhs) {
+        return lhs = vec4d( simd4d_mul(lhs.value, rhs.value) );
+    }
+
+    vectorial_inline vec4d operator/=(vec4d& lhs, const vec4d& rhs) {
+        return lhs = vec4d( simd4d_div(lhs.value, rhs.value) );
+    }
+
+
+
+    vectorial_inline vec4d operator+(const vec4d& lhs, double rhs) {
+        return vec4d( simd4d_add(lhs.value, simd4d_splat(rhs)) );
+    }
+
+    vectorial_inline vec4d operator-(const vec4d& lhs, double rhs) {
+        return vec4d( simd4d_sub(lhs.value, simd4d_splat(rhs)) );
+    }
+
+    vectorial_inline vec4d operator*(const vec4d& lhs, double rhs) {
+        return vec4d( simd4d_mul(lhs.value, simd4d_splat(rhs)) );
+    }
+
+    vectorial_inline vec4d operator/(const vec4d& lhs, double rhs) {
+        return vec4d( simd4d_div(lhs.value, simd4d_splat(rhs)) );
+    }
+
+    vectorial_inline vec4d operator+(double lhs, const vec4d& rhs) {
+        return vec4d( simd4d_add(simd4d_splat(lhs), rhs.value) );
+    }
+
+    vectorial_inline vec4d operator-(double lhs, const vec4d& rhs) {
+        return vec4d( simd4d_sub(simd4d_splat(lhs), rhs.value) );
+    }
+
+    vectorial_inline vec4d operator*(double lhs, const vec4d& rhs) {
+        return vec4d( simd4d_mul(simd4d_splat(lhs), rhs.value) );
+    }
+
+    vectorial_inline vec4d operator/(double lhs, const vec4d& rhs) {
+        return vec4d( simd4d_div(simd4d_splat(lhs), rhs.value) );
+    }
+
+
+    vectorial_inline vec4d operator+=(vec4d& lhs, double rhs) {
+        return lhs = vec4d( simd4d_add(lhs.value, simd4d_splat(rhs)) );
+    }
+
+    vectorial_inline vec4d operator-=(vec4d& lhs, double rhs) {
+        return lhs = vec4d( simd4d_sub(lhs.value, simd4d_splat(rhs)) );
+    }
+
+    vectorial_inline vec4d operator*=(vec4d& lhs, double rhs) {
+        return lhs = vec4d( simd4d_mul(lhs.value, simd4d_splat(rhs)) );
+    }
+
+    vectorial_inline vec4d operator/=(vec4d& lhs, double rhs) {
+        return lhs = vec4d( simd4d_div(lhs.value, simd4d_splat(rhs)) );
+    }
+
+
+    vectorial_inline double dot(const vec4d& lhs, const vec4d& rhs) {
+        return simd4d_get_x( simd4d_dot4(lhs.value, rhs.value) );
+    }
+
+
+    vectorial_inline double length(const vec4d& v) {
+        return simd4d_get_x( simd4d_length4(v.value) );
+    }
+
+    vectorial_inline double length_squared(const vec4d& v) {
+        return simd4d_get_x( simd4d_length4_squared(v.value) );
+    }
+
+    vectorial_inline vec4d normalize(const vec4d& v) {
+        return vec4d( simd4d_normalize4(v.value) );
+    }
+
+    vectorial_inline vec4d min(const vec4d& a, const vec4d& b) {
+        return vec4d( simd4d_min(a.value, b.value) );
+    }
+
+    vectorial_inline vec4d max(const vec4d& a, const vec4d& b) {
+        return vec4d( simd4d_max(a.value, b.value) );
+    }
+
+
+
+    vectorial_inline vec4f toFloat(const vec4d& v) {
+        return vec4f( simd4d_to_simd4f(v.value) );
+    }
+
+}
+
+
+namespace std {
+    inline ::vectorial::vec4d min(const ::vectorial::vec4d& a, const ::vectorial::vec4d& b) { return ::vectorial::min(a,b); }
+    inline ::vectorial::vec4d max(const ::vectorial::vec4d& a, const ::vectorial::vec4d& b) { return ::vectorial::max(a,b); }
+}
+
+
+#ifdef VECTORIAL_OSTREAM
+#include <ostream>
+
+vectorial_inline std::ostream& operator<<(std::ostream& os, const vectorial::vec4d& v) {
+    os << "[ " << v.x() << ", "
+               << v.y() << ", "
+               << v.z() << ", "
+               << v.w() << " ]";
+    return os;
+}
+#endif
+
+
+
+
+#endif
@@ -17,6 +17,36 @@ namespace vectorial {
     class vec3f;
     class vec2f;
 
+    // Lane masks from comparing vec4f, for select and the any/all tests
+    class vec4b {
+    public:
+
+        simd4f_mask value;
+
+        inline vec4b() {}
+        explicit inline vec4b(const simd4f_mask& v) : value(v) {}
+
+        enum { elements = 4 };
+
+    };
+
+    vectorial_inline vec4b operator&(const vec4b& lhs, const vec4b& rhs) {
+        return vec4b( simd4f_mask_and(lhs.value, rhs.value) );
+    }
+
+    vectorial_inline vec4b operator|(const vec4b& lhs, const vec4b& rhs) {
+        return vec4b( simd4f_mask_or(lhs.value, rhs.value) );
+    }
+
+    vectorial_inline vec4b operator^(const vec4b& lhs, const vec4b& rhs) {
+        return vec4b( simd4f_mask_xor(lhs.value, rhs.value) );
+    }
+
+    vectorial_inline vec4b operator~(const vec4b& v) {
+        return vec4b( simd4f_mask_not(v.value) );
+    }
+
+
     class vec4f {
     public:
 
@@ -170,6 +200,44 @@ namespace vectorial {
     }
 
 
+    vectorial_inline vec4b operator==(const vec4f& lhs, const vec4f& rhs) {
+        return vec4b( simd4f_cmpeq(lhs.value, rhs.value) );
+    }
+
+    vectorial_inline vec4b operator!=(const vec4f& lhs, const vec4f& rhs) {
+        return vec4b( simd4f_cmpne(lhs.value, rhs.value) );
+    }
+
+    vectorial_inline vec4b operator<(const vec4f& lhs, const vec4f& rhs) {
+        return vec4b( simd4f_cmplt(lhs.value, rhs.value) );
+    }
+
+    vectorial_inline vec4b operator<=(const vec4f& lhs, const vec4f& rhs) {
+        return vec4b( simd4f_cmple(lhs.value, rhs.value) );
+    }
+
+    vectorial_inline vec4b operator>(const vec4f& lhs, const vec4f& rhs) {
+        return vec4b( simd4f_cmpgt(lhs.value, rhs.value) );
+    }
+
+    vectorial_inline vec4b operator>=(const vec4f& lhs, const vec4f& rhs) {
+        return vec4b( simd4f_cmpge(lhs.value, rhs.value) );
+    }
+
+    // a where the mask is set, b elsewhere
+    vectorial_inline vec4f select(const vec4b& mask, const vec4f& a, const vec4f& b) {
+        return vec4f( simd4f_select(mask.value, a.value, b.value) );
+    }
+
+    vectorial_inline bool any(const vec4b& mask) {
+        return (simd4f_movemask(mask.value) & 15) != 0;
+    }
+
+    vectorial_inline bool all(const vec4b& mask) {
+        return (simd4f_movemask(mask.value) & 15) == 15;
+    }
+
+
 }
 
 
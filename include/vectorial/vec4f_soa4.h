@@ -0,0 +1,220 @@
+/*
+  Vectorial
+  Copyright (c) 2010 Mikko Lehtonen
+  Licensed under the terms of the two-clause BSD License (see LICENSE)
+*/
+#ifndef VECTORIAL_VEC4F_SOA4_H
+#define VECTORIAL_VEC4F_SOA4_H
+
+#ifndef VECTORIAL_SIMD4F_H
+  #include "vectorial/simd4f.h"
+#endif
+
+#ifndef VECTORIAL_SIMD4F_AOS_H
+  #include "vectorial/simd4f_aos.h"
+#endif
+
+#ifndef VECTORIAL_VEC4F_H
+  #include "vectorial/vec4f.h"
+#endif
+
+/*
+  4 vec4f in structure-of-arrays layout, one simd4f per component
+  with lane i holding vector i. Everything is computed lane-wise, so dot,
+  length etc. need no horizontal operations and give one result per lane.
+*/
+
+namespace vectorial {
+
+    class vec4f_soa4 {
+    public:
+
+        simd4f x, y, z, w;
+
+        inline vec4f_soa4() {}
+        inline vec4f_soa4(simd4f x_, simd4f y_, simd4f z_, simd4f w_) : x(x_), y(y_), z(z_), w(w_) {}
+        explicit inline vec4f_soa4(float xyzw)
+          : x( simd4f_splat(xyzw) ), y( simd4f_splat(xyzw) ), z( simd4f_splat(xyzw) ), w( simd4f_splat(xyzw) ) {}
+        inline vec4f_soa4(float x_, float y_, float z_, float w_)
+          : x( simd4f_splat(x_) ), y( simd4f_splat(y_) ), z( simd4f_splat(z_) ), w( simd4f_splat(w_) ) {}
+
+        // Every lane set to v
+        explicit inline vec4f_soa4(const vec4f& v)
+          : x( simd4f_splat_x(v.value) ),
+            y( simd4f_splat_y(v.value) ),
+            z( simd4f_splat_z(v.value) ),
+            w( simd4f_splat_w(v.value) ) {}
+
+        // Component streams, 4 floats each
+        inline void load(const float *x_, const float *y_, const float *z_, const float *w_) { x = simd4f_uload4(x_); y = simd4f_uload4(y_); z = simd4f_uload4(z_); w = simd4f_uload4(w_); }
+        inline void store(float *x_, float *y_, float *z_, float *w_) const { simd4f_ustore4(x, x_); simd4f_ustore4(y, y_); simd4f_ustore4(z, z_); simd4f_ustore4(w, w_); }
+
+        // Packed or strided vectors, see simd4f_aos.h
+        inline void load_aos(const float *ary, size_t stride) { simd4f_aos_load4(ary, stride, &x, &y, &z, &w); }
+        inline void store_aos(float *ary, size_t stride) const { simd4f_aos_store4(x, y, z, w, ary, stride); }
+
+        // 4 vec4f, a whole register each
+        inline void load(const vec4f *v) { load_aos((const float*)v, 4); }
+        inline void store(vec4f *v) const { store_aos((float*)v, 4); }
+
+        enum { elements = 4, width = 4 };
+
+        static vec4f_soa4 zero() { return vec4f_soa4(simd4f_zero(), simd4f_zero(), simd4f_zero(), simd4f_zero()); }
+        static vec4f_soa4 one() { return vec4f_soa4(1.0f); }
+
+    };
+
+    vectorial_inline vec4f_soa4 operator-(const vec4f_soa4& lhs) {
+        return vec4f_soa4( simd4f_sub(simd4f_zero(), lhs.x), simd4f_sub(simd4f_zero(), lhs.y), simd4f_sub(simd4f_zero(), lhs.z), simd4f_sub(simd4f_zero(), lhs.w) );
+    }
+
+
+    vectorial_inline vec4f_soa4 operator+(const vec4f_soa4& lhs, const vec4f_soa4& rhs) {
+        return vec4f_soa4( simd4f_add(lhs.x, rhs.x), simd4f_add(lhs.y, rhs.y), simd4f_add(lhs.z, rhs.z), simd4f_add(lhs.w, rhs.w) );
+    }
+
+    vectorial_inline vec4f_soa4 operator-(const vec4f_soa4& lhs, const vec4f_soa4& rhs) {
+        return vec4f_soa4( simd4f_sub(lhs.x, rhs.x), simd4f_sub(lhs.y, rhs.y), simd4f_sub(lhs.z, rhs.z), simd4f_sub(lhs.w, rhs.w) );
+    }
+
+    vectorial_inline vec4f_soa4 operator*(const vec4f_soa4& lhs, const vec4f_soa4& rhs) {
+        return vec4f_soa4( simd4f_mul(lhs.x, rhs.x), simd4f_mul(lhs.y, rhs.y), simd4f_mul(lhs.z, rhs.z), simd4f_mul(lhs.w, rhs.w) );
+    }
+
+    vectorial_inline vec4f_soa4 operator/(const vec4f_soa4& lhs, const vec4f_soa4& rhs) {
+        return vec4f_soa4( simd4f_div(lhs.x, rhs.x), simd4f_div(lhs.y, rhs.y), simd4f_div(lhs.z, rhs.z), simd4f_div(lhs.w, rhs.w) );
+    }
+
+
+    vectorial_inline vec4f_soa4 operator+=(vec4f_soa4& lhs, const vec4f_soa4& rhs) {
+        return lhs = lhs + rhs;
+    }
+
+    vectorial_inline vec4f_soa4 operator-=(vec4f_soa4& lhs, const vec4f_soa4& rhs) {
+        return lhs = lhs - rhs;
+    }
+
+    vectorial_inline vec4f_soa4 operator*=(vec4f_soa4& lhs, const vec4f_soa4& rhs) {
+        return lhs = lhs * rhs;
+    }
+
+    vectorial_inline vec4f_soa4 operator/=(vec4f_soa4& lhs, const vec4f_soa4& rhs) {
+        return lhs = lhs / rhs;
+    }
+
+
+    // Scales vector i by lane i of rhs, f.ex. the result of dot or length
+    vectorial_inline vec4f_soa4 operator*(const vec4f_soa4& lhs, const simd4f& rhs) {
+        return vec4f_soa4( simd4f_mul(lhs.x, rhs), simd4f_mul(lhs.y, rhs), simd4f_mul(lhs.z, rhs), simd4f_mul(lhs.w, rhs) );
+    }
+
+    vectorial_inline vec4f_soa4 operator/(const vec4f_soa4& lhs, const simd4f& rhs) {
+        return vec4f_soa4( simd4f_div(lhs.x, rhs), simd4f_div(lhs.y, rhs), simd4f_div(lhs.z, rhs), simd4f_div(lhs.w, rhs) );
+    }
+
+    vectorial_inline vec4f_soa4 operator*(const simd4f& lhs, const vec4f_soa4& rhs) {
+        return rhs * lhs;
+    }
+
+
+
+    vectorial_inline vec4f_soa4 operator+(const vec4f_soa4& lhs, float rhs) {
+        return lhs + vec4f_soa4(rhs);
+    }
+
+    vectorial_inline vec4f_soa4 operator-(const vec4f_soa4& lhs, float rhs) {
+        return lhs - vec4f_soa4(rhs);
+    }
+
+    vectorial_inline vec4f_soa4 operator*(const vec4f_soa4& lhs, float rhs) {
+        return lhs * vec4f_soa4(rhs);
+    }
+
+    vectorial_inline vec4f_soa4 operator/(const vec4f_soa4& lhs, float rhs) {
+        return lhs / vec4f_soa4(rhs);
+    }
+
+
+    vectorial_inline vec4f_soa4 operator+(float lhs, const vec4f_soa4& rhs) {
+        return vec4f_soa4(lhs) + rhs;
+    }
+
+    vectorial_inline vec4f_soa4 operator-(float lhs, const vec4f_soa4& rhs) {
+        return vec4f_soa4(lhs) - rhs;
+    }
+
+    vectorial_inline vec4f_soa4 operator*(float lhs, const vec4f_soa4& rhs) {
+        return vec4f_soa4(lhs) * rhs;
+    }
+
+    vectorial_inline vec4f_soa4 operator/(float lhs, const vec4f_soa4& rhs) {
+        return vec4f_soa4(lhs) / rhs;
+    }
+
+
+    vectorial_inline vec4f_soa4 operator+=(vec4f_soa4& lhs, float rhs) {
+        return lhs = lhs + vec4f_soa4(rhs);
+    }
+
+    vectorial_inline vec4f_soa4 operator-=(vec4f_soa4& lhs, float rhs) {
+        return lhs = lhs - vec4f_soa4(rhs);
+    }
+
+    vectorial_inline vec4f_soa4 operator*=(vec4f_soa4& lhs, float rhs) {
+        return lhs = lhs * vec4f_soa4(rhs);
+    }
+
+    vectorial_inline vec4f_soa4 operator/=(vec4f_soa4& lhs, float rhs) {
+        return lhs = lhs / vec4f_soa4(rhs);
+    }
+
+
+    vectorial_inline simd4f dot(const vec4f_soa4& lhs, const vec4f_soa4& rhs) {
+        return simd4f_madd(lhs.x, rhs.x, simd4f_madd(lhs.y, rhs.y, simd4f_madd(lhs.z, rhs.z, simd4f_mul(lhs.w, rhs.w))));
+    }
+
+
+    vectorial_inline simd4f length(const vec4f_soa4& v) {
+        return simd4f_sqrt( dot(v, v) );
+    }
+
+    vectorial_inline simd4f length_squared(const vec4f_soa4& v) {
+        return dot(v, v);
+    }
+
+    vectorial_inline vec4f_soa4 normalize(const vec4f_soa4& v) {
+        return v * simd4f_rsqrt( dot(v, v) );
+    }
+
+    vectorial_inline vec4f_soa4 min(const vec4f_soa4& a, const vec4f_soa4& b) {
+        return vec4f_soa4( simd4f_min(a.x, b.x), simd4f_min(a.y, b.y), simd4f_min(a.z, b.z), simd4f_min(a.w, b.w) );
+    }
+
+    vectorial_inline vec4f_soa4 max(const vec4f_soa4& a, const vec4f_soa4& b) {
+        return vec4f_soa4( simd4f_max(a.x, b.x), simd4f_max(a.y, b.y), simd4f_max(a.z, b.z), simd4f_max(a.w, b.w) );
+    }
+
+}
+
+
+namespace std {
+    inline ::vectorial::vec4f_soa4 min(const ::vectorial::vec4f_soa4& a, const ::vectorial::vec4f_soa4& b) { return ::vectorial::min(a,b); }
+    inline ::vectorial::vec4f_soa4 max(const ::vectorial::vec4f_soa4& a, const ::vectorial::vec4f_soa4& b) { return ::vectorial::max(a,b); }
+}
+
+
+#ifdef VECTORIAL_OSTREAM
+#include <ostream>
+
+vectorial_inline std::ostream& operator<<(std::ostream& os, const vectorial::vec4f_soa4& v) {
+    os << "[ " << v.x << ", "
+               << v.y << ", "
+               << v.z << ", "
+               << v.w << " ]";
+    return os;
+}
+#endif
+
+
+
+#endif
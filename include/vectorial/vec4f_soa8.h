@@ -0,0 +1,220 @@
+/*
+  Vectorial
+  Copyright (c) 2010 Mikko Lehtonen
+  Licensed under the terms of the two-clause BSD License (see LICENSE)
+*/
+#ifndef VECTORIAL_VEC4F_SOA8_H
+#define VECTORIAL_VEC4F_SOA8_H
+
+#ifndef VECTORIAL_SIMD8F_H
+  #include "vectorial/simd8f.h"
+#endif
+
+#ifndef VECTORIAL_SIMD8F_AOS_H
+  #include "vectorial/simd8f_aos.h"
+#endif
+
+#ifndef VECTORIAL_VEC4F_H
+  #include "vectorial/vec4f.h"
+#endif
+
+/*
+  8 vec4f in structure-of-arrays layout, one simd8f per component
+  with lane i holding vector i. Everything is computed lane-wise, so dot,
+  length etc. need no horizontal operations and give one result per lane.
+*/
+
+namespace vectorial {
+
+    class vec4f_soa8 {
+    public:
+
+        simd8f x, y, z, w;
+
+        inline vec4f_soa8() {}
+        inline vec4f_soa8(simd8f x_, simd8f y_, simd8f z_, simd8f w_) : x(x_), y(y_), z(z_), w(w_) {}
+        explicit inline vec4f_soa8(float xyzw)
+          : x( simd8f_splat(xyzw) ), y( simd8f_splat(xyzw) ), z( simd8f_splat(xyzw) ), w( simd8f_splat(xyzw) ) {}
+        inline vec4f_soa8(float x_, float y_, float z_, float w_)
+          : x( simd8f_splat(x_) ), y( simd8f_splat(y_) ), z( simd8f_splat(z_) ), w( simd8f_splat(w_) ) {}
+
+        // Every lane set to v
+        explicit inline vec4f_soa8(const vec4f& v)
+          : x( simd8f_combine(simd4f_splat_x(v.value), simd4f_splat_x(v.value)) ),
+            y( simd8f_combine(simd4f_splat_y(v.value), simd4f_splat_y(v.value)) ),
+            z( simd8f_combine(simd4f_splat_z(v.value), simd4f_splat_z(v.value)) ),
+            w( simd8f_combine(simd4f_splat_w(v.value), simd4f_splat_w(v.value)) ) {}
+
+        // Component streams, 8 floats each
+        inline void load(const float *x_, const float *y_, const float *z_, const float *w_) { x = simd8f_uload8(x_); y = simd8f_uload8(y_); z = simd8f_uload8(z_); w = simd8f_uload8(w_); }
+        inline void store(float *x_, float *y_, float *z_, float *w_) const { simd8f_ustore8(x, x_); simd8f_ustore8(y, y_); simd8f_ustore8(z, z_); simd8f_ustore8(w, w_); }
+
+        // Packed or strided vectors, see simd8f_aos.h
+        inline void load_aos(const float *ary, size_t stride) { simd8f_aos_load4(ary, stride, &x, &y, &z, &w); }
+        inline void store_aos(float *ary, size_t stride) const { simd8f_aos_store4(x, y, z, w, ary, stride); }
+
+        // 8 vec4f, a whole register each
+        inline void load(const vec4f *v) { load_aos((const float*)v, 4); }
+        inline void store(vec4f *v) const { store_aos((float*)v, 4); }
+
+        enum { elements = 4, width = 8 };
+
+        static vec4f_soa8 zero() { return vec4f_soa8(simd8f_zero(), simd8f_zero(), simd8f_zero(), simd8f_zero()); }
+        static vec4f_soa8 one() { return vec4f_soa8(1.0f); }
+
+    };
+
+    vectorial_inline vec4f_soa8 operator-(const vec4f_soa8& lhs) {
+        return vec4f_soa8( simd8f_sub(simd8f_zero(), lhs.x), simd8f_sub(simd8f_zero(), lhs.y), simd8f_sub(simd8f_zero(), lhs.z), simd8f_sub(simd8f_zero(), lhs.w) );
+    }
+
+
+    vectorial_inline vec4f_soa8 operator+(const vec4f_soa8& lhs, const vec4f_soa8& rhs) {
+        return vec4f_soa8( simd8f_add(lhs.x, rhs.x), simd8f_add(lhs.y, rhs.y), simd8f_add(lhs.z, rhs.z), simd8f_add(lhs.w, rhs.w) );
+    }
+
+    vectorial_inline vec4f_soa8 operator-(const vec4f_soa8& lhs, const vec4f_soa8& rhs) {
+        return vec4f_soa8( simd8f_sub(lhs.x, rhs.x), simd8f_sub(lhs.y, rhs.y), simd8f_sub(lhs.z, rhs.z), simd8f_sub(lhs.w, rhs.w) );
+    }
+
+    vectorial_inline vec4f_soa8 operator*(const vec4f_soa8& lhs, const vec4f_soa8& rhs) {
+        return vec4f_soa8( simd8f_mul(lhs.x, rhs.x), simd8f_mul(lhs.y, rhs.y), simd8f_mul(lhs.z, rhs.z), simd8f_mul(lhs.w, rhs.w) );
+    }
+
+    vectorial_inline vec4f_soa8 operator/(const vec4f_soa8& lhs, const vec4f_soa8& rhs) {
+        return vec4f_soa8( simd8f_div(lhs.x, rhs.x), simd8f_div(lhs.y, rhs.y), simd8f_div(lhs.z, rhs.z), simd8f_div(lhs.w, rhs.w) );
+    }
+
+
+    vectorial_inline vec4f_soa8 operator+=(vec4f_soa8& lhs, const vec4f_soa8& rhs) {
+        return lhs = lhs + rhs;
+    }
+
+    vectorial_inline vec4f_soa8 operator-=(vec4f_soa8& lhs, const vec4f_soa8& rhs) {
+        return lhs = lhs - rhs;
+    }
+
+    vectorial_inline vec4f_soa8 operator*=(vec4f_soa8& lhs, const vec4f_soa8& rhs) {
+        return lhs = lhs * rhs;
+    }
+
+    vectorial_inline vec4f_soa8 operator/=(vec4f_soa8& lhs, const vec4f_soa8& rhs) {
+        return lhs = lhs / rhs;
+    }
+
+
+    // Scales vector i by lane i of rhs, f.ex. the result of dot or length
+    vectorial_inline vec4f_soa8 operator*(const vec4f_soa8& lhs, const simd8f& rhs) {
+        return vec4f_soa8( simd8f_mul(lhs.x, rhs), simd8f_mul(lhs.y, rhs), simd8f_mul(lhs.z, rhs), simd8f_mul(lhs.w, rhs) );
+    }
+
+    vectorial_inline vec4f_soa8 operator/(const vec4f_soa8& lhs, const simd8f& rhs) {
+        return vec4f_soa8( simd8f_div(lhs.x, rhs), simd8f_div(lhs.y, rhs), simd8f_div(lhs.z, rhs), simd8f_div(lhs.w, rhs) );
+    }
+
+    vectorial_inline vec4f_soa8 operator*(const simd8f& lhs, const vec4f_soa8& rhs) {
+        return rhs * lhs;
+    }
+
+
+
+    vectorial_inline vec4f_soa8 operator+(const vec4f_soa8& lhs, float rhs) {
+        return lhs + vec4f_soa8(rhs);
+    }
+
+    vectorial_inline vec4f_soa8 operator-(const vec4f_soa8& lhs, float rhs) {
+        return lhs - vec4f_soa8(rhs);
+    }
+
+    vectorial_inline vec4f_soa8 operator*(const vec4f_soa8& lhs, float rhs) {
+        return lhs * vec4f_soa8(rhs);
+    }
+
+    vectorial_inline vec4f_soa8 operator/(const vec4f_soa8& lhs, float rhs) {
+        return lhs / vec4f_soa8(rhs);
+    }
+
+
+    vectorial_inline vec4f_soa8 operator+(float lhs, const vec4f_soa8& rhs) {
+        return vec4f_soa8(lhs) + rhs;
+    }
+
+    vectorial_inline vec4f_soa8 operator-(float lhs, const vec4f_soa8& rhs) {
+        return vec4f_soa8(lhs) - rhs;
+    }
+
+    vectorial_inline vec4f_soa8 operator*(float lhs, const vec4f_soa8& rhs) {
+        return vec4f_soa8(lhs) * rhs;
+    }
+
+    vectorial_inline vec4f_soa8 operator/(float lhs, const vec4f_soa8& rhs) {
+        return vec4f_soa8(lhs) / rhs;
+    }
+
+
+    vectorial_inline vec4f_soa8 operator+=(vec4f_soa8& lhs, float rhs) {
+        return lhs = lhs + vec4f_soa8(rhs);
+    }
+
+    vectorial_inline vec4f_soa8 operator-=(vec4f_soa8& lhs, float rhs) {
+        return lhs = lhs - vec4f_soa8(rhs);
+    }
+
+    vectorial_inline vec4f_soa8 operator*=(vec4f_soa8& lhs, float rhs) {
+        return lhs = lhs * vec4f_soa8(rhs);
+    }
+
+    vectorial_inline vec4f_soa8 operator/=(vec4f_soa8& lhs, float rhs) {
+        return lhs = lhs / vec4f_soa8(rhs);
+    }
+
+
+    vectorial_inline simd8f dot(const vec4f_soa8& lhs, const vec4f_soa8& rhs) {
+        return simd8f_madd(lhs.x, rhs.x, simd8f_madd(lhs.y, rhs.y, simd8f_madd(lhs.z, rhs.z, simd8f_mul(lhs.w, rhs.w))));
+    }
+
+
+    vectorial_inline simd8f length(const vec4f_soa8& v) {
+        return simd8f_sqrt( dot(v, v) );
+    }
+
+    vectorial_inline simd8f length_squared(const vec4f_soa8& v) {
+        return dot(v, v);
+    }
+
+    vectorial_inline vec4f_soa8 normalize(const vec4f_soa8& v) {
+        return v * simd8f_rsqrt( dot(v, v) );
+    }
+
+    vectorial_inline vec4f_soa8 min(const vec4f_soa8& a, const vec4f_soa8& b) {
+        return vec4f_soa8( simd8f_min(a.x, b.x), simd8f_min(a.y, b.y), simd8f_min(a.z, b.z), simd8f_min(a.w, b.w) );
+    }
+
+    vectorial_inline vec4f_soa8 max(const vec4f_soa8& a, const vec4f_soa8& b) {
+        return vec4f_soa8( simd8f_max(a.x, b.x), simd8f_max(a.y, b.y), simd8f_max(a.z, b.z), simd8f_max(a.w, b.w) );
+    }
+
+}
+
+
+namespace std {
+    inline ::vectorial::vec4f_soa8 min(const ::vectorial::vec4f_soa8& a, const ::vectorial::vec4f_soa8& b) { return ::vectorial::min(a,b); }
+    inline ::vectorial::vec4f_soa8 max(const ::vectorial::vec4f_soa8& a, const ::vectorial::vec4f_soa8& b) { return ::vectorial::max(a,b); }
+}
+
+
+#ifdef VECTORIAL_OSTREAM
+#include <ostream>
+
+vectorial_inline std::ostream& operator<<(std::ostream& os, const vectorial::vec4f_soa8& v) {
+    os << "[ " << v.x << ", "
+               << v.y << ", "
+               << v.z << ", "
+               << v.w << " ]";
+    return os;
+}
+#endif
+
+
+
+#endif
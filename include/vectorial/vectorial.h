@@ -11,6 +11,12 @@
 #include "vectorial/vec3f.h"
 #include "vectorial/vec4f.h"
 
+#include "vectorial/vec3f_soa4.h"
+#include "vectorial/vec4f_soa4.h"
+
+// The 8-wide vec3f_soa8.h and vec4f_soa8.h pull in simd8f, include them
+// directly when needed
+
 #include "vectorial/vec_convert.h"
 
 #include "vectorial/mat4f.h"
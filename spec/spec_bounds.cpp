@@ -0,0 +1,151 @@
+#include "spec_fixtures.h"
+#include "vectorial/bounds.h"
+#include <float.h>
+using vectorial::vec3f;
+using vectorial::vec4f;
+using vectorial::bounds;
+using vectorial::centroid;
+using vectorial::boundingSphere;
+
+const int epsilon = 1;
+
+namespace {
+
+    const size_t count = 71;
+
+    // Off the origin, with every seventh point repeating the one before
+    vec3f test_point(size_t i) {
+        const size_t j = i % 7 == 6 ? i - 1 : i;
+        return scattered(j) * vec3f(20.0f, 5.0f, 50.0f) + vec3f(0.0f, -3.0f, -100.0f);
+    }
+
+    void fill(vec3f* points, float* packed, size_t n) {
+        for(size_t i = 0; i < n; ++i) {
+            points[i] = test_point(i);
+            points[i].store(packed + 3*i);
+        }
+    }
+
+    bool inside(const vec4f& sphere, const vec3f& p) {
+        return length(p - sphere.xyz()) <= sphere.w() * 1.0001f;
+    }
+
+}
+
+describe(bounds, "aabb") {
+
+    it("should have bounds give the min and max of any number of points") {
+        vec3f points[count];
+        float packed[3 * count];
+        fill(points, packed, count);
+
+        for(size_t n = 0; n <= count; ++n) {
+            vec3f lo(FLT_MAX), hi(-FLT_MAX);
+            for(size_t i = 0; i < n; ++i) {
+                lo = min(lo, points[i]);
+                hi = max(hi, points[i]);
+            }
+
+            vec3f a, b;
+            bounds(points, n, a, b);
+            should_be_equal_vec3f(a, lo, 0);
+            should_be_equal_vec3f(b, hi, 0);
+            should_equal( simd4f_get_w(a.value), 0.0f );
+
+            bounds(packed, n, a, b);
+            should_be_equal_vec3f(a, lo, 0);
+            should_be_equal_vec3f(b, hi, 0);
+            should_equal( simd4f_get_w(b.value), 0.0f );
+        }
+    }
+
+}
+
+describe(bounds, "centroid") {
+
+    it("should have centroid give the average of any number of points") {
+        vec3f points[count];
+        float packed[3 * count];
+        fill(points, packed, count);
+
+        should_be_equal_vec3f( centroid(points, 0), vec3f(0, 0, 0), epsilon );
+        should_be_equal_vec3f( centroid(packed, 0), vec3f(0, 0, 0), epsilon );
+
+        for(size_t n = 1; n <= count; ++n) {
+            double x = 0, y = 0, z = 0;
+            for(size_t i = 0; i < n; ++i) {
+                x += points[i].x(); y += points[i].y(); z += points[i].z();
+            }
+            const vec3f expected( float(x / n), float(y / n), float(z / n) );
+            should_be_true( length(centroid(points, n) - expected) < 1e-4f );
+            should_be_true( length(centroid(packed, n) - expected) < 1e-4f );
+        }
+    }
+
+}
+
+describe(bounds, "bounding sphere") {
+
+    it("should find the sphere through opposite points") {
+        const vec3f axes[6] = { vec3f(3, 1, 1), vec3f(-1, 1, 1), vec3f(1, 3, 1),
+                                vec3f(1, -1, 1), vec3f(1, 1, 3), vec3f(1, 1, -1) };
+        const vec4f s = boundingSphere(axes, 6);
+        should_be_equal_vec3f( s.xyz(), vec3f(1, 1, 1), 8 );
+        should_be_close_to( s.w(), 2.0f, 8 );
+
+        const vec4f one = boundingSphere(axes, 1);
+        should_be_equal_vec4f( one, vec4f(3, 1, 1, 0), epsilon );
+        should_be_equal_vec4f( boundingSphere(axes, 0), vec4f(0, 0, 0, 0), epsilon );
+    }
+
+    it("should handle a repeated point, a line and a plane") {
+        const vec3f p(2.5f, -1.0f, 7.0f);
+        vec3f same[9];
+        for(size_t i = 0; i < 9; ++i) same[i] = p;
+        vec3f a, b;
+        bounds(same, 9, a, b);
+        should_be_equal_vec3f(a, p, 0);
+        should_be_equal_vec3f(b, p, 0);
+        should_be_equal_vec3f( centroid(same, 9), p, epsilon );
+        should_be_equal_vec4f( boundingSphere(same, 9), vec4f(2.5f, -1.0f, 7.0f, 0.0f), epsilon );
+
+        // On the line from (-3, 1, 2) to (5, 5, -6), out of order
+        vec3f line[9];
+        for(size_t i = 0; i < 9; ++i) line[i] = vec3f(-3, 1, 2) + vec3f(1, 0.5f, -1) * float((i * 5) % 9);
+        bounds(line, 9, a, b);
+        should_be_equal_vec3f(a, vec3f(-3, 1, -6), 0);
+        should_be_equal_vec3f(b, vec3f(5, 5, 2), 0);
+        const vec4f s = boundingSphere(line, 9);
+        should_be_equal_vec3f( s.xyz(), vec3f(1, 3, -2), 8 );
+        should_be_close_to( s.w(), 6.0f, 8 );
+
+        // On the plane z = 4, the box has no depth
+        vec3f flat[count];
+        for(size_t i = 0; i < count; ++i) flat[i] = test_point(i) * vec3f(1, 1, 0) + vec3f(0, 0, 4);
+        bounds(flat, count, a, b);
+        should_equal( a.z(), 4.0f );
+        should_equal( b.z(), 4.0f );
+        const vec4f fs = boundingSphere(flat, count);
+        for(size_t i = 0; i < count; ++i) should_be_true( inside(fs, flat[i]) );
+    }
+
+    it("should contain every point and touch the cloud") {
+        vec3f points[count];
+        float packed[3 * count];
+        fill(points, packed, count);
+
+        for(size_t n = 1; n <= count; ++n) {
+            const vec4f a = boundingSphere(points, n);
+            const vec4f b = boundingSphere(packed, n);
+            should_be_equal_vec4f( a, b, epsilon );
+
+            float farthest = 0;
+            for(size_t i = 0; i < n; ++i) {
+                should_be_true( inside(a, points[i]) );
+                farthest = std::max( farthest, length(points[i] - a.xyz()) );
+            }
+            should_be_close_to( farthest, a.w(), 64 );
+        }
+    }
+
+}
@@ -0,0 +1,34 @@
+#ifndef VECTORIAL_SPEC_FIXTURES_H
+#define VECTORIAL_SPEC_FIXTURES_H
+
+#include "spec_helper.h"
+
+// Inputs shared between the specs
+
+// Translation, rotation and a non-uniform scale, so nothing is orthogonal
+static inline vectorial::mat4f skewed() {
+    using vectorial::vec3f;
+    using vectorial::mat4f;
+    return mat4f::translation(vec3f(-4, 0.5f, 2)) * mat4f::axisRotation(1.3f, normalize(vec3f(0, 1, 1)))
+         * mat4f::scale(vec3f(2, 0.5f, 3));
+}
+
+// Invertible and different for each i, repeating every 13 so long arrays
+// stay small
+static inline simd4x4f test_matrix(size_t i) {
+    const float f = float(i % 13);
+    return simd4x4f_create( simd4f_create(1+f, 2, 3, 4),
+                            simd4f_create(5, 6-f, 7, 8),
+                            simd4f_create(9, 10, 11+f, 12),
+                            simd4f_create(13, 14, 15, 16-f) );
+}
+
+// The i:th of a deterministic scatter over [-1, 1]^3, the frequencies
+// don't share periods so consecutive samples don't line up
+static inline vectorial::vec3f scattered(size_t i) {
+    const float f = float(i);
+    return vectorial::vec3f( sinf(f), cosf(1.3f * f), sinf(0.7f * f) );
+}
+
+
+#endif
@@ -0,0 +1,224 @@
+#include "spec_fixtures.h"
+#include "vectorial/frustumf.h"
+using vectorial::vec3f;
+using vectorial::vec4f;
+using vectorial::mat4f;
+using vectorial::frustumf;
+
+const int epsilon = 1;
+
+namespace {
+
+    const size_t count = 71;
+
+    // 90 degrees, square, looking down -z from the origin
+    frustumf test_frustum() {
+        return frustumf( mat4f::perspective(VECTORIAL_HALFPI, 1.0f, 1.0f, 100.0f) );
+    }
+
+    // Axis aligned planes, x and y in -10..10, z in -1..-100
+    frustumf test_box_frustum() {
+        return frustumf( mat4f::ortho(-10.0f, 10.0f, -10.0f, 10.0f, 1.0f, 100.0f) );
+    }
+
+    // Spread around the frustum, inside, outside and across the planes
+    vec4f test_sphere(size_t i) {
+        const vec3f s = scattered(i);
+        return vec4f( 7.0f * s.x(), 5.0f * s.y(), -50.0f + 60.0f * s.z(), 0.5f + float(i % 4) );
+    }
+
+    // Boxes touching each plane of f from outside and inside with a face,
+    // an edge and a single point, plus boxes flat on it. Coordinates on the
+    // plane come from the plane itself, so rounding puts them on either side.
+    size_t boundary_boxes(const frustumf& f, vec3f* lo, vec3f* hi) {
+        size_t n = 0;
+        for(int i = 0; i < SIMD4F_FRUSTUM_PLANES; ++i) {
+            const vec4f p = f.plane(i);
+            const vec3f a( fabsf(p.x()), fabsf(p.y()), fabsf(p.z()) );
+            const int k = a.x() >= a.y() && a.x() >= a.z() ? 0 : (a.y() >= a.z() ? 1 : 2);
+            const vec3f axis = k == 0 ? vec3f(1, 0, 0) : (k == 1 ? vec3f(0, 1, 0) : vec3f(0, 0, 1));
+            const vec3f across = vec3f(1, 1, 1) - axis;
+            // A point on the plane along the axis of its normal from the
+            // middle of the frustum
+            const vec3f mid(0, 0, -50);
+            const float n_k = dot(p.xyz(), axis);
+            const float t = -(dot(p.xyz(), mid * across) + p.w()) / n_k;
+            const vec3f on = mid * across + axis * t;
+            const vec3f out = axis * (n_k > 0 ? -1.0f : 1.0f);
+
+            const float sizes[] = { 0.0f, 0.5f, 3.0f };
+            for(int j = 0; j < 3; ++j) {
+                const vec3f e = across * sizes[j];
+                // Face on the plane, outside and inside
+                lo[n] = min(on - e, on + e + out); hi[n] = max(on - e, on + e + out); ++n;
+                lo[n] = min(on - e, on + e - out); hi[n] = max(on - e, on + e - out); ++n;
+                // Flat on the plane
+                lo[n] = on - e; hi[n] = on + e; ++n;
+            }
+        }
+        return n;
+    }
+
+}
+
+describe(frustumf, "planes") {
+
+    it("should extract normalized planes pointing inside from a view projection") {
+        frustumf f = test_frustum();
+        should_be_near_simd4f( f.plane(SIMD4F_FRUSTUM_NEAR).value, simd4f_create(0, 0, -1, -1), 1e-5f );
+        should_be_near_simd4f( f.plane(SIMD4F_FRUSTUM_FAR).value, simd4f_create(0, 0, 1, 100), 1e-3f );
+        const float h = sqrtf(0.5f);
+        should_be_near_simd4f( f.plane(SIMD4F_FRUSTUM_LEFT).value, simd4f_create(h, 0, -h, 0), 1e-5f );
+        should_be_near_simd4f( f.plane(SIMD4F_FRUSTUM_TOP).value, simd4f_create(0, -h, -h, 0), 1e-5f );
+    }
+
+    it("should follow the view in the matrix") {
+        // Camera at z 10 looking back towards the origin
+        mat4f view = mat4f::lookAt(vec3f(0, 0, 10), vec3f(0, 0, 0), vec3f(0, 1, 0));
+        frustumf f( mat4f::perspective(VECTORIAL_HALFPI, 1.0f, 1.0f, 100.0f) * view );
+        should_be_true( isVisible(f, vec4f(0, 0, 0, 0.1f)) );
+        should_be_false( isVisible(f, vec4f(0, 0, 20, 0.1f)) );
+    }
+
+}
+
+describe(frustumf, "visibility") {
+
+    it("should test spheres against every plane") {
+        frustumf f = test_frustum();
+        should_be_true( isVisible(f, vec4f(0, 0, -10, 1)) );
+        should_be_false( isVisible(f, vec4f(0, 0, 10, 1)) );
+        should_be_true( isVisible(f, vec4f(0, 0, -0.5f, 0.6f)) );
+        should_be_false( isVisible(f, vec4f(0, 0, -0.5f, 0.4f)) );
+        should_be_false( isVisible(f, vec4f(20, 0, -10, 5)) );
+        should_be_true( isVisible(f, vec4f(20, 0, -10, 8)) );
+        should_be_false( isVisible(f, vec4f(0, 0, -110, 5)) );
+    }
+
+    it("should test boxes by their center and extents") {
+        frustumf f = test_frustum();
+        should_be_true( isVisible(f, vec3f(-1, -1, -11), vec3f(1, 1, -9)) );
+        should_be_false( isVisible(f, vec3f(-1, -1, 9), vec3f(1, 1, 11)) );
+        should_be_true( isVisible(f, vec3f(9, -1, -10), vec3f(11, 1, -5)) );
+        should_be_false( isVisible(f, vec3f(11, -1, -10), vec3f(13, 1, -5)) );
+        should_be_true( isVisible(f, vec3f(-200, -200, -200), vec3f(200, 200, 200)) );
+    }
+
+    it("should see boxes that reach into the frustum however thin") {
+        frustumf f = test_box_frustum();
+        should_be_true( isVisible(f, vec3f(0, 0, -50), vec3f(0, 0, -50)) );
+        should_be_true( isVisible(f, vec3f(-20, 0, -50), vec3f(20, 0, -50)) );
+        should_be_true( isVisible(f, vec3f(-20, -20, -50), vec3f(20, 20, -50)) );
+        should_be_false( isVisible(f, vec3f(11, 0, -50), vec3f(11, 0, -50)) );
+        should_be_false( isVisible(f, vec3f(-20, -20, -0.5f), vec3f(20, 20, -0.5f)) );
+    }
+
+}
+
+describe(frustumf, "array kernels") {
+
+    it("should have cullSpheres and compactSpheres agree with isVisible for any count") {
+        frustumf f = test_frustum();
+        vec4f spheres[count];
+        bool expected[count];
+        size_t visible_count = 0;
+        for(size_t i = 0; i < count; ++i) {
+            spheres[i] = test_sphere(i);
+            expected[i] = isVisible(f, spheres[i]);
+            if( expected[i] ) ++visible_count;
+        }
+        should_be_true( visible_count > 5 && visible_count < count - 5 );
+
+        uint32_t bits[4];
+        uint32_t indices[count];
+        for(size_t n = 0; n <= count; ++n) {
+            for(int w = 0; w < 4; ++w) bits[w] = 0xdeadbeef;
+            cullSpheres(f, spheres, n, bits);
+            for(size_t i = 0; i < (n + 31) / 32 * 32; ++i) {
+                const bool bit = (bits[i / 32] >> (i % 32)) & 1;
+                should_be_true( bit == (i < n && expected[i]) );
+            }
+            should_equal( bits[(n + 31) / 32], 0xdeadbeef );
+
+            const size_t c = compactSpheres(f, spheres, n, indices);
+            size_t e = 0;
+            for(size_t i = 0; i < n; ++i) {
+                if( !expected[i] ) continue;
+                should_be_true( e < c && indices[e] == i );
+                ++e;
+            }
+            should_equal( c, e );
+        }
+    }
+
+    it("should have cullBoxes and compactBoxes agree with isVisible for any count") {
+        frustumf f = test_frustum();
+        vec3f lo[count], hi[count];
+        bool expected[count];
+        for(size_t i = 0; i < count; ++i) {
+            const vec4f s = test_sphere(i);
+            // Every fifth one flat or a single point
+            const vec3f e = vec3f(0.5f, i % 5 == 1 ? 0.0f : 1.0f, i % 5 == 2 ? 0.0f : 2.0f) * s.w();
+            lo[i] = s.xyz() - e;
+            hi[i] = s.xyz() + e;
+            expected[i] = isVisible(f, lo[i], hi[i]);
+        }
+
+        uint32_t bits[3];
+        uint32_t indices[count];
+        for(size_t n = 0; n <= count; ++n) {
+            cullBoxes(f, lo, hi, n, bits);
+            for(size_t i = 0; i < n; ++i) {
+                const bool bit = (bits[i / 32] >> (i % 32)) & 1;
+                should_be_true( bit == expected[i] );
+            }
+
+            const size_t c = compactBoxes(f, lo, hi, n, indices);
+            size_t e = 0;
+            for(size_t i = 0; i < n; ++i) {
+                if( !expected[i] ) continue;
+                should_be_true( e < c && indices[e] == i );
+                ++e;
+            }
+            should_equal( c, e );
+        }
+    }
+
+    it("should have isVisible and the array kernels agree on boxes touching the planes") {
+        const frustumf frusta[] = { test_frustum(), test_box_frustum() };
+        for(int j = 0; j < 2; ++j) {
+            const frustumf& f = frusta[j];
+            vec3f lo[54], hi[54];
+            const size_t n = boundary_boxes(f, lo, hi);
+            uint32_t bits[2];
+            uint32_t indices[54];
+            cullBoxes(f, lo, hi, n, bits);
+            const size_t c = compactBoxes(f, lo, hi, n, indices);
+            size_t e = 0;
+            for(size_t i = 0; i < n; ++i) {
+                const bool visible = isVisible(f, lo[i], hi[i]);
+                should_be_true( ((bits[i / 32] >> (i % 32)) & 1) == visible );
+                if( visible ) should_be_true( e < c && indices[e++] == i );
+            }
+            should_equal( c, e );
+        }
+    }
+
+    it("should have isVisible and the array kernels agree on spheres touching the planes") {
+        const frustumf frusta[] = { test_frustum(), test_box_frustum() };
+        for(int j = 0; j < 2; ++j) {
+            const frustumf& f = frusta[j];
+            vec3f lo[54], hi[54];
+            const size_t n = boundary_boxes(f, lo, hi);
+            // Centered on a box corner, reaching to the plane or not at all
+            vec4f spheres[54];
+            for(size_t i = 0; i < n; ++i) spheres[i] = vec4f(lo[i].x(), lo[i].y(), lo[i].z(), float(i % 3) * 0.5f);
+            uint32_t bits[2];
+            cullSpheres(f, spheres, n, bits);
+            for(size_t i = 0; i < n; ++i) {
+                should_be_true( bool((bits[i / 32] >> (i % 32)) & 1) == isVisible(f, spheres[i]) );
+            }
+        }
+    }
+
+}
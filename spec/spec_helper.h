@@ -6,6 +6,12 @@
 #include "spec.h"
 
 #include "vectorial/vectorial.h"
+#include "vectorial/simd8f.h"
+#include "vectorial/vec3f_soa8.h"
+#include "vectorial/vec4f_soa8.h"
+#include "vectorial/simd4i.h"
+#include "vectorial/simd4d.h"
+#include "vectorial/simd3x3f.h"
 
 #ifdef VECTORIAL_HAVE_SIMD2F
 #include "vectorial/simd2f.h"
@@ -17,6 +23,9 @@
 
 #define should_be_close_to(a,b,tolerance) should_be_close_to_(this, a,b,tolerance,__FILE__,__LINE__)
 #define should_be_equal_simd4f( a, b, tolerance) should_be_equal_simd4f_(this, a,b,tolerance,__FILE__,__LINE__)
+#define should_be_equal_simd4i( a, b) should_be_equal_simd4i_(this, a,b,__FILE__,__LINE__)
+#define should_be_equal_simd4d( a, b, tolerance) should_be_equal_simd4d_(this, a,b,tolerance,__FILE__,__LINE__)
+#define should_be_equal_simd8f( a, b, tolerance) should_be_equal_simd8f_(this, a,b,tolerance,__FILE__,__LINE__)
 #define should_be_equal_simd2f( a, b, tolerance) should_be_equal_simd2f_(this, a,b,tolerance,__FILE__,__LINE__)
 #define should_be_equal_vec4f( a, b, tolerance) should_be_equal_vec4f_(this, a,b,tolerance,__FILE__,__LINE__)
 #define should_be_equal_vec3f( a, b, tolerance) should_be_equal_vec3f_(this, a,b,tolerance,__FILE__,__LINE__)
@@ -26,6 +35,10 @@
 
 #define should_be_equal_mat4f( a, b, tolerance) should_be_equal_mat4f_(this, a,b,tolerance,__FILE__,__LINE__)
 
+#define should_be_near_simd4f( a, b, tolerance) should_be_near_simd4f_(this, a,b,tolerance,__FILE__,__LINE__)
+#define should_be_near_simd4x4f( a, b, tolerance) should_be_near_simd4x4f_(this, a,b,tolerance,__FILE__,__LINE__)
+#define should_be_near_simd3x3f( a, b, tolerance) should_be_near_simd3x3f_(this, a,b,tolerance,__FILE__,__LINE__)
+
 // Based on:
 // http://www.cygnus-software.com/papers/comparingfloats/comparingfloats.htm
 // 
@@ -104,6 +117,84 @@ static inline void should_be_equal_simd4f_(specific::SpecBase *spec, const simd4
     spec->should_test(equal, ss.str().c_str(), file, line);
     
     
+}
+
+// Within an absolute distance, for results landing on exact zeros that
+// ulps can't compare
+static inline bool near_simd4f(const simd4f& a, const simd4f& b, float tolerance) {
+    const simd4f d = simd4f_sub(a, b);
+    return simd4f_get_x( simd4f_dot4(d, d) ) <= tolerance * tolerance;
+}
+
+static inline void should_be_near_simd4f_(specific::SpecBase *spec, const simd4f& a, const simd4f& b, float tolerance, const char *file, int line) {
+
+    std::stringstream ss;
+    ss << a << " == " << b << " (within " << tolerance << ")";
+    spec->should_test(near_simd4f(a, b, tolerance), ss.str().c_str(), file, line);
+
+}
+
+static inline void should_be_equal_simd4i_(specific::SpecBase *spec, const simd4i& a, const simd4i& b, const char *file, int line) {
+
+    bool equal = simd4i_get_x(a) == simd4i_get_x(b) && simd4i_get_y(a) == simd4i_get_y(b) &&
+                 simd4i_get_z(a) == simd4i_get_z(b) && simd4i_get_w(a) == simd4i_get_w(b);
+
+    std::stringstream ss;
+    ss << a << " == " << b;
+    spec->should_test(equal, ss.str().c_str(), file, line);
+
+}
+
+// compare_floats for doubles, with the ordering done in 64 bits
+static inline bool compare_doubles(double A, double B, long long maxUlps)
+{
+    union {
+        double d;
+        long long i;
+    } d2iA, d2iB;
+    d2iA.d = A;
+    d2iB.d = B;
+
+    long long aInt = d2iA.i;
+    if (aInt < 0)
+        aInt = (long long)0x8000000000000000ULL - aInt;
+    long long bInt = d2iB.i;
+    if (bInt < 0)
+        bInt = (long long)0x8000000000000000ULL - bInt;
+    long long intDiff = aInt > bInt ? aInt - bInt : bInt - aInt;
+    return intDiff <= maxUlps;
+}
+
+static inline void should_be_equal_simd4d_(specific::SpecBase *spec, const simd4d& a, const simd4d& b, int tolerance, const char *file, int line) {
+
+    bool equal = compare_doubles(simd4d_get_x(a), simd4d_get_x(b), tolerance) &&
+                 compare_doubles(simd4d_get_y(a), simd4d_get_y(b), tolerance) &&
+                 compare_doubles(simd4d_get_z(a), simd4d_get_z(b), tolerance) &&
+                 compare_doubles(simd4d_get_w(a), simd4d_get_w(b), tolerance);
+
+    std::stringstream ss;
+    ss.precision(17);
+    ss << a << " == " << b << " (with tolerance of " << tolerance << ")";
+    spec->should_test(equal, ss.str().c_str(), file, line);
+
+}
+
+static inline void should_be_equal_simd8f_(specific::SpecBase *spec, const simd8f& a, const simd8f& b, int tolerance, const char *file, int line) {
+    
+    float fa[8], fb[8];
+    simd8f_ustore8(a, fa);
+    simd8f_ustore8(b, fb);
+
+    bool equal=true;
+    for(int i = 0; i < 8; ++i) {
+        if( !compare_floats( fa[i], fb[i], tolerance) ) equal = false;
+    }
+    
+    std::stringstream ss;
+    ss << a << " == " << b << " (with tolerance of " << tolerance << ")";
+    spec->should_test(equal, ss.str().c_str(), file, line);
+    
+    
 }
 
 static inline void should_be_equal_vec4f_(specific::SpecBase *spec, const vectorial::vec4f& a, const vectorial::vec4f& b, int tolerance, const char *file, int line) {
@@ -180,6 +271,28 @@ static inline void should_be_equal_simd4x4f_(specific::SpecBase *spec, const sim
     
 }
 
+static inline void should_be_near_simd4x4f_(specific::SpecBase *spec, const simd4x4f& a, const simd4x4f& b, float tolerance, const char *file, int line) {
+
+    bool equal = near_simd4f(a.x, b.x, tolerance) && near_simd4f(a.y, b.y, tolerance) &&
+                 near_simd4f(a.z, b.z, tolerance) && near_simd4f(a.w, b.w, tolerance);
+
+    std::stringstream ss;
+    ss << a << " == " << b << " (within " << tolerance << ")";
+    spec->should_test(equal, ss.str().c_str(), file, line);
+
+}
+
+static inline void should_be_near_simd3x3f_(specific::SpecBase *spec, const simd3x3f& a, const simd3x3f& b, float tolerance, const char *file, int line) {
+
+    bool equal = near_simd4f(a.x, b.x, tolerance) && near_simd4f(a.y, b.y, tolerance) &&
+                 near_simd4f(a.z, b.z, tolerance);
+
+    std::stringstream ss;
+    ss << a << " == " << b << " (within " << tolerance << ")";
+    spec->should_test(equal, ss.str().c_str(), file, line);
+
+}
+
 static inline void should_be_equal_mat4f_(specific::SpecBase *spec, const vectorial::mat4f& a, const vectorial::mat4f& b, int tolerance, const char *file, int line) {
                                                                         
     bool equal=true;                                                    
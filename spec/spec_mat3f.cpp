@@ -0,0 +1,77 @@
+#include "spec_helper.h"
+#include "spec_fixtures.h"
+#include "vectorial/mat3f.h"
+using vectorial::vec3f;
+using vectorial::mat4f;
+using vectorial::mat3f;
+
+const int epsilon = 1;
+const float tolerance = 1e-5f;
+
+describe(simd3x3f, "3x3 matrix math") {
+
+    it("should have simd3x3f_uload reading columns") {
+        const float f[9] = { 1, 2, 3,  4, 5, 6,  7, 8, 9 };
+        simd3x3f m;
+        simd3x3f_uload(&m, f);
+        should_be_equal_simd4f(m.y, simd4f_create(4, 5, 6, 0), epsilon);
+
+        float out[9];
+        simd3x3f_ustore(&m, out);
+        for(int i = 0; i < 9; ++i) should_be_close_to(out[i], f[i], epsilon);
+    }
+
+    it("should have simd3x3f_matrix_mul and simd3x3f_transpose") {
+        simd3x3f a = simd3x3f_create( simd4f_create(1, 4, 7, 0),
+                                      simd4f_create(2, 5, 8, 0),
+                                      simd4f_create(3, 6, 10, 0) );
+        simd3x3f b = simd3x3f_create( simd4f_create(2, 0, 1, 0),
+                                      simd4f_create(-1, 3, 0, 0),
+                                      simd4f_create(0, 1, -2, 0) );
+
+        simd3x3f x;
+        simd3x3f_matrix_mul(&a, &b, &x);
+        // octave: [1,2,3;4,5,6;7,8,10] * [2,-1,0;0,3,1;1,0,-2]
+        should_be_equal_simd4f(x.x, simd4f_create(5, 14, 24, 0), epsilon);
+        should_be_equal_simd4f(x.y, simd4f_create(5, 11, 17, 0), epsilon);
+        should_be_equal_simd4f(x.z, simd4f_create(-4, -7, -12, 0), epsilon);
+
+        simd3x3f_transpose(&a, &x);
+        should_be_equal_simd4f(x.x, simd4f_create(1, 2, 3, 0), epsilon);
+        should_be_equal_simd4f(x.z, simd4f_create(7, 8, 10, 0), epsilon);
+
+        should_be_close_to( simd4f_get_x(simd3x3f_determinant(&a)), -3.0f, epsilon );
+    }
+
+}
+
+describe(mat3f, "inverse and normal matrix") {
+
+    it("should invert") {
+        const mat3f m(skewed());
+        should_be_close_to( determinant(m), 3.0f, 4 );
+        should_be_near_simd3x3f( (inverse(m) * m).value, mat3f::identity().value, tolerance );
+        should_be_near_simd3x3f( (m * inverse(m)).value, mat3f::identity().value, tolerance );
+    }
+
+    it("should have normalMatrix matching the 4x4 inverse transpose") {
+        const mat4f a = skewed();
+        const mat3f expected( transpose(inverse(a)) );
+        should_be_near_simd3x3f( normalMatrix(a).value, expected.value, tolerance );
+
+        // Normals stay perpendicular to transformed tangents
+        vec3f n = normalize(vec3f(1, 2, 3));
+        vec3f t = cross(n, vec3f(0, 0, 1));
+        float d = dot( normalMatrix(a) * n, transformVector(a, t) );
+        should_be_true( d < tolerance && d > -tolerance );
+    }
+
+    it("should match mat4f for rotations") {
+        vec3f axis = normalize(vec3f(1, -2, 3));
+        const mat3f r = mat3f::axisRotation(0.7f, axis);
+        vec3f v(3, -4, 5);
+        should_be_near_simd4f( (r * v).value, transformVector(mat4f::axisRotation(0.7f, axis), v).value, 4 * tolerance );
+        should_be_near_simd3x3f( transpose(r).value, inverse(r).value, tolerance );
+    }
+
+}
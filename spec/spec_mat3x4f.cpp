@@ -0,0 +1,102 @@
+#include "spec_helper.h"
+#include "spec_fixtures.h"
+#include "vectorial/mat3x4f.h"
+#include "vectorial/mat4f_array.h"
+using vectorial::vec3f;
+using vectorial::mat4f;
+using vectorial::mat3x4f;
+
+const int epsilon = 1;
+const float tolerance = 1e-5f;
+
+static mat3x4f rigid() {
+    return mat3x4f::translation(vec3f(1, -2, 3)) * mat3x4f::axisRotation(0.7f, normalize(vec3f(1, 2, -1)));
+}
+
+describe(simd4x3f, "affine rows") {
+
+    it("should have simd4x3f_uload reading rows") {
+        const float f[12] = { 1, 2, 3, 4,  5, 6, 7, 8,  9, 10, 11, 12 };
+        simd4x3f m;
+        simd4x3f_uload(&m, f);
+        should_be_equal_simd4f(m.y, simd4f_create(5, 6, 7, 8), epsilon);
+
+        float out[12];
+        simd4x3f_ustore(&m, out);
+        for(int i = 0; i < 12; ++i) should_be_close_to(out[i], f[i], epsilon);
+    }
+
+    it("should round trip through simd4x4f") {
+        const mat4f a = skewed();
+        simd4x3f m;
+        simd4x3f_from_simd4x4f(&a.value, &m);
+        should_be_equal_simd4f(m.x, simd4f_create( simd4f_get_x(a.value.x), simd4f_get_x(a.value.y),
+                                                  simd4f_get_x(a.value.z), simd4f_get_x(a.value.w) ), epsilon);
+
+        simd4x4f back;
+        simd4x3f_to_simd4x4f(&m, &back);
+        should_be_near_simd4x4f( mat4f(back).value, a.value, 0 );
+    }
+
+    it("should have simd4x3f_matrix_point3_mul and simd4x3f_matrix_vector3_mul") {
+        simd4x3f m = simd4x3f_create( simd4f_create(0, -1, 0, 1),
+                                      simd4f_create(1,  0, 0, 2),
+                                      simd4f_create(0,  0, 2, 3) );
+        simd4f b = simd4f_create(5, 6, 7, 9);
+
+        simd4f x;
+        simd4x3f_matrix_point3_mul(&m, &b, &x);
+        should_be_equal_simd4f(x, simd4f_create(-5, 7, 17, 1), epsilon);
+
+        simd4x3f_matrix_vector3_mul(&m, &b, &x);
+        should_be_equal_simd4f(x, simd4f_create(-6, 5, 14, 0), epsilon);
+    }
+
+}
+
+describe(mat3x4f, "affine transforms") {
+
+    it("should multiply like mat4f") {
+        const mat4f a = skewed();
+        const mat4f b = toMat4f(rigid());
+        should_be_near_simd4x4f( toMat4f(mat3x4f(a) * mat3x4f(b)).value, (a * b).value, 4 * tolerance );
+
+        mat3x4f c(a);
+        c *= mat3x4f(b);
+        should_be_near_simd4x4f( toMat4f(c).value, (a * b).value, 4 * tolerance );
+    }
+
+    it("should transform points and vectors like mat4f") {
+        const mat4f a = skewed();
+        const mat3x4f m(a);
+        vec3f v(3, -4, 5);
+        should_be_near_simd4f( transformPoint(m, v).value, transformPoint(a, v).value, 4 * tolerance );
+        should_be_near_simd4f( transformVector(m, v).value, transformVector(a, v).value, 4 * tolerance );
+
+        vec3f in[5] = { vec3f(1, 2, 3), vec3f(-1, 0, 4), vec3f(0, 0, 0), vec3f(7, -8, 9), v };
+        vec3f out[5];
+        transformPoints(m, in, out, 5);
+        for(int i = 0; i < 5; ++i) should_be_near_simd4f( out[i].value, transformPoint(a, in[i]).value, 4 * tolerance );
+        transformVectors(m, in, out, 5);
+        for(int i = 0; i < 5; ++i) should_be_near_simd4f( out[i].value, transformVector(a, in[i]).value, 4 * tolerance );
+    }
+
+    it("should have inverse matching the mat4f inverse") {
+        const mat4f a = skewed();
+        const mat3x4f inv = inverse(mat3x4f(a));
+        should_be_near_simd4x4f( toMat4f(inv).value, inverse(a).value, 4 * tolerance );
+        should_be_near_simd4x4f( toMat4f(inv * mat3x4f(a)).value, mat4f::identity().value, 4 * tolerance );
+
+        const mat3x4f m(a);
+        simd4x3f x;
+        simd4f det = simd4x3f_inverse(&m.value, &x);
+        should_be_close_to( simd4f_get_x(det), 3.0f, 4 );
+    }
+
+    it("should have orthoInverse for rotation and translation") {
+        const mat3x4f m = rigid();
+        should_be_near_simd4x4f( toMat4f(orthoInverse(m)).value, inverse(toMat4f(m)).value, 4 * tolerance );
+        should_be_near_simd4x4f( toMat4f(orthoInverse(m) * m).value, mat4f::identity().value, 4 * tolerance );
+    }
+
+}
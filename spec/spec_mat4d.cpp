@@ -0,0 +1,105 @@
+#include "spec_helper.h"
+#include "vectorial/mat4d.h"
+using vectorial::vec4f;
+using vectorial::vec3f;
+using vectorial::mat4f;
+using vectorial::vec4d;
+using vectorial::vec3d;
+using vectorial::mat4d;
+
+const int epsilon = 1;
+
+describe(vec3d, "constructing and arithmetic") {
+
+    it("should have the vec3f constructors and accessors") {
+        vec3d a(1, 2, 3);
+        should_equal( a.x(), 1.0 );
+        should_equal( a.y(), 2.0 );
+        should_equal( a.z(), 3.0 );
+
+        double ary[3] = { 4, 5, 6 };
+        should_be_equal_simd4d( vec3d(ary).value, simd4d_create(4, 5, 6, 0), epsilon );
+        should_be_equal_simd4d( vec3d(vec3f(1.5f, 2, 3)).value, simd4d_create(1.5, 2, 3, 0), epsilon );
+    }
+
+    it("should have operators, dot, cross and length") {
+        vec3d a(1, 2, 3);
+        vec3d b(4, 5, 6);
+        should_be_equal_simd4d( (a + b).value, simd4d_create(5, 7, 9, 0), epsilon );
+        should_be_equal_simd4d( (b - a).value, simd4d_create(3, 3, 3, 0), epsilon );
+        should_be_equal_simd4d( (a * 2.0).value, simd4d_create(2, 4, 6, 0), epsilon );
+        should_be_equal_simd4d( (-a).value, simd4d_create(-1, -2, -3, 0), epsilon );
+        should_equal( dot(a, b), 32.0 );
+        should_be_equal_simd4d( cross(a, b).value, simd4d_create(-3, 6, -3, 0), epsilon );
+        should_equal( length(vec3d(3, 0, 4)), 5.0 );
+        should_be_equal_simd4d( normalize(vec3d(0, 3, 4)).value, simd4d_create(0, 0.6, 0.8, 0), epsilon );
+    }
+
+    it("should convert to float relative to an origin") {
+        vec3d origin(6.4e6, -6.4e6, 1e7);
+        vec3d p = origin + vec3d(0.001, 0.25, -0.5);
+        should_be_equal_vec3f( relativeToFloat(p, origin), vec3f(0.001f, 0.25f, -0.5f), 64 );
+
+        // Rounding first loses the offset completely
+        should_be_true( toFloat(p).x() - toFloat(origin).x() == 0.0f );
+
+        vec3d points[3] = { origin + vec3d(1, 0, 0), origin + vec3d(0, 0.125, 0), origin };
+        vec3f out[3];
+        relativeToFloat(points, origin, out, 3);
+        should_be_equal_vec3f( out[0], vec3f(1, 0, 0), epsilon );
+        should_be_equal_vec3f( out[1], vec3f(0, 0.125f, 0), epsilon );
+        should_be_equal_vec3f( out[2], vec3f(0, 0, 0), epsilon );
+    }
+
+}
+
+describe(vec4d, "constructing and arithmetic") {
+
+    it("should have the vec4f constructors and accessors") {
+        vec4d a(1, 2, 3, 4);
+        should_equal( a.w(), 4.0 );
+        should_be_equal_simd4d( vec4d(vec3d(1, 2, 3), 1).value, simd4d_create(1, 2, 3, 1), epsilon );
+        should_be_equal_simd4d( a.xyz().value, simd4d_create(1, 2, 3, 0), epsilon );
+        should_be_equal_vec4f( toFloat(a), vec4f(1, 2, 3, 4), epsilon );
+    }
+
+    it("should have dot and length over four lanes") {
+        vec4d a(1, 2, 3, 4);
+        should_equal( dot(a, a), 30.0 );
+        should_equal( length(vec4d(1, 1, 1, 1)), 2.0 );
+        should_be_equal_simd4d( (a / vec4d(2.0)).value, simd4d_create(0.5, 1, 1.5, 2), epsilon );
+    }
+
+}
+
+describe(mat4d, "transforming") {
+
+    it("should transform points and vectors like mat4f") {
+        mat4d md = mat4d::translation(vec3d(1, 2, 3)) * mat4d::axisRotation(0.5, vec3d(1, 1, 0)) * mat4d::scale(2.0);
+        mat4f mf = mat4f::translation(vec3f(1, 2, 3)) * mat4f::axisRotation(0.5f, vec3f(1, 1, 0)) * mat4f::scale(2.0f);
+
+        should_be_equal_mat4f( toFloat(md), mf, 10 );
+        should_be_equal_vec3f( toFloat(transformPoint(md, vec3d(1, -1, 2))), transformPoint(mf, vec3f(1, -1, 2)), 10 );
+        should_be_equal_vec3f( toFloat(transformVector(md, vec3d(1, -1, 2))), transformVector(mf, vec3f(1, -1, 2)), 10 );
+        should_be_equal_vec4f( toFloat(md * vec4d(1, -1, 2, 1)), mf * vec4f(1, -1, 2, 1), 10 );
+    }
+
+    it("should have inverse and transpose") {
+        mat4d m = mat4d::lookAt(vec3d(6.4e6, 10, 3e6), vec3d(6.4e6 + 100, 0, 3e6), vec3d(0, 1, 0));
+        vec3d p(6.4e6 + 5, 7, 3e6 - 2);
+        vec3d back = transformPoint(inverse(m), transformPoint(m, p));
+        should_be_true( length(back - p) < 1e-8 );
+
+        mat4d t = transpose(transpose(m));
+        should_be_equal_simd4d( t.value.w, m.value.w, epsilon );
+    }
+
+    it("should give a float model matrix relative to the camera") {
+        vec3d camera(6.4e6, 0, -1e7);
+        mat4d model = mat4d::translation(camera + vec3d(0.125, 2, -0.5)) * mat4d::scale(3.0);
+
+        mat4f rel = relativeToFloat(model, camera);
+        should_be_equal_vec3f( transformPoint(rel, vec3f(1, 0, 0)), vec3f(3.125f, 2, -0.5f), epsilon );
+    }
+
+}
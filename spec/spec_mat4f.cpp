@@ -1,6 +1,8 @@
 #include "spec_helper.h"
+#include "vectorial/mat4f_array.h"
 #include <iostream>
 using vectorial::vec4f;
+using vectorial::vec3f;
 using vectorial::mat4f;
 
 const int epsilon = 1;
@@ -27,3 +29,41 @@ describe(mat4f, "constructing") {
     
 }
 
+
+describe(mat4f, "transforming arrays") {
+
+    const mat4f m( vec4f(1,2,3,0), vec4f(0,1,4,0), vec4f(5,6,0,0), vec4f(7,8,9,1) );
+
+    it("should have transformPoints and transformVectors for vec3f arrays matching the per-element functions") {
+        vec3f in[5], points[5], vectors[5];
+        for(int i = 0; i < 5; ++i) in[i] = vec3f(i + 1, 2 - i, 3 * i);
+
+        transformPoints(m, in, points, 5);
+        transformVectors(m, in, vectors, 5);
+        for(int i = 0; i < 5; ++i) {
+            should_be_equal_vec3f(points[i], transformPoint(m, in[i]), epsilon);
+            should_be_equal_vec3f(vectors[i], transformVector(m, in[i]), epsilon);
+        }
+    }
+
+    it("should have transformVectors for vec4f arrays") {
+        vec4f in[5], out[5];
+        for(int i = 0; i < 5; ++i) in[i] = vec4f(i + 1, 2 - i, 3 * i, 0.5f * i);
+
+        transformVectors(m, in, out, 5);
+        for(int i = 0; i < 5; ++i) {
+            should_be_equal_vec4f(out[i], m * in[i], epsilon);
+        }
+    }
+
+    it("should have transformPoints for packed float arrays") {
+        float in[15], out[15];
+        for(int i = 0; i < 15; ++i) in[i] = float(i) - 4;
+
+        transformPoints(m, in, out, 5);
+        for(int i = 0; i < 5; ++i) {
+            should_be_equal_vec3f(vec3f(out + 3*i), transformPoint(m, vec3f(in + 3*i)), epsilon);
+        }
+    }
+
+}
@@ -0,0 +1,166 @@
+#include "spec_fixtures.h"
+#include "vectorial/parallel.h"
+#include <vector>
+using vectorial::thread_pool;
+
+const int epsilon = 1;
+
+namespace {
+
+    // Records every chunk, checks each index is covered exactly once
+    struct coverage {
+        std::vector<std::atomic<int> > hits;
+        std::mutex mutex;
+        std::vector<size_t> begins;
+
+        explicit coverage(size_t n) : hits(n) {
+            for(size_t i = 0; i < n; ++i) hits[i] = 0;
+        }
+
+        void operator()(size_t begin, size_t end) {
+            for(size_t i = begin; i < end; ++i) ++hits[i];
+            std::lock_guard<std::mutex> lock(mutex);
+            begins.push_back(begin);
+        }
+
+        bool once() const {
+            for(size_t i = 0; i < hits.size(); ++i) if( hits[i] != 1 ) return false;
+            return true;
+        }
+    };
+
+}
+
+describe(parallel, "thread_pool") {
+
+    it("should default to a thread per hardware thread") {
+        thread_pool pool;
+        should_be_true( pool.size() >= 1 );
+        thread_pool one(1);
+        should_be_true( one.size() == 1 );
+    }
+
+    it("should cover every index exactly once, for any thread count and grain") {
+        const size_t sizes[] = { 1, 7, 64, 1000, 4097 };
+        const size_t grains[] = { 1, 3, 64, 0 };
+        for(size_t threads = 1; threads <= 5; ++threads) {
+            thread_pool pool(threads);
+            for(size_t s = 0; s < 5; ++s) {
+                for(size_t g = 0; g < 4; ++g) {
+                    coverage c(sizes[s]);
+                    pool.parallel_for(sizes[s], [&](size_t b, size_t e) { c(b, e); }, grains[g]);
+                    should_be_true( c.once() );
+                }
+            }
+        }
+    }
+
+    it("should start chunks on cache line boundaries of the output") {
+        thread_pool pool(4);
+        float storage[3 * 1000 + 16];
+        for(size_t offset = 0; offset < 16; ++offset) {
+            float* out = storage + offset;
+            coverage c(1000);
+            pool.parallel_for(1000, [&](size_t b, size_t e) { c(b, e); }, 20, 3 * sizeof(float), out);
+            should_be_true( c.once() );
+            for(size_t i = 0; i < c.begins.size(); ++i) {
+                if( c.begins[i] == 0 ) continue;
+                should_be_true( size_t(out + 3 * c.begins[i]) % thread_pool::cache_line == 0 );
+            }
+        }
+    }
+
+    it("should run nested parallel_for calls inline") {
+        thread_pool pool(3);
+        coverage c(100 * 50);
+        pool.parallel_for(100, [&](size_t b, size_t e) {
+            for(size_t i = b; i < e; ++i) {
+                pool.parallel_for(50, [&](size_t bb, size_t ee) { c(i * 50 + bb, i * 50 + ee); }, 1);
+            }
+        }, 1);
+        should_be_true( c.once() );
+    }
+
+    it("should run the array kernels the same as on one thread") {
+        const size_t n = 1003;
+        thread_pool pool(4);
+        std::vector<simd4x4f> a(n), b(n), x(n), expected(n);
+        simd4f in[n], y[n], ey[n];
+        for(size_t i = 0; i < n; ++i) {
+            a[i] = test_matrix(i);
+            b[i] = test_matrix(n - i);
+            in[i] = simd4f_create(i % 5 + 0.5f, 2.5f - i % 3, 1, 1);
+        }
+
+        simd4x4f_matrix_mul_array(&a[0], &b[0], &expected[0], n);
+        vectorial::parallel_matrix_mul_array(pool, &a[0], &b[0], &x[0], n, 16);
+        for(size_t i = 0; i < n; ++i) should_be_equal_simd4x4f(x[i], expected[i], epsilon);
+
+        simd4x4f_matrix_mul_one_by_array(&a[0], &b[0], &expected[0], n);
+        vectorial::parallel_matrix_mul_one_by_array(pool, &a[0], &b[0], &x[0], n, 16);
+        for(size_t i = 0; i < n; ++i) should_be_equal_simd4x4f(x[i], expected[i], epsilon);
+
+        simd4x4f_matrix_point3_mul_array(&a[1], &in[0], &ey[0], n);
+        vectorial::parallel_matrix_point3_mul_array(pool, &a[1], &in[0], &y[0], n, 16);
+        for(size_t i = 0; i < n; ++i) should_be_equal_simd4f(y[i], ey[i], epsilon);
+    }
+
+    it("should run packed float3 kernels the same as on one thread") {
+        const size_t n = 1001;
+        thread_pool pool(3);
+        const simd4x4f m = test_matrix(5);
+        std::vector<float> in(3 * n), x(3 * n + 1), expected(3 * n + 1);
+        for(size_t i = 0; i < 3 * n; ++i) in[i] = float(i % 17) + 0.25f;
+
+        simd4x4f_matrix_point3_mul_packed3(&m, &in[0], &expected[1], n);
+        vectorial::parallel_matrix_point3_mul_packed3(pool, &m, &in[0], &x[1], n, 5);
+        for(size_t i = 1; i <= 3 * n; ++i) should_be_close_to(x[i], expected[i], epsilon);
+    }
+
+
+    it("should reduce bounds chunk by chunk to what one thread gives") {
+        const size_t n = 1003;
+        thread_pool pool(4);
+        simd4f p[n];
+        std::vector<float> packed(3 * n);
+        for(size_t i = 0; i < n; ++i) {
+            p[i] = simd4f_create( float(i % 37) - 11.0f, float(i % 23) * 0.5f, 3.0f - float(i % 11), 0 );
+            simd4f_ustore3(p[i], &packed[3*i]);
+        }
+
+        simd4f lo, hi, elo, ehi;
+        simd4f_aabb_array(&p[0], n, &elo, &ehi);
+        vectorial::parallel_aabb_array(pool, &p[0], n, &lo, &hi, 16);
+        should_be_equal_simd4f(lo, elo, epsilon);
+        should_be_equal_simd4f(hi, ehi, epsilon);
+        vectorial::parallel_aabb_packed3(pool, &packed[0], n, &lo, &hi, 16);
+        should_be_equal_simd4f(lo, elo, epsilon);
+        should_be_equal_simd4f(hi, ehi, epsilon);
+
+        const simd4f c = simd4f_centroid_array(&p[0], n);
+        should_be_equal_simd4f(vectorial::parallel_centroid_array(pool, &p[0], n, 16), c, 16);
+        should_be_equal_simd4f(vectorial::parallel_centroid_packed3(pool, &packed[0], n, 16), c, 16);
+
+        // Chunk results merge in chunk order, not as they finish, so any
+        // schedule gives the same bits as the inline run of one thread
+        thread_pool inline_pool(1);
+        const simd4f centroid = vectorial::parallel_centroid_array(inline_pool, &p[0], n, 16);
+        const simd4f sphere = vectorial::parallel_bounding_sphere_array(inline_pool, &p[0], n, 16);
+        for(int run = 0; run < 20; ++run) {
+            should_be_equal_simd4f(vectorial::parallel_centroid_array(pool, &p[0], n, 16), centroid, 0);
+            should_be_equal_simd4f(vectorial::parallel_bounding_sphere_array(pool, &p[0], n, 16), sphere, 0);
+        }
+
+        // Merged spheres are looser, but still hold every point
+        const simd4f spheres[2] = { vectorial::parallel_bounding_sphere_array(pool, &p[0], n, 16),
+                                    vectorial::parallel_bounding_sphere_packed3(pool, &packed[0], n, 16) };
+        for(int k = 0; k < 2; ++k) {
+            const float r = simd4f_get_w(spheres[k]);
+            for(size_t i = 0; i < n; ++i) {
+                const simd4f v = simd4f_sub(p[i], simd4f_zero_w(spheres[k]));
+                should_be_true( sqrtf(simd4f_get_x(simd4f_dot3(v, v))) <= r * 1.0001f );
+            }
+        }
+    }
+
+}
@@ -0,0 +1,125 @@
+#include "spec_helper.h"
+#include "vectorial/quatf.h"
+using vectorial::vec4f;
+using vectorial::vec3f;
+using vectorial::mat4f;
+using vectorial::quatf;
+
+// q and -q are the same rotation, b or -b whichever is on the side of a
+static simd4f same_side(const quatf& a, const quatf& b) {
+    return dot(a, b) < 0 ? simd4f_sub(simd4f_zero(), b.value) : b.value;
+}
+
+const float tolerance = 1e-5f;
+
+describe(quatf, "constructing") {
+
+    it("should have identity and axisRotation") {
+        should_be_near_simd4f( quatf::identity().value, simd4f_create(0, 0, 0, 1), 0 );
+
+        quatf q = quatf::axisRotation(VECTORIAL_PI, vec3f(0, 0, 2));
+        should_be_near_simd4f( q.value, simd4f_create(0, 0, 1, 0), tolerance );
+        should_be_close_to( length(q), 1.0f, 2 );
+    }
+
+    it("should convert to mat4f like mat4f::axisRotation") {
+        vec3f axis = normalize(vec3f(1, -2, 3));
+        mat4f m = mat4f::axisRotation(0.7f, axis);
+        should_be_near_simd4x4f( toMat4f(quatf::axisRotation(0.7f, axis)).value, m.value, tolerance );
+    }
+
+    it("should convert back from mat4f for any of the four largest components") {
+        const float angles[4] = { 0.3f, 2.9f, 3.1f, -3.0f };
+        const vec3f axes[3] = { vec3f(1, 0.1f, 0.2f), vec3f(0.1f, 1, -0.2f), vec3f(0.2f, -0.1f, 1) };
+        for(int i = 0; i < 4; ++i) {
+            for(int j = 0; j < 3; ++j) {
+                quatf q = quatf::axisRotation(angles[i], axes[j]);
+                const quatf back = quatf::fromMat4f(toMat4f(q));
+                should_be_near_simd4f( back.value, same_side(back, q), tolerance );
+            }
+        }
+    }
+
+}
+
+describe(quatf, "rotating") {
+
+    it("should rotate vectors like the matrix") {
+        quatf q = quatf::axisRotation(VECTORIAL_HALFPI, vec3f(0, 0, 1));
+        should_be_near_simd4f( (q * vec3f(1, 0, 0)).value, simd4f_create(0, 1, 0, 0), tolerance );
+
+        quatf r = quatf::axisRotation(1.3f, vec3f(-1, 2, 0.5f));
+        vec3f v(3, -4, 5);
+        should_be_near_simd4f( rotate(r, v).value, transformVector(toMat4f(r), v).value, 4 * tolerance );
+    }
+
+    it("should compose in the same order as mat4f") {
+        quatf a = quatf::axisRotation(0.5f, vec3f(1, 0, 0));
+        quatf b = quatf::axisRotation(1.1f, vec3f(0, 1, 1));
+        should_be_near_simd4x4f( toMat4f(a * b).value, (toMat4f(a) * toMat4f(b)).value, tolerance );
+
+        quatf c = a;
+        c *= b;
+        should_be_near_simd4f( c.value, (a * b).value, 0 );
+    }
+
+    it("should undo the rotation with conjugate") {
+        quatf q = quatf::axisRotation(2.0f, vec3f(1, 1, 1));
+        should_be_near_simd4f( (conjugate(q) * q).value, quatf::identity().value, tolerance );
+        should_be_close_to( dot(q, q), 1.0f, 2 );
+    }
+
+}
+
+describe(quatf, "interpolating") {
+
+    it("should have slerp that interpolates the angle evenly") {
+        vec3f axis(0, 1, 0);
+        quatf a = quatf::identity();
+        quatf b = quatf::axisRotation(2.0f, axis);
+        should_be_near_simd4f( slerp(a, b, 0.25f).value, quatf::axisRotation(0.5f, axis).value, tolerance );
+        should_be_near_simd4f( slerp(a, b, 0.0f).value, a.value, tolerance );
+        should_be_near_simd4f( slerp(a, b, 1.0f).value, b.value, tolerance );
+    }
+
+    it("should have nlerp that ends at both quaternions and stays unit length") {
+        quatf a = quatf::axisRotation(0.2f, vec3f(1, 0, 0));
+        quatf b = quatf::axisRotation(1.4f, vec3f(0, 0, 1));
+        should_be_near_simd4f( nlerp(a, b, 0.0f).value, a.value, tolerance );
+        should_be_near_simd4f( nlerp(a, b, 1.0f).value, b.value, tolerance );
+        should_be_close_to( length(nlerp(a, b, 0.4f)), 1.0f, 4 );
+    }
+
+    it("should take the short way when the quaternions point apart") {
+        quatf a = quatf::axisRotation(0.5f, vec3f(0, 0, 1));
+        quatf b = quatf::axisRotation(1.5f, vec3f(0, 0, 1));
+        quatf negb( simd4f_sub(simd4f_zero(), b.value) );
+        const quatf expected = quatf::axisRotation(1.0f, vec3f(0, 0, 1));
+        const quatf s = slerp(a, negb, 0.5f), l = nlerp(a, negb, 0.5f);
+        should_be_near_simd4f( s.value, same_side(s, expected), tolerance );
+        should_be_near_simd4f( l.value, same_side(l, expected), tolerance );
+    }
+
+    it("should blend arrays like one at a time, any count") {
+        const size_t n = 7;
+        quatf a[n], b[n], s[n], l[n];
+        for(size_t i = 0; i < n; ++i) {
+            a[i] = quatf::axisRotation(0.1f * i, vec3f(1, (float)i, 0));
+            b[i] = quatf::axisRotation(3.0f - 0.4f * i, vec3f(0, 1, (float)i));
+            if( i & 1 ) b[i] = quatf( simd4f_sub(simd4f_zero(), b[i].value) );
+        }
+        b[3] = a[3];
+
+        slerp(a, b, 0.3f, s, n);
+        nlerp(a, b, 0.3f, l, n);
+        for(size_t i = 0; i < n; ++i) {
+            should_be_near_simd4f( s[i].value, slerp(a[i], b[i], 0.3f).value, 1e-4f );
+            should_be_near_simd4f( l[i].value, nlerp(a[i], b[i], 0.3f).value, 1e-4f );
+        }
+
+        // In place
+        slerp(a, b, 0.3f, a, n);
+        should_be_near_simd4f( a[6].value, s[6].value, 0 );
+    }
+
+}
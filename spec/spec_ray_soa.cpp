@@ -0,0 +1,216 @@
+#include "spec_fixtures.h"
+#include "vectorial/ray_soa.h"
+#include <math.h>
+#include <float.h>
+using vectorial::vec3f;
+using vectorial::vec3f_soa4;
+using vectorial::vec3f_soa8;
+using vectorial::ray_soa4;
+using vectorial::ray_soa8;
+
+const int epsilon = 1;
+
+namespace {
+
+    // Triangle in the z -5 plane, legs of 4 along x and y
+    const vec3f tri[3] = { vec3f(0, 0, -5), vec3f(4, 0, -5), vec3f(0, 4, -5) };
+
+    // Ray i from the origin towards (x[i], y[i], -5), hitting the triangle at
+    // distance 1 when the point is inside it
+    const float tx[8] = { 1.0f, 3.0f, -1.0f, 1.0f, 2.5f, 0.5f, 1.0f, 5.0f };
+    const float ty[8] = { 1.0f, 0.5f,  1.0f, 2.0f, 2.5f, 3.0f, -0.5f, 0.5f };
+    const int inside = 1 | 2 | 8 | 32;
+
+    // Above the triangles looking down -z, spread so some miss
+    vec3f test_origin(size_t i) {
+        return scattered(i) * vec3f(1.5f, 1.0f, 1.0f) + vec3f(0.0f, 0.0f, 4.0f);
+    }
+
+    vec3f test_direction(size_t i) {
+        return scattered(i + 1000) * vec3f(0.3f, 0.25f, 0.0f) + vec3f(0.0f, 0.0f, -1.0f);
+    }
+
+    // Double precision Moller-Trumbore, the barycentrics for telling
+    // the edge cases apart
+    bool reference_triangle(const vec3f& o, const vec3f& d, const vec3f* v, double* t, double* margin) {
+        const double e1[3] = { double(v[1].x()) - v[0].x(), double(v[1].y()) - v[0].y(), double(v[1].z()) - v[0].z() };
+        const double e2[3] = { double(v[2].x()) - v[0].x(), double(v[2].y()) - v[0].y(), double(v[2].z()) - v[0].z() };
+        const double s[3] = { double(o.x()) - v[0].x(), double(o.y()) - v[0].y(), double(o.z()) - v[0].z() };
+        const double dd[3] = { d.x(), d.y(), d.z() };
+        const double p[3] = { dd[1]*e2[2] - dd[2]*e2[1], dd[2]*e2[0] - dd[0]*e2[2], dd[0]*e2[1] - dd[1]*e2[0] };
+        const double q[3] = { s[1]*e1[2] - s[2]*e1[1], s[2]*e1[0] - s[0]*e1[2], s[0]*e1[1] - s[1]*e1[0] };
+        const double det = e1[0]*p[0] + e1[1]*p[1] + e1[2]*p[2];
+        const double u = (s[0]*p[0] + s[1]*p[1] + s[2]*p[2]) / det;
+        const double w = (dd[0]*q[0] + dd[1]*q[1] + dd[2]*q[2]) / det;
+        *t = (e2[0]*q[0] + e2[1]*q[1] + e2[2]*q[2]) / det;
+        *margin = fmin( fmin(fabs(u), fabs(w)), fabs(1.0 - u - w) );
+        return u >= 0 && w >= 0 && u + w <= 1 && *t > 0;
+    }
+
+    bool near(float a, double b) {
+        return fabs(a - b) <= 1e-4 * fmax(1.0, fabs(b));
+    }
+
+    float lane(simd4f v, int i) { float f[4]; simd4f_ustore4(v, f); return f[i]; }
+    float lane(simd8f v, int i) { float f[8]; simd8f_ustore8(v, f); return f[i]; }
+
+}
+
+describe(ray_soa, "triangles") {
+
+    it("should hit the lanes inside the triangle at their distance") {
+        vec3f dir[8];
+        for(int i = 0; i < 8; ++i) dir[i] = vec3f(tx[i], ty[i], -5.0f);
+        vec3f_soa4 d4;
+        d4.load(dir);
+        ray_soa4 r4( vec3f_soa4(0.0f), d4 );
+
+        simd4f t4 = simd4f_splat(FLT_MAX);
+        const simd4f_mask hit4 = intersectTriangle(r4, tri[0], tri[1], tri[2], t4);
+        should_equal( simd4f_movemask(hit4), inside & 15 );
+        should_be_close_to( lane(t4, 0), 1.0f, epsilon );
+        should_be_close_to( lane(t4, 1), 1.0f, epsilon );
+        should_equal( lane(t4, 2), FLT_MAX );
+
+        ray_soa8 r8;
+        vec3f origins[8];
+        for(int i = 0; i < 8; ++i) origins[i] = vec3f(0, 0, 0);
+        r8.load(origins, dir);
+        simd8f t8 = simd8f_splat(FLT_MAX);
+        const simd8f_mask hit8 = intersectTriangle(r8, tri[0], tri[1], tri[2], t8);
+        should_equal( simd8f_movemask(hit8), inside );
+        should_be_close_to( lane(t8, 5), 1.0f, epsilon );
+    }
+
+    it("should only take hits closer than t and in front of the origin") {
+        vec3f_soa4 d(0.25f, 0.25f, -1.0f);
+        simd4f t = simd4f_create(FLT_MAX, 5.5f, 4.5f, 5.0f);
+        intersectTriangle( ray_soa4(vec3f_soa4(0.0f), d), tri[0], tri[1], tri[2], t );
+        should_be_equal_simd4f( t, simd4f_create(5.0f, 5.0f, 4.5f, 5.0f), epsilon );
+
+        t = simd4f_splat(FLT_MAX);
+        const simd4f_mask behind = intersectTriangle( ray_soa4(vec3f_soa4(0, 0, -10), d), tri[0], tri[1], tri[2], t );
+        should_be_false( simd4f_any(behind) );
+
+        // Parallel to the triangle plane
+        const simd4f_mask parallel = intersectTriangle( ray_soa4(vec3f_soa4(0, 0, -5), vec3f_soa4(1, 1, 0)), tri[0], tri[1], tri[2], t );
+        should_be_false( simd4f_any(parallel) );
+    }
+
+    it("should agree with a double precision reference away from the edges") {
+        vec3f v[3] = { vec3f(-3, -2, -4), vec3f(4, -1, -6), vec3f(0, 3, -5) };
+        int tested = 0, hits = 0;
+        for(size_t i = 0; i < 256; i += 8) {
+            vec3f o[8], d[8];
+            for(int k = 0; k < 8; ++k) { o[k] = test_origin(i + k); d[k] = test_direction(i + k); }
+            ray_soa4 r4; r4.load(o, d);
+            ray_soa8 r8; r8.load(o, d);
+            simd4f t4 = simd4f_splat(FLT_MAX);
+            simd8f t8 = simd8f_splat(FLT_MAX);
+            const int m4 = simd4f_movemask( intersectTriangle(r4, v[0], v[1], v[2], t4) );
+            const int m8 = simd8f_movemask( intersectTriangle(r8, v[0], v[1], v[2], t8) );
+
+            for(int k = 0; k < 8; ++k) {
+                double t, margin;
+                const bool expected = reference_triangle(o[k], d[k], v, &t, &margin);
+                if( margin < 1e-4 ) continue;
+                ++tested;
+                should_equal( ((m8 >> k) & 1) != 0, expected );
+                if( k < 4 ) should_equal( ((m4 >> k) & 1) != 0, expected );
+                if( !expected ) continue;
+                ++hits;
+                should_be_true( near(lane(t8, k), t) );
+                if( k < 4 ) should_be_true( near(lane(t4, k), t) );
+            }
+        }
+        should_be_true( tested > 200 && hits > 30 && hits < tested - 30 );
+    }
+
+    it("should find the closest of many triangles with its index") {
+        // Quads of two triangles stacked along -z, the middle one shifted off to the side
+        vec3f v[18];
+        for(int k = 0; k < 3; ++k) {
+            const float z = -2.0f - 2.0f * k;
+            const float x = k == 1 ? 10.0f : 0.0f;
+            v[6*k+0] = vec3f(x - 1, -1, z); v[6*k+1] = vec3f(x + 1, -1, z); v[6*k+2] = vec3f(x + 1, 1, z);
+            v[6*k+3] = vec3f(x - 1, -1, z); v[6*k+4] = vec3f(x + 1, 1, z); v[6*k+5] = vec3f(x - 1, 1, z);
+        }
+        // Lanes 3 and 4 miss everything, lane 5 only sees the middle quad
+        const vec3f o[8] = { vec3f(0.5f, -0.5f, 0), vec3f(-0.5f, 0.5f, 0), vec3f(0, 0.2f, 0), vec3f(5, 5, 0),
+                             vec3f(0.5f, -0.5f, 0), vec3f(10, 0.3f, 0), vec3f(-0.5f, 0.5f, -3), vec3f(0.5f, -0.5f, -5) };
+        const vec3f d[8] = { vec3f(0, 0, -1), vec3f(0, 0, -1), vec3f(0, 0, -1), vec3f(0, 0, -1),
+                             vec3f(0, 0, 1), vec3f(0, 0, -1), vec3f(0, 0, -1), vec3f(0, 0, -2) };
+
+        ray_soa8 r8; r8.load(o, d);
+        simd8f t8 = simd8f_splat(FLT_MAX);
+        int32_t index[8];
+        const int m8 = intersectTriangles(r8, v, 6, t8, index);
+        should_equal( m8, 1 | 2 | 4 | 32 | 64 | 128 );
+        const int32_t expected[8] = { 0, 1, 1, -1, -1, 3, 5, 4 };
+        for(int k = 0; k < 8; ++k) should_equal( index[k], expected[k] );
+        should_be_equal_simd4f( simd8f_get_low(t8), simd4f_create(2, 2, 2, FLT_MAX), epsilon );
+        should_be_close_to( lane(t8, 5), 4.0f, epsilon );
+        should_be_close_to( lane(t8, 6), 3.0f, epsilon );
+        should_be_close_to( lane(t8, 7), 0.5f, epsilon );
+
+        ray_soa4 r4; r4.load(o, d);
+        simd4f t4 = simd4f_splat(FLT_MAX);
+        const int m4 = intersectTriangles(r4, v, 6, t4, index);
+        should_equal( m4, m8 & 15 );
+        for(int k = 0; k < 4; ++k) should_equal( index[k], expected[k] );
+    }
+
+}
+
+describe(ray_soa, "boxes") {
+
+    it("should give the entry distance of the lanes hitting the box") {
+        const vec3f lo(-1, -1, -6), hi(1, 1, -4);
+        const vec3f o[8] = { vec3f(0, 0, 0), vec3f(0.5f, 0.5f, 0), vec3f(3, 0, 0), vec3f(0, 0, -5),
+                             vec3f(0, 0, -10), vec3f(0, 0, -10), vec3f(-5, 0, -5), vec3f(0, 0, 0) };
+        const vec3f d[8] = { vec3f(0, 0, -1), vec3f(0, 0, -2), vec3f(0, 0, -1), vec3f(1, 0, 0),
+                             vec3f(0, 0, 1), vec3f(0, 0, -1), vec3f(1, 0.1f, 0), vec3f(0.15f, 0, -1) };
+
+        ray_soa8 r8; r8.load(o, d);
+        simd8f tnear8 = simd8f_splat(-1.0f);
+        const simd8f_mask hit8 = intersectBox(r8, lo, hi, simd8f_splat(100.0f), tnear8);
+        should_equal( simd8f_movemask(hit8), 1 | 2 | 8 | 16 | 64 | 128 );
+        should_be_equal_simd8f( tnear8, simd8f_create(4.0f, 2.0f, -1.0f, 0.0f, 4.0f, -1.0f, 4.0f, 4.0f), epsilon );
+
+        ray_soa4 r4; r4.load(o, d);
+        simd4f tnear4 = simd4f_zero();
+        const simd4f_mask hit4 = intersectBox(r4, lo, hi, simd4f_splat(100.0f), tnear4);
+        should_equal( simd4f_movemask(hit4), 1 | 2 | 8 );
+        should_be_equal_simd4f( tnear4, simd4f_create(4.0f, 2.0f, 0.0f, 0.0f), epsilon );
+    }
+
+    it("should take rays parallel to a slab by whether the origin is within it") {
+        const vec3f lo(-1, -1, -6), hi(1, 1, -4);
+        // Lanes 2, 4 and 7 lie in a min face, 3 and 6 in a max face, 4 and 7
+        // with a negative zero
+        const vec3f o[8] = { vec3f(0, 0, 0), vec3f(2, 0, 0), vec3f(-1, 0, 0), vec3f(1, 0, 0),
+                             vec3f(0, -1, 0), vec3f(0, 0, -5), vec3f(-5, 0, -4), vec3f(-5, 0, -6) };
+        const vec3f d[8] = { vec3f(0, 0, -1), vec3f(0, 0, -1), vec3f(0, 0, -1), vec3f(0, 0, -1),
+                             vec3f(-0.0f, 0, -1), vec3f(1, 0, 0), vec3f(1, 0, 0), vec3f(2, 0, -0.0f) };
+
+        ray_soa8 r8; r8.load(o, d);
+        simd8f tnear8 = simd8f_splat(-1.0f);
+        const simd8f_mask hit8 = intersectBox(r8, lo, hi, simd8f_splat(100.0f), tnear8);
+        should_equal( simd8f_movemask(hit8), 1 | 4 | 16 | 32 | 128 );
+        should_be_equal_simd8f( tnear8, simd8f_create(4.0f, -1.0f, 4.0f, -1.0f, 4.0f, 0.0f, -1.0f, 2.0f), epsilon );
+
+        ray_soa4 r4; r4.load(o + 4, d + 4);
+        simd4f tnear4 = simd4f_splat(-1.0f);
+        const simd4f_mask hit4 = intersectBox(r4, lo, hi, simd4f_splat(100.0f), tnear4);
+        should_equal( simd4f_movemask(hit4), 1 | 2 | 8 );
+        should_be_equal_simd4f( tnear4, simd4f_create(4.0f, 0.0f, -1.0f, 2.0f), epsilon );
+    }
+
+    it("should miss boxes further away than tmax") {
+        ray_soa4 r( vec3f_soa4(0.0f), vec3f_soa4(0, 0, -1) );
+        simd4f tnear = simd4f_zero();
+        const simd4f_mask hit = intersectBox(r, vec3f(-1, -1, -6), vec3f(1, 1, -4), simd4f_create(3.9f, 4.1f, 10.0f, 0.0f), tnear);
+        should_equal( simd4f_movemask(hit), 2 | 4 );
+    }
+
+}
@@ -0,0 +1,190 @@
+#include "spec_helper.h"
+#include "vectorial/simd4x4d.h"
+
+const int epsilon = 1;
+
+describe(simd4d, "sanity") {
+    it("VECTORIAL_SIMD4D_TYPE should be defined to a string") {
+        std::cout << "Simd4d type: " << VECTORIAL_SIMD4D_TYPE << std::endl;
+    }
+}
+
+describe(simd4d, "creating") {
+
+    it("should be possible to create with simd4d_create") {
+        simd4d x = simd4d_create(1, 2, 3, 4);
+        should_equal( simd4d_get_x(x), 1.0 );
+        should_equal( simd4d_get_y(x), 2.0 );
+        should_equal( simd4d_get_z(x), 3.0 );
+        should_equal( simd4d_get_w(x), 4.0 );
+    }
+
+    it("should have simd4d_zero and simd4d_splat") {
+        should_be_equal_simd4d( simd4d_zero(), simd4d_create(0, 0, 0, 0), epsilon );
+        should_be_equal_simd4d( simd4d_splat(7.5), simd4d_create(7.5, 7.5, 7.5, 7.5), epsilon );
+    }
+
+    it("should have simd4d_uload4, 3 and 2 for unaligned double arrays") {
+        double storage[5] = { 0, 1, 2, 3, 4 };
+        should_be_equal_simd4d( simd4d_uload4(storage + 1), simd4d_create(1, 2, 3, 4), epsilon );
+        should_be_equal_simd4d( simd4d_uload3(storage + 1), simd4d_create(1, 2, 3, 0), epsilon );
+        should_be_equal_simd4d( simd4d_uload2(storage + 1), simd4d_create(1, 2, 0, 0), epsilon );
+    }
+
+    it("should have simd4d_ustore4, 3 and 2 that leave the rest alone") {
+        double storage[6] = { 0, 0, 0, 0, 0, 0 };
+        simd4d_ustore4( simd4d_create(1, 2, 3, 4), storage + 1 );
+        should_equal( storage[0], 0.0 );
+        should_equal( storage[4], 4.0 );
+        should_equal( storage[5], 0.0 );
+
+        simd4d_ustore3( simd4d_create(5, 6, 7, 8), storage + 1 );
+        should_equal( storage[3], 7.0 );
+        should_equal( storage[4], 4.0 );
+
+        simd4d_ustore2( simd4d_create(9, 10, 11, 12), storage + 1 );
+        should_equal( storage[2], 10.0 );
+        should_equal( storage[3], 7.0 );
+    }
+
+}
+
+describe(simd4d, "utilities") {
+
+    it("should have simd4d_splat_x..w") {
+        simd4d a = simd4d_create(1, 2, 3, 4);
+        should_be_equal_simd4d( simd4d_splat_x(a), simd4d_splat(1), epsilon );
+        should_be_equal_simd4d( simd4d_splat_y(a), simd4d_splat(2), epsilon );
+        should_be_equal_simd4d( simd4d_splat_z(a), simd4d_splat(3), epsilon );
+        should_be_equal_simd4d( simd4d_splat_w(a), simd4d_splat(4), epsilon );
+    }
+
+    it("should have simd4d_zero_w and simd4d_zero_zw") {
+        simd4d a = simd4d_create(1, 2, 3, 4);
+        should_be_equal_simd4d( simd4d_zero_w(a), simd4d_create(1, 2, 3, 0), epsilon );
+        should_be_equal_simd4d( simd4d_zero_zw(a), simd4d_create(1, 2, 0, 0), epsilon );
+    }
+
+    it("should have simd4d_min and simd4d_max") {
+        simd4d a = simd4d_create(1, 6, -3, 4);
+        simd4d b = simd4d_create(2, 5, -4, 4);
+        should_be_equal_simd4d( simd4d_min(a, b), simd4d_create(1, 5, -4, 4), epsilon );
+        should_be_equal_simd4d( simd4d_max(a, b), simd4d_create(2, 6, -3, 4), epsilon );
+    }
+
+}
+
+describe(simd4d, "arithmetic") {
+
+    it("should have simd4d_add, sub, mul, div and madd") {
+        simd4d a = simd4d_create(1, 2, 3, 4);
+        simd4d b = simd4d_create(10, 20, 30, 40);
+        should_be_equal_simd4d( simd4d_add(a, b), simd4d_create(11, 22, 33, 44), epsilon );
+        should_be_equal_simd4d( simd4d_sub(a, b), simd4d_create(-9, -18, -27, -36), epsilon );
+        should_be_equal_simd4d( simd4d_mul(a, b), simd4d_create(10, 40, 90, 160), epsilon );
+        should_be_equal_simd4d( simd4d_div(b, a), simd4d_create(10, 10, 10, 10), epsilon );
+        should_be_equal_simd4d( simd4d_madd(a, b, a), simd4d_create(11, 42, 93, 164), epsilon );
+    }
+
+    it("should have full precision simd4d_reciprocal, sqrt and rsqrt") {
+        simd4d a = simd4d_create(4, 16, 0.25, 3);
+        should_be_equal_simd4d( simd4d_reciprocal(a), simd4d_create(0.25, 0.0625, 4, 1.0 / 3.0), epsilon );
+        should_be_equal_simd4d( simd4d_sqrt(a), simd4d_create(2, 4, 0.5, sqrt(3.0)), epsilon );
+        should_be_equal_simd4d( simd4d_rsqrt(a), simd4d_create(0.5, 0.25, 2, 1.0 / sqrt(3.0)), epsilon );
+    }
+
+}
+
+describe(simd4d, "vector math") {
+
+    it("should have simd4d_dot3, dot4 and dot2 in all lanes") {
+        simd4d a = simd4d_create(1, 2, 3, 4);
+        simd4d b = simd4d_create(5, 6, 7, 8);
+        should_be_equal_simd4d( simd4d_dot3(a, b), simd4d_splat(38), epsilon );
+        should_be_equal_simd4d( simd4d_dot4(a, b), simd4d_splat(70), epsilon );
+        should_be_equal_simd4d( simd4d_dot2(a, b), simd4d_splat(17), epsilon );
+        should_equal( simd4d_dot3_scalar(a, b), 38.0 );
+    }
+
+    it("should have simd4d_cross3 with zero w") {
+        simd4d a = simd4d_create(1, 2, 3, 9);
+        simd4d b = simd4d_create(4, 5, 6, 9);
+        should_be_equal_simd4d( simd4d_cross3(a, b), simd4d_create(-3, 6, -3, 0), epsilon );
+    }
+
+    it("should have simd4d_length3 and simd4d_normalize3") {
+        simd4d a = simd4d_create(3, 0, 4, 0);
+        should_be_equal_simd4d( simd4d_length3(a), simd4d_splat(5), epsilon );
+        should_be_equal_simd4d( simd4d_normalize3(a), simd4d_create(0.6, 0, 0.8, 0), epsilon );
+    }
+
+}
+
+describe(simd4d, "converting") {
+
+    it("should convert to and from simd4f") {
+        should_be_equal_simd4f( simd4d_to_simd4f( simd4d_create(1.5, -2.25, 1e10, 0.1) ),
+                                simd4f_create(1.5f, -2.25f, 1e10f, 0.1f), epsilon );
+        should_be_equal_simd4d( simd4f_to_simd4d( simd4f_create(1.5f, -2.25f, 1e10f, 0.1f) ),
+                                simd4d_create(1.5, -2.25, (double)1e10f, (double)0.1f), epsilon );
+    }
+
+    it("should keep precision of large coordinates relative to an origin") {
+        simd4d points[2] = { simd4d_create(6.4e6 + 0.001, -6.4e6, 1e7 + 0.5, 0),
+                             simd4d_create(6.4e6 - 0.001, -6.4e6 + 0.25, 1e7, 0) };
+        simd4f out[2];
+        simd4d_relative_to_simd4f_array(points, simd4d_create(6.4e6, -6.4e6, 1e7, 0), out, 2);
+        should_be_equal_simd4f( out[0], simd4f_create(0.001f, 0, 0.5f, 0), 64 );
+        should_be_equal_simd4f( out[1], simd4f_create(-0.001f, 0.25f, 0, 0), 64 );
+    }
+
+}
+
+describe(simd4x4d, "matrix math") {
+
+    it("should multiply points and matrices like simd4x4f") {
+        simd4x4d t, r, m;
+        simd4x4d_translation(&t, 1, 2, 3);
+        simd4x4d_axis_rotation(&r, VECTORIAL_HALFPI, simd4d_create(0, 0, 1, 0));
+        simd4x4d_matrix_mul(&t, &r, &m);
+
+        simd4d p = simd4d_create(1, 0, 0, 1);
+        simd4d out;
+        simd4x4d_matrix_point3_mul(&m, &p, &out);
+
+        simd4x4f tf, rf, mf;
+        simd4x4f_translation(&tf, 1, 2, 3);
+        simd4x4f_axis_rotation(&rf, VECTORIAL_HALFPI, simd4f_create(0, 0, 1, 0));
+        simd4x4f_matrix_mul(&tf, &rf, &mf);
+        simd4f pf = simd4f_create(1, 0, 0, 1);
+        simd4f outf;
+        simd4x4f_matrix_point3_mul(&mf, &pf, &outf);
+
+        should_be_equal_simd4f( simd4d_to_simd4f(out), outf, 10 );
+    }
+
+    it("should have simd4x4d_inverse returning the determinant") {
+        simd4x4d m = simd4x4d_create( simd4d_create(2, 0, 0, 0), simd4d_create(0, 4, 0, 0),
+                                      simd4d_create(1, 0, 8, 0), simd4d_create(1e7, -3e6, 5, 1) );
+        simd4x4d inv, id;
+        simd4d det = simd4x4d_inverse(&m, &inv);
+        should_be_equal_simd4d( det, simd4d_splat(64), epsilon );
+
+        simd4x4d_matrix_mul(&m, &inv, &id);
+        double ary[16];
+        simd4x4d_ustore(&id, ary);
+        for(int i = 0; i < 16; ++i) {
+            should_be_true( fabs(ary[i] - (i % 5 == 0 ? 1.0 : 0.0)) < 1e-9 );
+        }
+    }
+
+    it("should make the translation relative before rounding to simd4x4f") {
+        simd4x4d m;
+        simd4x4d_translation(&m, 6.4e6 + 0.125, 2, -1e7 - 0.5);
+        simd4x4f out;
+        simd4x4d_relative_to_simd4x4f(&m, simd4d_create(6.4e6, 0, -1e7, 123), &out);
+        should_be_equal_simd4f( out.x, simd4f_create(1, 0, 0, 0), epsilon );
+        should_be_equal_simd4f( out.w, simd4f_create(0.125f, 2, -0.5f, 1), epsilon );
+    }
+
+}
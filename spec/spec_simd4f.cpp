@@ -418,12 +418,94 @@ describe(simd4f, "min-max") {
         should_be_equal_simd4f(x, simd4f_create(2.0f, 2.0f, 300000000.0f, 0.000001f), epsilon);
         
     }
+
+    it("should have simd4f_floor rounding towards negative infinity") {
+        simd4f x = simd4f_floor(simd4f_create(1.5f, -1.5f, 2.0f, -0.25f));
+        should_be_equal_simd4f(x, simd4f_create(1.0f, -2.0f, 2.0f, -1.0f), epsilon);
+
+        x = simd4f_floor(simd4f_create(0.999999f, -3.0f, 8388607.5f, -8388607.5f));
+        should_be_equal_simd4f(x, simd4f_create(0.0f, -3.0f, 8388607.0f, -8388608.0f), epsilon);
+
+        x = simd4f_floor(simd4f_create(16777216.0f, -300000000.0f, 3e9f, -3e9f));
+        should_be_equal_simd4f(x, simd4f_create(16777216.0f, -300000000.0f, 3e9f, -3e9f), epsilon);
+    }
+
+    it("should have simd4f_ldexp scaling by powers of two") {
+        simd4f x = simd4f_ldexp(simd4f_create(1.0f, -3.0f, 0.75f, 5.0f), simd4f_create(0.0f, 4.0f, -2.0f, 100.0f));
+        should_be_equal_simd4f(x, simd4f_create(1.0f, -48.0f, 0.1875f, 5.0f * 1.2676506e30f), epsilon);
+
+        // Past the normal range in one step but not in the result
+        x = simd4f_ldexp(simd4f_create(0.5f, 4.0f, 1e-30f, 1e30f), simd4f_create(128.0f, -128.0f, 200.0f, -200.0f));
+        should_be_equal_simd4f(x, simd4f_create(1.7014118e38f, 1.1754944e-38f, 1.6069380e30f, 6.2230153e-31f), epsilon);
+    }
+
+    it("should have simd4f_frexp splitting to mantissa and exponent") {
+        simd4f e;
+        simd4f m = simd4f_frexp(simd4f_create(1.0f, -48.0f, 0.1875f, 3e38f), &e);
+        should_be_equal_simd4f(m, simd4f_create(0.5f, -0.75f, 0.75f, 0.88162076f), epsilon);
+        should_be_equal_simd4f(e, simd4f_create(1.0f, 6.0f, -2.0f, 128.0f), epsilon);
+
+        m = simd4f_frexp(simd4f_create(0.0f, 1.1754944e-38f, 7.0f, -0.3f), &e);
+        should_be_equal_simd4f(m, simd4f_create(0.0f, 0.5f, 0.875f, -0.6f), epsilon);
+        should_be_equal_simd4f(e, simd4f_create(0.0f, -125.0f, 3.0f, -1.0f), epsilon);
+    }
     
     
     
 }
 
 
+describe(simd4f, "comparing") {
+
+    it("should have simd4f_cmpeq, simd4f_cmpne, simd4f_cmplt, simd4f_cmple, simd4f_cmpgt and simd4f_cmpge giving masks") {
+        simd4f a = simd4f_create(1.0f, 2.0f, -3.0f, 4.0f);
+        simd4f b = simd4f_create(1.0f, -2.0f, 3.0f, 4.5f);
+
+        should_equal( simd4f_movemask( simd4f_cmpeq(a, b) ), 1 );
+        should_equal( simd4f_movemask( simd4f_cmpne(a, b) ), 2 | 4 | 8 );
+        should_equal( simd4f_movemask( simd4f_cmplt(a, b) ), 4 | 8 );
+        should_equal( simd4f_movemask( simd4f_cmple(a, b) ), 1 | 4 | 8 );
+        should_equal( simd4f_movemask( simd4f_cmpgt(a, b) ), 2 );
+        should_equal( simd4f_movemask( simd4f_cmpge(a, b) ), 1 | 2 );
+    }
+
+    it("should combine masks with simd4f_mask_and, simd4f_mask_or, simd4f_mask_xor and simd4f_mask_not") {
+        simd4f a = simd4f_create(1.0f, 2.0f, 3.0f, 4.0f);
+        simd4f_mask lo = simd4f_cmpgt(a, simd4f_splat(1.5f));
+        simd4f_mask hi = simd4f_cmplt(a, simd4f_splat(3.5f));
+
+        should_equal( simd4f_movemask( simd4f_mask_and(lo, hi) ), 2 | 4 );
+        should_equal( simd4f_movemask( simd4f_mask_or(lo, hi) ), 15 );
+        should_equal( simd4f_movemask( simd4f_mask_xor(lo, hi) ), 1 | 8 );
+        should_equal( simd4f_movemask( simd4f_mask_not(lo) ), 1 );
+    }
+
+    it("should have simd4f_select picking lanes by a mask") {
+        simd4f a = simd4f_create(1.0f, -2.0f, 3.0f, -4.0f);
+        simd4f b = simd4f_create(10.0f, 20.0f, 30.0f, 40.0f);
+
+        simd4f x = simd4f_select( simd4f_cmplt(a, simd4f_zero()), b, a );
+        should_be_equal_simd4f(x, simd4f_create(1.0f, 20.0f, 3.0f, 40.0f), epsilon);
+
+        // Clamp without min and max
+        simd4f c = simd4f_create(-5.0f, 0.5f, 2.0f, 7.0f);
+        simd4f lo = simd4f_splat(0.0f), hi = simd4f_splat(1.0f);
+        x = simd4f_select( simd4f_cmplt(c, lo), lo, simd4f_select( simd4f_cmpgt(c, hi), hi, c ) );
+        should_be_equal_simd4f(x, simd4f_create(0.0f, 0.5f, 1.0f, 1.0f), epsilon);
+    }
+
+    it("should have simd4f_any and simd4f_all testing the lanes of a mask") {
+        simd4f a = simd4f_create(1.0f, 2.0f, 3.0f, 4.0f);
+
+        should_be_true( simd4f_any( simd4f_cmpgt(a, simd4f_splat(3.5f)) ) );
+        should_be_false( simd4f_any( simd4f_cmpgt(a, simd4f_splat(4.5f)) ) );
+        should_be_true( simd4f_all( simd4f_cmpgt(a, simd4f_splat(0.5f)) ) );
+        should_be_false( simd4f_all( simd4f_cmpgt(a, simd4f_splat(1.5f)) ) );
+    }
+
+}
+
+
 describe(simd4f, "zeroing")
 {
 
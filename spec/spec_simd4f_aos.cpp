@@ -0,0 +1,138 @@
+#include "spec_helper.h"
+#include "vectorial/simd4f_aos.h"
+#include "vectorial/simd8f_aos.h"
+
+#include <vector>
+
+const int epsilon = 1;
+
+namespace {
+
+    const size_t max_count = 8;
+    const size_t max_stride = 5;
+
+    // Component c of vector i is 10*i + c, padding is -1
+    void fill(float *ary, size_t count, size_t stride, size_t elements) {
+        for(size_t i = 0; i < count; ++i) {
+            for(size_t c = 0; c < stride; ++c) {
+                ary[i*stride + c] = c < elements ? float(10*i + c) : -1.0f;
+            }
+        }
+    }
+
+    simd4f lanes4(size_t c) {
+        return simd4f_create(c, 10 + c, 20 + c, 30 + c);
+    }
+
+    simd8f lanes8(size_t c) {
+        return simd8f_create(c, 10 + c, 20 + c, 30 + c, 40 + c, 50 + c, 60 + c, 70 + c);
+    }
+
+}
+
+describe(simd4f_aos, "loading") {
+
+    it("should have simd4f_aos_load4 for strided float4 arrays") {
+        for(size_t stride = 4; stride <= max_stride; ++stride) {
+            float ary[max_count * max_stride];
+            fill(ary, 4, stride, 4);
+            simd4f x, y, z, w;
+            simd4f_aos_load4(ary, stride, &x, &y, &z, &w);
+            should_be_equal_simd4f(x, lanes4(0), epsilon);
+            should_be_equal_simd4f(y, lanes4(1), epsilon);
+            should_be_equal_simd4f(z, lanes4(2), epsilon);
+            should_be_equal_simd4f(w, lanes4(3), epsilon);
+        }
+    }
+
+    it("should have simd4f_aos_load3 for packed, padded and strided float3 arrays") {
+        for(size_t stride = 3; stride <= max_stride; ++stride) {
+            float ary[max_count * max_stride];
+            fill(ary, 4, stride, 3);
+            simd4f x, y, z;
+            simd4f_aos_load3(ary, stride, &x, &y, &z);
+            should_be_equal_simd4f(x, lanes4(0), epsilon);
+            should_be_equal_simd4f(y, lanes4(1), epsilon);
+            should_be_equal_simd4f(z, lanes4(2), epsilon);
+        }
+    }
+
+    it("should have simd4f_aos_load3 read only the 3 floats of the last vector") {
+        for(size_t stride = 3; stride <= max_stride; ++stride) {
+            // Sized to end right after the last vector for memory checkers
+            std::vector<float> ary(3*stride + 3);
+            fill(&ary[0], 3, stride, 3);
+            for(size_t c = 0; c < 3; ++c) ary[3*stride + c] = float(30 + c);
+            simd4f x, y, z;
+            simd4f_aos_load3(&ary[0], stride, &x, &y, &z);
+            should_be_equal_simd4f(x, lanes4(0), epsilon);
+            should_be_equal_simd4f(y, lanes4(1), epsilon);
+            should_be_equal_simd4f(z, lanes4(2), epsilon);
+        }
+    }
+
+    it("should have simd8f_aos_load4 and simd8f_aos_load3 for 8 vectors") {
+        for(size_t stride = 3; stride <= max_stride; ++stride) {
+            float ary[max_count * max_stride];
+            simd8f x, y, z, w;
+            fill(ary, 8, stride, 3);
+            simd8f_aos_load3(ary, stride, &x, &y, &z);
+            should_be_equal_simd8f(x, lanes8(0), epsilon);
+            should_be_equal_simd8f(y, lanes8(1), epsilon);
+            should_be_equal_simd8f(z, lanes8(2), epsilon);
+            if( stride < 4 ) continue;
+            fill(ary, 8, stride, 4);
+            simd8f_aos_load4(ary, stride, &x, &y, &z, &w);
+            should_be_equal_simd8f(x, lanes8(0), epsilon);
+            should_be_equal_simd8f(w, lanes8(3), epsilon);
+        }
+    }
+
+}
+
+describe(simd4f_aos, "storing") {
+
+    it("should have simd4f_aos_store4 leaving the padding alone") {
+        for(size_t stride = 4; stride <= max_stride; ++stride) {
+            float ary[max_count * max_stride], expected[max_count * max_stride];
+            fill(expected, 4, stride, 4);
+            for(size_t i = 0; i < 4*stride; ++i) ary[i] = -1.0f;
+            simd4f_aos_store4(lanes4(0), lanes4(1), lanes4(2), lanes4(3), ary, stride);
+            for(size_t i = 0; i < 4*stride; ++i) {
+                should_be_close_to(ary[i], expected[i], epsilon);
+            }
+        }
+    }
+
+    it("should have simd4f_aos_store3 leaving the padding alone") {
+        for(size_t stride = 3; stride <= max_stride; ++stride) {
+            float ary[max_count * max_stride], expected[max_count * max_stride];
+            fill(expected, 4, stride, 3);
+            for(size_t i = 0; i < 4*stride; ++i) ary[i] = -1.0f;
+            simd4f_aos_store3(lanes4(0), lanes4(1), lanes4(2), ary, stride);
+            for(size_t i = 0; i < 4*stride; ++i) {
+                should_be_close_to(ary[i], expected[i], epsilon);
+            }
+        }
+    }
+
+    it("should have simd8f_aos_store4 and simd8f_aos_store3 for 8 vectors") {
+        for(size_t stride = 3; stride <= max_stride; ++stride) {
+            float ary[max_count * max_stride], expected[max_count * max_stride];
+            fill(expected, 8, stride, 3);
+            for(size_t i = 0; i < 8*stride; ++i) ary[i] = -1.0f;
+            simd8f_aos_store3(lanes8(0), lanes8(1), lanes8(2), ary, stride);
+            for(size_t i = 0; i < 8*stride; ++i) {
+                should_be_close_to(ary[i], expected[i], epsilon);
+            }
+            if( stride < 4 ) continue;
+            fill(expected, 8, stride, 4);
+            for(size_t i = 0; i < 8*stride; ++i) ary[i] = -1.0f;
+            simd8f_aos_store4(lanes8(0), lanes8(1), lanes8(2), lanes8(3), ary, stride);
+            for(size_t i = 0; i < 8*stride; ++i) {
+                should_be_close_to(ary[i], expected[i], epsilon);
+            }
+        }
+    }
+
+}
@@ -0,0 +1,239 @@
+#include "spec_helper.h"
+#include "vectorial/simd4f_math.h"
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+const int epsilon = 1;
+
+namespace {
+
+    // Distance from the double result in units of the float result's last place
+    double ulp_error(float actual, double expected) {
+        const float e = float(expected);
+        const double ulp = e == 0 ? std::ldexp(1.0, -149) : std::ldexp(1.0, std::ilogb(e) - 23);
+        return std::fabs(actual - expected) / ulp;
+    }
+
+    typedef simd4f (*math_func)(simd4f);
+
+    // Worst error over a sweep of [-range, range], near the zeros only the
+    // absolute error counts as the reduction works in absolute terms
+    double sweep(math_func f, double (*reference)(double), float range, int steps, double max_result = 1e30) {
+        const double tiny = 1.0 / 16777216.0;
+        double worst = 0;
+        for(int i = 0; i < steps; i += 4) {
+            float x[4], y[4];
+            for(int j = 0; j < 4; ++j) x[j] = -range + 2 * range * float(i + j) / steps;
+            simd4f_ustore4(f(simd4f_uload4(x)), y);
+            for(int j = 0; j < 4; ++j) {
+                const double e = reference(x[j]);
+                if( std::fabs(e) > max_result ) continue;
+                if( std::fabs(y[j] - e) <= tiny ) continue;
+                const double err = ulp_error(y[j], e);
+                if( err > worst ) worst = err;
+            }
+        }
+        return worst;
+    }
+
+    simd4f sincos_sin(simd4f v) { simd4f s, c; simd4f_sincos(v, &s, &c); return s; }
+    simd4f sincos_cos(simd4f v) { simd4f s, c; simd4f_sincos(v, &s, &c); return c; }
+
+}
+
+describe(simd4f_math, "trigonometry") {
+
+    it("should have simd4f_sin within 2 ulp of libm") {
+        should_be_true( sweep(simd4f_sin, sin, 8, 400000) <= 2 );
+        should_be_true( sweep(simd4f_sin, sin, 8192, 400000) <= 2 );
+    }
+
+    it("should have simd4f_cos within 2 ulp of libm") {
+        should_be_true( sweep(simd4f_cos, cos, 8, 400000) <= 2 );
+        should_be_true( sweep(simd4f_cos, cos, 8192, 400000) <= 2 );
+    }
+
+    it("should have simd4f_sincos within 2 ulp of libm") {
+        should_be_true( sweep(sincos_sin, sin, 8, 400000) <= 2 );
+        should_be_true( sweep(sincos_cos, cos, 8, 400000) <= 2 );
+        should_be_true( sweep(sincos_sin, sin, 8192, 400000) <= 2 );
+        should_be_true( sweep(sincos_cos, cos, 8192, 400000) <= 2 );
+    }
+
+    it("should have simd4f_tan within 5 ulp of libm away from the poles") {
+        should_be_true( sweep(simd4f_tan, tan, 8, 400000, 1e4) <= 5 );
+        should_be_true( sweep(simd4f_tan, tan, 8192, 400000, 1e4) <= 5 );
+    }
+
+    it("should have exact values at the usual angles") {
+        simd4f x = simd4f_sin(simd4f_create(0.0f, VECTORIAL_HALFPI, -VECTORIAL_HALFPI, 0.5235987756f));
+        should_be_equal_simd4f(x, simd4f_create(0.0f, 1.0f, -1.0f, 0.5f), epsilon);
+
+        x = simd4f_cos(simd4f_create(0.0f, VECTORIAL_PI, -VECTORIAL_PI, 2 * VECTORIAL_PI));
+        should_be_equal_simd4f(x, simd4f_create(1.0f, -1.0f, -1.0f, 1.0f), epsilon);
+
+        x = simd4f_tan(simd4f_create(0.7853981634f, -0.7853981634f, 2.3561944902f, 0.0f));
+        should_be_equal_simd4f(x, simd4f_create(1.0f, -1.0f, -1.0f, 0.0f), epsilon);
+    }
+
+}
+
+
+namespace {
+
+    enum error_kind { ulps, relative, absolute };
+
+    // Worst error over a sweep of [lo, hi], of x itself or of 2^x when
+    // sweeping the exponent
+    double sweep_exp(math_func f, double (*reference)(double), float lo, float hi, bool exponent, error_kind kind, int steps = 400000) {
+        const double tiny = 1.0 / 16777216.0;
+        double worst = 0;
+        for(int i = 0; i < steps; i += 4) {
+            float x[4], y[4];
+            for(int j = 0; j < 4; ++j) {
+                const double t = lo + (hi - lo) * double(i + j) / steps;
+                x[j] = float(exponent ? std::exp2(t) : t);
+            }
+            simd4f_ustore4(f(simd4f_uload4(x)), y);
+            for(int j = 0; j < 4; ++j) {
+                const double e = reference(x[j]);
+                double err = std::fabs(y[j] - e);
+                if( kind == relative ) err /= std::fabs(e);
+                if( kind == ulps ) err = err <= tiny && std::fabs(e) < 1 ? 0 : ulp_error(y[j], e);
+                if( err > worst ) worst = err;
+            }
+        }
+        return worst;
+    }
+
+    double exp2_double(double x) { return std::exp2(x); }
+    double log2_double(double x) { return std::log2(x); }
+    double gamma_double(double x) { return std::pow(x, double(2.2f)); }
+    double inverse_gamma_double(double x) { return std::pow(x, double(1 / 2.2f)); }
+    simd4f gamma(simd4f x) { return simd4f_pow(x, simd4f_splat(2.2f)); }
+    simd4f inverse_gamma(simd4f x) { return simd4f_pow(x, simd4f_splat(1 / 2.2f)); }
+    simd4f gamma_fast(simd4f x) { return simd4f_pow_fast(x, simd4f_splat(2.2f)); }
+    simd4f inverse_gamma_fast(simd4f x) { return simd4f_pow_fast(x, simd4f_splat(1 / 2.2f)); }
+
+    // By the bits, -ffast-math folds isnan and comparisons with inf
+    unsigned int float_bits(float f) {
+        unsigned int u;
+        std::memcpy(&u, &f, sizeof(u));
+        return u;
+    }
+
+    float from_bits(unsigned int u) {
+        float f;
+        std::memcpy(&f, &u, sizeof(f));
+        return f;
+    }
+
+    bool is_nan(float f) {
+        const unsigned int u = float_bits(f);
+        return (u & 0x7f800000u) == 0x7f800000u && (u & 0x007fffffu) != 0;
+    }
+
+    const float inf = from_bits(0x7f800000u);
+    const float nan = from_bits(0x7fc00000u);
+
+    // log of 0, -0, -1 and 1 is -inf, -inf, nan and 0, of +inf, nan and
+    // -inf +inf, nan and nan
+    bool log_special_cases(math_func f) {
+        const simd4f y = f( simd4f_create(0.0f, -0.0f, -1.0f, 1.0f) );
+        const simd4f z = f( simd4f_create(inf, nan, -inf, 1.0f) );
+        return float_bits(simd4f_get_x(y)) == 0xff800000u && float_bits(simd4f_get_y(y)) == 0xff800000u &&
+               is_nan(simd4f_get_z(y)) && simd4f_get_w(y) == 0 &&
+               float_bits(simd4f_get_x(z)) == 0x7f800000u && is_nan(simd4f_get_y(z)) && is_nan(simd4f_get_z(z));
+    }
+
+    // exp of nan, +inf, -inf and 0 is nan, +inf, 0 and 1
+    bool exp_special_cases(math_func f) {
+        const simd4f y = f( simd4f_create(nan, inf, -inf, 0.0f) );
+        return is_nan(simd4f_get_x(y)) && float_bits(simd4f_get_y(y)) == 0x7f800000u &&
+               float_bits(simd4f_get_z(y)) == 0 && float_bits(simd4f_get_w(y)) == 0x3f800000u;
+    }
+
+    // pow(0, 0), pow(inf, 1), pow(inf, -1) and pow(nan, 0) is 1, inf, 0 and
+    // 1, pow(1, nan), pow(nan, 2), pow(0, -1) and pow(2, -0) 1, nan, inf and 1
+    bool pow_special_cases(simd4f (*f)(simd4f, simd4f)) {
+        const simd4f y = f( simd4f_create(0.0f, inf, inf, nan), simd4f_create(0.0f, 1.0f, -1.0f, 0.0f) );
+        const simd4f z = f( simd4f_create(1.0f, nan, 0.0f, 2.0f), simd4f_create(nan, 2.0f, -1.0f, -0.0f) );
+        return float_bits(simd4f_get_x(y)) == 0x3f800000u && float_bits(simd4f_get_y(y)) == 0x7f800000u &&
+               float_bits(simd4f_get_z(y)) == 0 && float_bits(simd4f_get_w(y)) == 0x3f800000u &&
+               float_bits(simd4f_get_x(z)) == 0x3f800000u && is_nan(simd4f_get_y(z)) &&
+               float_bits(simd4f_get_z(z)) == 0x7f800000u && float_bits(simd4f_get_w(z)) == 0x3f800000u;
+    }
+
+    // Zero stays zero, the rest of the curve is unaffected
+    bool pow_zero_cases(math_func f, double (*expected)(double)) {
+        const simd4f y = f( simd4f_create(0.0f, -0.0f, 0.5f, 1.0f) );
+        return simd4f_get_x(y) == 0 && simd4f_get_y(y) == 0 &&
+               std::fabs(simd4f_get_z(y) - expected(0.5)) < 1e-3 && std::fabs(simd4f_get_w(y) - 1) < 1e-3;
+    }
+
+}
+
+describe(simd4f_math, "exponentials and logarithms") {
+
+    it("should have simd4f_exp and simd4f_exp2 within 2 ulp of libm") {
+        should_be_true( sweep_exp(simd4f_exp, exp, -87, 88.7f, false, ulps) <= 2 );
+        should_be_true( sweep_exp(simd4f_exp2, exp2_double, -125.5f, 127.9f, false, ulps) <= 2 );
+    }
+
+    it("should have simd4f_exp and simd4f_exp2 go to zero and infinity past the range") {
+        simd4f x = simd4f_exp(simd4f_create(-200.0f, 200.0f, 0.0f, 1.0f));
+        should_be_equal_simd4f(x, simd4f_create(0.0f, inf, 1.0f, 2.7182818f), epsilon);
+        x = simd4f_exp2(simd4f_create(-300.0f, 300.0f, 10.0f, -3.0f));
+        should_be_equal_simd4f(x, simd4f_create(0.0f, inf, 1024.0f, 0.125f), epsilon);
+    }
+
+    it("should have simd4f_log and simd4f_log2 within 2 ulp of libm") {
+        should_be_true( sweep_exp(simd4f_log, log, -126, 128, true, ulps) <= 2 );
+        should_be_true( sweep_exp(simd4f_log2, log2_double, -126, 128, true, ulps) <= 2 );
+        should_be_true( sweep_exp(simd4f_log, log, 0.5f, 2, false, ulps) <= 2 );
+        should_be_true( sweep_exp(simd4f_log2, log2_double, 0.5f, 2, false, ulps) <= 2 );
+    }
+
+    it("should have simd4f_pow within its bound of libm for gamma curves") {
+        // 2 + |y log2(x)| ulp, |log2(x)| up to 16 here
+        should_be_true( sweep_exp(gamma, gamma_double, -16, 0, true, relative) <= (2 + 2.2 * 16) / 8388608.0 );
+        should_be_true( sweep_exp(inverse_gamma, inverse_gamma_double, -16, 0, true, relative) <= (2 + 16 / 2.2) / 8388608.0 );
+    }
+
+    it("should have the _fast variants within 2^-12") {
+        const double bound = 1.0 / 4096;
+        should_be_true( sweep_exp(simd4f_exp_fast, exp, -87, 88.7f, false, relative) <= bound );
+        should_be_true( sweep_exp(simd4f_exp2_fast, exp2_double, -125.5f, 127.9f, false, relative) <= bound );
+        should_be_true( sweep_exp(simd4f_log_fast, log, -126, 128, true, absolute) <= bound );
+        should_be_true( sweep_exp(simd4f_log2_fast, log2_double, -126, 128, true, absolute) <= bound );
+        should_be_true( sweep_exp(gamma_fast, gamma_double, -16, 0, true, relative) <= bound * 3.2 );
+    }
+
+    it("should have log of zero be -inf, of negatives nan and of inf inf") {
+        should_be_true( log_special_cases(simd4f_log) );
+        should_be_true( log_special_cases(simd4f_log2) );
+        should_be_true( log_special_cases(simd4f_log_fast) );
+        should_be_true( log_special_cases(simd4f_log2_fast) );
+    }
+
+    it("should have pow of zero be zero for positive exponents") {
+        should_be_true( pow_zero_cases(gamma, gamma_double) );
+        should_be_true( pow_zero_cases(inverse_gamma, inverse_gamma_double) );
+        should_be_true( pow_zero_cases(gamma_fast, gamma_double) );
+        should_be_true( pow_zero_cases(inverse_gamma_fast, inverse_gamma_double) );
+    }
+
+    it("should have exp pass nan through and take infinities to inf and zero") {
+        should_be_true( exp_special_cases(simd4f_exp) );
+        should_be_true( exp_special_cases(simd4f_exp2) );
+        should_be_true( exp_special_cases(simd4f_exp_fast) );
+        should_be_true( exp_special_cases(simd4f_exp2_fast) );
+    }
+
+    it("should have pow give the C99 special values") {
+        should_be_true( pow_special_cases(simd4f_pow) );
+        should_be_true( pow_special_cases(simd4f_pow_fast) );
+    }
+
+}
@@ -0,0 +1,142 @@
+#include "spec_helper.h"
+
+describe(simd4i, "sanity") {
+    it("VECTORIAL_SIMD4I_TYPE should be defined to a string") {
+        std::cout << "Simd4i type: " << VECTORIAL_SIMD4I_TYPE << std::endl;
+    }
+}
+
+describe(simd4i, "creating") {
+
+    it("should be possible to create with simd4i_create") {
+        simd4i x = simd4i_create(1, -2, 3, -4);
+        should_equal( simd4i_get_x(x), 1 );
+        should_equal( simd4i_get_y(x), -2 );
+        should_equal( simd4i_get_z(x), 3 );
+        should_equal( simd4i_get_w(x), -4 );
+    }
+
+    it("should have simd4i_zero and simd4i_splat") {
+        should_be_equal_simd4i( simd4i_zero(), simd4i_create(0, 0, 0, 0) );
+        should_be_equal_simd4i( simd4i_splat(-7), simd4i_create(-7, -7, -7, -7) );
+    }
+
+    it("should have simd4i_uload4 and simd4i_ustore4 for unaligned int arrays") {
+        int storage[6] = { 0, 10, 20, 30, 40, 0 };
+        simd4i x = simd4i_uload4(storage + 1);
+        should_be_equal_simd4i( x, simd4i_create(10, 20, 30, 40) );
+
+        simd4i_ustore4( simd4i_create(-1, -2, -3, -4), storage + 1 );
+        should_equal( storage[0], 0 );
+        should_equal( storage[1], -1 );
+        should_equal( storage[4], -4 );
+        should_equal( storage[5], 0 );
+    }
+
+}
+
+describe(simd4i, "arithmetic") {
+
+    it("should have simd4i_add, simd4i_sub and simd4i_mul") {
+        const simd4i a = simd4i_create(1, -20, 300, 40000);
+        const simd4i b = simd4i_create(7, 3, -11, 50000);
+        should_be_equal_simd4i( simd4i_add(a, b), simd4i_create(8, -17, 289, 90000) );
+        should_be_equal_simd4i( simd4i_sub(a, b), simd4i_create(-6, -23, 311, -10000) );
+        should_be_equal_simd4i( simd4i_mul(a, b), simd4i_create(7, -60, -3300, 2000000000) );
+    }
+
+    it("should wrap around on overflow") {
+        const simd4i big = simd4i_splat(0x7fffffff);
+        should_be_equal_simd4i( simd4i_add(big, simd4i_splat(1)), simd4i_splat((int)0x80000000) );
+        should_be_equal_simd4i( simd4i_mul(simd4i_create(65536, 65537, -65536, 3), simd4i_create(65536, 65537, 65536, 0x55555556)),
+                                simd4i_create(0, 131073, 0, 2) );
+    }
+
+    it("should have arithmetic and logical shifts") {
+        const simd4i a = simd4i_create(1, -1, -256, 0x40000000);
+        should_be_equal_simd4i( simd4i_shift_left(a, 1), simd4i_create(2, -2, -512, (int)0x80000000) );
+        should_be_equal_simd4i( simd4i_shift_right(a, 4), simd4i_create(0, -1, -16, 0x04000000) );
+        should_be_equal_simd4i( simd4i_shift_right_logical(a, 4), simd4i_create(0, 0x0fffffff, 0x0ffffff0, 0x04000000) );
+        should_be_equal_simd4i( simd4i_shift_left(a, 0), a );
+        should_be_equal_simd4i( simd4i_shift_right(a, 31), simd4i_create(0, -1, -1, 0) );
+    }
+
+}
+
+describe(simd4i, "bitwise") {
+
+    it("should have simd4i_and, simd4i_or, simd4i_xor and simd4i_not") {
+        const simd4i a = simd4i_create(0x0f0f, -1, 0, 0x12345678);
+        const simd4i b = simd4i_create(0x00ff, 0x5555, -1, 0x0000ffff);
+        should_be_equal_simd4i( simd4i_and(a, b), simd4i_create(0x000f, 0x5555, 0, 0x5678) );
+        should_be_equal_simd4i( simd4i_or(a, b), simd4i_create(0x0fff, -1, -1, 0x1234ffff) );
+        should_be_equal_simd4i( simd4i_xor(a, b), simd4i_create(0x0ff0, ~0x5555, -1, 0x1234a987) );
+        should_be_equal_simd4i( simd4i_not(a), simd4i_create(~0x0f0f, 0, -1, ~0x12345678) );
+    }
+
+}
+
+describe(simd4i, "comparing") {
+
+    it("should have compares giving masks of all ones or zero") {
+        const simd4i a = simd4i_create(1, -5, 7, (int)0x80000000);
+        const simd4i b = simd4i_create(1, 3, -7, 0x7fffffff);
+        should_be_equal_simd4i( simd4i_cmpeq(a, b), simd4i_create(-1, 0, 0, 0) );
+        should_be_equal_simd4i( simd4i_cmpgt(a, b), simd4i_create(0, 0, -1, 0) );
+        should_be_equal_simd4i( simd4i_cmplt(a, b), simd4i_create(0, -1, 0, -1) );
+    }
+
+    it("should have signed simd4i_min and simd4i_max") {
+        const simd4i a = simd4i_create(1, -5, 7, (int)0x80000000);
+        const simd4i b = simd4i_create(1, 3, -7, 0x7fffffff);
+        should_be_equal_simd4i( simd4i_min(a, b), simd4i_create(1, -5, -7, (int)0x80000000) );
+        should_be_equal_simd4i( simd4i_max(a, b), simd4i_create(1, 3, 7, 0x7fffffff) );
+    }
+
+}
+
+describe(simd4i, "conversions") {
+
+    const int epsilon = 1;
+
+    it("should have simd4f_to_simd4i_trunc rounding towards zero") {
+        const simd4f x = simd4f_create(1.75f, -1.75f, 0.5f, -1000000.5f);
+        should_be_equal_simd4i( simd4f_to_simd4i_trunc(x), simd4i_create(1, -1, 0, -1000000) );
+    }
+
+    it("should have simd4f_to_simd4i_round rounding to nearest") {
+        const simd4f x = simd4f_create(1.75f, -1.25f, 2.4f, -1000000.75f);
+        should_be_equal_simd4i( simd4f_to_simd4i_round(x), simd4i_create(2, -1, 2, -1000001) );
+    }
+
+    it("should have simd4f_to_simd4i_round rounding halves to even") {
+        const simd4f x = simd4f_create(0.5f, 1.5f, 2.5f, -2.5f);
+        should_be_equal_simd4i( simd4f_to_simd4i_round(x), simd4i_create(0, 2, 2, -2) );
+    }
+
+    it("should have simd4i_to_simd4f") {
+        const simd4f x = simd4i_to_simd4f( simd4i_create(3, -16777216, 0, 123456) );
+        should_be_equal_simd4f( x, simd4f_create(3, -16777216.0f, 0, 123456), epsilon );
+    }
+
+    it("should bit cast between simd4f and simd4i") {
+        const simd4i bits = simd4f_as_simd4i( simd4f_create(1.0f, -2.0f, 0.0f, 0.5f) );
+        should_be_equal_simd4i( bits, simd4i_create(0x3f800000, (int)0xc0000000, 0, 0x3f000000) );
+
+        const simd4f x = simd4i_as_simd4f( simd4i_create(0x40400000, (int)0xbf800000, 0x3e800000, 0x41200000) );
+        should_be_equal_simd4f( x, simd4f_create(3, -1, 0.25f, 10), epsilon );
+    }
+
+    it("should mask floats with the bit casts and integer compares") {
+        // Absolute value and a select by integer compare, as used for
+        // picking quadrants in the range reduction
+        const simd4f x = simd4f_create(-1.5f, -2.0f, -0.25f, 8.0f);
+        const simd4f a = simd4i_as_simd4f( simd4i_and( simd4f_as_simd4i(x), simd4i_splat(0x7fffffff) ) );
+        should_be_equal_simd4f( a, simd4f_create(1.5f, 2.0f, 0.25f, 8.0f), epsilon );
+
+        const simd4i m = simd4i_cmpgt( simd4i_create(1, 0, 1, 0), simd4i_zero() );
+        const simd4f s = simd4i_as_simd4f( simd4i_or( simd4i_and(m, simd4f_as_simd4i(x)), simd4i_and(simd4i_not(m), simd4f_as_simd4i(a)) ) );
+        should_be_equal_simd4f( s, simd4f_create(-1.5f, 2.0f, -0.25f, 8.0f), epsilon );
+    }
+
+}
@@ -0,0 +1,333 @@
+#include "spec_fixtures.h"
+#include "vectorial/simd4x4f_array.h"
+
+const int epsilon = 1;
+
+namespace {
+
+    const size_t count = 7;
+
+    simd4f test_point(size_t i) {
+        const float f = float(i);
+        return simd4f_create(f, 2*f - 3, 4 - f, 1 + f);
+    }
+
+    typedef void (*matrix_array_func)(const simd4x4f*, const simd4x4f*, simd4x4f*, size_t);
+
+    // a_step and b_step 0 for the single matrix side
+    void check_matrix_mul_array(specific::SpecBase* spec, matrix_array_func f, size_t a_step, size_t b_step) {
+        simd4x4f a[count], b[count], expected[count];
+        for(size_t i = 0; i < count; ++i) {
+            a[i] = test_matrix(i);
+            b[i] = test_matrix(count - i);
+            simd4x4f_matrix_mul(&a[i*a_step], &b[i*b_step], &expected[i]);
+        }
+
+        // Output at every 16 byte offset within 64, streams have separate
+        // paths for outputs not aligned to the register size
+        const size_t total = 4 * (count + 2);
+        simd4f_aligned16 simd4f columns[total];
+
+        for(int isa = VECTORIAL_ISA_GENERIC; isa <= vectorial_cpu_isa(); ++isa) {
+            vectorial_dispatch_force((vectorial_isa)isa);
+            for(size_t n = 0; n <= count; ++n) {
+                for(size_t offset = 0; offset < 4; ++offset) {
+                    for(size_t i = 0; i < total; ++i) columns[i] = simd4f_splat(-1);
+                    simd4x4f* x = (simd4x4f*)(columns + offset);
+                    f(a, b, x, n);
+                    for(size_t i = 0; i < n; ++i) {
+                        should_be_equal_simd4x4f_(spec, x[i], expected[i], epsilon, __FILE__, __LINE__);
+                    }
+                    for(size_t i = 0; i < total; ++i) {
+                        if( i >= offset && i < 4*n + offset ) continue;
+                        should_be_equal_simd4f_(spec, columns[i], simd4f_splat(-1), epsilon, __FILE__, __LINE__);
+                    }
+                }
+            }
+        }
+        vectorial_dispatch_force(VECTORIAL_ISA_DEFAULT);
+    }
+
+    typedef void (*array_func)(const simd4x4f*, const simd4f*, simd4f*, size_t);
+    typedef void (*element_func)(const simd4x4f*, const simd4f*, simd4f*);
+
+    // Every count up to 7 so all tails get run, and nothing past n written
+    void check_transform_array(specific::SpecBase* spec, array_func f, element_func g) {
+        simd4x4f m = test_matrix(3);
+        simd4f in[count], x[count], expected[count];
+        for(size_t i = 0; i < count; ++i) {
+            in[i] = test_point(i);
+            g(&m, &in[i], &expected[i]);
+        }
+
+        for(int isa = VECTORIAL_ISA_GENERIC; isa <= vectorial_cpu_isa(); ++isa) {
+            vectorial_dispatch_force((vectorial_isa)isa);
+            for(size_t n = 0; n <= count; ++n) {
+                for(size_t i = 0; i < count; ++i) x[i] = simd4f_splat(-1);
+                f(&m, in, x, n);
+                for(size_t i = 0; i < n; ++i) {
+                    should_be_equal_simd4f_(spec, x[i], expected[i], epsilon, __FILE__, __LINE__);
+                }
+                for(size_t i = n; i < count; ++i) {
+                    should_be_equal_simd4f_(spec, x[i], simd4f_splat(-1), epsilon, __FILE__, __LINE__);
+                }
+            }
+        }
+        vectorial_dispatch_force(VECTORIAL_ISA_DEFAULT);
+    }
+
+}
+
+describe(simd4x4f_array, "dispatch") {
+
+    it("should report the instruction set in use") {
+        std::cout << "Dispatch: " << vectorial_isa_name(vectorial_dispatch_isa())
+                  << " (cpu " << vectorial_isa_name(vectorial_cpu_isa()) << ")" << std::endl;
+    }
+
+    it("should not go above what the cpu supports when forced") {
+        vectorial_dispatch_force(VECTORIAL_ISA_AVX512);
+        should_be_true( vectorial_dispatch_isa() <= vectorial_cpu_isa() );
+        vectorial_dispatch_force(VECTORIAL_ISA_DEFAULT);
+        should_be_true( vectorial_dispatch_isa() == vectorial_cpu_isa() );
+    }
+
+    it("should run the generic kernels when forced to") {
+        vectorial_dispatch_force(VECTORIAL_ISA_GENERIC);
+        should_equal( vectorial_dispatch_isa(), VECTORIAL_ISA_GENERIC );
+        vectorial_dispatch_force(VECTORIAL_ISA_DEFAULT);
+        should_be_true( vectorial_dispatch_isa() != VECTORIAL_ISA_DEFAULT );
+    }
+
+}
+
+describe(simd4x4f_array, "kernels") {
+
+    it("should have simd4x4f_matrix_mul_array multiplying pairwise, for every instruction set") {
+        check_matrix_mul_array(this, simd4x4f_matrix_mul_array, 1, 1);
+        check_matrix_mul_array(this, simd4x4f_matrix_mul_array_stream, 1, 1);
+    }
+
+    it("should have simd4x4f_matrix_mul_one_by_array multiplying one by many, for every instruction set") {
+        check_matrix_mul_array(this, simd4x4f_matrix_mul_one_by_array, 0, 1);
+        check_matrix_mul_array(this, simd4x4f_matrix_mul_one_by_array_stream, 0, 1);
+    }
+
+    it("should have simd4x4f_matrix_mul_array_by_one multiplying many by one, for every instruction set") {
+        check_matrix_mul_array(this, simd4x4f_matrix_mul_array_by_one, 1, 0);
+        check_matrix_mul_array(this, simd4x4f_matrix_mul_array_by_one_stream, 1, 0);
+    }
+
+    it("should allow simd4x4f_matrix_mul_array output over an input") {
+        simd4x4f a[count], b[count], expected[count];
+        for(size_t i = 0; i < count; ++i) {
+            a[i] = test_matrix(i);
+            b[i] = test_matrix(count - i);
+            simd4x4f_matrix_mul(&a[i], &b[i], &expected[i]);
+        }
+
+        simd4x4f_matrix_mul_array(a, b, a, count);
+        for(size_t i = 0; i < count; ++i) {
+            should_be_equal_simd4x4f(a[i], expected[i], epsilon);
+        }
+    }
+
+    it("should allow the array output over the array input of one by many and many by one") {
+        for(int isa = VECTORIAL_ISA_GENERIC; isa <= vectorial_cpu_isa(); ++isa) {
+            vectorial_dispatch_force((vectorial_isa)isa);
+            const simd4x4f one = test_matrix(9);
+            simd4x4f x[count], y[count], ex[count], ey[count];
+            for(size_t i = 0; i < count; ++i) {
+                x[i] = y[i] = test_matrix(i);
+                simd4x4f_matrix_mul(&one, &x[i], &ex[i]);
+                simd4x4f_matrix_mul(&y[i], &one, &ey[i]);
+            }
+
+            simd4x4f_matrix_mul_one_by_array(&one, x, x, count);
+            simd4x4f_matrix_mul_array_by_one(y, &one, y, count);
+            for(size_t i = 0; i < count; ++i) {
+                should_be_equal_simd4x4f(x[i], ex[i], epsilon);
+                should_be_equal_simd4x4f(y[i], ey[i], epsilon);
+            }
+        }
+        vectorial_dispatch_force(VECTORIAL_ISA_DEFAULT);
+    }
+
+    it("should have simd4x4f_matrix_point3_mul_array transforming points, for every instruction set") {
+        check_transform_array(this, simd4x4f_matrix_point3_mul_array, simd4x4f_matrix_point3_mul);
+    }
+
+    it("should have simd4x4f_matrix_vector3_mul_array transforming vectors, for every instruction set") {
+        check_transform_array(this, simd4x4f_matrix_vector3_mul_array, simd4x4f_matrix_vector3_mul);
+    }
+
+    it("should have simd4x4f_matrix_vector_mul_array transforming vec4, for every instruction set") {
+        check_transform_array(this, simd4x4f_matrix_vector_mul_array, simd4x4f_matrix_vector_mul);
+    }
+
+    it("should have simd4x4f_matrix_point3_project_array dividing by w, for every instruction set") {
+        const int epsilon = 4; // A fused variant rounds differently, both x and w
+        simd4x4f m;
+        simd4x4f_perspective(&m, 1.0f, 1.5f, 1.0f, 100.0f);
+        simd4f in[count], x[count], expected[count];
+        for(size_t i = 0; i < count; ++i) {
+            in[i] = simd4f_create(i + 0.5f, 2.5f - i, -5.0f - i, 1);
+            simd4x4f_matrix_point3_mul(&m, &in[i], &expected[i]);
+            expected[i] = simd4f_div(expected[i], simd4f_splat_w(expected[i]));
+        }
+
+        for(int isa = VECTORIAL_ISA_GENERIC; isa <= vectorial_cpu_isa(); ++isa) {
+            vectorial_dispatch_force((vectorial_isa)isa);
+            for(size_t n = 0; n <= count; ++n) {
+                for(size_t i = 0; i < count; ++i) x[i] = simd4f_splat(-1);
+                simd4x4f_matrix_point3_project_array(&m, in, x, n);
+                for(size_t i = 0; i < n; ++i) {
+                    should_be_equal_simd4f(x[i], expected[i], epsilon);
+                }
+                for(size_t i = n; i < count; ++i) {
+                    should_be_equal_simd4f(x[i], simd4f_splat(-1), epsilon);
+                }
+            }
+        }
+        vectorial_dispatch_force(VECTORIAL_ISA_DEFAULT);
+    }
+
+}
+
+describe(simd4x4f_array, "packed float3 kernels") {
+
+    const size_t packed_count = 9;
+
+    it("should have simd4x4f_matrix_point3_mul_packed3, simd4x4f_matrix_vector3_mul_packed3 and simd4x4f_matrix_point3_project_packed3") {
+        simd4x4f m;
+        simd4x4f_perspective(&m, 1.0f, 1.5f, 1.0f, 100.0f);
+        m.w = simd4f_add(m.w, simd4f_create(1, 2, 3, 0));
+
+        float in[3*packed_count], x[3*packed_count + 1];
+        for(size_t i = 0; i < packed_count; ++i) {
+            in[3*i + 0] = float(i % 7) - 3.5f;
+            in[3*i + 1] = 2.0f * i + 0.5f;
+            in[3*i + 2] = -2.0f - i;
+        }
+
+        for(int kind = 0; kind < 3; ++kind) {
+            for(size_t n = 0; n <= packed_count; ++n) {
+                for(size_t i = 0; i <= 3*packed_count; ++i) x[i] = -1;
+
+                if( kind == 0 ) simd4x4f_matrix_point3_mul_packed3(&m, in, x, n);
+                if( kind == 1 ) simd4x4f_matrix_vector3_mul_packed3(&m, in, x, n);
+                if( kind == 2 ) simd4x4f_matrix_point3_project_packed3(&m, in, x, n);
+
+                for(size_t i = 0; i < n; ++i) {
+                    const simd4f p = simd4f_uload3(in + 3*i);
+                    simd4f e;
+                    if( kind == 1 ) simd4x4f_matrix_vector3_mul(&m, &p, &e);
+                    else simd4x4f_matrix_point3_mul(&m, &p, &e);
+                    if( kind == 2 ) e = simd4f_div(e, simd4f_splat_w(e));
+                    should_be_close_to(x[3*i + 0], simd4f_get_x(e), epsilon);
+                    should_be_close_to(x[3*i + 1], simd4f_get_y(e), epsilon);
+                    should_be_close_to(x[3*i + 2], simd4f_get_z(e), epsilon);
+                }
+                for(size_t i = 3*n; i <= 3*packed_count; ++i) {
+                    should_be_close_to(x[i], -1, epsilon);
+                }
+            }
+        }
+    }
+
+    it("should allow the packed output over the input") {
+        simd4x4f m = test_matrix(2);
+        float in[3*packed_count], x[3*packed_count];
+        for(size_t i = 0; i < 3*packed_count; ++i) in[i] = x[i] = float(i);
+
+        simd4x4f_matrix_point3_mul_packed3(&m, x, x, packed_count);
+        for(size_t i = 0; i < packed_count; ++i) {
+            const simd4f p = simd4f_uload3(in + 3*i);
+            simd4f e;
+            simd4x4f_matrix_point3_mul(&m, &p, &e);
+            should_be_close_to(x[3*i + 0], simd4f_get_x(e), epsilon);
+            should_be_close_to(x[3*i + 1], simd4f_get_y(e), epsilon);
+            should_be_close_to(x[3*i + 2], simd4f_get_z(e), epsilon);
+        }
+    }
+
+}
+
+
+namespace {
+
+    const size_t inverse_count = 19;
+
+    // Well conditioned and all different, the last one singular
+    simd4x4f invertible_matrix(size_t i) {
+        const float f = 0.25f * float(i);
+        simd4x4f m = simd4x4f_create( simd4f_create(4+f, 1, -2, 0.5f),
+                                      simd4f_create(1, 3-f, 0.5f, 1),
+                                      simd4f_create(-1, 0.5f, 5, f),
+                                      simd4f_create(2, -f, 1, 6) );
+        if( i == inverse_count - 1 ) m.w = m.x;
+        return m;
+    }
+
+    // M * M^-1 = I, to an absolute tolerance as most elements are 0
+    bool is_inverse(const simd4x4f& m, const simd4x4f& inv) {
+        simd4x4f p, identity;
+        simd4x4f_matrix_mul(&m, &inv, &p);
+        simd4x4f_identity(&identity);
+        const simd4f d[4] = { simd4f_sub(p.x, identity.x), simd4f_sub(p.y, identity.y),
+                              simd4f_sub(p.z, identity.z), simd4f_sub(p.w, identity.w) };
+        for(int i = 0; i < 4; ++i) {
+            if( simd4f_get_x( simd4f_dot4(d[i], d[i]) ) > 1e-10f ) return false;
+        }
+        return true;
+    }
+
+}
+
+describe(simd4x4f_array, "batched inverse") {
+
+    it("should have simd4x4f_inverse4 and simd4x4f_inverse8 with the determinants") {
+        simd4x4f in[8], x[8];
+        for(size_t i = 0; i < 8; ++i) in[i] = invertible_matrix(i);
+
+        in[2] = simd4x4f_create( simd4f_create(2, 0, 0, 0), simd4f_create(0, 3, 0, 0),
+                                 simd4f_create(0, 0, 4, 0), simd4f_create(0, 0, 0, 5) );
+        in[5] = in[2];
+
+        const simd4f d4 = simd4x4f_inverse4(in, x);
+        for(size_t i = 0; i < 4; ++i) should_be_true( is_inverse(in[i], x[i]) );
+        should_be_close_to( simd4f_get_z(d4), 120, epsilon );
+
+        const simd8f d8 = simd4x4f_inverse8(in, x);
+        for(size_t i = 0; i < 8; ++i) should_be_true( is_inverse(in[i], x[i]) );
+        float det[8];
+        simd8f_ustore8(d8, det);
+        should_be_close_to( det[2], 120, epsilon );
+        should_be_close_to( det[5], 120, epsilon );
+    }
+
+    it("should have simd4x4f_inverse_array and simd4x4f_inverse_array_det for any count, in place too") {
+        simd4x4f in[inverse_count], x[inverse_count + 1];
+        float det[inverse_count + 1];
+        for(size_t i = 0; i < inverse_count; ++i) in[i] = invertible_matrix(i);
+
+        for(size_t n = 0; n < inverse_count; ++n) {
+            for(size_t i = 0; i <= inverse_count; ++i) { x[i] = simd4x4f_create(simd4f_splat(-1), simd4f_splat(-1), simd4f_splat(-1), simd4f_splat(-1)); det[i] = -1; }
+            simd4x4f_inverse_array_det(in, x, det, n);
+            for(size_t i = 0; i < n; ++i) {
+                should_be_true( is_inverse(in[i], x[i]) );
+                should_be_true( fabsf(det[i]) > 1 );
+            }
+            should_be_equal_simd4f(x[n].x, simd4f_splat(-1), epsilon);
+            should_be_close_to(det[n], -1, epsilon);
+        }
+
+        simd4x4f_inverse_array_det(in, x, det, inverse_count);
+        should_be_close_to(det[inverse_count - 1], 0, epsilon);
+
+        for(size_t i = 0; i < inverse_count; ++i) x[i] = in[i];
+        simd4x4f_inverse_array(x, x, inverse_count - 1);
+        for(size_t i = 0; i < inverse_count - 1; ++i) should_be_true( is_inverse(in[i], x[i]) );
+    }
+
+}
@@ -0,0 +1,307 @@
+#include "spec_helper.h"
+
+const int epsilon = 1;
+
+describe(simd8f, "sanity") {
+    it("VECTORIAL_SIMD8F_TYPE should be defined to a string") {
+        std::cout << "Simd8f type: " << VECTORIAL_SIMD8F_TYPE << std::endl;
+    }
+}
+
+describe(simd8f, "creating") {
+
+    it("should be possible to create with simd8f_create") {
+
+        simd8f x = simd8f_create(1, 2, 3, 4, 5, 6, 7, 8);
+
+        // octave simd8f: [1,2,3,4,5,6,7,8]
+        should_be_equal_simd8f(x, simd8f_create(1.000000000000000f, 2.000000000000000f, 3.000000000000000f, 4.000000000000000f, 5.000000000000000f, 6.000000000000000f, 7.000000000000000f, 8.000000000000000f), epsilon );
+
+    }
+
+    it("should have simd8f_zero for zero vector") {
+
+        simd8f x = simd8f_zero();
+
+        // octave simd8f: [0,0,0,0,0,0,0,0]
+        should_be_equal_simd8f(x, simd8f_create(0.000000000000000f, 0.000000000000000f, 0.000000000000000f, 0.000000000000000f, 0.000000000000000f, 0.000000000000000f, 0.000000000000000f, 0.000000000000000f), epsilon );
+    }
+
+    it("should have simd8f_combine for creating from two simd4f") {
+
+        simd8f x = simd8f_combine( simd4f_create(1,2,3,4), simd4f_create(5,6,7,8) );
+
+        should_be_equal_simd8f(x, simd8f_create(1, 2, 3, 4, 5, 6, 7, 8), epsilon );
+    }
+
+    it("should have simd8f_get_low and simd8f_get_high for splitting to two simd4f") {
+
+        simd8f a = simd8f_create(1, 2, 3, 4, 5, 6, 7, 8);
+
+        should_be_equal_simd4f(simd8f_get_low(a), simd4f_create(1,2,3,4), epsilon );
+        should_be_equal_simd4f(simd8f_get_high(a), simd4f_create(5,6,7,8), epsilon );
+    }
+
+}
+
+#ifdef _MSC_VER
+#include <malloc.h>
+#else
+#include <alloca.h>
+#endif
+
+#define unaligned_mem(n) ((float*)((unsigned char*)alloca(sizeof(float)*n+4)+4))
+
+describe(simd8f, "utilities") {
+
+    it("should have simd8f_uload8 for loading eight float values from an unaligned float array into simd8f") {
+        float *f = unaligned_mem(8);
+        for(int i = 0; i < 8; ++i) f[i] = float(i + 1);
+        simd8f x = simd8f_uload8(f);
+        // octave simd8f: [1,2,3,4,5,6,7,8]
+        should_be_equal_simd8f(x, simd8f_create(1.000000000000000f, 2.000000000000000f, 3.000000000000000f, 4.000000000000000f, 5.000000000000000f, 6.000000000000000f, 7.000000000000000f, 8.000000000000000f), epsilon );
+    }
+
+    it("should have simd8f_ustore8 for storing eight float values from simd8f to an unaligned array") {
+        float *f = unaligned_mem(8);
+        for(int i = 0; i < 8; ++i) f[i] = -1.0f;
+        simd8f a = simd8f_create(1, 2, 3, 4, 5, 6, 7, 8);
+        simd8f_ustore8(a, f);
+        for(int i = 0; i < 8; ++i) {
+            should_be_close_to(f[i], float(i + 1), epsilon);
+        }
+    }
+
+    it("should have simd8f_splat that expands a single scalar to all elements") {
+        simd8f x = simd8f_splat(42);
+        // octave simd8f: [42,42,42,42,42,42,42,42]
+        should_be_equal_simd8f(x, simd8f_create(42.000000000000000f, 42.000000000000000f, 42.000000000000000f, 42.000000000000000f, 42.000000000000000f, 42.000000000000000f, 42.000000000000000f, 42.000000000000000f), epsilon );
+    }
+
+    it("should have simd8f_splat_x,y,z,w splatting an element within each half") {
+        simd8f a = simd8f_create(1, 2, 3, 4, 5, 6, 7, 8);
+
+        simd8f x = simd8f_splat_x(a);
+        should_be_equal_simd8f(x, simd8f_create(1, 1, 1, 1, 5, 5, 5, 5), epsilon );
+
+        x = simd8f_splat_y(a);
+        should_be_equal_simd8f(x, simd8f_create(2, 2, 2, 2, 6, 6, 6, 6), epsilon );
+
+        x = simd8f_splat_z(a);
+        should_be_equal_simd8f(x, simd8f_create(3, 3, 3, 3, 7, 7, 7, 7), epsilon );
+
+        x = simd8f_splat_w(a);
+        should_be_equal_simd8f(x, simd8f_create(4, 4, 4, 4, 8, 8, 8, 8), epsilon );
+    }
+
+    it("should have simd8f_sum that adds elements of each half") {
+        simd8f a = simd8f_create(1, 2, 3, 4, 5, 6, 7, 8);
+        simd8f x = simd8f_sum(a);
+        // octave simd8f: [10,10,10,10,26,26,26,26]
+        should_be_equal_simd8f(x, simd8f_create(10.000000000000000f, 10.000000000000000f, 10.000000000000000f, 10.000000000000000f, 26.000000000000000f, 26.000000000000000f, 26.000000000000000f, 26.000000000000000f), epsilon );
+    }
+
+    it("should have simd8f_reciprocal") {
+        simd8f a = simd8f_create(0.00001f, 2.00001f, 3.0f, 99999999.0f, 0.5f, 4.0f, 16.0f, 100.0f);
+        simd8f x = simd8f_reciprocal(a);
+        // octave simd8f: 1 ./ [0.00001, 2.00001, 3.0, 99999999.0, 0.5, 4.0, 16.0, 100.0]
+        should_be_equal_simd8f(x, simd8f_create(99999.999999999985448f, 0.499997500012500f, 0.333333333333333f, 0.000000010000000f, 2.000000000000000f, 0.250000000000000f, 0.062500000000000f, 0.010000000000000f), epsilon );
+    }
+
+    it("should have simd8f_sqrt") {
+        simd8f a = simd8f_create(0.00001f, 2.00001f, 3.0f, 99999999.0f, 0.5f, 4.0f, 16.0f, 100.0f);
+        simd8f x = simd8f_sqrt(a);
+        // octave simd8f: sqrt([0.00001, 2.00001, 3.0, 99999999.0, 0.5, 4.0, 16.0, 100.0])
+        should_be_equal_simd8f(x, simd8f_create(0.003162277660168f, 1.414217097902582f, 1.732050807568877f, 9999.999949999999444f, 0.707106781186548f, 2.000000000000000f, 4.000000000000000f, 10.000000000000000f), epsilon );
+
+        x = simd8f_sqrt( simd8f_zero() );
+        should_be_equal_simd8f(x, simd8f_zero(), epsilon );
+    }
+
+    it("should have simd8f_rsqrt for reciprocal of square-root") {
+        simd8f a = simd8f_create(0.00001f, 2.00001f, 3.0f, 99999999.0f, 0.5f, 4.0f, 16.0f, 100.0f);
+        simd8f x = simd8f_rsqrt(a);
+        const int epsilon = 4; // Grant larger error
+        // octave simd8f: 1 ./ sqrt([0.00001, 2.00001, 3.0, 99999999.0, 0.5, 4.0, 16.0, 100.0])
+        should_be_equal_simd8f(x, simd8f_create(316.227766016837904f, 0.707105013426224f, 0.577350269189626f, 0.000100000000500f, 1.414213562373095f, 0.500000000000000f, 0.250000000000000f, 0.100000000000000f), epsilon );
+    }
+
+}
+
+describe(simd8f, "arithmetic with another simd8f") {
+
+    it("should have simd8f_add for component-wise addition") {
+        simd8f a = simd8f_create(1, 2, 3, 4, 5, 6, 7, 8);
+        simd8f b = simd8f_create(10, 20, 30, 40, 50, 60, 70, 80);
+
+        simd8f x = simd8f_add(a,b);
+        // octave simd8f: [1,2,3,4,5,6,7,8] + [10,20,30,40,50,60,70,80]
+        should_be_equal_simd8f(x, simd8f_create(11.000000000000000f, 22.000000000000000f, 33.000000000000000f, 44.000000000000000f, 55.000000000000000f, 66.000000000000000f, 77.000000000000000f, 88.000000000000000f), epsilon );
+    }
+
+    it("should have simd8f_sub for component-wise subtraction") {
+        simd8f a = simd8f_create(1, 2, 3, 4, 5, 6, 7, 8);
+        simd8f b = simd8f_create(10, 20, 30, 40, 50, 60, 70, 80);
+
+        simd8f x = simd8f_sub(b,a);
+        // octave simd8f: [10,20,30,40,50,60,70,80] - [1,2,3,4,5,6,7,8]
+        should_be_equal_simd8f(x, simd8f_create(9.000000000000000f, 18.000000000000000f, 27.000000000000000f, 36.000000000000000f, 45.000000000000000f, 54.000000000000000f, 63.000000000000000f, 72.000000000000000f), epsilon );
+    }
+
+    it("should have simd8f_mul for component-wise multiply") {
+        simd8f a = simd8f_create(1, 2, 3, 4, 5, 6, 7, 8);
+        simd8f b = simd8f_create(10, 20, 30, 40, 50, 60, 70, 80);
+
+        simd8f x = simd8f_mul(a,b);
+        // octave simd8f: [1,2,3,4,5,6,7,8] .* [10,20,30,40,50,60,70,80]
+        should_be_equal_simd8f(x, simd8f_create(10.000000000000000f, 40.000000000000000f, 90.000000000000000f, 160.000000000000000f, 250.000000000000000f, 360.000000000000000f, 490.000000000000000f, 640.000000000000000f), epsilon );
+    }
+
+    it("should have simd8f_div for component-wise division") {
+        simd8f a = simd8f_create(1, 2, 3, 4, 5, 6, 7, 8);
+        simd8f b = simd8f_create(10, 20, 30, 40, 50, 60, 70, 80);
+
+        simd8f x = simd8f_div(b,a);
+        // octave simd8f: [10,20,30,40,50,60,70,80] ./ [1,2,3,4,5,6,7,8]
+        should_be_equal_simd8f(x, simd8f_create(10.000000000000000f, 10.000000000000000f, 10.000000000000000f, 10.000000000000000f, 10.000000000000000f, 10.000000000000000f, 10.000000000000000f, 10.000000000000000f), epsilon );
+    }
+
+    it("should have simd8f_madd for multiply-add") {
+        simd8f a = simd8f_create(1, 2, 3, 4, 5, 6, 7, 8);
+        simd8f b = simd8f_splat(100);
+        simd8f c = simd8f_create(6, 7, 8, 9, 10, 11, 12, 13);
+
+        simd8f x = simd8f_madd(a,b,c);
+        // octave simd8f: [1,2,3,4,5,6,7,8] .* 100 .+ [6,7,8,9,10,11,12,13]
+        should_be_equal_simd8f(x, simd8f_create(106.000000000000000f, 207.000000000000000f, 308.000000000000000f, 409.000000000000000f, 510.000000000000000f, 611.000000000000000f, 712.000000000000000f, 813.000000000000000f), epsilon );
+
+    }
+
+}
+
+
+describe(simd8f, "vector math") {
+
+    it("should have simd8f_dot4 for four component dot product of each half") {
+        simd8f a = simd8f_create(1, 2, 3, 4, 5, 6, 7, 8);
+        simd8f b = simd8f_create(10, 20, 30, 40, 50, 60, 70, 80);
+
+        simd8f x = simd8f_dot4(a,b);
+        // octave simd8f: [ones(1,4)*dot([1,2,3,4], [10,20,30,40]), ones(1,4)*dot([5,6,7,8], [50,60,70,80])]
+        should_be_equal_simd8f(x, simd8f_create(300.000000000000000f, 300.000000000000000f, 300.000000000000000f, 300.000000000000000f, 1740.000000000000000f, 1740.000000000000000f, 1740.000000000000000f, 1740.000000000000000f), epsilon );
+    }
+
+    it("should have simd8f_dot3 for three component dot product of each half") {
+        simd8f a = simd8f_create(1, 2, 3, 9999, 5, 6, 7, 9999);
+        simd8f b = simd8f_create(10, 20, 30, -9990, 50, 60, 70, -9990);
+
+        simd8f x = simd8f_dot3(a,b);
+        // octave simd8f: [ones(1,4)*dot([1,2,3], [10,20,30]), ones(1,4)*dot([5,6,7], [50,60,70])]
+        should_be_equal_simd8f(x, simd8f_create(140.000000000000000f, 140.000000000000000f, 140.000000000000000f, 140.000000000000000f, 1100.000000000000000f, 1100.000000000000000f, 1100.000000000000000f, 1100.000000000000000f), epsilon );
+    }
+
+    it("should have simd8f_length4 for four component vector length of each half") {
+        simd8f a = simd8f_create(1, 2, -3, 9999, 5, 6, 7, 8);
+        simd8f x = simd8f_length4(a);
+        // octave simd8f: [ones(1,4)*norm([1,2,-3,9999]), ones(1,4)*norm([5,6,7,8])]
+        should_be_equal_simd8f(x, simd8f_create(9999.000700069982486f, 9999.000700069982486f, 9999.000700069982486f, 9999.000700069982486f, 13.190905958272920f, 13.190905958272920f, 13.190905958272920f, 13.190905958272920f), epsilon );
+    }
+
+    it("should have simd8f_length3 for three component vector length of each half") {
+        simd8f a = simd8f_create(1, 2, -3, 9999, 5, 6, 7, 9999);
+        simd8f x = simd8f_length3(a);
+        // octave simd8f: [ones(1,4)*norm([1,2,-3]), ones(1,4)*norm([5,6,7])]
+        should_be_equal_simd8f(x, simd8f_create(3.741657386773941f, 3.741657386773941f, 3.741657386773941f, 3.741657386773941f, 10.488088481701515f, 10.488088481701515f, 10.488088481701515f, 10.488088481701515f), epsilon );
+    }
+
+    it("should have simd8f_length4_squared and simd8f_length3_squared for squared vector lengths") {
+        simd8f a = simd8f_create(1, 2, -3, 4, 5, 6, 7, 8);
+
+        simd8f x = simd8f_length4_squared(a);
+        should_be_equal_simd8f(x, simd8f_create(30, 30, 30, 30, 174, 174, 174, 174), epsilon );
+
+        x = simd8f_length3_squared(a);
+        should_be_equal_simd8f(x, simd8f_create(14, 14, 14, 14, 110, 110, 110, 110), epsilon );
+    }
+
+    it("should have simd8f_normalize4 for normalizing each half to unit length") {
+        simd8f a = simd8f_create(1, 2, 3, 4, 5, 6, 7, 8);
+        simd8f x = simd8f_normalize4(a);
+        const int epsilon = 4; // Grant larger error, rsqrt estimate
+        // octave simd8f: [[1,2,3,4] / norm([1,2,3,4]), [5,6,7,8] / norm([5,6,7,8])]
+        should_be_equal_simd8f(x, simd8f_create(0.182574185835055f, 0.365148371670111f, 0.547722557505166f, 0.730296743340221f, 0.379049021789452f, 0.454858826147342f, 0.530668630505232f, 0.606478434863123f), epsilon );
+    }
+
+    it("should have simd8f_normalize3 for normalizing three components of each half to unit length") {
+        simd8f a = simd8f_create(1, 2, 3, 0, 5, 6, 7, 0);
+        simd8f x = simd8f_normalize3(a);
+        const int epsilon = 4; // Grant larger error, rsqrt estimate
+        // octave simd8f: [[1,2,3,0] / norm([1,2,3]), [5,6,7,0] / norm([5,6,7])]
+        should_be_equal_simd8f(x, simd8f_create(0.267261241912424f, 0.534522483824849f, 0.801783725737273f, 0.000000000000000f, 0.476731294622796f, 0.572077553547355f, 0.667423812471915f, 0.000000000000000f), epsilon );
+    }
+
+}
+
+describe(simd8f, "min-max") {
+
+    it("should have simd8f_min for choosing minimum elements") {
+        simd8f a = simd8f_create(1.0f,  2.0f, -300000000.0f, -0.000002f, 5.0f, -6.0f, 7.0f, -8.0f);
+        simd8f b = simd8f_create(2.0f, -2.0f,  300000000.0f,  0.000001f, 6.0f, -7.0f, 6.0f,  8.0f);
+
+        simd8f x = simd8f_min(a,b);
+        should_be_equal_simd8f(x, simd8f_create(1.0f, -2.0f, -300000000.0f, -0.000002f, 5.0f, -7.0f, 6.0f, -8.0f), epsilon);
+
+    }
+
+    it("should have simd8f_max for choosing maximum elements") {
+        simd8f a = simd8f_create(1.0f,  2.0f, -300000000.0f, -0.000002f, 5.0f, -6.0f, 7.0f, -8.0f);
+        simd8f b = simd8f_create(2.0f, -2.0f,  300000000.0f,  0.000001f, 6.0f, -7.0f, 6.0f,  8.0f);
+
+        simd8f x = simd8f_max(a,b);
+        should_be_equal_simd8f(x, simd8f_create(2.0f, 2.0f, 300000000.0f, 0.000001f, 6.0f, -6.0f, 7.0f, 8.0f), epsilon);
+
+    }
+
+}
+
+
+describe(simd8f, "masks") {
+
+    it("should have simd8f_cmpeq, simd8f_cmpne, simd8f_cmplt, simd8f_cmple, simd8f_cmpgt and simd8f_cmpge giving masks") {
+        simd8f a = simd8f_create(1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f, 8.0f);
+        simd8f b = simd8f_create(1.0f, 1.0f, 4.0f, 5.0f, 5.0f, 7.0f, 6.0f, 8.0f);
+
+        should_equal( simd8f_movemask( simd8f_cmpeq(a, b) ), 1 | 16 | 128 );
+        should_equal( simd8f_movemask( simd8f_cmpne(a, b) ), 2 | 4 | 8 | 32 | 64 );
+        should_equal( simd8f_movemask( simd8f_cmplt(a, b) ), 4 | 8 | 32 );
+        should_equal( simd8f_movemask( simd8f_cmple(a, b) ), 1 | 4 | 8 | 16 | 32 | 128 );
+        should_equal( simd8f_movemask( simd8f_cmpgt(a, b) ), 2 | 64 );
+        should_equal( simd8f_movemask( simd8f_cmpge(a, b) ), 1 | 2 | 16 | 64 | 128 );
+    }
+
+    it("should combine masks with simd8f_mask_and, simd8f_mask_or, simd8f_mask_xor and simd8f_mask_not") {
+        simd8f a = simd8f_create(1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f, 8.0f);
+        simd8f_mask lo = simd8f_cmpgt(a, simd8f_splat(2.5f));
+        simd8f_mask hi = simd8f_cmplt(a, simd8f_splat(6.5f));
+
+        should_equal( simd8f_movemask( simd8f_mask_and(lo, hi) ), 4 | 8 | 16 | 32 );
+        should_equal( simd8f_movemask( simd8f_mask_or(lo, hi) ), 255 );
+        should_equal( simd8f_movemask( simd8f_mask_xor(lo, hi) ), 1 | 2 | 64 | 128 );
+        should_equal( simd8f_movemask( simd8f_mask_not(lo) ), 1 | 2 );
+    }
+
+    it("should have simd8f_select picking lanes by a mask") {
+        simd8f a = simd8f_create(1.0f, -2.0f, 3.0f, -4.0f, -5.0f, 6.0f, -7.0f, 8.0f);
+        simd8f x = simd8f_select( simd8f_cmplt(a, simd8f_zero()), simd8f_sub(simd8f_zero(), a), a );
+        should_be_equal_simd8f(x, simd8f_create(1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f, 8.0f), epsilon);
+    }
+
+    it("should have simd8f_any and simd8f_all testing the lanes of a mask") {
+        simd8f a = simd8f_create(1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f, 8.0f);
+        should_be_true( simd8f_any( simd8f_cmpgt(a, simd8f_splat(7.5f)) ) );
+        should_be_false( simd8f_any( simd8f_cmpgt(a, simd8f_splat(8.5f)) ) );
+        should_be_true( simd8f_all( simd8f_cmpgt(a, simd8f_splat(0.5f)) ) );
+        should_be_false( simd8f_all( simd8f_cmplt(a, simd8f_splat(7.5f)) ) );
+    }
+
+}
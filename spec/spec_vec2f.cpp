@@ -1,6 +1,7 @@
 #include "spec_helper.h"
 #include <iostream>
 using vectorial::vec2f;
+using vectorial::vec2b;
 
 const int epsilon = 1;
 
@@ -253,3 +254,33 @@ describe(vec2f, "vector math") {
 }
 
 
+describe(vec2f, "comparing") {
+
+    it("should have comparison operators giving vec2b masks") {
+        vec2f a(1,-2), b(1,2);
+
+        should_be_true( all(a == a) );
+        should_be_true( any(a == b) );
+        should_be_false( all(a == b) );
+        should_be_true( any(a != b) );
+        should_be_true( all(a <= b) );
+        should_be_false( all(a < b) );
+        should_be_false( any(a > b) );
+        should_be_true( all(b >= a) );
+    }
+
+    it("should ignore the last two lanes in any and all") {
+        vec2f a(1,2);
+        vec2f b( simd4f_create(1,2,3,4) );
+        should_be_true( all(a == b) );
+        should_be_false( any(a != b) );
+    }
+
+    it("should have select picking components by a mask") {
+        vec2f a(1,-2);
+        vec2b m = ~(a < vec2f::zero()) | (a > vec2f(5.0f));
+        vec2f x = select(m ^ (a > vec2f(5.0f)), a, vec2f(7.0f));
+        should_be_equal_vec2f(x, simd4f_create(1, 7, 0, 0), epsilon);
+    }
+
+}
@@ -1,6 +1,7 @@
 #include "spec_helper.h"
 #include <iostream>
 using vectorial::vec3f;
+using vectorial::vec3b;
 
 const int epsilon = 1;
 
@@ -261,3 +262,36 @@ describe(vec3f, "vector math") {
 }
 
 
+describe(vec3f, "comparing") {
+
+    it("should have comparison operators giving vec3b masks") {
+        vec3f a(1,2,-3), b(1,-2,3);
+
+        should_be_true( all(a == a) );
+        should_be_true( any(a == b) );
+        should_be_false( all(a == b) );
+        should_be_true( all(a != b) == false );
+        should_be_true( any(a < b) );
+        should_be_true( all(a <= vec3f(1,2,3)) );
+        should_be_false( any(a > vec3f(2)) );
+        should_be_true( all(a >= vec3f(-3)) );
+    }
+
+    it("should ignore the fourth lane in any and all") {
+        vec3f a(1,2,3);
+        vec3f b( simd4f_create(1,2,3,5) );
+        should_be_true( all(a == b) );
+        should_be_false( any(a != b) );
+        should_be_false( any(a > vec3f(3)) );
+    }
+
+    it("should have select picking components by a mask") {
+        vec3f a(1,-2,3);
+        vec3b m = (a > vec3f(0.0f)) & ~(a > vec3f(2.0f));
+        vec3f x = select(m, a, vec3f::zero());
+        should_be_equal_vec3f(x, simd4f_create(1, 0, 0, 0), epsilon);
+        should_be_true( any(m ^ (a > vec3f(0.0f))) );
+        should_be_true( all(m | (a < vec3f(3.5f))) );
+    }
+
+}
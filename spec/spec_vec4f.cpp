@@ -1,6 +1,7 @@
 #include "spec_helper.h"
 #include <iostream>
 using vectorial::vec4f;
+using vectorial::vec4b;
 
 const int epsilon = 1;
 
@@ -256,3 +257,34 @@ describe(vec4f, "vector math") {
 }
 
 
+describe(vec4f, "comparing") {
+
+    it("should have comparison operators giving vec4b masks") {
+        vec4f a(1,2,-3,4), b(1,-2,3,4.5f);
+
+        should_be_true( all(a == a) );
+        should_be_true( any(a == b) );
+        should_be_false( all(a == b) );
+        should_equal( simd4f_movemask( (a != b).value ), 2 | 4 | 8 );
+        should_equal( simd4f_movemask( (a < b).value ), 4 | 8 );
+        should_equal( simd4f_movemask( (a <= b).value ), 1 | 4 | 8 );
+        should_equal( simd4f_movemask( (a > b).value ), 2 );
+        should_equal( simd4f_movemask( (a >= b).value ), 1 | 2 );
+    }
+
+    it("should combine vec4b masks with &, |, ^ and ~") {
+        vec4f a(1,2,3,4);
+        vec4b m = (a > vec4f(1.5f)) & (a < vec4f(3.5f));
+        should_equal( simd4f_movemask( m.value ), 2 | 4 );
+        should_equal( simd4f_movemask( (m | (a > vec4f(3.5f))).value ), 2 | 4 | 8 );
+        should_equal( simd4f_movemask( (m ^ (a > vec4f(2.5f))).value ), 2 | 8 );
+        should_equal( simd4f_movemask( (~m).value ), 1 | 8 );
+    }
+
+    it("should have select picking components by a mask") {
+        vec4f a(1,-2,3,-4);
+        vec4f x = select(a < vec4f::zero(), -a, a);
+        should_be_equal_vec4f(x, simd4f_create(1, 2, 3, 4), epsilon);
+    }
+
+}
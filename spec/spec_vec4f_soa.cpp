@@ -0,0 +1,264 @@
+#include "spec_helper.h"
+#include <iostream>
+using vectorial::vec4f;
+using vectorial::vec4f_soa4;
+using vectorial::vec4f_soa8;
+
+const int epsilon = 1;
+
+namespace {
+
+    // Lane i of the test packets is vector a(i) / b(i)
+    vec4f a(int i) { return vec4f(1.0f + i, 2.0f - 3*i, 0.5f * i + 3, 2.0f - 0.25f * i); }
+    vec4f b(int i) { return vec4f(4.5f - i, 1.5f * i + 1, 7.0f - 2*i, 0.5f + i); }
+
+    template<class T>
+    T packet(vec4f (*f)(int)) {
+        float x[T::width], y[T::width], z[T::width], w[T::width];
+        for(int i = 0; i < T::width; ++i) {
+            const vec4f v = f(i);
+            x[i] = v.x(); y[i] = v.y(); z[i] = v.z(); w[i] = v.w();
+        }
+        T p;
+        p.load(x, y, z, w);
+        return p;
+    }
+
+    template<class T>
+    vec4f lane(const T& p, int i) {
+        float x[T::width], y[T::width], z[T::width], w[T::width];
+        p.store(x, y, z, w);
+        return vec4f(x[i], y[i], z[i], w[i]);
+    }
+
+    float lane(const simd4f& s, int i) {
+        float f[4];
+        simd4f_ustore4(s, f);
+        return f[i];
+    }
+
+    float lane(const simd8f& s, int i) {
+        float f[8];
+        simd8f_ustore8(s, f);
+        return f[i];
+    }
+
+}
+
+
+describe(vec4f_soa4, "constructing") {
+
+    it("should have constructor with component registers") {
+        vec4f_soa4 x(simd4f_create(1,2,3,4), simd4f_create(5,6,7,8), simd4f_create(9,10,11,12), simd4f_create(13,14,15,16));
+        should_be_equal_simd4f(x.x, simd4f_create(1,2,3,4), epsilon);
+        should_be_equal_simd4f(x.y, simd4f_create(5,6,7,8), epsilon);
+        should_be_equal_simd4f(x.z, simd4f_create(9,10,11,12), epsilon);
+        should_be_equal_simd4f(x.w, simd4f_create(13,14,15,16), epsilon);
+    }
+
+    it("should have constructor with element values for every lane") {
+        vec4f_soa4 x(1,2,3,4);
+        should_be_equal_simd4f(x.x, simd4f_splat(1), epsilon);
+        should_be_equal_simd4f(x.y, simd4f_splat(2), epsilon);
+        should_be_equal_simd4f(x.z, simd4f_splat(3), epsilon);
+        should_be_equal_simd4f(x.w, simd4f_splat(4), epsilon);
+    }
+
+    it("should have constructor that broadcasts a vec4f to every lane") {
+        vec4f_soa4 x( vec4f(1,2,3,4) );
+        should_be_equal_simd4f(x.x, simd4f_splat(1), epsilon);
+        should_be_equal_simd4f(x.y, simd4f_splat(2), epsilon);
+        should_be_equal_simd4f(x.z, simd4f_splat(3), epsilon);
+        should_be_equal_simd4f(x.w, simd4f_splat(4), epsilon);
+    }
+
+}
+
+describe(vec4f_soa4, "loads and stores") {
+
+    it("should have method for loading from component arrays") {
+        float xs[4] = { 1,2,3,4 }, ys[4] = { 5,6,7,8 }, zs[4] = { 9,10,11,12 }, ws[4] = { 13,14,15,16 };
+        vec4f_soa4 x;
+        x.load(xs, ys, zs, ws);
+        should_be_equal_simd4f(x.x, simd4f_create(1,2,3,4), epsilon);
+        should_be_equal_simd4f(x.y, simd4f_create(5,6,7,8), epsilon);
+        should_be_equal_simd4f(x.z, simd4f_create(9,10,11,12), epsilon);
+        should_be_equal_simd4f(x.w, simd4f_create(13,14,15,16), epsilon);
+    }
+
+    it("should have method for storing to component arrays") {
+        float xs[4], ys[4], zs[4], ws[4];
+        vec4f_soa4 x(simd4f_create(1,2,3,4), simd4f_create(5,6,7,8), simd4f_create(9,10,11,12), simd4f_create(13,14,15,16));
+        x.store(xs, ys, zs, ws);
+        for(int i = 0; i < 4; ++i) {
+            should_be_close_to(xs[i], 1 + i, epsilon);
+            should_be_close_to(ys[i], 5 + i, epsilon);
+            should_be_close_to(zs[i], 9 + i, epsilon);
+            should_be_close_to(ws[i], 13 + i, epsilon);
+        }
+    }
+
+    it("should have load and store for vec4f arrays") {
+        vec4f v[4], out[4];
+        for(int i = 0; i < 4; ++i) v[i] = a(i);
+        vec4f_soa4 x;
+        x.load(v);
+        for(int i = 0; i < 4; ++i) {
+            should_be_equal_vec4f(lane(x, i), a(i), epsilon);
+        }
+        x.store(out);
+        for(int i = 0; i < 4; ++i) {
+            should_be_equal_vec4f(out[i], a(i), epsilon);
+        }
+    }
+
+    it("should have load_aos and store_aos for packed float arrays") {
+        float ary[4*4], out[4*4];
+        for(int i = 0; i < 4; ++i) {
+            a(i).store(ary + 4*i);
+        }
+        vec4f_soa4 x;
+        x.load_aos(ary, 4);
+        for(int i = 0; i < 4; ++i) {
+            should_be_equal_vec4f(lane(x, i), a(i), epsilon);
+        }
+        x.store_aos(out, 4);
+        for(int i = 0; i < 4*4; ++i) {
+            should_be_close_to(out[i], ary[i], epsilon);
+        }
+    }
+
+}
+
+describe(vec4f_soa4, "lane-wise operations matching vec4f") {
+
+    const vec4f_soa4 pa = packet<vec4f_soa4>(a);
+    const vec4f_soa4 pb = packet<vec4f_soa4>(b);
+
+    it("should have arithmetic with another vec4f_soa4") {
+        for(int i = 0; i < 4; ++i) {
+            should_be_equal_vec4f(lane(pa + pb, i), a(i) + b(i), epsilon);
+            should_be_equal_vec4f(lane(pa - pb, i), a(i) - b(i), epsilon);
+            should_be_equal_vec4f(lane(pa * pb, i), a(i) * b(i), epsilon);
+            should_be_equal_vec4f(lane(pa / pb, i), a(i) / b(i), epsilon);
+            should_be_equal_vec4f(lane(-pa, i), -a(i), epsilon);
+        }
+    }
+
+    it("should have arithmetic with a float") {
+        for(int i = 0; i < 4; ++i) {
+            should_be_equal_vec4f(lane(pa + 2.0f, i), a(i) + 2.0f, epsilon);
+            should_be_equal_vec4f(lane(pa * 2.0f, i), a(i) * 2.0f, epsilon);
+            should_be_equal_vec4f(lane(2.0f - pa, i), 2.0f - a(i), epsilon);
+            should_be_equal_vec4f(lane(2.0f / pa, i), 2.0f / a(i), epsilon);
+        }
+    }
+
+    it("should have compound assignment operators") {
+        vec4f_soa4 x = pa, y = pa, z = pa, w = pa;
+        x += pb;
+        y -= pb;
+        z *= 2.0f;
+        w /= 2.0f;
+        for(int i = 0; i < 4; ++i) {
+            should_be_equal_vec4f(lane(x, i), a(i) + b(i), epsilon);
+            should_be_equal_vec4f(lane(y, i), a(i) - b(i), epsilon);
+            should_be_equal_vec4f(lane(z, i), a(i) * 2.0f, epsilon);
+            should_be_equal_vec4f(lane(w, i), a(i) / 2.0f, epsilon);
+        }
+    }
+
+    it("should have per-lane scaling with a simd4f") {
+        const simd4f s = simd4f_create(1,2,3,4);
+        for(int i = 0; i < 4; ++i) {
+            should_be_equal_vec4f(lane(pa * s, i), a(i) * float(i + 1), epsilon);
+            should_be_equal_vec4f(lane(s * pa, i), a(i) * float(i + 1), epsilon);
+            should_be_equal_vec4f(lane(pa / s, i), a(i) / float(i + 1), epsilon);
+        }
+    }
+
+    it("should have dot, length and length_squared giving one value per lane") {
+        for(int i = 0; i < 4; ++i) {
+            should_be_close_to(lane(dot(pa, pb), i), dot(a(i), b(i)), epsilon);
+            should_be_close_to(lane(length(pa), i), length(a(i)), epsilon);
+            should_be_close_to(lane(length_squared(pa), i), length_squared(a(i)), epsilon);
+        }
+    }
+
+    it("should have normalize") {
+        const int epsilon = 4; // rsqrt estimate
+        for(int i = 0; i < 4; ++i) {
+            should_be_equal_vec4f(lane(normalize(pa), i), a(i) / length(a(i)), epsilon);
+        }
+    }
+
+    it("should have min and max") {
+        for(int i = 0; i < 4; ++i) {
+            should_be_equal_vec4f(lane(min(pa, pb), i), min(a(i), b(i)), epsilon);
+            should_be_equal_vec4f(lane(max(pa, pb), i), max(a(i), b(i)), epsilon);
+        }
+    }
+
+}
+
+
+describe(vec4f_soa8, "constructing") {
+
+    it("should have constructor that broadcasts a vec4f to every lane") {
+        vec4f_soa8 x( vec4f(1,2,3,4) );
+        should_be_equal_simd8f(x.x, simd8f_splat(1), epsilon);
+        should_be_equal_simd8f(x.y, simd8f_splat(2), epsilon);
+        should_be_equal_simd8f(x.z, simd8f_splat(3), epsilon);
+        should_be_equal_simd8f(x.w, simd8f_splat(4), epsilon);
+    }
+
+    it("should have load and store for vec4f arrays") {
+        vec4f v[8], out[8];
+        for(int i = 0; i < 8; ++i) v[i] = a(i);
+        vec4f_soa8 x;
+        x.load(v);
+        x.store(out);
+        for(int i = 0; i < 8; ++i) {
+            should_be_equal_vec4f(lane(x, i), a(i), epsilon);
+            should_be_equal_vec4f(out[i], a(i), epsilon);
+        }
+    }
+
+}
+
+describe(vec4f_soa8, "lane-wise operations matching vec4f") {
+
+    const vec4f_soa8 pa = packet<vec4f_soa8>(a);
+    const vec4f_soa8 pb = packet<vec4f_soa8>(b);
+
+    it("should have arithmetic") {
+        for(int i = 0; i < 8; ++i) {
+            should_be_equal_vec4f(lane(pa + pb, i), a(i) + b(i), epsilon);
+            should_be_equal_vec4f(lane(pa - pb * 2.0f, i), a(i) - b(i) * 2.0f, epsilon);
+            should_be_equal_vec4f(lane(pa / pb, i), a(i) / b(i), epsilon);
+            should_be_equal_vec4f(lane(-pa, i), -a(i), epsilon);
+        }
+    }
+
+    it("should have dot and length") {
+        for(int i = 0; i < 8; ++i) {
+            should_be_close_to(lane(dot(pa, pb), i), dot(a(i), b(i)), epsilon);
+            should_be_close_to(lane(length(pa), i), length(a(i)), epsilon);
+        }
+    }
+
+    it("should have normalize") {
+        const int epsilon = 4; // rsqrt estimate
+        for(int i = 0; i < 8; ++i) {
+            should_be_equal_vec4f(lane(normalize(pa), i), a(i) / length(a(i)), epsilon);
+        }
+    }
+
+    it("should have min and max") {
+        for(int i = 0; i < 8; ++i) {
+            should_be_equal_vec4f(lane(min(pa, pb), i), min(a(i), b(i)), epsilon);
+            should_be_equal_vec4f(lane(max(pa, pb), i), max(a(i), b(i)), epsilon);
+        }
+    }
+
+}
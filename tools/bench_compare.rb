@@ -0,0 +1,93 @@
+#!/usr/bin/env ruby
+#
+# Runs the same benches on every built benchmark-<backend> and prints one
+# table of per item times, with the speedup over the baseline backend.
+#
+#   tools/bench_compare.rb [--backends scalar,gnu,sse,avx] [--baseline scalar]
+#                          [--tolerance 0.1] [benchmark options and benches...]
+#
+# Anything else on the command line goes to the benchmarks as is, for
+# example "--samples 20 --filter aabb bounds cull". A * marks the times more
+# than tolerance slower than the fastest backend for that op.
+
+require 'csv'
+require 'open3'
+
+ROOT = File.expand_path("..", File.dirname(__FILE__))
+
+backends = %w(scalar gnu sse avx)
+baseline = "scalar"
+tolerance = 0.1
+passthrough = []
+
+args = ARGV.dup
+until args.empty?
+  arg = args.shift
+  case arg
+  when "--backends" then backends = args.shift.split(",")
+  when "--baseline" then baseline = args.shift
+  when "--tolerance" then tolerance = Float(args.shift)
+  else passthrough << arg
+  end
+end
+
+if passthrough.any? { |a| a == "--format" || a == "--output" }
+  abort "bench_compare: --format and --output are set by the driver"
+end
+
+
+# [bench, name] => { backend => ns per item }
+times = {}
+simd = {}
+ran = []
+
+backends.each do |backend|
+  exe = File.join(ROOT, "benchmark-#{backend}")
+  unless File.executable?(exe)
+    $stderr.puts "skipping #{backend}, no #{exe}, try make benchmark-#{backend}"
+    next
+  end
+  $stderr.puts "running benchmark-#{backend}"
+  out, status = Open3.capture2(exe, "--format", "csv", *passthrough, :err => File::NULL)
+  # A crash, f.ex. an illegal instruction on an older CPU, leaves that
+  # backend out and the rest still get compared
+  unless status.success?
+    $stderr.puts "skipping #{backend}, benchmark-#{backend} failed (#{status})"
+    next
+  end
+
+  CSV.parse(out, :headers => true).each do |row|
+    (times[[row["bench"], row["name"]]] ||= {})[backend] = Float(row["ns_per_element"])
+    simd[backend] = row["simd"]
+  end
+  ran << backend
+end
+
+abort "bench_compare: nothing to compare" if times.empty?
+$stderr.puts "no #{baseline} results, showing times only" unless ran.include?(baseline)
+
+
+def cell(ns, base, mark)
+  s = "%.3fns" % ns
+  s << " %5.2fx" % (base / ns) if base
+  s << (mark ? " *" : "  ")
+end
+
+headers = ["bench", "op"] + ran.map { |b| simd[b] == b ? b : "#{b} (#{simd[b]})" }
+rows = times.map do |(bench, name), by_backend|
+  fastest = by_backend.values.min
+  base = by_backend[baseline]
+  [bench, name] + ran.map do |b|
+    ns = by_backend[b]
+    ns ? cell(ns, base, ns > fastest * (1 + tolerance)) : "-"
+  end
+end
+
+widths = headers.each_index.map { |i| ([headers] + rows).map { |r| r[i].size }.max }
+line = lambda { |r| r.each_with_index.map { |c, i| i < 2 ? c.ljust(widths[i]) : c.rjust(widths[i]) }.join("  ") }
+
+puts line.call(headers)
+puts widths.map { |w| "-" * w }.join("  ")
+rows.each { |r| puts line.call(r) }
+puts
+puts "per item median#{ran.include?(baseline) ? ", speedup over #{baseline}" : ""}, * more than #{(tolerance * 100).round}% slower than the fastest"
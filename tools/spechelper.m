@@ -33,7 +33,12 @@ function spec_formatter (val,type)
         return;
     endif
 
-    if( size(val) == [4,4] ) 
+    if( size(val) == [1,8] )
+        printf("        should_be_equal_%s(x, simd8f_create(%15.15ff, %15.15ff, %15.15ff, %15.15ff, %15.15ff, %15.15ff, %15.15ff, %15.15ff), epsilon );",type, val(1), val(2), val(3), val(4), val(5), val(6), val(7), val(8));
+        return;
+    endif
+
+    if( size(val) == [4,4] )
         printf("        should_be_equal_%s(x, simd4x4f_create(simd4f_create(%15.15ff, %15.15ff, %15.15ff, %15.15ff), simd4f_create(%15.15ff, %15.15ff, %15.15ff, %15.15ff), simd4f_create(%15.15ff, %15.15ff, %15.15ff, %15.15ff), simd4f_create(%15.15ff, %15.15ff, %15.15ff, %15.15ff)), epsilon );",type, 
         val(1), val(2), val(3), val(4), val(5), val(6), val(7), val(8), val(9), val(10), val(11), val(12), val(13), val(14), val(15), val(16)
         );